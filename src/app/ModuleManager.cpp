@@ -9,6 +9,7 @@
 namespace {
 constexpr const char* kSettingsGroup = "Modules";
 constexpr const char* kSettingsKeyOrder = "order";
+constexpr const char* kSettingsKeyLastActive = "lastActive";
 }
 
 
@@ -103,6 +104,13 @@ void ModuleManager::activateModule(const QString& moduleId)
     if (newMod) {
         newMod->onActivate();
         currentModuleId_ = moduleId;
+
+        // Remembered so the next launch reopens the same module
+        QSettings settings;
+        settings.beginGroup(kSettingsGroup);
+        settings.setValue(kSettingsKeyLastActive, moduleId);
+        settings.endGroup();
+
         emit moduleActivated(moduleId);
         qDebug() << "ModuleManager: Activated module:" << moduleId;
     } else {
@@ -110,6 +118,16 @@ void ModuleManager::activateModule(const QString& moduleId)
     }
 }
 
+QString ModuleManager::lastActiveModuleId() const
+{
+    QSettings settings;
+    settings.beginGroup(kSettingsGroup);
+    const QString moduleId = settings.value(kSettingsKeyLastActive).toString();
+    settings.endGroup();
+
+    return modules_.contains(moduleId) ? moduleId : QString();
+}
+
 void ModuleManager::setModuleOrder(const QStringList& orderedIds)
 {
     // Store as "loaded/user order" source, then reconcile deterministically
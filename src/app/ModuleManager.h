@@ -40,6 +40,7 @@ public:
     QWidget* getModuleWidget(const QString& moduleId, QWidget* parent = nullptr);
     QString currentModuleId() const { return currentModuleId_; }
     void activateModule(const QString& moduleId);
+    QString lastActiveModuleId() const;     ///< Module active at the end of the last session (empty if unknown)
 
     // Ordering / persistence
     void setModuleOrder(const QStringList& orderedIds);
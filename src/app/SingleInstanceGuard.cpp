@@ -0,0 +1,134 @@
+// src/app/SingleInstanceGuard.cpp
+
+#include "SingleInstanceGuard.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDebug>
+
+
+namespace {
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_6_0;
+}
+
+
+SingleInstanceGuard::SingleInstanceGuard(QObject* parent)
+    : QObject(parent)
+    , server_(nullptr)
+{
+    // Per user: local server names are global on Windows and live in /tmp elsewhere
+    const QByteArray userKey = QCryptographicHash::hash(QDir::homePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    serverName_ = QString("TestLeadToolbox-%1").arg(QString::fromLatin1(userKey.left(16)));
+}
+
+SingleInstanceGuard::~SingleInstanceGuard()
+{
+    if (server_) {
+        server_->close();
+    }
+}
+
+SingleInstanceGuard::Handoff SingleInstanceGuard::sendToRunningInstance(const QStringList& filePaths,
+                                                                       int connectTimeoutMs, int answerTimeoutMs)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName_);
+    if (!socket.waitForConnected(connectTimeoutMs)) {
+        const QLocalSocket::LocalSocketError error = socket.error();
+        if (error == QLocalSocket::ServerNotFoundError || error == QLocalSocket::ConnectionRefusedError) {
+            return NoInstance;
+        }
+        qWarning() << "SingleInstanceGuard: Could not reach the running instance:" << socket.errorString();
+        return NotResponding;
+    }
+
+    QByteArray message;
+    QDataStream out(&message, QIODevice::WriteOnly);
+    out.setVersion(kStreamVersion);
+    out << filePaths;
+
+    // Connected means alive: from here on a slow answer is waited for, never taken as a crash
+    socket.write(message);
+    if (!socket.waitForBytesWritten(answerTimeoutMs)) {
+        qWarning() << "SingleInstanceGuard: Running instance did not accept the message:" << socket.errorString();
+        return NotResponding;
+    }
+
+    if (!socket.waitForReadyRead(answerTimeoutMs) || !socket.read(1).startsWith(ACK)) {
+        qWarning() << "SingleInstanceGuard: Running instance did not acknowledge";
+        return NotResponding;
+    }
+
+    socket.disconnectFromServer();
+    return Delivered;
+}
+
+bool SingleInstanceGuard::listen()
+{
+    if (!server_) {
+        server_ = new QLocalServer(this);
+        server_->setSocketOptions(QLocalServer::UserAccessOption);
+        connect(server_, &QLocalServer::newConnection, this, &SingleInstanceGuard::onNewConnection);
+    }
+
+    if (server_->listen(serverName_)) {
+        return true;
+    }
+
+    // Only a socket nobody accepts on was left behind by a crashed instance; another
+    // launch may have started listening since sendToRunningInstance() looked
+    if (server_->serverError() == QAbstractSocket::AddressInUseError && isStale()) {
+        QLocalServer::removeServer(serverName_);
+        if (server_->listen(serverName_)) {
+            return true;
+        }
+    }
+
+    qWarning() << "SingleInstanceGuard: Could not listen on" << serverName_ << "-" << server_->errorString();
+    return false;
+}
+
+bool SingleInstanceGuard::isStale() const
+{
+    QLocalSocket probe;
+    probe.connectToServer(serverName_);
+    if (probe.waitForConnected(1000)) {
+        probe.abort();
+        return false;
+    }
+    return probe.error() == QLocalSocket::ConnectionRefusedError;
+}
+
+void SingleInstanceGuard::onNewConnection()
+{
+    while (QLocalSocket* socket = server_->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readMessage(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+
+        // The message may already be buffered
+        if (socket->bytesAvailable() > 0) {
+            readMessage(socket);
+        }
+    }
+}
+
+void SingleInstanceGuard::readMessage(QLocalSocket* socket)
+{
+    QDataStream in(socket);
+    in.setVersion(kStreamVersion);
+
+    // Wait for the rest if the list arrived in several chunks
+    in.startTransaction();
+    QStringList filePaths;
+    in >> filePaths;
+    if (!in.commitTransaction()) {
+        return;
+    }
+
+    socket->write(&ACK, 1);
+    socket->flush();
+
+    emit filesReceived(filePaths);
+}
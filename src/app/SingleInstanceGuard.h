@@ -0,0 +1,67 @@
+// src/app/SingleInstanceGuard.h
+
+
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+
+class QLocalServer;
+class QLocalSocket;
+
+
+/**
+ * @class SingleInstanceGuard
+ * @brief Keeps one running application per user and hands files to it
+ *
+ * The first instance listens on a per-user local socket. A later launch connects to it
+ * before any window or module is built, sends its file arguments and exits; the running
+ * instance emits filesReceived() and opens them with its already warm state.
+ *
+ * Message: one QDataStream-serialized QStringList of absolute paths (possibly empty),
+ * answered with a single ACK byte once it has been read.
+ *
+ * A socket is only treated as left behind by a crashed instance when connecting to it
+ * is refused. An instance that accepts the connection but answers late (still building
+ * its window, or busy) is alive, and its socket is never removed.
+ */
+class SingleInstanceGuard : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SingleInstanceGuard(QObject* parent = nullptr);
+    ~SingleInstanceGuard();
+
+    enum Handoff {
+        Delivered,          ///< A running instance has the files (the caller should exit)
+        NoInstance,         ///< Nobody is listening (the caller becomes the running instance)
+        NotResponding       ///< An instance is running but did not answer (the caller must not start a second one)
+    };
+
+    /**
+     * @brief Hand files to an already running instance
+     * @param filePaths Absolute paths to open (empty just brings the running window forward)
+     * @param connectTimeoutMs Budget for connecting
+     * @param answerTimeoutMs Budget for write and acknowledge once connected (the running
+     *        instance answers from its event loop, which may still be starting up)
+     */
+    Handoff sendToRunningInstance(const QStringList& filePaths, int connectTimeoutMs = 1000, int answerTimeoutMs = 15000);
+
+    bool listen();                                      ///< @brief Become the running instance (false if the socket could not be created)
+    QString serverName() const { return serverName_; }
+
+    static constexpr char ACK = '\x06';
+
+signals:
+    void filesReceived(const QStringList& filePaths);   ///< @brief Another launch forwarded these files
+
+private:
+    bool isStale() const;                               ///< The socket exists but nobody accepts connections
+    void onNewConnection();
+    void readMessage(QLocalSocket* socket);
+
+    QString serverName_;
+    QLocalServer* server_;
+};
@@ -1,10 +1,81 @@
 #include "mainwindow.h"
+#include "SingleInstanceGuard.h"
+#include "modules/timeline/TimelineSyncRelay.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QMessageBox>
+
+namespace {
+
+bool hasArgument(int argc, char *argv[], const char *name)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
 
 int main(int argc, char *argv[])
 {
+    // The live-session relay runs headless, without a display or a main window
+    if (hasArgument(argc, argv, "--sync-relay")) {
+        QCoreApplication relayApp(argc, argv);
+        return TimelineSyncRelay::runStandalone(relayApp.arguments());
+    }
+
     QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("TestLeadToolbox");
+    parser.addHelpOption();
+    parser.addPositionalArgument("files", "Timeline files to open.", "[files...]");
+    parser.addOption({ "new-instance", "Start a separate instance instead of handing files to a running one." });
+    parser.addOption({ "sync-relay", "Run a live-session relay without a window (see --sync-port). "
+                                     "The session token is read from TESTLEADTOOLBOX_SYNC_TOKEN, or generated and printed." });
+    parser.addOption({ "sync-port", "Port the live-session relay listens on.", "port" });
+    parser.addOption({ "sync-shared", "Let the relay accept other computers (default: this computer only)." });
+    parser.addOption({ "sync-exit-when-idle", "Stop the relay once the last participant has left." });
+    parser.process(a);
+
+    // Positional arguments are files to open (e.g. a double-clicked timeline)
+    QStringList filePaths;
+    const QStringList arguments = parser.positionalArguments();
+    for (const QString& argument : arguments) {
+        filePaths.append(QFileInfo(argument).absoluteFilePath());
+    }
+
+    // A second launch hands its files to the running instance before building any UI
+    // (unless asked for its own window, e.g. to join a live session from the same machine)
+    SingleInstanceGuard instance;
+    const bool separateInstance = parser.isSet("new-instance");
+    if (!separateInstance) {
+        switch (instance.sendToRunningInstance(filePaths)) {
+        case SingleInstanceGuard::Delivered:
+            return 0;
+        case SingleInstanceGuard::NotResponding:
+            // Starting anyway would put two instances on the same autosave files
+            QMessageBox::warning(nullptr, "TestLeadToolbox",
+                                 "TestLeadToolbox is already running but is not responding.\n\n"
+                                 "Try again once it has finished starting, or close it first.");
+            return 1;
+        case SingleInstanceGuard::NoInstance:
+            break;
+        }
+        instance.listen();
+    }
+
     MainWindow w;
+    QObject::connect(&instance, &SingleInstanceGuard::filesReceived, &w, &MainWindow::openFiles);
     w.show();
+
+    if (!filePaths.isEmpty()) {
+        w.openFiles(filePaths);
+    }
+
     return a.exec();
 }
@@ -15,6 +15,7 @@
 #include <QStackedWidget>
 #include <QSplitter>
 #include <QVBoxLayout>
+#include <QFileInfo>
 #include <QDebug>
 
 MainWindow::MainWindow(QWidget *parent)
@@ -46,6 +47,13 @@ MainWindow::MainWindow(QWidget *parent)
 
     // Status bar
     statusBar()->showMessage("Ready - Select a module to begin");
+
+    // Reopen the module the last session ended in; its widget was already built (and its
+    // project load started) in setupModules(), so this only puts it on screen
+    const QString lastModuleId = moduleManager_->lastActiveModuleId();
+    if (!lastModuleId.isEmpty()) {
+        onModuleLaunchRequested(lastModuleId);
+    }
 }
 
 MainWindow::~MainWindow()
@@ -403,8 +411,42 @@ void MainWindow::onLoad()
     }
 }
 
+void MainWindow::openFiles(const QStringList& filePaths)
+{
+    if (isMinimized()) {
+        showNormal();
+    }
+    raise();
+    activateWindow();
+
+    if (filePaths.isEmpty()) {
+        return;
+    }
+
+    // Timeline projects are the only documents; one project is open at a time, so the last one wins
+    onModuleLaunchRequested("timeline");
+    TimelineModule* timelineModule = qobject_cast<TimelineModule*>(moduleStack_->currentWidget());
+    if (!timelineModule) {
+        return;
+    }
+
+    if (filePaths.size() > 1) {
+        statusBar()->showMessage(QString("Opening %1 of %2 files").arg(QFileInfo(filePaths.last()).fileName()).arg(filePaths.size()));
+    }
+    timelineModule->loadFile(filePaths.last());
+}
+
 void MainWindow::closeEvent(QCloseEvent* event)
 {
+    // Modules settle what their destructors could not (e.g. a save blocked by a pending merge)
+    for (const QString& moduleId : moduleManager_->moduleIds()) {
+        IModule* mod = moduleManager_->module(moduleId);
+        if (mod && !mod->prepareToClose()) {
+            event->ignore();
+            return;
+        }
+    }
+
     // Check all modules for unsaved changes
     QStringList modulesWithChanges;
     for (const QString& moduleId : moduleManager_->moduleIds()) {
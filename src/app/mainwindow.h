@@ -4,6 +4,7 @@
 #pragma once
 #include <QMainWindow>
 #include <QList>
+#include <QStringList>
 #include <QMetaObject>
 
 
@@ -34,6 +35,9 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+public slots:
+    void openFiles(const QStringList& filePaths);     ///< @brief Bring the window forward and open files (command line or second instance)
+
 protected:
     void closeEvent(QCloseEvent* event) override;
 
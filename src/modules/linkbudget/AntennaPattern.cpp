@@ -0,0 +1,308 @@
+// src/modules/linkbudget/AntennaPattern.cpp
+
+#include "AntennaPattern.h"
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QRandomGenerator>
+#include <QFileInfo>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double kFullTurn = 360.0;
+
+/**
+ * @brief Cell and weight of a value on a uniform axis
+ */
+struct AxisPosition {
+    int i0 = 0;
+    int i1 = 0;
+    double t = 0.0;
+};
+
+inline AxisPosition axisPosition(double value, double start, double inverseStep, int count, bool wraps)
+{
+    AxisPosition p;
+    if (count <= 1) {
+        return p;
+    }
+
+    double pos = (value - start) * inverseStep;
+    if (wraps) {
+        pos = std::fmod(pos, static_cast<double>(count));
+        if (pos < 0.0) {
+            pos += count;
+        }
+        p.i0 = std::min(static_cast<int>(pos), count - 1);
+        p.i1 = (p.i0 + 1 == count) ? 0 : p.i0 + 1;
+    } else {
+        pos = std::clamp(pos, 0.0, static_cast<double>(count - 1));
+        p.i0 = std::min(static_cast<int>(pos), count - 2);
+        p.i1 = p.i0 + 1;
+    }
+    p.t = pos - p.i0;
+    return p;
+}
+
+/**
+ * @brief Sorted distinct values of an axis, checked for uniform spacing
+ */
+bool uniformAxis(QVector<double> values, double& start, double& step, int& count, QString& error)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end(),
+                             [](double a, double b) { return qAbs(a - b) < 1e-9; }),
+                 values.end());
+
+    start = values.first();
+    count = values.size();
+    step = count > 1 ? (values.last() - values.first()) / (count - 1) : 1.0;
+
+    for (int i = 1; i < count; ++i) {
+        if (qAbs((values[i] - values[i - 1]) - step) > step * 1e-3) {
+            error = QString("Angles are not uniformly spaced (%1 to %2)").arg(values[i - 1]).arg(values[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+AntennaPattern AntennaPattern::fromGrid(double azimuthStart, double azimuthStep, int azimuthCount,
+                                        double elevationStart, double elevationStep, int elevationCount,
+                                        const QVector<float>& gainsDb)
+{
+    AntennaPattern pattern;
+    if (azimuthCount < 1 || elevationCount < 1 || gainsDb.size() != azimuthCount * elevationCount
+        || azimuthStep <= 0.0 || elevationStep <= 0.0) {
+        return pattern;
+    }
+
+    pattern.azimuthStart_ = azimuthStart;
+    pattern.azimuthStep_ = azimuthStep;
+    pattern.azimuthCount_ = azimuthCount;
+    pattern.elevationStart_ = elevationStart;
+    pattern.elevationStep_ = elevationStep;
+    pattern.elevationCount_ = elevationCount;
+    pattern.gains_ = gainsDb;
+    pattern.peakGain_ = *std::max_element(gainsDb.cbegin(), gainsDb.cend());
+
+    // A full turn without a duplicated closing column interpolates across the seam
+    pattern.azimuthWraps_ = elevationCount > 1 && azimuthCount > 1
+                            && qAbs(azimuthCount * azimuthStep - kFullTurn) < azimuthStep * 0.5;
+    return pattern;
+}
+
+AntennaPattern AntennaPattern::fromFile(const QString& filePath, QString* errorString)
+{
+    auto fail = [errorString](const QString& message) {
+        if (errorString) {
+            *errorString = message;
+        }
+        return AntennaPattern();
+    };
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return fail("Could not open file: " + file.errorString());
+    }
+
+    static const QRegularExpression separators("[,;\\s]+");
+
+    QVector<double> azimuths;
+    QVector<double> elevations;
+    QVector<double> values;
+    int columns = 0;
+    int lineNumber = 0;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        ++lineNumber;
+        QString line = in.readLine();
+        const int comment = line.indexOf('#');
+        if (comment >= 0) {
+            line.truncate(comment);
+        }
+
+        const QStringList fields = line.split(separators, Qt::SkipEmptyParts);
+        if (fields.isEmpty()) {
+            continue;
+        }
+
+        double numbers[3] = {};
+        bool numeric = fields.size() <= 3;
+        for (int i = 0; numeric && i < fields.size(); ++i) {
+            numbers[i] = fields[i].toDouble(&numeric);
+        }
+
+        if (!numeric || fields.size() < 2) {
+            if (values.isEmpty() && columns == 0) {
+                continue;   // Header
+            }
+            return fail(QString("Line %1: expected 'angle gain' or 'azimuth elevation gain'").arg(lineNumber));
+        }
+
+        if (columns == 0) {
+            columns = fields.size();
+        } else if (fields.size() != columns) {
+            return fail(QString("Line %1: expected %2 columns").arg(lineNumber).arg(columns));
+        }
+
+        azimuths.append(numbers[0]);
+        if (columns == 3) {
+            elevations.append(numbers[1]);
+        }
+        values.append(numbers[columns - 1]);
+    }
+
+    if (values.size() < 2) {
+        return fail("Pattern needs at least two samples");
+    }
+
+    QString error;
+    double azStart = 0.0, azStep = 1.0, elStart = 0.0, elStep = 1.0;
+    int azCount = 0, elCount = 1;
+
+    if (!uniformAxis(azimuths, azStart, azStep, azCount, error)
+        || (columns == 3 && !uniformAxis(elevations, elStart, elStep, elCount, error))) {
+        return fail(error);
+    }
+
+    if (azCount * elCount != values.size()) {
+        return fail(QString("Incomplete grid: %1 azimuths x %2 elevations, %3 samples")
+                        .arg(azCount).arg(elCount).arg(values.size()));
+    }
+
+    // Samples may come in any order; place each one by its angles
+    QVector<float> grid(azCount * elCount, std::numeric_limits<float>::quiet_NaN());
+    for (int i = 0; i < values.size(); ++i) {
+        const int az = qRound((azimuths[i] - azStart) / azStep);
+        const int el = columns == 3 ? qRound((elevations[i] - elStart) / elStep) : 0;
+        grid[el * azCount + az] = static_cast<float>(values[i]);
+    }
+
+    if (std::any_of(grid.cbegin(), grid.cend(), [](float g) { return std::isnan(g); })) {
+        return fail("Grid has duplicate or missing samples");
+    }
+
+    AntennaPattern pattern = fromGrid(azStart, azStep, azCount, elStart, elStep, elCount, grid);
+    pattern.sourceFile_ = filePath;
+
+    qDebug() << "AntennaPattern: Loaded" << QFileInfo(filePath).fileName() << "-"
+             << azCount << "x" << elCount << "samples, peak" << pattern.peakGain_ << "dBi";
+    return pattern;
+}
+
+double AntennaPattern::gain(double azimuthDeg, double elevationDeg) const
+{
+    double result = 0.0;
+    gains(&azimuthDeg, &elevationDeg, &result, 1);
+    return result;
+}
+
+double AntennaPattern::offBoresightGain(double thetaDeg, double phiDeg) const
+{
+    if (isSymmetric()) {
+        return gain(thetaDeg, 0.0);
+    }
+
+    const double phi = qDegreesToRadians(phiDeg);
+    return gain(thetaDeg * std::cos(phi), thetaDeg * std::sin(phi));
+}
+
+void AntennaPattern::gains(const double* azimuthDeg, const double* elevationDeg, double* gainsDb, qsizetype count) const
+{
+    if (!isValid()) {
+        std::fill(gainsDb, gainsDb + count, 0.0);
+        return;
+    }
+
+    // Members to locals so the loops keep everything in registers
+    const float* grid = gains_.constData();
+    const int azCount = azimuthCount_;
+    const int elCount = elevationCount_;
+    const double azStart = azimuthStart_;
+    const double elStart = elevationStart_;
+    const double azInverseStep = 1.0 / azimuthStep_;
+    const double elInverseStep = 1.0 / elevationStep_;
+    const bool wraps = azimuthWraps_;
+
+    if (elCount == 1) {
+        // Symmetric cut: linear interpolation over the off-boresight angle
+        for (qsizetype i = 0; i < count; ++i) {
+            const double theta = std::hypot(azimuthDeg[i], elevationDeg ? elevationDeg[i] : 0.0);
+            const AxisPosition a = axisPosition(theta, azStart, azInverseStep, azCount, false);
+            gainsDb[i] = grid[a.i0] + (grid[a.i1] - grid[a.i0]) * a.t;
+        }
+        return;
+    }
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const AxisPosition a = axisPosition(azimuthDeg[i], azStart, azInverseStep, azCount, wraps);
+        const AxisPosition e = axisPosition(elevationDeg[i], elStart, elInverseStep, elCount, false);
+
+        const float* row0 = grid + e.i0 * azCount;
+        const float* row1 = grid + e.i1 * azCount;
+
+        const double g0 = row0[a.i0] + (row0[a.i1] - row0[a.i0]) * a.t;
+        const double g1 = row1[a.i0] + (row1[a.i1] - row1[a.i0]) * a.t;
+        gainsDb[i] = g0 + (g1 - g0) * e.t;
+    }
+}
+
+PointingLossStats AntennaPattern::pointingLoss(double sigmaDeg, double biasDeg, int samples, quint32 seed) const
+{
+    PointingLossStats stats;
+    if (!isValid() || samples <= 0) {
+        return stats;
+    }
+
+    QRandomGenerator random(seed);
+
+    std::array<double, BATCH_SIZE> az;
+    std::array<double, BATCH_SIZE> el;
+    std::array<double, BATCH_SIZE> g;
+
+    QVector<float> losses;
+    losses.reserve(samples);
+    double linearSum = 0.0;
+
+    for (int done = 0; done < samples; done += BATCH_SIZE) {
+        const int n = std::min(BATCH_SIZE, samples - done);
+
+        // Box-Muller: independent Gaussian errors in azimuth and elevation
+        for (int i = 0; i < n; ++i) {
+            const double u1 = 1.0 - random.generateDouble();    // (0, 1]
+            const double u2 = random.generateDouble();
+            const double r = sigmaDeg * std::sqrt(-2.0 * std::log(u1));
+            const double angle = 2.0 * M_PI * u2;
+            az[i] = biasDeg + r * std::cos(angle);
+            el[i] = r * std::sin(angle);
+        }
+
+        gains(az.data(), el.data(), g.data(), n);
+
+        for (int i = 0; i < n; ++i) {
+            const double loss = peakGain_ - g[i];
+            losses.append(static_cast<float>(loss));
+            linearSum += std::pow(10.0, g[i] / 10.0);
+        }
+    }
+
+    stats.samples = samples;
+    stats.meanLossDb = peakGain_ - 10.0 * std::log10(linearSum / samples);
+
+    const int p95Index = std::min(static_cast<int>(losses.size()) - 1, static_cast<int>(0.95 * losses.size()));
+    std::nth_element(losses.begin(), losses.begin() + p95Index, losses.end());
+    stats.p95LossDb = losses[p95Index];
+    stats.maxLossDb = *std::max_element(losses.cbegin(), losses.cend());
+
+    return stats;
+}
@@ -0,0 +1,96 @@
+// src/modules/linkbudget/AntennaPattern.h
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief Result of a Monte Carlo pointing-loss evaluation
+ */
+struct PointingLossStats {
+    double meanLossDb = 0.0;        ///< Loss of the mean linear gain relative to peak
+    double p95LossDb = 0.0;         ///< Loss exceeded by 5% of the samples
+    double maxLossDb = 0.0;         ///< Worst sample
+    int samples = 0;
+};
+
+/**
+ * @class AntennaPattern
+ * @brief Antenna gain over an azimuth/elevation grid with bilinear interpolation
+ *
+ * Gains are stored as one packed float array, elevation-major (all azimuths of the
+ * first elevation, then the next), on uniform axes. A lookup is therefore two index
+ * computations and four loads from two adjacent rows, with no search.
+ *
+ * Azimuth wraps around when the grid covers a full turn; elevation (and azimuth on
+ * partial grids) is clamped to the grid edges. A pattern with a single elevation row
+ * is a rotationally symmetric cut, indexed by off-boresight angle.
+ *
+ * Pattern files are plain text, one sample per line, separated by commas, semicolons,
+ * tabs or spaces ('#' starts a comment, a non-numeric first line is a header):
+ * - "azimuth elevation gain" (degrees, dBi) forming a complete uniform grid
+ * - "angle gain" for a symmetric cut (angle = off-boresight degrees)
+ */
+class AntennaPattern {
+public:
+    AntennaPattern() = default;
+
+    /**
+     * @brief Read a pattern file
+     * @param filePath Text pattern file (see class description)
+     * @param errorString Receives the reason on failure (optional)
+     * @return Pattern, invalid on failure
+     */
+    static AntennaPattern fromFile(const QString& filePath, QString* errorString = nullptr);
+
+    /**
+     * @brief Build a pattern from a grid
+     * @param gainsDb Elevation-major gains, azimuthCount * elevationCount values
+     */
+    static AntennaPattern fromGrid(double azimuthStart, double azimuthStep, int azimuthCount,
+                                   double elevationStart, double elevationStep, int elevationCount,
+                                   const QVector<float>& gainsDb);
+
+    bool isValid() const { return !gains_.isEmpty(); }
+    bool isSymmetric() const { return elevationCount_ == 1; }      ///< @brief Single cut indexed by off-boresight angle
+    QString sourceFile() const { return sourceFile_; }
+
+    int azimuthCount() const { return azimuthCount_; }
+    int elevationCount() const { return elevationCount_; }
+    double peakGain() const { return peakGain_; }                   ///< @brief Maximum gain on the grid (dBi)
+
+    double gain(double azimuthDeg, double elevationDeg) const;      ///< @brief Interpolated gain (dBi)
+    double offBoresightGain(double thetaDeg, double phiDeg = 0.0) const;    ///< @brief Gain at off-boresight angle theta in plane phi
+
+    /**
+     * @brief Interpolated gains for many directions in one pass
+     * @param azimuthDeg Azimuths, count values
+     * @param elevationDeg Elevations, count values (ignored for symmetric patterns)
+     * @param gainsDb Output, count values
+     */
+    void gains(const double* azimuthDeg, const double* elevationDeg, double* gainsDb, qsizetype count) const;
+
+    /**
+     * @brief Pointing loss for a Gaussian pointing error
+     * @param sigmaDeg Standard deviation of the error in azimuth and elevation (degrees)
+     * @param biasDeg Constant off-boresight offset, applied in azimuth (degrees)
+     * @param samples Monte Carlo samples
+     * @param seed Random seed (same seed, same result)
+     */
+    PointingLossStats pointingLoss(double sigmaDeg, double biasDeg = 0.0, int samples = 20000, quint32 seed = 1) const;
+
+    static constexpr int BATCH_SIZE = 1024;     ///< Samples generated and evaluated per batch
+
+private:
+    double azimuthStart_ = 0.0;
+    double azimuthStep_ = 1.0;
+    double elevationStart_ = 0.0;
+    double elevationStep_ = 1.0;
+    int azimuthCount_ = 0;
+    int elevationCount_ = 0;
+    bool azimuthWraps_ = false;     ///< Grid spans 360 degrees; the last column interpolates into the first
+    double peakGain_ = 0.0;
+    QVector<float> gains_;          ///< Elevation-major, azimuthCount_ * elevationCount_
+    QString sourceFile_;
+};
@@ -0,0 +1,331 @@
+// src/modules/linkbudget/InterferenceEngine.cpp
+
+#include "InterferenceEngine.h"
+#include "AntennaPattern.h"
+#include <QFile>
+#include <QTextStream>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double kSpeedOfLight = 299792458.0;   // m/s
+constexpr double kLn10Over10 = 2.302585092994046 / 10.0;
+
+inline double dbToLinear(double db)
+{
+    return std::exp(kLn10Over10 * db);
+}
+
+}
+
+QJsonObject Interferer::toJson() const
+{
+    QJsonObject json;
+    json["name"] = name;
+    json["eirp"] = eirpDbw;
+    json["frequencyOffsetMHz"] = frequencyOffsetMHz;
+    json["distanceKm"] = distanceKm;
+    json["offAxisDeg"] = offAxisDeg;
+    json["discrimination"] = discriminationDb;
+    return json;
+}
+
+Interferer Interferer::fromJson(const QJsonObject& json)
+{
+    Interferer interferer;
+    interferer.name = json.value("name").toString();
+    interferer.eirpDbw = json.value("eirp").toDouble(0.0);
+    interferer.frequencyOffsetMHz = json.value("frequencyOffsetMHz").toDouble(0.0);
+    interferer.distanceKm = json.value("distanceKm").toDouble(1.0);
+    interferer.offAxisDeg = json.value("offAxisDeg").toDouble(0.0);
+    interferer.discriminationDb = json.value("discrimination").toDouble(0.0);
+    return interferer;
+}
+
+void InterferenceEngine::setCarrier(double frequencyHz, double bandwidthHz, double rxGainDbi, const AntennaPattern* rxPattern,
+                                    double rxLineLossDb)
+{
+    const AntennaPattern* pattern = (rxPattern && rxPattern->isValid()) ? rxPattern : nullptr;
+    if (frequencyHz == frequencyHz_ && bandwidthHz == bandwidthHz_
+        && rxGainDbi == rxGainDbi_ && pattern == rxPattern_ && rxLineLossDb == rxLineLossDb_) {
+        return;
+    }
+
+    frequencyHz_ = frequencyHz;
+    bandwidthHz_ = bandwidthHz;
+    rxGainDbi_ = rxGainDbi;
+    rxPattern_ = pattern;
+    rxLineLossDb_ = rxLineLossDb;
+
+    recompute();
+}
+
+void InterferenceEngine::setInterferers(const QVector<Interferer>& interferers)
+{
+    const int n = interferers.size();
+
+    names_.resize(n);
+    eirpDbw_.resize(n);
+    offsetHz_.resize(n);
+    distanceM_.resize(n);
+    offAxisDeg_.resize(n);
+    discriminationDb_.resize(n);
+
+    for (int i = 0; i < n; ++i) {
+        const Interferer& interferer = interferers[i];
+        names_[i] = interferer.name;
+        eirpDbw_[i] = interferer.eirpDbw;
+        offsetHz_[i] = interferer.frequencyOffsetMHz * 1e6;
+        distanceM_[i] = std::max(interferer.distanceKm * 1000.0, 1.0);
+        offAxisDeg_[i] = interferer.offAxisDeg;
+        discriminationDb_[i] = interferer.discriminationDb;
+    }
+
+    recompute();
+}
+
+int InterferenceEngine::addInterferer(const Interferer& interferer)
+{
+    names_.append(interferer.name);
+    eirpDbw_.append(interferer.eirpDbw);
+    offsetHz_.append(interferer.frequencyOffsetMHz * 1e6);
+    distanceM_.append(std::max(interferer.distanceKm * 1000.0, 1.0));
+    offAxisDeg_.append(interferer.offAxisDeg);
+    discriminationDb_.append(interferer.discriminationDb);
+    contributions_.append(0.0);
+
+    const int index = names_.size() - 1;
+    computeContributions(index, 1);
+    applyDelta(contributions_[index]);
+    return index;
+}
+
+void InterferenceEngine::updateInterferer(int index, const Interferer& interferer)
+{
+    if (index < 0 || index >= count()) {
+        return;
+    }
+
+    const double before = contributions_[index];
+
+    names_[index] = interferer.name;
+    eirpDbw_[index] = interferer.eirpDbw;
+    offsetHz_[index] = interferer.frequencyOffsetMHz * 1e6;
+    distanceM_[index] = std::max(interferer.distanceKm * 1000.0, 1.0);
+    offAxisDeg_[index] = interferer.offAxisDeg;
+    discriminationDb_[index] = interferer.discriminationDb;
+
+    computeContributions(index, 1);
+    applyDelta(contributions_[index] - before);
+}
+
+void InterferenceEngine::removeInterferer(int index)
+{
+    if (index < 0 || index >= count()) {
+        return;
+    }
+
+    const double before = contributions_[index];
+
+    names_.removeAt(index);
+    eirpDbw_.removeAt(index);
+    offsetHz_.removeAt(index);
+    distanceM_.removeAt(index);
+    offAxisDeg_.removeAt(index);
+    discriminationDb_.removeAt(index);
+    contributions_.removeAt(index);
+
+    applyDelta(-before);
+}
+
+void InterferenceEngine::clear()
+{
+    setInterferers({});
+}
+
+void InterferenceEngine::recompute()
+{
+    contributions_.resize(names_.size());
+    computeContributions(0, names_.size());
+
+    // Compensated (Neumaier) sum, so thousands of small terms next to one dominant
+    // interferer are not lost
+    double sum = 0.0;
+    double compensation = 0.0;
+    for (double c : std::as_const(contributions_)) {
+        const double t = sum + c;
+        compensation += (std::abs(sum) >= std::abs(c)) ? (sum - t) + c : (c - t) + sum;
+        sum = t;
+    }
+
+    total_ = sum + compensation;
+    updatesSinceResum_ = 0;
+}
+
+void InterferenceEngine::computeContributions(int first, int n)
+{
+    if (n <= 0) {
+        return;
+    }
+
+    double* out = contributions_.data() + first;
+
+    if (frequencyHz_ <= 0.0 || bandwidthHz_ <= 0.0) {
+        std::fill(out, out + n, 0.0);
+        return;
+    }
+
+    const double* eirp = eirpDbw_.constData() + first;
+    const double* offset = offsetHz_.constData() + first;
+    const double* distance = distanceM_.constData() + first;
+    const double* discrimination = discriminationDb_.constData() + first;
+
+    // Receive gain toward each interferer: one batched pattern pass, or the scalar gain
+    QVector<double> rxGain(n, rxGainDbi_);
+    if (rxPattern_) {
+        if (rxPattern_->isSymmetric()) {
+            rxPattern_->gains(offAxisDeg_.constData() + first, nullptr, rxGain.data(), n);
+        } else {
+            // Off-axis angle is taken in the azimuth plane
+            const QVector<double> zeros(n, 0.0);
+            rxPattern_->gains(offAxisDeg_.constData() + first, zeros.constData(), rxGain.data(), n);
+        }
+    }
+    const double* gain = rxGain.constData();
+
+    const double lambdaOver4Pi = kSpeedOfLight / (4.0 * M_PI * frequencyHz_);
+    const double inverseBandwidth = 1.0 / bandwidthHz_;
+
+    // Branch-free kernel over contiguous arrays
+    for (int i = 0; i < n; ++i) {
+        const double spreading = lambdaOver4Pi / distance[i];
+        const double overlap = std::max(0.0, 1.0 - std::abs(offset[i]) * inverseBandwidth);
+        out[i] = dbToLinear(eirp[i] + gain[i] - discrimination[i] - rxLineLossDb_) * spreading * spreading * overlap;
+    }
+}
+
+void InterferenceEngine::applyDelta(double delta)
+{
+    if (names_.isEmpty()) {
+        total_ = 0.0;
+        updatesSinceResum_ = 0;
+        return;
+    }
+
+    total_ += delta;
+
+    // Drift guard: periodic exact resum, and never report negative power
+    if (++updatesSinceResum_ >= RESUM_INTERVAL || total_ < 0.0) {
+        recompute();
+    }
+}
+
+Interferer InterferenceEngine::interferer(int index) const
+{
+    Interferer interferer;
+    if (index < 0 || index >= count()) {
+        return interferer;
+    }
+
+    interferer.name = names_[index];
+    interferer.eirpDbw = eirpDbw_[index];
+    interferer.frequencyOffsetMHz = offsetHz_[index] / 1e6;
+    interferer.distanceKm = distanceM_[index] / 1000.0;
+    interferer.offAxisDeg = offAxisDeg_[index];
+    interferer.discriminationDb = discriminationDb_[index];
+    return interferer;
+}
+
+QVector<Interferer> InterferenceEngine::interferers() const
+{
+    QVector<Interferer> result;
+    result.reserve(count());
+    for (int i = 0; i < count(); ++i) {
+        result.append(interferer(i));
+    }
+    return result;
+}
+
+double InterferenceEngine::totalInterferenceDbw() const
+{
+    return total_ > 0.0 ? 10.0 * std::log10(total_) : -std::numeric_limits<double>::infinity();
+}
+
+double InterferenceEngine::carrierToInterference(double carrierDbw) const
+{
+    return total_ > 0.0 ? carrierDbw - totalInterferenceDbw() : std::numeric_limits<double>::infinity();
+}
+
+double InterferenceEngine::carrierToNoisePlusInterference(double carrierDbw, double noiseDbw) const
+{
+    return carrierDbw - 10.0 * std::log10(dbToLinear(noiseDbw) + total_);
+}
+
+QVector<Interferer> InterferenceEngine::fromCsv(const QString& filePath, QString* errorString)
+{
+    QVector<Interferer> result;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (errorString) {
+            *errorString = "Could not open file: " + file.errorString();
+        }
+        return result;
+    }
+
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        ++lineNumber;
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const QStringList fields = line.split(',');
+        if (fields.size() < 4) {
+            if (errorString) {
+                *errorString = QString("Line %1: expected name,eirp,offset,distance[,offAxis[,discrimination]]").arg(lineNumber);
+            }
+            return {};
+        }
+
+        bool ok = true;
+        auto number = [&fields, &ok](int column, double fallback) {
+            if (column >= fields.size() || fields[column].trimmed().isEmpty()) {
+                return fallback;
+            }
+            bool valueOk = false;
+            const double value = fields[column].trimmed().toDouble(&valueOk);
+            ok = ok && valueOk;
+            return value;
+        };
+
+        Interferer interferer;
+        interferer.name = fields[0].trimmed();
+        interferer.eirpDbw = number(1, 0.0);
+        interferer.frequencyOffsetMHz = number(2, 0.0);
+        interferer.distanceKm = number(3, 1.0);
+        interferer.offAxisDeg = number(4, 0.0);
+        interferer.discriminationDb = number(5, 0.0);
+
+        if (!ok) {
+            // A header line is allowed before the first row
+            if (result.isEmpty()) {
+                continue;
+            }
+            if (errorString) {
+                *errorString = QString("Line %1: invalid number").arg(lineNumber);
+            }
+            return {};
+        }
+
+        result.append(interferer);
+    }
+
+    return result;
+}
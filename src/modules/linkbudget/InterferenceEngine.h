@@ -0,0 +1,100 @@
+// src/modules/linkbudget/InterferenceEngine.h
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+
+class AntennaPattern;
+
+/**
+ * @brief One potential interferer as seen from the victim receiver
+ */
+struct Interferer {
+    QString name;
+    double eirpDbw = 0.0;               ///< EIRP toward the victim receiver
+    double frequencyOffsetMHz = 0.0;    ///< Interferer center minus carrier center
+    double distanceKm = 1.0;            ///< Path length to the victim receiver
+    double offAxisDeg = 0.0;            ///< Angle off the receive boresight (used with a receive pattern)
+    double discriminationDb = 0.0;      ///< Additional isolation (polarization, shielding, ...)
+
+    QJsonObject toJson() const;
+    static Interferer fromJson(const QJsonObject& json);
+};
+
+/**
+ * @class InterferenceEngine
+ * @brief Aggregates interference power from many interferers in the linear domain
+ *
+ * Interferer parameters are kept as separate arrays (structure of arrays), so a full
+ * evaluation is a few branch-free passes the compiler can vectorize. The aggregate is
+ * a running sum: changing, adding or removing one interferer adjusts it by that
+ * interferer's old and new contribution instead of resumming everything. A full
+ * resum happens only when the carrier changes, and every RESUM_INTERVAL incremental
+ * updates, to keep rounding drift bounded.
+ *
+ * Contribution of interferer i (watts):
+ *   EIRP_i * G_rx(offAxis_i) / D_i / L_rx * (lambda / 4 pi d_i)^2 * overlap_i
+ * where overlap_i = max(0, 1 - |offset_i| / B) for equal-width rectangular spectra.
+ * L_rx is the receive line loss: contributions are referenced at the receiver input,
+ * like the carrier power they are compared with.
+ */
+class InterferenceEngine {
+public:
+    InterferenceEngine() = default;
+
+    /**
+     * @brief Victim carrier (triggers a full recompute if anything changed)
+     * @param frequencyHz Carrier center frequency
+     * @param bandwidthHz Receiver and interferer bandwidth
+     * @param rxGainDbi Scalar receive gain, used when no pattern is set
+     * @param rxPattern Receive pattern (nullptr = scalar gain); must outlive its use here
+     * @param rxLineLossDb Loss between antenna and receiver, applied to every contribution
+     */
+    void setCarrier(double frequencyHz, double bandwidthHz, double rxGainDbi, const AntennaPattern* rxPattern,
+                    double rxLineLossDb);
+
+    void setInterferers(const QVector<Interferer>& interferers);   ///< @brief Replace all (one full pass)
+    int addInterferer(const Interferer& interferer);               ///< @brief Append; returns its index
+    void updateInterferer(int index, const Interferer& interferer);///< @brief Change one (incremental)
+    void removeInterferer(int index);                              ///< @brief Remove one (incremental)
+    void clear();
+    void recompute();                                               ///< @brief Full pass (e.g. after the receive pattern was replaced)
+
+    int count() const { return names_.size(); }
+    Interferer interferer(int index) const;
+    QVector<Interferer> interferers() const;
+    double contributionWatts(int index) const { return contributions_.value(index); }
+
+    double totalInterferenceWatts() const { return total_; }
+    double totalInterferenceDbw() const;                            ///< @brief -inf without interference
+
+    double carrierToInterference(double carrierDbw) const;          ///< @brief C/I in dB (+inf without interference)
+    double carrierToNoisePlusInterference(double carrierDbw, double noiseDbw) const;   ///< @brief C/(N+I) in dB
+
+    static QVector<Interferer> fromCsv(const QString& filePath, QString* errorString = nullptr);  ///< @brief name,eirp,offset,distance[,offAxis[,discrimination]]
+
+    static constexpr int RESUM_INTERVAL = 4096;     ///< Incremental updates between full resums
+
+private:
+    void computeContributions(int first, int count);
+    void applyDelta(double delta);
+
+    // Structure of arrays, index-aligned
+    QVector<QString> names_;
+    QVector<double> eirpDbw_;
+    QVector<double> offsetHz_;
+    QVector<double> distanceM_;
+    QVector<double> offAxisDeg_;
+    QVector<double> discriminationDb_;
+    QVector<double> contributions_;     ///< Watts at the receiver input
+
+    double frequencyHz_ = 0.0;
+    double bandwidthHz_ = 0.0;
+    double rxGainDbi_ = 0.0;
+    double rxLineLossDb_ = 0.0;
+    const AntennaPattern* rxPattern_ = nullptr;
+
+    double total_ = 0.0;
+    int updatesSinceResum_ = 0;
+};
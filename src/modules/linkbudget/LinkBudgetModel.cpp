@@ -2,6 +2,7 @@
 
 #include "LinkBudgetModel.h"
 #include <QJsonObject>
+#include <QJsonArray>
 #include <QDebug>
 
 LinkBudgetModel::LinkBudgetModel(QObject* parent)
@@ -10,6 +11,7 @@ LinkBudgetModel::LinkBudgetModel(QObject* parent)
     , txLineLoss_(0.5)
     , txAntennaGain_(20.0)
     , txPolarization_("Linear")
+    , txPointingError_(0.0)
     , frequency_(2.4)
     , frequencyUnit_("GHz")
     , distance_(100.0)
@@ -19,6 +21,7 @@ LinkBudgetModel::LinkBudgetModel(QObject* parent)
     , polarizationLoss_(0.0)
     , miscLoss_(0.0)
     , rxAntennaGain_(15.0)
+    , rxPointingError_(0.0)
     , rxLineLoss_(0.5)
     , systemNoiseTemp_(290.0)
     , noiseFigure_(3.0)
@@ -26,6 +29,7 @@ LinkBudgetModel::LinkBudgetModel(QObject* parent)
     , bandwidthUnit_("MHz")
     , requiredSNR_(10.0)
     , implementationLoss_(1.0)
+    , rollOff_(0.35)
     , name_("Untitled Link Budget")
     , description_("")
 {
@@ -50,6 +54,8 @@ QJsonObject LinkBudgetModel::toJson() const
     tx["lineLoss"] = txLineLoss_;
     tx["antennaGain"] = txAntennaGain_;
     tx["polarization"] = txPolarization_;
+    tx["antennaPatternFile"] = txAntennaPatternFile_;
+    tx["pointingError"] = txPointingError_;
     json["transmitter"] = tx;
 
     // Path
@@ -67,6 +73,8 @@ QJsonObject LinkBudgetModel::toJson() const
     // Receiver
     QJsonObject rx;
     rx["antennaGain"] = rxAntennaGain_;
+    rx["antennaPatternFile"] = rxAntennaPatternFile_;
+    rx["pointingError"] = rxPointingError_;
     rx["lineLoss"] = rxLineLoss_;
     rx["systemNoiseTemp"] = systemNoiseTemp_;
     rx["noiseFigure"] = noiseFigure_;
@@ -74,8 +82,17 @@ QJsonObject LinkBudgetModel::toJson() const
     rx["bandwidthUnit"] = bandwidthUnit_;
     rx["requiredSNR"] = requiredSNR_;
     rx["implementationLoss"] = implementationLoss_;
+    rx["modCodTable"] = modCodTable_;
+    rx["rollOff"] = rollOff_;
     json["receiver"] = rx;
 
+    // Interference
+    QJsonArray interference;
+    for (const Interferer& interferer : interferers_) {
+        interference.append(interferer.toJson());
+    }
+    json["interference"] = interference;
+
     return json;
 }
 
@@ -91,6 +108,8 @@ void LinkBudgetModel::fromJson(const QJsonObject& json)
     txLineLoss_ = tx.value("lineLoss").toDouble(0.5);
     txAntennaGain_ = tx.value("antennaGain").toDouble(20.0);
     txPolarization_ = tx.value("polarization").toString("Linear");
+    txAntennaPatternFile_ = tx.value("antennaPatternFile").toString();
+    txPointingError_ = tx.value("pointingError").toDouble(0.0);
 
     // Path
     QJsonObject path = json.value("path").toObject();
@@ -106,6 +125,8 @@ void LinkBudgetModel::fromJson(const QJsonObject& json)
     // Receiver
     QJsonObject rx = json.value("receiver").toObject();
     rxAntennaGain_ = rx.value("antennaGain").toDouble(15.0);
+    rxAntennaPatternFile_ = rx.value("antennaPatternFile").toString();
+    rxPointingError_ = rx.value("pointingError").toDouble(0.0);
     rxLineLoss_ = rx.value("lineLoss").toDouble(0.5);
     systemNoiseTemp_ = rx.value("systemNoiseTemp").toDouble(290.0);
     noiseFigure_ = rx.value("noiseFigure").toDouble(3.0);
@@ -113,6 +134,16 @@ void LinkBudgetModel::fromJson(const QJsonObject& json)
     bandwidthUnit_ = rx.value("bandwidthUnit").toString("MHz");
     requiredSNR_ = rx.value("requiredSNR").toDouble(10.0);
     implementationLoss_ = rx.value("implementationLoss").toDouble(1.0);
+    modCodTable_ = rx.value("modCodTable").toString();
+    rollOff_ = rx.value("rollOff").toDouble(0.35);
+
+    // Interference
+    interferers_.clear();
+    const QJsonArray interference = json.value("interference").toArray();
+    interferers_.reserve(interference.size());
+    for (const QJsonValue& value : interference) {
+        interferers_.append(Interferer::fromJson(value.toObject()));
+    }
 
     emit modelChanged();
 
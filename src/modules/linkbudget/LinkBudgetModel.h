@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QString>
 #include <QJsonObject>
+#include <QVector>
+#include "InterferenceEngine.h"
 
 /**
  * @class LinkBudgetModel
@@ -37,6 +39,12 @@ public:
     void setTxPolarization(const QString& pol) { txPolarization_ = pol; emit modelChanged(); }
     QString txPolarization() const { return txPolarization_; }
 
+    void setTxAntennaPatternFile(const QString& path) { txAntennaPatternFile_ = path; emit modelChanged(); }
+    QString txAntennaPatternFile() const { return txAntennaPatternFile_; }     ///< Empty = scalar txAntennaGain()
+
+    void setTxPointingError(double sigmaDeg) { txPointingError_ = sigmaDeg; emit modelChanged(); }
+    double txPointingError() const { return txPointingError_; }               ///< 1-sigma pointing error (degrees)
+
     // Path parameters
     void setFrequency(double freq) { frequency_ = freq; emit modelChanged(); }
     double frequency() const { return frequency_; }
@@ -66,6 +74,12 @@ public:
     void setRxAntennaGain(double gain) { rxAntennaGain_ = gain; emit modelChanged(); }
     double rxAntennaGain() const { return rxAntennaGain_; }
 
+    void setRxAntennaPatternFile(const QString& path) { rxAntennaPatternFile_ = path; emit modelChanged(); }
+    QString rxAntennaPatternFile() const { return rxAntennaPatternFile_; }     ///< Empty = scalar rxAntennaGain()
+
+    void setRxPointingError(double sigmaDeg) { rxPointingError_ = sigmaDeg; emit modelChanged(); }
+    double rxPointingError() const { return rxPointingError_; }               ///< 1-sigma pointing error (degrees)
+
     void setRxLineLoss(double loss) { rxLineLoss_ = loss; emit modelChanged(); }
     double rxLineLoss() const { return rxLineLoss_; }
 
@@ -87,6 +101,16 @@ public:
     void setImplementationLoss(double loss) { implementationLoss_ = loss; emit modelChanged(); }
     double implementationLoss() const { return implementationLoss_; }
 
+    void setModCodTable(const QString& table) { modCodTable_ = table; emit modelChanged(); }
+    QString modCodTable() const { return modCodTable_; }     ///< Built-in table name or CSV path; empty = required SNR only
+
+    void setRollOff(double rollOff) { rollOff_ = rollOff; emit modelChanged(); }
+    double rollOff() const { return rollOff_; }               ///< Pulse-shaping roll-off (symbol rate = B / (1 + rolloff))
+
+    // Interference
+    void setInterferers(const QVector<Interferer>& interferers) { interferers_ = interferers; emit modelChanged(); }
+    QVector<Interferer> interferers() const { return interferers_; }
+
     // Metadata
     void setName(const QString& name) { name_ = name; emit modelChanged(); }
     QString name() const { return name_; }
@@ -103,6 +127,8 @@ private:
     double txLineLoss_;
     double txAntennaGain_;
     QString txPolarization_;
+    QString txAntennaPatternFile_;
+    double txPointingError_;
 
     // Path
     double frequency_;
@@ -116,6 +142,8 @@ private:
 
     // Receiver
     double rxAntennaGain_;
+    QString rxAntennaPatternFile_;
+    double rxPointingError_;
     double rxLineLoss_;
     double systemNoiseTemp_;
     double noiseFigure_;
@@ -123,6 +151,11 @@ private:
     QString bandwidthUnit_;
     double requiredSNR_;
     double implementationLoss_;
+    QString modCodTable_;
+    double rollOff_;
+
+    // Interference
+    QVector<Interferer> interferers_;
 
     // Metadata
     QString name_;
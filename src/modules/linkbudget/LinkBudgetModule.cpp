@@ -20,14 +20,73 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QFile>
+#include <QFileInfo>
 #include <QPainter>
 #include <QPixmap>
+#include <QSignalBlocker>
+#include <QTextStream>
 #include <QtMath>
 #include <QDebug>
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+/**
+ * @brief Read a "time_s,value" CSV series ('#' comments, optional header line)
+ */
+bool readTimeSeries(const QString& filePath, QVector<double>& times, QVector<double>& values, QString& error)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = "Could not open file: " + file.errorString();
+        return false;
+    }
+
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        ++lineNumber;
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const QStringList fields = line.split(',');
+        bool timeOk = false;
+        bool valueOk = false;
+        const double time = fields.value(0).trimmed().toDouble(&timeOk);
+        const double value = fields.value(1).trimmed().toDouble(&valueOk);
+
+        if (!timeOk || !valueOk) {
+            if (times.isEmpty()) {
+                continue;   // Header
+            }
+            error = QString("Line %1: expected time_s,value").arg(lineNumber);
+            return false;
+        }
+        if (!times.isEmpty() && time <= times.last()) {
+            error = QString("Line %1: times must increase").arg(lineNumber);
+            return false;
+        }
+
+        times.append(time);
+        values.append(value);
+    }
+
+    if (times.size() < 2) {
+        error = "Series needs at least two samples";
+        return false;
+    }
+    return true;
+}
+
+}
 
 LinkBudgetModule::LinkBudgetModule(QWidget* parent)
     : QWidget(parent)
     , model_(nullptr)
+    , updatingInterferenceTable_(false)
     , hasUnsavedChanges_(false)
 {
     model_ = new LinkBudgetModel(this);
@@ -119,6 +178,7 @@ bool LinkBudgetModule::save()
     }
 
     // Save logic would go here
+    model_->setInterferers(interferenceEngine_.interferers());
     QJsonObject json = model_->toJson();
     QJsonDocument doc(json);
 
@@ -164,11 +224,13 @@ void LinkBudgetModule::setupUI()
     createTransmitterSection();
     createPathSection();
     createReceiverSection();
+    createInterferenceSection();
     createResultsSection();
 
     scrollLayout->addWidget(transmitterGroup_);
     scrollLayout->addWidget(pathGroup_);
     scrollLayout->addWidget(receiverGroup_);
+    scrollLayout->addWidget(interferenceGroup_);
     scrollLayout->addWidget(resultsGroup_);
     scrollLayout->addStretch();
 
@@ -212,6 +274,19 @@ void LinkBudgetModule::createTransmitterSection()
     txAntennaGainSpin_->setToolTip("Transmit antenna gain");
     layout->addRow("Tx Antenna Gain:", txAntennaGainSpin_);
 
+    // TX Antenna Pattern
+    layout->addRow("Tx Antenna Pattern:", createPatternRow(true));
+
+    // TX Pointing Error
+    txPointingErrorSpin_ = new QDoubleSpinBox(this);
+    txPointingErrorSpin_->setRange(0.0, 30.0);
+    txPointingErrorSpin_->setValue(0.0);
+    txPointingErrorSpin_->setSuffix(" deg (1σ)");
+    txPointingErrorSpin_->setDecimals(3);
+    txPointingErrorSpin_->setSingleStep(0.05);
+    txPointingErrorSpin_->setToolTip("Transmit pointing error per axis; used with an antenna pattern");
+    layout->addRow("Tx Pointing Error:", txPointingErrorSpin_);
+
     // Polarization
     txPolarizationCombo_ = new QComboBox(this);
     txPolarizationCombo_->addItems({"Linear", "Circular (RHCP)", "Circular (LHCP)"});
@@ -307,6 +382,19 @@ void LinkBudgetModule::createReceiverSection()
     rxAntennaGainSpin_->setToolTip("Receive antenna gain");
     layout->addRow("Rx Antenna Gain:", rxAntennaGainSpin_);
 
+    // RX Antenna Pattern
+    layout->addRow("Rx Antenna Pattern:", createPatternRow(false));
+
+    // RX Pointing Error
+    rxPointingErrorSpin_ = new QDoubleSpinBox(this);
+    rxPointingErrorSpin_->setRange(0.0, 30.0);
+    rxPointingErrorSpin_->setValue(0.0);
+    rxPointingErrorSpin_->setSuffix(" deg (1σ)");
+    rxPointingErrorSpin_->setDecimals(3);
+    rxPointingErrorSpin_->setSingleStep(0.05);
+    rxPointingErrorSpin_->setToolTip("Receive pointing error per axis; used with an antenna pattern");
+    layout->addRow("Rx Pointing Error:", rxPointingErrorSpin_);
+
     // RX Line Loss
     rxLineLossSpin_ = new QDoubleSpinBox(this);
     rxLineLossSpin_->setRange(0.0, 50.0);
@@ -367,6 +455,441 @@ void LinkBudgetModule::createReceiverSection()
     implementationLossSpin_->setDecimals(2);
     implementationLossSpin_->setToolTip("Implementation losses (ADC, filters, etc.)");
     layout->addRow("Implementation Loss:", implementationLossSpin_);
+
+    // ModCod Table
+    layout->addRow("ModCod Table:", createModCodRow());
+
+    // Roll-off
+    rollOffSpin_ = new QDoubleSpinBox(this);
+    rollOffSpin_->setRange(0.0, 1.0);
+    rollOffSpin_->setValue(0.35);
+    rollOffSpin_->setDecimals(2);
+    rollOffSpin_->setSingleStep(0.05);
+    rollOffSpin_->setToolTip("Pulse-shaping roll-off; symbol rate = bandwidth / (1 + roll-off)");
+    layout->addRow("Roll-off:", rollOffSpin_);
+}
+
+QHBoxLayout* LinkBudgetModule::createModCodRow()
+{
+    auto* rowLayout = new QHBoxLayout();
+
+    modCodCombo_ = new QComboBox(this);
+    modCodCombo_->addItem("None (required SNR)", QString());
+    for (const QString& name : ModCodTable::builtInNames()) {
+        modCodCombo_->addItem(name + " (built-in)", name);
+    }
+    modCodCombo_->setToolTip("Pick the best modulation/coding for the computed C/(N+I) and report throughput");
+    connect(modCodCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &LinkBudgetModule::onModCodTableChanged);
+
+    auto* importButton = new QPushButton("Import...", this);
+    importButton->setToolTip("Import a ModCod table from CSV: name,esNoThresholdDb,spectralEfficiency");
+    connect(importButton, &QPushButton::clicked, this, &LinkBudgetModule::importModCodTable);
+
+    dataVolumeButton_ = new QPushButton("Data Volume...", this);
+    dataVolumeButton_->setToolTip("Map a C/(N+I) time series (CSV: time_s,cn_db) to data rate and total volume");
+    dataVolumeButton_->setEnabled(false);
+    connect(dataVolumeButton_, &QPushButton::clicked, this, &LinkBudgetModule::calculateDataVolume);
+
+    rowLayout->addWidget(modCodCombo_, 1);
+    rowLayout->addWidget(importButton);
+    rowLayout->addWidget(dataVolumeButton_);
+    return rowLayout;
+}
+
+void LinkBudgetModule::onModCodTableChanged(int index)
+{
+    QString error;
+    if (!applyModCodTable(modCodCombo_->itemData(index).toString(), &error)) {
+        QMessageBox::warning(this, "ModCod Table", "Could not load ModCod table:\n" + error);
+        applyModCodTable(QString(), nullptr);
+    }
+
+    onParameterChanged();
+}
+
+void LinkBudgetModule::importModCodTable()
+{
+    QString filePath = QFileDialog::getOpenFileName(
+        this,
+        "Import ModCod Table",
+        QString(),
+        "CSV Files (*.csv);;All Files (*)"
+        );
+
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QString error;
+    if (!applyModCodTable(filePath, &error)) {
+        QMessageBox::warning(this, "Import Failed", "Could not import ModCod table:\n" + error);
+        return;
+    }
+
+    onParameterChanged();
+}
+
+bool LinkBudgetModule::applyModCodTable(const QString& table, QString* errorString)
+{
+    ModCodTable loaded;
+    if (ModCodTable::builtInNames().contains(table)) {
+        loaded = ModCodTable::builtIn(table);
+    } else if (!table.isEmpty()) {
+        loaded = ModCodTable::fromCsv(table, errorString);
+        if (!loaded.isValid()) {
+            return false;
+        }
+    }
+
+    modCodTable_ = std::move(loaded);
+    model_->setModCodTable(table);
+
+    // Select (or add) the matching combo entry without re-entering onModCodTableChanged()
+    int index = modCodCombo_->findData(table);
+    if (index < 0) {
+        modCodCombo_->addItem(QFileInfo(table).fileName(), table);
+        index = modCodCombo_->count() - 1;
+    }
+    {
+        const QSignalBlocker blocker(modCodCombo_);
+        modCodCombo_->setCurrentIndex(index);
+    }
+
+    dataVolumeButton_->setEnabled(modCodTable_.isValid());
+    return true;
+}
+
+void LinkBudgetModule::calculateDataVolume()
+{
+    if (!modCodTable_.isValid()) {
+        return;
+    }
+
+    QString filePath = QFileDialog::getOpenFileName(
+        this,
+        "C/(N+I) Time Series",
+        QString(),
+        "CSV Files (*.csv);;All Files (*)"
+        );
+
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QVector<double> times;
+    QVector<double> esNo;
+    QString error;
+    if (!readTimeSeries(filePath, times, esNo, error)) {
+        QMessageBox::warning(this, "Data Volume", "Could not read time series:\n" + error);
+        return;
+    }
+
+    // Each sample holds until the next one; the last repeats the previous interval
+    const qsizetype count = times.size();
+    QVector<double> durations(count);
+    for (qsizetype i = 0; i + 1 < count; ++i) {
+        durations[i] = times[i + 1] - times[i];
+    }
+    durations[count - 1] = durations[count - 2];
+
+    for (double& value : esNo) {
+        value = esNoFromCarrierToNoise(value);
+    }
+
+    const ModCodThroughput result = modCodTable_.evaluate(esNo.constData(), durations.constData(), count, symbolRate());
+
+    QMessageBox::information(this, "Data Volume",
+                             QString("%1 samples over %2 s (%3)\n\n"
+                                     "Total data volume: %4 Mbit (%5 MB)\n"
+                                     "Mean data rate: %6 Mbps\n"
+                                     "Peak data rate: %7 Mbps\n"
+                                     "Availability: %8 %")
+                                 .arg(count)
+                                 .arg(result.durationSecs, 0, 'f', 1)
+                                 .arg(modCodTable_.name())
+                                 .arg(result.totalBits / 1e6, 0, 'f', 3)
+                                 .arg(result.totalBits / 8e6, 0, 'f', 3)
+                                 .arg(result.meanRateBps() / 1e6, 0, 'f', 3)
+                                 .arg(result.peakRateBps / 1e6, 0, 'f', 3)
+                                 .arg(result.availability() * 100.0, 0, 'f', 2));
+}
+
+QHBoxLayout* LinkBudgetModule::createPatternRow(bool transmit)
+{
+    auto* rowLayout = new QHBoxLayout();
+
+    auto* patternLabel = new QLabel("None (scalar gain)", this);
+    patternLabel->setToolTip("Gain versus azimuth/elevation; pointing loss is evaluated against its peak");
+
+    auto* loadButton = new QPushButton("Load...", this);
+    loadButton->setToolTip("Load an antenna pattern file (angle gain, or azimuth elevation gain)");
+    connect(loadButton, &QPushButton::clicked, this, [this, transmit]() { loadAntennaPattern(transmit); });
+
+    auto* clearButton = new QPushButton("Clear", this);
+    clearButton->setToolTip("Use the scalar antenna gain again");
+    clearButton->setEnabled(false);
+    connect(clearButton, &QPushButton::clicked, this, [this, transmit]() { clearAntennaPattern(transmit); });
+
+    rowLayout->addWidget(patternLabel, 1);
+    rowLayout->addWidget(loadButton);
+    rowLayout->addWidget(clearButton);
+
+    if (transmit) {
+        txPatternLabel_ = patternLabel;
+        txPatternClearButton_ = clearButton;
+    } else {
+        rxPatternLabel_ = patternLabel;
+        rxPatternClearButton_ = clearButton;
+    }
+
+    return rowLayout;
+}
+
+void LinkBudgetModule::loadAntennaPattern(bool transmit)
+{
+    QString filePath = QFileDialog::getOpenFileName(
+        this,
+        transmit ? "Load Tx Antenna Pattern" : "Load Rx Antenna Pattern",
+        QString(),
+        "Antenna Patterns (*.csv *.txt *.pat);;All Files (*)"
+        );
+
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QString error;
+    if (!applyAntennaPattern(transmit, filePath, &error)) {
+        QMessageBox::warning(this, "Load Failed", "Could not load antenna pattern:\n" + error);
+        return;
+    }
+
+    onParameterChanged();
+}
+
+bool LinkBudgetModule::applyAntennaPattern(bool transmit, const QString& filePath, QString* errorString)
+{
+    AntennaPattern pattern = AntennaPattern::fromFile(filePath, errorString);
+    if (!pattern.isValid()) {
+        return false;
+    }
+
+    if (transmit) {
+        txPattern_ = std::move(pattern);
+        txPointingCache_.valid = false;
+        model_->setTxAntennaPatternFile(filePath);
+    } else {
+        rxPattern_ = std::move(pattern);
+        rxPointingCache_.valid = false;
+        model_->setRxAntennaPatternFile(filePath);
+        interferenceEngine_.recompute();    // Same object, new gains toward every interferer
+    }
+
+    updatePatternControls(transmit);
+    return true;
+}
+
+void LinkBudgetModule::clearAntennaPattern(bool transmit)
+{
+    if (transmit) {
+        txPattern_ = AntennaPattern();
+        txPointingCache_.valid = false;
+        model_->setTxAntennaPatternFile(QString());
+    } else {
+        rxPattern_ = AntennaPattern();
+        rxPointingCache_.valid = false;
+        model_->setRxAntennaPatternFile(QString());
+    }
+
+    updatePatternControls(transmit);
+    onParameterChanged();
+}
+
+void LinkBudgetModule::updatePatternControls(bool transmit)
+{
+    const AntennaPattern& pattern = transmit ? txPattern_ : rxPattern_;
+    QLabel* label = transmit ? txPatternLabel_ : rxPatternLabel_;
+    QPushButton* clearButton = transmit ? txPatternClearButton_ : rxPatternClearButton_;
+    QDoubleSpinBox* gainSpin = transmit ? txAntennaGainSpin_ : rxAntennaGainSpin_;
+
+    clearButton->setEnabled(pattern.isValid());
+
+    // With a pattern, the boresight gain is the pattern peak
+    gainSpin->setEnabled(!pattern.isValid());
+    if (!pattern.isValid()) {
+        label->setText("None (scalar gain)");
+        return;
+    }
+
+    const QString shape = pattern.isSymmetric()
+                              ? QString("%1-point cut").arg(pattern.azimuthCount())
+                              : QString("%1 x %2 grid").arg(pattern.azimuthCount()).arg(pattern.elevationCount());
+    label->setText(QString("%1 (%2, peak %3 dBi)")
+                       .arg(QFileInfo(pattern.sourceFile()).fileName(), shape)
+                       .arg(pattern.peakGain(), 0, 'f', 2));
+    gainSpin->setValue(pattern.peakGain());
+}
+
+void LinkBudgetModule::createInterferenceSection()
+{
+    interferenceGroup_ = new QGroupBox("Interference", this);
+    auto* layout = new QVBoxLayout(interferenceGroup_);
+
+    interferenceTable_ = new QTableWidget(0, 6, this);
+    interferenceTable_->setHorizontalHeaderLabels({"Name", "EIRP (dBW)", "Offset (MHz)",
+                                                   "Distance (km)", "Off-Axis (deg)", "Discrim. (dB)"});
+    interferenceTable_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    interferenceTable_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    interferenceTable_->setMaximumHeight(220);
+    interferenceTable_->setToolTip("Interferers as seen from this receiver; off-axis angles use the Rx antenna pattern");
+    connect(interferenceTable_, &QTableWidget::cellChanged, this, &LinkBudgetModule::onInterferenceCellChanged);
+    layout->addWidget(interferenceTable_);
+
+    auto* buttonLayout = new QHBoxLayout();
+
+    auto* addButton = new QPushButton("Add", this);
+    addButton->setToolTip("Add an interferer");
+    connect(addButton, &QPushButton::clicked, this, &LinkBudgetModule::addInterfererRow);
+
+    auto* removeButton = new QPushButton("Remove", this);
+    removeButton->setToolTip("Remove the selected interferers");
+    connect(removeButton, &QPushButton::clicked, this, &LinkBudgetModule::removeSelectedInterferers);
+
+    auto* importButton = new QPushButton("Import CSV...", this);
+    importButton->setToolTip("Append interferers from CSV: name,eirp,offset,distance[,offAxis[,discrimination]]");
+    connect(importButton, &QPushButton::clicked, this, &LinkBudgetModule::importInterferers);
+
+    buttonLayout->addWidget(addButton);
+    buttonLayout->addWidget(removeButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(importButton);
+    layout->addLayout(buttonLayout);
+}
+
+void LinkBudgetModule::setInterferenceRow(int row, const Interferer& interferer)
+{
+    const QStringList values = {
+        interferer.name,
+        QString::number(interferer.eirpDbw, 'f', 2),
+        QString::number(interferer.frequencyOffsetMHz, 'f', 3),
+        QString::number(interferer.distanceKm, 'f', 3),
+        QString::number(interferer.offAxisDeg, 'f', 2),
+        QString::number(interferer.discriminationDb, 'f', 2)
+    };
+
+    for (int column = 0; column < values.size(); ++column) {
+        interferenceTable_->setItem(row, column, new QTableWidgetItem(values[column]));
+    }
+}
+
+Interferer LinkBudgetModule::interfererFromRow(int row) const
+{
+    auto number = [this, row](int column, double fallback) {
+        const QTableWidgetItem* item = interferenceTable_->item(row, column);
+        bool ok = false;
+        const double value = item ? item->text().toDouble(&ok) : 0.0;
+        return ok ? value : fallback;
+    };
+
+    Interferer interferer;
+    const QTableWidgetItem* nameItem = interferenceTable_->item(row, 0);
+    interferer.name = nameItem ? nameItem->text() : QString();
+    interferer.eirpDbw = number(1, 0.0);
+    interferer.frequencyOffsetMHz = number(2, 0.0);
+    interferer.distanceKm = number(3, 1.0);
+    interferer.offAxisDeg = number(4, 0.0);
+    interferer.discriminationDb = number(5, 0.0);
+    return interferer;
+}
+
+void LinkBudgetModule::populateInterferenceTable()
+{
+    updatingInterferenceTable_ = true;
+
+    interferenceTable_->setRowCount(interferenceEngine_.count());
+    for (int row = 0; row < interferenceEngine_.count(); ++row) {
+        setInterferenceRow(row, interferenceEngine_.interferer(row));
+    }
+
+    updatingInterferenceTable_ = false;
+}
+
+void LinkBudgetModule::addInterfererRow()
+{
+    Interferer interferer;
+    interferer.name = QString("Interferer %1").arg(interferenceEngine_.count() + 1);
+
+    const int row = interferenceEngine_.addInterferer(interferer);
+
+    updatingInterferenceTable_ = true;
+    interferenceTable_->insertRow(row);
+    setInterferenceRow(row, interferer);
+    updatingInterferenceTable_ = false;
+
+    onParameterChanged();
+}
+
+void LinkBudgetModule::removeSelectedInterferers()
+{
+    QList<int> rows;
+    for (const QModelIndex& index : interferenceTable_->selectionModel()->selectedRows()) {
+        rows.append(index.row());
+    }
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    // Highest first so the remaining indices stay valid
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+
+    updatingInterferenceTable_ = true;
+    for (int row : std::as_const(rows)) {
+        interferenceEngine_.removeInterferer(row);
+        interferenceTable_->removeRow(row);
+    }
+    updatingInterferenceTable_ = false;
+
+    onParameterChanged();
+}
+
+void LinkBudgetModule::importInterferers()
+{
+    QString filePath = QFileDialog::getOpenFileName(
+        this,
+        "Import Interferers",
+        QString(),
+        "CSV Files (*.csv);;All Files (*)"
+        );
+
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QString error;
+    const QVector<Interferer> imported = InterferenceEngine::fromCsv(filePath, &error);
+    if (!error.isEmpty()) {
+        QMessageBox::warning(this, "Import Failed", "Could not import interferers:\n" + error);
+        return;
+    }
+
+    // One full pass for the whole batch
+    interferenceEngine_.setInterferers(interferenceEngine_.interferers() + imported);
+    populateInterferenceTable();
+    onParameterChanged();
+}
+
+void LinkBudgetModule::onInterferenceCellChanged(int row, int column)
+{
+    Q_UNUSED(column);
+
+    if (updatingInterferenceTable_) {
+        return;
+    }
+
+    // Only this interferer's contribution is recomputed
+    interferenceEngine_.updateInterferer(row, interfererFromRow(row));
+    onParameterChanged();
 }
 
 void LinkBudgetModule::createResultsSection()
@@ -402,6 +925,18 @@ void LinkBudgetModule::createResultsSection()
     cnrLabel_->setStyleSheet("font-weight: normal; font-size: 11pt;");
     keyResultsLayout->addRow("C/N Ratio:", cnrLabel_);
 
+    interferencePowerLabel_ = new QLabel("-- dBW", this);
+    interferencePowerLabel_->setStyleSheet("font-weight: normal; font-size: 11pt;");
+    keyResultsLayout->addRow("Interference Power:", interferencePowerLabel_);
+
+    ciLabel_ = new QLabel("-- dB", this);
+    ciLabel_->setStyleSheet("font-weight: normal; font-size: 11pt;");
+    keyResultsLayout->addRow("C/I Ratio:", ciLabel_);
+
+    cnirLabel_ = new QLabel("-- dB", this);
+    cnirLabel_->setStyleSheet("font-weight: normal; font-size: 11pt;");
+    keyResultsLayout->addRow("C/(N+I) Ratio:", cnirLabel_);
+
     gtLabel_ = new QLabel("-- dB/K", this);
     gtLabel_->setStyleSheet("font-weight: normal; font-size: 11pt;");
     keyResultsLayout->addRow("G/T:", gtLabel_);
@@ -413,6 +948,14 @@ void LinkBudgetModule::createResultsSection()
     linkMarginLabel_->setFont(marginFont);
     keyResultsLayout->addRow("Link Margin:", linkMarginLabel_);
 
+    modCodLabel_ = new QLabel("--", this);
+    modCodLabel_->setStyleSheet("font-weight: normal; font-size: 11pt;");
+    keyResultsLayout->addRow("Best ModCod:", modCodLabel_);
+
+    throughputLabel_ = new QLabel("--", this);
+    throughputLabel_->setStyleSheet("font-weight: normal; font-size: 11pt;");
+    keyResultsLayout->addRow("Throughput:", throughputLabel_);
+
     layout->addLayout(keyResultsLayout);
 
     // Detailed budget table
@@ -473,6 +1016,8 @@ void LinkBudgetModule::connectSignals()
             this, &LinkBudgetModule::onParameterChanged);
     connect(txAntennaGainSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
             this, &LinkBudgetModule::onParameterChanged);
+    connect(txPointingErrorSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &LinkBudgetModule::onParameterChanged);
 
     connect(frequencySpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
             this, &LinkBudgetModule::onParameterChanged);
@@ -485,12 +1030,18 @@ void LinkBudgetModule::connectSignals()
 
     connect(rxAntennaGainSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
             this, &LinkBudgetModule::onParameterChanged);
+    connect(rxPointingErrorSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &LinkBudgetModule::onParameterChanged);
     connect(rxLineLossSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
             this, &LinkBudgetModule::onParameterChanged);
     connect(bandwidthSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
             this, &LinkBudgetModule::onParameterChanged);
     connect(bandwidthUnitCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &LinkBudgetModule::onParameterChanged);
+    connect(implementationLossSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &LinkBudgetModule::onParameterChanged);
+    connect(rollOffSpin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &LinkBudgetModule::onParameterChanged);
 }
 
 void LinkBudgetModule::onParameterChanged()
@@ -511,6 +1062,8 @@ void LinkBudgetModule::clearAll()
     txPowerSpin_->setValue(10.0);
     txLineLossSpin_->setValue(0.5);
     txAntennaGainSpin_->setValue(20.0);
+    txPointingErrorSpin_->setValue(0.0);
+    clearAntennaPattern(true);
 
     frequencySpin_->setValue(2.4);
     frequencyUnitCombo_->setCurrentText("GHz");
@@ -523,6 +1076,8 @@ void LinkBudgetModule::clearAll()
     miscLossSpin_->setValue(0.0);
 
     rxAntennaGainSpin_->setValue(15.0);
+    rxPointingErrorSpin_->setValue(0.0);
+    clearAntennaPattern(false);
     rxLineLossSpin_->setValue(0.5);
     systemNoiseTempSpin_->setValue(290.0);
     noiseFigureSpin_->setValue(3.0);
@@ -530,6 +1085,12 @@ void LinkBudgetModule::clearAll()
     bandwidthUnitCombo_->setCurrentText("MHz");
     requiredSNRSpin_->setValue(10.0);
     implementationLossSpin_->setValue(1.0);
+    rollOffSpin_->setValue(0.35);
+    applyModCodTable(QString(), nullptr);
+
+    interferenceEngine_.clear();
+    populateInterferenceTable();
+    updateResults();
 
     hasUnsavedChanges_ = false;
 }
@@ -562,6 +1123,39 @@ void LinkBudgetModule::loadPreset()
     }
 
     model_->fromJson(doc.object());
+
+    // Patterns referenced by the preset
+    txPointingErrorSpin_->setValue(model_->txPointingError());
+    rxPointingErrorSpin_->setValue(model_->rxPointingError());
+
+    const QString txPatternFile = model_->txAntennaPatternFile();
+    const QString rxPatternFile = model_->rxAntennaPatternFile();
+    QStringList loadErrors;
+    for (bool transmit : {true, false}) {
+        const QString patternFile = transmit ? txPatternFile : rxPatternFile;
+        QString error;
+        if (patternFile.isEmpty()) {
+            clearAntennaPattern(transmit);
+        } else if (!applyAntennaPattern(transmit, patternFile, &error)) {
+            loadErrors.append(QString("%1: %2").arg(patternFile, error));
+            clearAntennaPattern(transmit);
+        }
+    }
+    interferenceEngine_.setInterferers(model_->interferers());
+    populateInterferenceTable();
+
+    rollOffSpin_->setValue(model_->rollOff());
+    const QString modCodTable = model_->modCodTable();
+    QString modCodError;
+    if (!applyModCodTable(modCodTable, &modCodError)) {
+        loadErrors.append(QString("%1: %2").arg(modCodTable, modCodError));
+        applyModCodTable(QString(), nullptr);
+    }
+
+    if (!loadErrors.isEmpty()) {
+        QMessageBox::warning(this, "Load Preset", "Some referenced files could not be loaded:\n" + loadErrors.join('\n'));
+    }
+
     hasUnsavedChanges_ = false;
     calculate();
 }
@@ -585,22 +1179,25 @@ void LinkBudgetModule::updateResults()
                        + polarizationLossSpin_->value() + miscLossSpin_->value();
     double rxPower = calculateReceivedPower();
     double gt = calculateGT();
+    const PointingLossStats txPointing = calculatePointingLoss(true);
+    const PointingLossStats rxPointing = calculatePointingLoss(false);
 
     // Calculate noise power: N = k*T*B (in dBW)
-    const double BOLTZMANN = 1.380649e-23; // J/K
-    double bwHz = bandwidthSpin_->value();
-    if (bandwidthUnitCombo_->currentText() == "kHz") bwHz *= 1e3;
-    else if (bandwidthUnitCombo_->currentText() == "MHz") bwHz *= 1e6;
-    else if (bandwidthUnitCombo_->currentText() == "GHz") bwHz *= 1e9;
-
-    double noisePowerWatts = BOLTZMANN * systemNoiseTempSpin_->value() * bwHz;
-    double noisePower_dBW = 10.0 * log10(noisePowerWatts);
+    double noisePower_dBW = calculateNoisePower();
 
     // C/N ratio
     double cnr = rxPower - noisePower_dBW;
 
-    // Link margin
-    double linkMargin = cnr - requiredSNRSpin_->value() - implementationLossSpin_->value();
+    // Interference: contributions only change here when the carrier itself changed
+    interferenceEngine_.setCarrier(frequencyHz(), bandwidthHz(), rxAntennaGainSpin_->value(), &rxPattern_,
+                                   rxLineLossSpin_->value());
+    const bool hasInterference = interferenceEngine_.totalInterferenceWatts() > 0.0;
+    const double interference_dBW = interferenceEngine_.totalInterferenceDbw();
+    const double ci = interferenceEngine_.carrierToInterference(rxPower);
+    const double cnir = interferenceEngine_.carrierToNoisePlusInterference(rxPower, noisePower_dBW);
+
+    // Link margin (against C/(N+I), which equals C/N without interferers)
+    double linkMargin = cnir - requiredSNRSpin_->value() - implementationLossSpin_->value();
 
     // Update result labels
     eirpLabel_->setText(QString::number(eirp, 'f', 2) + " dBW");
@@ -609,6 +1206,9 @@ void LinkBudgetModule::updateResults()
     rxPowerLabel_->setText(QString::number(rxPower, 'f', 2) + " dBW");
     noisePowerLabel_->setText(QString::number(noisePower_dBW, 'f', 2) + " dBW");
     cnrLabel_->setText(QString::number(cnr, 'f', 2) + " dB");
+    interferencePowerLabel_->setText(hasInterference ? QString::number(interference_dBW, 'f', 2) + " dBW" : QString("None"));
+    ciLabel_->setText(hasInterference ? QString::number(ci, 'f', 2) + " dB" : QString("--"));
+    cnirLabel_->setText(QString::number(cnir, 'f', 2) + " dB");
     gtLabel_->setText(QString::number(gt, 'f', 2) + " dB/K");
 
     // Color code link margin
@@ -621,6 +1221,26 @@ void LinkBudgetModule::updateResults()
     }
     linkMarginLabel_->setText(QString::number(linkMargin, 'f', 2) + " dB");
 
+    // Adaptive coding: best ModCod the link closes with
+    const double esNo = esNoFromCarrierToNoise(cnir);
+    const int modCodIndex = modCodTable_.bestIndex(esNo);
+    const ModCod modCod = modCodTable_.at(modCodIndex);
+    const double throughput = modCodIndex >= 0 ? modCod.spectralEfficiency * symbolRate() : 0.0;
+
+    if (!modCodTable_.isValid()) {
+        modCodLabel_->setText("--");
+        throughputLabel_->setText("--");
+    } else if (modCodIndex < 0) {
+        modCodLabel_->setText(QString("None (needs %1 dB Es/N0)").arg(modCodTable_.at(0).esNoThresholdDb, 0, 'f', 2));
+        throughputLabel_->setText("0 (outage)");
+    } else {
+        modCodLabel_->setText(QString("%1 (%2 bit/sym, +%3 dB)")
+                                  .arg(modCod.name)
+                                  .arg(modCod.spectralEfficiency, 0, 'f', 3)
+                                  .arg(esNo - modCod.esNoThresholdDb, 0, 'f', 2));
+        throughputLabel_->setText(QString::number(throughput / 1e6, 'f', 3) + " Mbps");
+    }
+
     // Update detailed table
     budgetTable_->setRowCount(0);
     auto addRow = [this](const QString& param, const QString& value) {
@@ -633,6 +1253,10 @@ void LinkBudgetModule::updateResults()
     addRow("Tx Power", QString::number(txPowerSpin_->value(), 'f', 2) + " dBW");
     addRow("Tx Line Loss", QString::number(-txLineLossSpin_->value(), 'f', 2) + " dB");
     addRow("Tx Antenna Gain", QString::number(txAntennaGainSpin_->value(), 'f', 2) + " dBi");
+    if (txPattern_.isValid()) {
+        addRow("Tx Pointing Loss (mean / 95%)", QString("%1 / %2 dB")
+                   .arg(-txPointing.meanLossDb, 0, 'f', 2).arg(-txPointing.p95LossDb, 0, 'f', 2));
+    }
     addRow("EIRP", QString::number(eirp, 'f', 2) + " dBW");
     addRow("Free Space Loss", QString::number(-fsl, 'f', 2) + " dB");
     addRow("Atmospheric Loss", QString::number(-atmosphericLossSpin_->value(), 'f', 2) + " dB");
@@ -640,18 +1264,60 @@ void LinkBudgetModule::updateResults()
     addRow("Polarization Loss", QString::number(-polarizationLossSpin_->value(), 'f', 2) + " dB");
     addRow("Misc. Losses", QString::number(-miscLossSpin_->value(), 'f', 2) + " dB");
     addRow("Rx Antenna Gain", QString::number(rxAntennaGainSpin_->value(), 'f', 2) + " dBi");
+    if (rxPattern_.isValid()) {
+        addRow("Rx Pointing Loss (mean / 95%)", QString("%1 / %2 dB")
+                   .arg(-rxPointing.meanLossDb, 0, 'f', 2).arg(-rxPointing.p95LossDb, 0, 'f', 2));
+    }
     addRow("Rx Line Loss", QString::number(-rxLineLossSpin_->value(), 'f', 2) + " dB");
     addRow("Received Power", QString::number(rxPower, 'f', 2) + " dBW");
     addRow("Noise Power", QString::number(noisePower_dBW, 'f', 2) + " dBW");
     addRow("C/N Ratio", QString::number(cnr, 'f', 2) + " dB");
+    if (hasInterference) {
+        addRow(QString("Interference (%1 interferers)").arg(interferenceEngine_.count()),
+               QString::number(interference_dBW, 'f', 2) + " dBW");
+        addRow("C/I Ratio", QString::number(ci, 'f', 2) + " dB");
+        addRow("C/(N+I) Ratio", QString::number(cnir, 'f', 2) + " dB");
+    }
     addRow("Required SNR", QString::number(requiredSNRSpin_->value(), 'f', 2) + " dB");
     addRow("Implementation Loss", QString::number(-implementationLossSpin_->value(), 'f', 2) + " dB");
     addRow("Link Margin", QString::number(linkMargin, 'f', 2) + " dB");
+    if (modCodTable_.isValid()) {
+        addRow("Es/N0", QString::number(esNo, 'f', 2) + " dB");
+        addRow("Symbol Rate", QString::number(symbolRate() / 1e6, 'f', 3) + " Msps");
+        if (modCodIndex >= 0) {
+            addRow("Best ModCod", QString("%1 (%2)").arg(modCod.name, modCodTable_.name()));
+            addRow("ModCod Threshold", QString::number(modCod.esNoThresholdDb, 'f', 2) + " dB");
+            addRow("ModCod Margin", QString::number(esNo - modCod.esNoThresholdDb, 'f', 2) + " dB");
+        } else {
+            addRow("Best ModCod", "None (outage)");
+        }
+        addRow("Throughput", QString::number(throughput / 1e6, 'f', 3) + " Mbps");
+    }
 }
 
 double LinkBudgetModule::calculateEIRP() const
 {
-    return txPowerSpin_->value() - txLineLossSpin_->value() + txAntennaGainSpin_->value();
+    return txPowerSpin_->value() - txLineLossSpin_->value() + txAntennaGainSpin_->value()
+           - calculatePointingLoss(true).meanLossDb;
+}
+
+PointingLossStats LinkBudgetModule::calculatePointingLoss(bool transmit) const
+{
+    const AntennaPattern& pattern = transmit ? txPattern_ : rxPattern_;
+    if (!pattern.isValid()) {
+        return PointingLossStats();
+    }
+
+    // Fixed seed keeps the displayed budget stable between recalculations, so one
+    // simulation serves every caller until the pattern or the sigma changes
+    const double sigma = transmit ? txPointingErrorSpin_->value() : rxPointingErrorSpin_->value();
+    PointingLossCache& cache = transmit ? txPointingCache_ : rxPointingCache_;
+    if (!cache.valid || cache.sigmaDeg != sigma) {
+        cache.stats = sigma > 0.0 ? pattern.pointingLoss(sigma) : pattern.pointingLoss(0.0, 0.0, 1);
+        cache.sigmaDeg = sigma;
+        cache.valid = true;
+    }
+    return cache.stats;
 }
 
 double LinkBudgetModule::calculateFreeSpaceLoss() const
@@ -660,12 +1326,7 @@ double LinkBudgetModule::calculateFreeSpaceLoss() const
     // where d is distance in meters, f is frequency in Hz
 
     // Convert frequency to Hz
-    double freqHz = frequencySpin_->value();
-    if (frequencyUnitCombo_->currentText() == "MHz") {
-        freqHz *= 1e6;
-    } else if (frequencyUnitCombo_->currentText() == "GHz") {
-        freqHz *= 1e9;
-    }
+    double freqHz = frequencyHz();
 
     // Convert distance to meters
     double distMeters = distanceSpin_->value();
@@ -689,7 +1350,8 @@ double LinkBudgetModule::calculateReceivedPower() const
     double fsl = calculateFreeSpaceLoss();
     double totalLoss = fsl + atmosphericLossSpin_->value() + rainLossSpin_->value()
                        + polarizationLossSpin_->value() + miscLossSpin_->value();
-    double rxPower = eirp - totalLoss + rxAntennaGainSpin_->value() - rxLineLossSpin_->value();
+    double rxPower = eirp - totalLoss + rxAntennaGainSpin_->value() - calculatePointingLoss(false).meanLossDb
+                     - rxLineLossSpin_->value();
     return rxPower;
 }
 
@@ -703,21 +1365,48 @@ double LinkBudgetModule::calculateGT() const
 double LinkBudgetModule::calculateLinkMargin() const
 {
     double rxPower = calculateReceivedPower();
+    double cnir = interferenceEngine_.carrierToNoisePlusInterference(rxPower, calculateNoisePower());
+    double linkMargin = cnir - requiredSNRSpin_->value() - implementationLossSpin_->value();
+
+    return linkMargin;
+}
+
+double LinkBudgetModule::calculateNoisePower() const
+{
+    const double BOLTZMANN = 1.380649e-23; // J/K
+    double noisePowerWatts = BOLTZMANN * systemNoiseTempSpin_->value() * bandwidthHz();
+    return 10.0 * log10(noisePowerWatts);
+}
+
+double LinkBudgetModule::frequencyHz() const
+{
+    double freqHz = frequencySpin_->value();
+    if (frequencyUnitCombo_->currentText() == "MHz") {
+        freqHz *= 1e6;
+    } else if (frequencyUnitCombo_->currentText() == "GHz") {
+        freqHz *= 1e9;
+    }
+    return freqHz;
+}
 
-    // Calculate noise power
-    const double BOLTZMANN = 1.380649e-23;
+double LinkBudgetModule::bandwidthHz() const
+{
     double bwHz = bandwidthSpin_->value();
     if (bandwidthUnitCombo_->currentText() == "kHz") bwHz *= 1e3;
     else if (bandwidthUnitCombo_->currentText() == "MHz") bwHz *= 1e6;
     else if (bandwidthUnitCombo_->currentText() == "GHz") bwHz *= 1e9;
+    return bwHz;
+}
 
-    double noisePowerWatts = BOLTZMANN * systemNoiseTempSpin_->value() * bwHz;
-    double noisePower_dBW = 10.0 * log10(noisePowerWatts);
-
-    double cnr = rxPower - noisePower_dBW;
-    double linkMargin = cnr - requiredSNRSpin_->value() - implementationLossSpin_->value();
+double LinkBudgetModule::symbolRate() const
+{
+    return bandwidthHz() / (1.0 + rollOffSpin_->value());
+}
 
-    return linkMargin;
+double LinkBudgetModule::esNoFromCarrierToNoise(double cnDb) const
+{
+    // Noise is measured in the full bandwidth B, symbols arrive at B / (1 + roll-off)
+    return cnDb + 10.0 * log10(1.0 + rollOffSpin_->value()) - implementationLossSpin_->value();
 }
 
 double LinkBudgetModule::calculateAtmosphericLoss() const
@@ -2,6 +2,9 @@
 #pragma once
 
 #include "shared/interfaces/IModule.h"
+#include "AntennaPattern.h"
+#include "InterferenceEngine.h"
+#include "ModCodTable.h"
 #include <QWidget>
 
 class LinkBudgetModel;
@@ -48,6 +51,7 @@ private:
     void createTransmitterSection();
     void createPathSection();
     void createReceiverSection();
+    void createInterferenceSection();
     void createResultsSection();
     void createControlButtons();
     void connectSignals();
@@ -61,6 +65,29 @@ private:
     void onParameterChanged();
     void updateResults();
 
+    // Antenna patterns (transmit = true for the Tx side)
+    QHBoxLayout* createPatternRow(bool transmit);
+    void loadAntennaPattern(bool transmit);
+    bool applyAntennaPattern(bool transmit, const QString& filePath, QString* errorString);
+    void clearAntennaPattern(bool transmit);
+    void updatePatternControls(bool transmit);
+
+    // Interference
+    void addInterfererRow();
+    void removeSelectedInterferers();
+    void importInterferers();
+    void onInterferenceCellChanged(int row, int column);
+    void populateInterferenceTable();
+    void setInterferenceRow(int row, const Interferer& interferer);
+    Interferer interfererFromRow(int row) const;
+
+    // ModCod table (adaptive coding)
+    QHBoxLayout* createModCodRow();
+    void onModCodTableChanged(int index);
+    void importModCodTable();
+    bool applyModCodTable(const QString& table, QString* errorString);  ///< Built-in name, CSV path, or empty for none
+    void calculateDataVolume();
+
     // Helper methods
     double calculateFreeSpaceLoss() const;
     double calculateAtmosphericLoss() const;
@@ -69,6 +96,12 @@ private:
     double calculateLinkMargin() const;
     double calculateEIRP() const;
     double calculateGT() const;
+    PointingLossStats calculatePointingLoss(bool transmit) const;   ///< Zero loss without a pattern
+    double calculateNoisePower() const;                             ///< Thermal noise k*T*B in dBW
+    double frequencyHz() const;
+    double bandwidthHz() const;
+    double symbolRate() const;                                      ///< Bandwidth / (1 + roll-off), in baud
+    double esNoFromCarrierToNoise(double cnDb) const;               ///< Es/N0 after implementation loss
 
 private:
     // Model
@@ -78,6 +111,7 @@ private:
     QGroupBox* transmitterGroup_;
     QGroupBox* pathGroup_;
     QGroupBox* receiverGroup_;
+    QGroupBox* interferenceGroup_;
     QGroupBox* resultsGroup_;
 
     // Transmitter parameters
@@ -85,6 +119,9 @@ private:
     QDoubleSpinBox* txLineLossSpin_;
     QDoubleSpinBox* txAntennaGainSpin_;
     QComboBox* txPolarizationCombo_;
+    QLabel* txPatternLabel_;
+    QPushButton* txPatternClearButton_;
+    QDoubleSpinBox* txPointingErrorSpin_;
 
     // Path parameters
     QDoubleSpinBox* frequencySpin_;
@@ -98,6 +135,9 @@ private:
 
     // Receiver parameters
     QDoubleSpinBox* rxAntennaGainSpin_;
+    QLabel* rxPatternLabel_;
+    QPushButton* rxPatternClearButton_;
+    QDoubleSpinBox* rxPointingErrorSpin_;
     QDoubleSpinBox* rxLineLossSpin_;
     QDoubleSpinBox* systemNoiseTempSpin_;
     QDoubleSpinBox* noiseFigureSpin_;
@@ -105,6 +145,9 @@ private:
     QComboBox* bandwidthUnitCombo_;
     QDoubleSpinBox* requiredSNRSpin_;
     QDoubleSpinBox* implementationLossSpin_;
+    QComboBox* modCodCombo_;
+    QDoubleSpinBox* rollOffSpin_;
+    QPushButton* dataVolumeButton_;
 
     // Results display
     QLabel* eirpLabel_;
@@ -113,8 +156,13 @@ private:
     QLabel* rxPowerLabel_;
     QLabel* noisePowerLabel_;
     QLabel* cnrLabel_;
+    QLabel* interferencePowerLabel_;
+    QLabel* ciLabel_;
+    QLabel* cnirLabel_;
     QLabel* gtLabel_;
     QLabel* linkMarginLabel_;
+    QLabel* modCodLabel_;
+    QLabel* throughputLabel_;
     QTableWidget* budgetTable_;
 
     // Control buttons
@@ -124,6 +172,27 @@ private:
     QPushButton* savePresetButton_;
     QPushButton* exportButton_;
 
+    // Interference (engine holds the values; the table mirrors it)
+    QTableWidget* interferenceTable_;
+    InterferenceEngine interferenceEngine_;
+    bool updatingInterferenceTable_;
+
+    // ModCod table (invalid = required SNR only)
+    ModCodTable modCodTable_;
+
+    // Antenna patterns (invalid = scalar gain from the spin box)
+    AntennaPattern txPattern_;
+    AntennaPattern rxPattern_;
+
+    // Monte Carlo pointing loss per side, reused until the pattern or the sigma changes
+    struct PointingLossCache {
+        bool valid = false;
+        double sigmaDeg = 0.0;
+        PointingLossStats stats;
+    };
+    mutable PointingLossCache txPointingCache_;
+    mutable PointingLossCache rxPointingCache_;
+
     // State tracking
     bool hasUnsavedChanges_;
 };
@@ -0,0 +1,235 @@
+// src/modules/linkbudget/ModCodTable.cpp
+
+#include "ModCodTable.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief DVB-S2 normal frames, ideal Es/N0 thresholds (AWGN, PER 1e-7) and efficiencies
+ */
+const QVector<ModCod>& dvbS2Entries()
+{
+    static const QVector<ModCod> entries = {
+        {"QPSK 1/4", -2.35, 0.490243},
+        {"QPSK 1/3", -1.24, 0.656448},
+        {"QPSK 2/5", -0.30, 0.789412},
+        {"QPSK 1/2", 1.00, 0.988858},
+        {"QPSK 3/5", 2.23, 1.188304},
+        {"QPSK 2/3", 3.10, 1.322253},
+        {"QPSK 3/4", 4.03, 1.487473},
+        {"QPSK 4/5", 4.68, 1.587196},
+        {"QPSK 5/6", 5.18, 1.654663},
+        {"QPSK 8/9", 6.20, 1.766451},
+        {"QPSK 9/10", 6.42, 1.788612},
+        {"8PSK 3/5", 5.50, 1.779991},
+        {"8PSK 2/3", 6.62, 1.980636},
+        {"8PSK 3/4", 7.91, 2.228124},
+        {"8PSK 5/6", 9.35, 2.478562},
+        {"8PSK 8/9", 10.69, 2.646012},
+        {"8PSK 9/10", 10.98, 2.679207},
+        {"16APSK 2/3", 8.97, 2.637201},
+        {"16APSK 3/4", 10.21, 2.966728},
+        {"16APSK 4/5", 11.03, 3.165623},
+        {"16APSK 5/6", 11.61, 3.300184},
+        {"16APSK 8/9", 12.89, 3.523143},
+        {"16APSK 9/10", 13.13, 3.567342},
+        {"32APSK 3/4", 12.73, 3.703295},
+        {"32APSK 4/5", 13.64, 3.951571},
+        {"32APSK 5/6", 14.28, 4.119540},
+        {"32APSK 8/9", 15.69, 4.397854},
+        {"32APSK 9/10", 16.05, 4.453027},
+    };
+    return entries;
+}
+
+const QString kDvbS2 = QStringLiteral("DVB-S2");
+
+// Up to this many entries a linear count beats a binary search per sample
+constexpr int kLinearCountLimit = 64;
+
+}
+
+QStringList ModCodTable::builtInNames()
+{
+    return {kDvbS2};
+}
+
+ModCodTable ModCodTable::builtIn(const QString& name)
+{
+    if (name == kDvbS2) {
+        return fromEntries(kDvbS2, dvbS2Entries());
+    }
+    return ModCodTable();
+}
+
+ModCodTable ModCodTable::fromEntries(const QString& name, QVector<ModCod> entries)
+{
+    ModCodTable table;
+    table.name_ = name;
+
+    // Most robust first; for equal thresholds the more efficient entry first
+    std::sort(entries.begin(), entries.end(), [](const ModCod& a, const ModCod& b) {
+        if (a.esNoThresholdDb != b.esNoThresholdDb) {
+            return a.esNoThresholdDb < b.esNoThresholdDb;
+        }
+        return a.spectralEfficiency > b.spectralEfficiency;
+    });
+
+    // Keep the efficient frontier: an entry must carry more bits than every cheaper one
+    double bestEfficiency = 0.0;
+    for (const ModCod& entry : std::as_const(entries)) {
+        if (!std::isfinite(entry.esNoThresholdDb) || entry.spectralEfficiency <= bestEfficiency) {
+            continue;
+        }
+        bestEfficiency = entry.spectralEfficiency;
+        table.thresholds_.append(entry.esNoThresholdDb);
+        table.efficiencies_.append(entry.spectralEfficiency);
+        table.names_.append(entry.name);
+    }
+
+    return table;
+}
+
+ModCodTable ModCodTable::fromCsv(const QString& filePath, QString* errorString)
+{
+    auto fail = [errorString](const QString& message) {
+        if (errorString) {
+            *errorString = message;
+        }
+        return ModCodTable();
+    };
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return fail("Could not open file: " + file.errorString());
+    }
+
+    QVector<ModCod> entries;
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        ++lineNumber;
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const QStringList fields = line.split(',');
+        if (fields.size() < 3) {
+            return fail(QString("Line %1: expected name,esNoThresholdDb,spectralEfficiency").arg(lineNumber));
+        }
+
+        bool thresholdOk = false;
+        bool efficiencyOk = false;
+        ModCod entry;
+        entry.name = fields[0].trimmed();
+        entry.esNoThresholdDb = fields[1].trimmed().toDouble(&thresholdOk);
+        entry.spectralEfficiency = fields[2].trimmed().toDouble(&efficiencyOk);
+
+        if (!thresholdOk || !efficiencyOk) {
+            // A header line is allowed before the first row
+            if (entries.isEmpty()) {
+                continue;
+            }
+            return fail(QString("Line %1: invalid number").arg(lineNumber));
+        }
+        if (entry.spectralEfficiency <= 0.0) {
+            return fail(QString("Line %1: spectral efficiency must be positive").arg(lineNumber));
+        }
+
+        entries.append(entry);
+    }
+
+    if (entries.isEmpty()) {
+        return fail("No ModCod entries found");
+    }
+
+    ModCodTable table = fromEntries(QFileInfo(filePath).completeBaseName(), entries);
+    qDebug() << "ModCodTable: Loaded" << QFileInfo(filePath).fileName() << "-"
+             << entries.size() << "entries," << table.size() << "on the efficient frontier";
+    return table;
+}
+
+ModCod ModCodTable::at(int index) const
+{
+    ModCod entry;
+    if (index < 0 || index >= size()) {
+        return entry;
+    }
+
+    entry.name = names_[index];
+    entry.esNoThresholdDb = thresholds_[index];
+    entry.spectralEfficiency = efficiencies_[index];
+    return entry;
+}
+
+int ModCodTable::bestIndex(double esNoDb) const
+{
+    // Last threshold <= Es/N0
+    const auto it = std::upper_bound(thresholds_.cbegin(), thresholds_.cend(), esNoDb);
+    return static_cast<int>(it - thresholds_.cbegin()) - 1;
+}
+
+double ModCodTable::throughputBps(double esNoDb, double symbolRateBaud) const
+{
+    const int index = bestIndex(esNoDb);
+    return index >= 0 ? efficiencies_[index] * symbolRateBaud : 0.0;
+}
+
+ModCodThroughput ModCodTable::evaluate(const double* esNoDb, qsizetype count, double symbolRateBaud,
+                                       double sampleSecs, double* rateBps) const
+{
+    const QVector<double> durations(count, sampleSecs);
+    return evaluate(esNoDb, durations.constData(), count, symbolRateBaud, rateBps);
+}
+
+ModCodThroughput ModCodTable::evaluate(const double* esNoDb, const double* durationsSecs, qsizetype count,
+                                       double symbolRateBaud, double* rateBps) const
+{
+    ModCodThroughput result;
+    if (count <= 0) {
+        return result;
+    }
+
+    // Rate per table slot; slot 0 is outage, slot i + 1 is entry i
+    QVector<double> slotRates(size() + 1, 0.0);
+    for (int i = 0; i < size(); ++i) {
+        slotRates[i + 1] = efficiencies_[i] * symbolRateBaud;
+    }
+
+    const double* thresholds = thresholds_.constData();
+    const double* rates = slotRates.constData();
+    const int entries = size();
+    const bool linear = entries <= kLinearCountLimit;
+
+    for (qsizetype i = 0; i < count; ++i) {
+        int slot = 0;
+        if (linear) {
+            // Thresholds are sorted, so the number met is the slot; no data-dependent branches
+            for (int j = 0; j < entries; ++j) {
+                slot += esNoDb[i] >= thresholds[j];
+            }
+        } else {
+            slot = static_cast<int>(std::upper_bound(thresholds, thresholds + entries, esNoDb[i]) - thresholds);
+        }
+
+        const double rate = rates[slot];
+        const double duration = durationsSecs[i];
+        if (rateBps) {
+            rateBps[i] = rate;
+        }
+
+        result.totalBits += rate * duration;
+        result.durationSecs += duration;
+        result.outageSecs += (slot == 0) ? duration : 0.0;
+        result.peakRateBps = std::max(result.peakRateBps, rate);
+    }
+
+    return result;
+}
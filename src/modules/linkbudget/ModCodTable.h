@@ -0,0 +1,89 @@
+// src/modules/linkbudget/ModCodTable.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief One modulation/coding combination
+ */
+struct ModCod {
+    QString name;
+    double esNoThresholdDb = 0.0;       ///< Minimum Es/N0 for quasi-error-free operation
+    double spectralEfficiency = 0.0;    ///< Information bits per symbol
+};
+
+/**
+ * @brief Result of mapping a whole Es/N0 time series to data rates
+ */
+struct ModCodThroughput {
+    double totalBits = 0.0;             ///< Data volume over the series
+    double durationSecs = 0.0;          ///< Time covered by the series
+    double outageSecs = 0.0;            ///< Time with no usable ModCod
+    double peakRateBps = 0.0;
+
+    double meanRateBps() const { return durationSecs > 0.0 ? totalBits / durationSecs : 0.0; }
+    double availability() const { return durationSecs > 0.0 ? 1.0 - outageSecs / durationSecs : 0.0; }
+};
+
+/**
+ * @class ModCodTable
+ * @brief Es/N0 thresholds and spectral efficiencies for adaptive coding analysis
+ *
+ * Entries are kept as parallel arrays sorted by threshold, reduced to the efficient
+ * frontier (an entry needing more Es/N0 than another must also carry more bits per
+ * symbol), so the best ModCod for a given Es/N0 is simply the last entry whose
+ * threshold it meets: a binary search for single lookups, and a branch-free count over
+ * the (short) threshold array for batches.
+ *
+ * Import format: CSV lines "name,esNoThresholdDb,spectralEfficiency" ('#' comments,
+ * optional header line).
+ */
+class ModCodTable {
+public:
+    ModCodTable() = default;
+
+    static QStringList builtInNames();                          ///< @brief Names accepted by builtIn()
+    static ModCodTable builtIn(const QString& name);            ///< @brief Built-in table (invalid for unknown names)
+    static ModCodTable fromCsv(const QString& filePath, QString* errorString = nullptr);
+    static ModCodTable fromEntries(const QString& name, QVector<ModCod> entries);
+
+    bool isValid() const { return !thresholds_.isEmpty(); }
+    QString name() const { return name_; }
+    int size() const { return thresholds_.size(); }
+    ModCod at(int index) const;
+
+    /**
+     * @brief Best ModCod for an Es/N0
+     * @return Index into the table, -1 if even the most robust ModCod does not close
+     */
+    int bestIndex(double esNoDb) const;
+
+    double throughputBps(double esNoDb, double symbolRateBaud) const;   ///< @brief 0 in outage
+
+    /**
+     * @brief Data rate for every sample of an Es/N0 series in one pass
+     * @param esNoDb Es/N0 samples
+     * @param count Number of samples
+     * @param symbolRateBaud Symbol rate
+     * @param rateBps Output rates (optional, count values)
+     * @param sampleSecs Duration each sample stands for (uniform series)
+     */
+    ModCodThroughput evaluate(const double* esNoDb, qsizetype count, double symbolRateBaud,
+                              double sampleSecs, double* rateBps = nullptr) const;
+
+    /**
+     * @brief Same as evaluate() for a series with per-sample durations
+     * @param durationsSecs Duration each sample stands for (count values)
+     */
+    ModCodThroughput evaluate(const double* esNoDb, const double* durationsSecs, qsizetype count,
+                              double symbolRateBaud, double* rateBps = nullptr) const;
+
+private:
+    QString name_;
+    QVector<double> thresholds_;        ///< Ascending
+    QVector<double> efficiencies_;      ///< Strictly ascending, index-aligned with thresholds_
+    QStringList names_;
+};
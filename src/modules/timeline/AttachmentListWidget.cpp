@@ -1,6 +1,7 @@
 // AttachmentListWidget.cpp
 
 #include "AttachmentListWidget.h"
+#include "LogViewerDialog.h"
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QMimeData>
@@ -10,6 +11,7 @@
 #include <QDebug>
 #include <QStyle>
 #include <QDir>
+#include <QSet>
 #include <algorithm>
 
 AttachmentListWidget::AttachmentListWidget(QWidget* parent)
@@ -19,11 +21,15 @@ AttachmentListWidget::AttachmentListWidget(QWidget* parent)
 {
     setupUI();
     setAcceptDrops(true);
+
+    connect(&AttachmentMetadataCache::instance(), &AttachmentMetadataCache::fileInfoChanged,
+            this, &AttachmentListWidget::onFileInfoChanged);
 }
 
 AttachmentListWidget::~AttachmentListWidget()
 {
     disconnect(&AttachmentManager::instance(), nullptr, this, nullptr);
+    disconnect(&AttachmentMetadataCache::instance(), nullptr, this, nullptr);
     qDebug() << "AttachmentListWidget destroyed for event:" << eventId_;
 }
 
@@ -75,6 +81,13 @@ void AttachmentListWidget::setupUI()
     revealButton_->setMaximumWidth(32);
     buttonLayout->addWidget(revealButton_);
 
+    viewButton_ = new QPushButton();
+    viewButton_->setIcon(QIcon::fromTheme("text-x-generic", style()->standardIcon(QStyle::SP_FileDialogDetailedView)));
+    viewButton_->setToolTip("View text/log attachment in the built-in log viewer");
+    viewButton_->setEnabled(false);
+    viewButton_->setMaximumWidth(32);
+    buttonLayout->addWidget(viewButton_);
+
     buttonLayout->addStretch();
 
     statusLabel_ = new QLabel("No attachments");
@@ -87,6 +100,7 @@ void AttachmentListWidget::setupUI()
     connect(removeButton_, &QPushButton::clicked, this, &AttachmentListWidget::onRemoveClicked);
     connect(openButton_, &QPushButton::clicked, this, &AttachmentListWidget::onOpenClicked);
     connect(revealButton_, &QPushButton::clicked, this, &AttachmentListWidget::onRevealClicked);
+    connect(viewButton_, &QPushButton::clicked, this, &AttachmentListWidget::onViewClicked);
     connect(listWidget_, &QListWidget::itemDoubleClicked, this, &AttachmentListWidget::onItemDoubleClicked);
     connect(listWidget_, &QListWidget::itemSelectionChanged, this, &AttachmentListWidget::onSelectionChanged);
 }
@@ -359,6 +373,37 @@ void AttachmentListWidget::onRevealClicked()
     }
 }
 
+void AttachmentListWidget::onViewClicked()
+{
+    QList<QListWidgetItem*> selectedItems = listWidget_->selectedItems();
+    if (selectedItems.isEmpty())
+    {
+        return;
+    }
+
+    int index = listWidget_->row(selectedItems[0]);
+    QList<Attachment> attachments = AttachmentManager::instance().getAttachments(numericEventId_);
+
+    if (index < 0 || index >= attachments.size())
+    {
+        return;
+    }
+
+    const Attachment& attachment = attachments[index];
+
+    // Non-modal and self-deleting; parented to the window so it outlives this widget's refreshes
+    LogViewerDialog* viewer = new LogViewerDialog(attachment.filePath, attachment.displayName, window());
+    if (!viewer->isValid())
+    {
+        delete viewer;
+        QMessageBox::warning(this, "View Failed",
+                             "Failed to open attachment. File may not exist.");
+        return;
+    }
+
+    viewer->show();
+}
+
 void AttachmentListWidget::onItemDoubleClicked(QListWidgetItem* item)
 {
     if (!item)
@@ -380,6 +425,20 @@ void AttachmentListWidget::onSelectionChanged()
     updateButtons();
 }
 
+void AttachmentListWidget::onFileInfoChanged(const QStringList& filePaths)
+{
+    const QSet<QString> changed(filePaths.cbegin(), filePaths.cend());
+
+    for (int row = 0; row < listWidget_->count(); ++row)
+    {
+        QListWidgetItem* item = listWidget_->item(row);
+        if (changed.contains(item->data(FilePathRole).toString()))
+        {
+            updateItemFileState(item);
+        }
+    }
+}
+
 void AttachmentListWidget::updateButtons()
 {
     bool hasSelection = !listWidget_->selectedItems().isEmpty();
@@ -388,6 +447,7 @@ void AttachmentListWidget::updateButtons()
     if (removeButton_) removeButton_->setEnabled(hasSelection);
     if (openButton_) openButton_->setEnabled(hasSingleSelection);
     if (revealButton_) revealButton_->setEnabled(hasSingleSelection);
+    if (viewButton_) viewButton_->setEnabled(hasSingleSelection && listWidget_->selectedItems()[0]->data(TextFileRole).toBool());
 }
 
 void AttachmentListWidget::addAttachmentToList(const Attachment& attachment, int index)
@@ -412,14 +472,36 @@ void AttachmentListWidget::addAttachmentToList(const Attachment& attachment, int
         tooltip += QString("\nNotes: %1").arg(attachment.notes);
     }
 
-    if (!attachment.exists())
+    item->setData(Qt::UserRole, index);
+    item->setData(TextFileRole, attachment.isTextFile());
+    item->setData(FilePathRole, attachment.filePath);
+    item->setData(BaseToolTipRole, tooltip);
+
+    updateItemFileState(item);
+
+    listWidget_->addItem(item);
+}
+
+void AttachmentListWidget::updateItemFileState(QListWidgetItem* item)
+{
+    // Cached state only; unknown files are checked in the background and updated via onFileInfoChanged()
+    const AttachmentFileInfo info = AttachmentMetadataCache::instance().fileInfo(item->data(FilePathRole).toString());
+
+    QString tooltip = item->data(BaseToolTipRole).toString();
+
+    if (info.known && !info.exists)
     {
         tooltip += "\n⚠ WARNING: File no longer exists!";
         item->setForeground(QBrush(QColor(200, 0, 0)));
     }
+    else
+    {
+        if (info.known && info.lastModified.isValid())
+        {
+            tooltip += QString("\nModified: %1").arg(info.lastModified.toString("yyyy-MM-dd HH:mm"));
+        }
+        item->setData(Qt::ForegroundRole, QVariant());
+    }
 
     item->setToolTip(tooltip);
-    item->setData(Qt::UserRole, index);
-
-    listWidget_->addItem(item);
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 #include "../../shared/models/AttachmentModel.h"
+#include "../../shared/models/AttachmentMetadataCache.h"
 #include <QWidget>
 #include <QListWidget>
 #include <QPushButton>
@@ -22,7 +23,9 @@ class QDropEvent;
  * - Add/Remove/Open/Reveal in Explorer buttons
  * - Drag-and-drop file addition
  * - Double-click to open files
+ * - Built-in log viewer for text attachments (memory-mapped, handles multi-GB logs)
  * - Real-time updates when attachments change
+ * - Missing-file state from AttachmentMetadataCache (no filesystem access on refresh)
  */
 class AttachmentListWidget : public QWidget
 {
@@ -54,13 +57,16 @@ private slots:
     void onRemoveClicked();
     void onOpenClicked();
     void onRevealClicked();
+    void onViewClicked();
     void onItemDoubleClicked(QListWidgetItem* item);
     void onSelectionChanged();
+    void onFileInfoChanged(const QStringList& filePaths);
 
 private:
     void setupUI();
     void updateButtons();
     void addAttachmentToList(const Attachment& attachment, int index);
+    void updateItemFileState(QListWidgetItem* item);
 
     QString eventId_;
     uint numericEventId_ = -1;  // Cached hash of eventId_
@@ -72,9 +78,13 @@ private:
     QPushButton* removeButton_ = nullptr;
     QPushButton* openButton_ = nullptr;
     QPushButton* revealButton_ = nullptr;
+    QPushButton* viewButton_ = nullptr;
 
     QLabel* statusLabel_ = nullptr;
 
     // Constants
     static constexpr int ICON_SIZE = 32;
+    static constexpr int TextFileRole = Qt::UserRole + 1;          // Item flag: attachment can open in the log viewer
+    static constexpr int FilePathRole = Qt::UserRole + 2;          // Item path, matched against cache updates
+    static constexpr int BaseToolTipRole = Qt::UserRole + 3;       // Tooltip without the file-state lines
 };
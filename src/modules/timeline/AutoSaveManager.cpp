@@ -4,6 +4,8 @@
 #include "AutoSaveManager.h"
 #include "TimelineModel.h"
 #include "TimelineSerializer.h"
+#include "TimelineShardStore.h"
+#include "TimelineFileWatcher.h"
 #include <QDateTime>
 #include <QDebug>
 
@@ -23,7 +25,12 @@ AutoSaveManager::AutoSaveManager(TimelineModel* model,
     // Connect to model signals to track changes
     connect(model_, &TimelineModel::eventAdded, this, &AutoSaveManager::onModelChanged);
     connect(model_, &TimelineModel::eventRemoved, this, &AutoSaveManager::onModelChanged);
+    connect(model_, &TimelineModel::eventsAdded, this, &AutoSaveManager::onModelChanged);
+    connect(model_, &TimelineModel::eventsRemoved, this, &AutoSaveManager::onModelChanged);
+    connect(model_, &TimelineModel::eventsArchived, this, &AutoSaveManager::onModelChanged);
+    connect(model_, &TimelineModel::eventsRestored, this, &AutoSaveManager::onModelChanged);
     connect(model_, &TimelineModel::eventUpdated, this, &AutoSaveManager::onModelChanged);
+    connect(model_, &TimelineModel::eventsUpdated, this, &AutoSaveManager::onModelChanged);
     connect(model_, &TimelineModel::eventsCleared, this, &AutoSaveManager::onModelChanged);
     connect(model_, &TimelineModel::versionDatesChanged, this, &AutoSaveManager::onModelChanged);
 }
@@ -65,7 +72,8 @@ bool AutoSaveManager::saveNow()
 {
     qDebug() << "Manual save triggered";
 
-    bool success = TimelineSerializer::saveToFile(model_, saveFilePath_);
+    QString errorString;
+    bool success = writeProject(&errorString);
 
     if (success)
     {
@@ -75,7 +83,7 @@ bool AutoSaveManager::saveNow()
     }
     else
     {
-        emit autoSaveFailed("Failed to save timeline data");
+        emit autoSaveFailed(errorString.isEmpty() ? QString("Failed to save timeline data") : errorString);
     }
 
     return success;
@@ -110,7 +118,8 @@ void AutoSaveManager::onAutoSaveTimer()
 
     qDebug() << "Auto-save triggered";
 
-    bool success = TimelineSerializer::saveToFile(model_, saveFilePath_);
+    QString errorString;
+    bool success = writeProject(&errorString);
 
     if (success)
     {
@@ -121,12 +130,42 @@ void AutoSaveManager::onAutoSaveTimer()
     }
     else
     {
-        emit autoSaveFailed("Auto-save failed");
+        emit autoSaveFailed(errorString.isEmpty() ? QString("Auto-save failed") : errorString);
         qWarning() << "Auto-save failed";
     }
 }
 
 void AutoSaveManager::onModelChanged()
 {
+    // Shards loaded while scrolling are already on disk
+    if (shardStore_ && shardStore_->isApplying())
+    {
+        return;
+    }
+
     markDirty();
 }
+
+bool AutoSaveManager::writeProject(QString* errorString)
+{
+    // Someone else saved since we loaded: their changes have to be merged first
+    if (fileWatcher_ && fileWatcher_->filePath() == saveFilePath_ && fileWatcher_->isChangedOnDisk())
+    {
+        *errorString = "The project file was changed by someone else - merge pending";
+        QMetaObject::invokeMethod(fileWatcher_, &TimelineFileWatcher::checkNow, Qt::QueuedConnection);
+        return false;
+    }
+
+    if (shardStore_ && TimelineShardStore::isShardedPath(saveFilePath_))
+    {
+        return shardStore_->save(saveFilePath_, errorString);
+    }
+
+    // A single file has to hold the whole history, including shards not viewed yet
+    if (shardStore_ && !shardStore_->loadAll(errorString))
+    {
+        return false;
+    }
+
+    return TimelineSerializer::saveToFile(model_, saveFilePath_);
+}
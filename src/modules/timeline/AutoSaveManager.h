@@ -9,6 +9,8 @@
 
 
 class TimelineModel;
+class TimelineShardStore;
+class TimelineFileWatcher;
 
 
 /**
@@ -94,6 +96,24 @@ public:
         return saveFilePath_;
     }
 
+    /**
+     * @brief Route saves of sharded projects through a shard store
+     * @param store Store tracking the open project (not owned; nullptr = single-file saves only)
+     */
+    void setShardStore(TimelineShardStore* store)
+    {
+        shardStore_ = store;
+    }
+
+    /**
+     * @brief Refuse to save over a project file someone else changed since it was loaded or saved
+     * @param watcher Watcher of the open file (not owned; nullptr = no check)
+     */
+    void setFileWatcher(TimelineFileWatcher* watcher)
+    {
+        fileWatcher_ = watcher;
+    }
+
 public slots:
     /**
      * @brief Manually trigger save
@@ -139,9 +159,13 @@ private slots:
     void onModelChanged();
 
 private:
+    bool writeProject(QString* errorString);    ///< Write the model to saveFilePath_ in the layout its suffix selects
+
     TimelineModel* model_;              ///< Model to save (not owned)
     QString saveFilePath_;              ///< Path to save file
     QTimer* autoSaveTimer_;             ///< Timer for periodic saves
     bool hasUnsavedChanges_;            ///< Tracks if save is needed
     QDateTime lastSaveTime_;            ///< Timestamp of last successful save
+    TimelineShardStore* shardStore_ = nullptr;  ///< Sharded project state (not owned)
+    TimelineFileWatcher* fileWatcher_ = nullptr;    ///< Detects external changes to the project file (not owned)
 };
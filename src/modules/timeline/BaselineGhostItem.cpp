@@ -0,0 +1,145 @@
+// BaselineGhostItem.cpp
+
+
+#include "BaselineGhostItem.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QtMath>
+
+
+BaselineGhostItem::BaselineGhostItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , flags_(TimelineBaselineComparator::Unchanged)
+{
+    // Draw between marker lines (0) and event bars (10)
+    setZValue(5);
+    setAcceptedMouseButtons(Qt::NoButton);
+}
+
+
+QRectF BaselineGhostItem::boundingRect() const
+{
+    QRectF bounds = baselineRect_.isNull() ? liveRect_
+                    : liveRect_.isNull()   ? baselineRect_
+                                           : baselineRect_.united(liveRect_);
+
+    // Room for pen width, arrow head and the tag drawn above the live bar
+    return bounds.adjusted(-10, -18, 10, 10);
+}
+
+
+void BaselineGhostItem::setGhost(TimelineBaselineComparator::ChangeFlags flags,
+                                 const QRectF& baselineRect,
+                                 const QRectF& liveRect,
+                                 const QString& title)
+{
+    // Relayouts refresh every ghost; most of them have not moved
+    if (flags == flags_ && baselineRect == baselineRect_ && liveRect == liveRect_ && title == title_)
+    {
+        return;
+    }
+
+    prepareGeometryChange();
+
+    flags_ = flags;
+    baselineRect_ = baselineRect;
+    liveRect_ = liveRect;
+    title_ = title;
+
+    setToolTip(QString("Baseline: %1\n%2")
+                   .arg(title_)
+                   .arg(TimelineBaselineComparator::describeChange(flags_)));
+
+    update();
+}
+
+
+void BaselineGhostItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*option*/, QWidget* /*widget*/)
+{
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
+    const bool removed = flags_.testFlag(TimelineBaselineComparator::Removed);
+    const bool moved = flags_.testFlag(TimelineBaselineComparator::Slipped)
+                       || flags_.testFlag(TimelineBaselineComparator::Resized);
+
+    // ========== GHOST BAR ==========
+    if ((removed || moved) && !baselineRect_.isNull())
+    {
+        QColor outline = removed ? QColor(200, 40, 40) : QColor(90, 90, 90);
+
+        QPen ghostPen(outline, 1.5);
+        ghostPen.setStyle(Qt::DashLine);
+        painter->setPen(ghostPen);
+        painter->setBrush(QColor(outline.red(), outline.green(), outline.blue(), 40));
+        painter->drawRect(baselineRect_);
+
+        if (removed)
+        {
+            // Struck-through title so removed work is still identifiable
+            QFont font = painter->font();
+            font.setPointSize(8);
+            font.setStrikeOut(true);
+            painter->setFont(font);
+            painter->setPen(outline);
+
+            QString elided = painter->fontMetrics().elidedText(title_, Qt::ElideRight, qMax(0, int(baselineRect_.width()) - 6));
+            painter->drawText(baselineRect_.adjusted(3, 0, -3, 0), Qt::AlignVCenter | Qt::AlignLeft, elided);
+        }
+    }
+
+    // ========== SLIP ARROW ==========
+    if (moved && !baselineRect_.isNull() && !liveRect_.isNull())
+    {
+        // Slips track the start; pure resizes track the end
+        const bool slipped = flags_.testFlag(TimelineBaselineComparator::Slipped);
+        const double fromX = slipped ? baselineRect_.left() : baselineRect_.right();
+        const double toX = slipped ? liveRect_.left() : liveRect_.right();
+
+        if (!qFuzzyCompare(fromX + 1.0, toX + 1.0))
+        {
+            // Late = red, early = green
+            QColor arrowColor = toX > fromX ? QColor(200, 40, 40) : QColor(40, 150, 60);
+            const double y = baselineRect_.center().y();
+
+            painter->setPen(QPen(arrowColor, 2));
+            painter->drawLine(QPointF(fromX, y), QPointF(toX, y));
+
+            const double dir = toX > fromX ? -1.0 : 1.0;
+            const double head = qMin(6.0, qAbs(toX - fromX));
+
+            QPainterPath arrowHead;
+            arrowHead.moveTo(toX, y);
+            arrowHead.lineTo(toX + dir * head, y - head * 0.6);
+            arrowHead.lineTo(toX + dir * head, y + head * 0.6);
+            arrowHead.closeSubpath();
+
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(arrowColor);
+            painter->drawPath(arrowHead);
+        }
+    }
+
+    // ========== TAG (Added / Edited) ==========
+    if (!liveRect_.isNull()
+        && (flags_.testFlag(TimelineBaselineComparator::Added) || flags_.testFlag(TimelineBaselineComparator::Edited)))
+    {
+        const bool added = flags_.testFlag(TimelineBaselineComparator::Added);
+        const QString tag = added ? "NEW" : "EDITED";
+
+        QFont font = painter->font();
+        font.setPointSize(7);
+        font.setBold(true);
+        font.setStrikeOut(false);
+        painter->setFont(font);
+
+        QFontMetrics fm(font);
+        QRectF tagRect(liveRect_.left(), liveRect_.top() - fm.height() - 2, fm.horizontalAdvance(tag) + 8, fm.height() + 2);
+
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(added ? QColor(40, 150, 60, 220) : QColor(230, 140, 20, 220));
+        painter->drawRoundedRect(tagRect, 3, 3);
+
+        painter->setPen(Qt::white);
+        painter->drawText(tagRect, Qt::AlignCenter, tag);
+    }
+}
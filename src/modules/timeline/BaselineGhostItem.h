@@ -0,0 +1,45 @@
+// BaselineGhostItem.h
+
+
+#pragma once
+#include <QGraphicsItem>
+#include "TimelineBaselineComparator.h"
+
+
+/**
+ * @class BaselineGhostItem
+ * @brief Renders the baselined position of an event that moved or disappeared
+ *
+ * Draws a translucent dashed "ghost" bar where the event sat in the baseline and,
+ * for events that are still on the timeline, an arrow from the baseline bar to the
+ * live bar showing the direction and size of the slip. Added/edited events without
+ * a schedule change get a small tag at the live bar instead of a ghost.
+ *
+ * Geometry is supplied by TimelineScene, which owns the coordinate mapping.
+ */
+class BaselineGhostItem : public QGraphicsItem
+{
+public:
+    explicit BaselineGhostItem(QGraphicsItem* parent = nullptr);                                                   ///< @brief Construct an empty ghost
+
+    QRectF boundingRect() const override;                                                                           ///< @brief Bounding rect covering ghost bar, arrow and tag
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;      ///< @brief Paint ghost bar, slip arrow and tag
+
+    /**
+     * @brief Update the ghost from a diff record
+     * @param flags Change classification for the event
+     * @param baselineRect Scene rect of the baselined bar (empty for added events)
+     * @param liveRect Scene rect of the live bar (empty for removed events)
+     * @param title Event title (used for removed events and tooltip)
+     */
+    void setGhost(TimelineBaselineComparator::ChangeFlags flags,
+                  const QRectF& baselineRect,
+                  const QRectF& liveRect,
+                  const QString& title);
+
+private:
+    TimelineBaselineComparator::ChangeFlags flags_;     ///< Change classification
+    QRectF baselineRect_;                               ///< Baselined bar in scene coordinates
+    QRectF liveRect_;                                   ///< Live bar in scene coordinates
+    QString title_;                                     ///< Event title
+};
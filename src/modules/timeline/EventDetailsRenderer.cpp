@@ -0,0 +1,760 @@
+// EventDetailsRenderer.cpp
+
+
+#include "EventDetailsRenderer.h"
+#include <QDateTime>
+#include <QThread>
+#include <utility>
+
+
+EventDetailsRenderer::EventDetailsRenderer(QObject* parent)
+    : QObject(parent)
+{
+    cache_.setMaxCost(CACHE_CAPACITY);
+}
+
+
+EventDetailsRenderer::~EventDetailsRenderer()
+{
+    stopPrefetch();
+}
+
+
+QString EventDetailsRenderer::html(const TimelineEvent& event)
+{
+    const qint64 minute = currentMinute();
+
+    if (isCached(event, minute))
+    {
+        return cache_.object(event.id)->html;
+    }
+
+    RenderedHtml rendered{event.id, event.revision, minute, renderHtml(event)};
+    store(rendered);
+    return rendered.html;
+}
+
+
+void EventDetailsRenderer::prefetch(const QVector<TimelineEvent>& events)
+{
+    const qint64 minute = currentMinute();
+
+    QVector<TimelineEvent> missing;
+    for (const TimelineEvent& event : events)
+    {
+        if (event.revision != 0 && !isCached(event, minute))
+        {
+            missing.append(event);
+        }
+    }
+
+    if (missing.isEmpty())
+    {
+        return;
+    }
+
+    // One worker at a time; a newer request replaces any queued one
+    if (prefetchThread_)
+    {
+        pendingPrefetch_ = missing;
+        hasPendingPrefetch_ = true;
+        return;
+    }
+
+    startPrefetch(missing);
+}
+
+
+void EventDetailsRenderer::clear()
+{
+    cache_.clear();
+}
+
+
+bool EventDetailsRenderer::isCached(const TimelineEvent& event, qint64 minute) const
+{
+    if (event.revision == 0)
+    {
+        return false;
+    }
+
+    const CachedHtml* cached = cache_.object(event.id);
+    return cached && cached->revision == event.revision && cached->minute == minute;
+}
+
+
+void EventDetailsRenderer::store(const RenderedHtml& rendered)
+{
+    // Revision 0 means the event did not come from the model
+    if (rendered.revision == 0)
+    {
+        return;
+    }
+
+    // A prefetch may finish after the event was edited and rendered again
+    const CachedHtml* existing = cache_.object(rendered.eventId);
+    if (existing && (existing->revision > rendered.revision
+                     || (existing->revision == rendered.revision && existing->minute >= rendered.minute)))
+    {
+        return;
+    }
+
+    cache_.insert(rendered.eventId, new CachedHtml{rendered.revision, rendered.minute, rendered.html});
+}
+
+
+void EventDetailsRenderer::startPrefetch(const QVector<TimelineEvent>& events)
+{
+    prefetchCancelled_ = false;
+
+    const qint64 minute = currentMinute();
+
+    prefetchThread_ = QThread::create([this, events, minute]()
+    {
+        QVector<RenderedHtml> rendered;
+        rendered.reserve(events.size());
+
+        for (const TimelineEvent& event : events)
+        {
+            if (prefetchCancelled_)
+            {
+                return;
+            }
+            rendered.append(RenderedHtml{event.id, event.revision, minute, renderHtml(event)});
+        }
+
+        QMetaObject::invokeMethod(this, [this, rendered]() { applyPrefetched(rendered); }, Qt::QueuedConnection);
+    });
+
+    connect(prefetchThread_, &QThread::finished, this, &EventDetailsRenderer::onPrefetchFinished);
+    prefetchThread_->start(QThread::LowPriority);
+}
+
+
+void EventDetailsRenderer::applyPrefetched(const QVector<RenderedHtml>& rendered)
+{
+    for (const RenderedHtml& entry : rendered)
+    {
+        store(entry);
+    }
+}
+
+
+void EventDetailsRenderer::onPrefetchFinished()
+{
+    if (!prefetchThread_)
+    {
+        return;
+    }
+
+    prefetchThread_->deleteLater();
+    prefetchThread_ = nullptr;
+
+    if (hasPendingPrefetch_)
+    {
+        hasPendingPrefetch_ = false;
+        prefetch(std::exchange(pendingPrefetch_, {}));
+    }
+}
+
+
+void EventDetailsRenderer::stopPrefetch()
+{
+    hasPendingPrefetch_ = false;
+    pendingPrefetch_.clear();
+
+    if (!prefetchThread_)
+    {
+        return;
+    }
+
+    prefetchCancelled_ = true;
+    prefetchThread_->wait();
+    delete prefetchThread_;
+    prefetchThread_ = nullptr;
+}
+
+
+qint64 EventDetailsRenderer::currentMinute()
+{
+    return QDateTime::currentSecsSinceEpoch() / 60;
+}
+
+
+QString EventDetailsRenderer::renderHtml(const TimelineEvent& event)
+{
+    // Build details text starting with description, then type-specific info
+    QString detailsText;
+
+    // Description First (Common to all types)
+    if (!event.description.isEmpty())
+    {
+        detailsText = QString("<b>Description:</b><br>%1").arg(event.description);
+    }
+
+    // Type-Specific Fields
+    QString typeSpecificDetails;
+
+    switch (event.type)
+    {
+    case TimelineEventType_Meeting:     typeSpecificDetails = buildMeetingDetails(event);      break;
+    case TimelineEventType_Action:      typeSpecificDetails = buildActionDetails(event);       break;
+    case TimelineEventType_TestEvent:   typeSpecificDetails = buildTestEventDetails(event);    break;
+    case TimelineEventType_Reminder:    typeSpecificDetails = buildReminderDetails(event);     break;
+    case TimelineEventType_JiraTicket:  typeSpecificDetails = buildJiraTicketDetails(event);   break;
+    default:                            typeSpecificDetails = buildGenericDetails(event);      break;
+    }
+
+    // Combine description and type-specific details with proper spacing
+    if (!typeSpecificDetails.isEmpty())
+    {
+        if (!detailsText.isEmpty())
+        {
+            detailsText += "<br><br>";  // Add blank line between description and type-specific
+        }
+        detailsText += typeSpecificDetails;
+    }
+
+    return detailsText;
+}
+
+
+QString EventDetailsRenderer::buildMeetingDetails(const TimelineEvent& event)
+{
+    QString details;
+
+    // ========== DATE/TIME SECTION ==========
+    details += QString("<b>Date & Time:</b><br>");
+
+    // Check if all-day event (time is 00:00:00 to 23:59:59)
+    bool isAllDay = (event.startDate.time() == QTime(0, 0, 0) &&
+                     event.endDate.time() == QTime(23, 59, 59));
+
+    if (isAllDay)
+    {
+        details += QString("Start: %1 (All Day)<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"));
+        details += QString("End: %1 (All Day)<br>")
+                       .arg(event.endDate.toString("yyyy-MM-dd"));
+    }
+    else
+    {
+        details += QString("Start: %1 at %2<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"))
+            .arg(event.startDate.time().toString("HH:mm"));
+        details += QString("End: %1 at %2<br>")
+                       .arg(event.endDate.toString("yyyy-MM-dd"))
+                       .arg(event.endDate.time().toString("HH:mm"));
+    }
+
+    // Duration calculation
+    if (event.startDate.date() == event.endDate.date())
+    {
+        // Same day - calculate time duration
+        qint64 seconds = event.startDate.secsTo(event.endDate);
+        int hours = seconds / 3600;
+        int mins = (seconds % 3600) / 60;
+
+        if (hours > 0)
+        {
+            details += QString("Duration: %1h %2m<br>").arg(hours).arg(mins);
+        }
+        else
+        {
+            details += QString("Duration: %1m<br>").arg(mins);
+        }
+    }
+    else
+    {
+        // Multi-day event
+        int days = event.startDate.daysTo(event.endDate);
+        details += QString("Duration: %1 days<br>").arg(days + 1);
+    }
+
+    // ========== MEETING-SPECIFIC FIELDS ==========
+    if (!event.location.isEmpty() || !event.participants.isEmpty())
+    {
+        details += "<br>";  // Add spacing before next section
+    }
+
+    if (!event.location.isEmpty())
+    {
+        details += QString("<b>Location:</b><br>%1<br>").arg(event.location);
+    }
+
+    if (!event.participants.isEmpty())
+    {
+        if (!event.location.isEmpty())
+        {
+            details += "<br>";  // Spacing between location and participants
+        }
+        details += QString("<b>Participants:</b><br>%1<br>").arg(event.participants);
+    }
+
+    return details;
+}
+
+
+
+QString EventDetailsRenderer::buildActionDetails(const TimelineEvent& event)
+{
+    QString details;
+
+    // ========== DATE/TIME SECTION ==========
+    details += QString("<b>Date & Time:</b><br>");
+
+    // Check if all-day event
+    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
+
+    if (isStartAllDay)
+    {
+        details += QString("Start: %1 (All Day)<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"));
+    }
+    else
+    {
+        details += QString("Start: %1 at %2<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"))
+            .arg(event.startDate.time().toString("HH:mm"));
+    }
+
+    // Due Date/Time
+    if (event.dueDateTime.isValid())
+    {
+        // Check if due time is midnight (all-day)
+        bool isDueAllDay = (event.dueDateTime.time() == QTime(0, 0, 0) ||
+                            event.dueDateTime.time() == QTime(23, 59, 59));
+
+        if (isDueAllDay)
+        {
+            details += QString("Due: %1 (All Day)<br>")
+            .arg(event.dueDateTime.toString("yyyy-MM-dd"));
+        }
+        else
+        {
+            details += QString("Due: %1 at %2<br>")
+            .arg(event.dueDateTime.toString("yyyy-MM-dd"))
+                .arg(event.dueDateTime.time().toString("HH:mm"));
+        }
+    }
+
+    // ========== STATUS SECTION ==========
+    if (!event.status.isEmpty())
+    {
+        details += "<br>";  // Add spacing before status section
+
+        QString statusColor = "black";
+        if (event.status == "Completed")
+            statusColor = "green";
+        else if (event.status == "In Progress")
+            statusColor = "blue";
+        else if (event.status == "Blocked")
+            statusColor = "red";
+
+        details += QString("<b>Status:</b> <span style='color:%1;'>%2</span><br>")
+                       .arg(statusColor)
+                       .arg(event.status);
+    }
+
+    // ========== TIME TRACKING SECTION ==========
+    if (event.dueDateTime.isValid())
+    {
+        details += "<br>";  // Add spacing before time tracking
+
+        QDateTime now = QDateTime::currentDateTime();
+        qint64 secsRemaining = now.secsTo(event.dueDateTime);
+
+        if (secsRemaining > 0)
+        {
+            int days = secsRemaining / 86400;
+            int hours = (secsRemaining % 86400) / 3600;
+
+            if (days > 0)
+            {
+                details += QString("<b>Time Remaining:</b><br>%1 days, %2 hours<br>")
+                .arg(days)
+                    .arg(hours);
+            }
+            else if (hours > 0)
+            {
+                details += QString("<b>Time Remaining:</b><br>%1 hours<br>")
+                .arg(hours);
+            }
+            else
+            {
+                int mins = secsRemaining / 60;
+                details += QString("<b>Time Remaining:</b><br>%1 minutes<br>")
+                               .arg(mins);
+            }
+        }
+        else if (secsRemaining < 0)
+        {
+            int days = (-secsRemaining) / 86400;
+            int hours = ((-secsRemaining) % 86400) / 3600;
+
+            if (days > 0)
+            {
+                details += QString("<b style='color:red;'>Overdue By:</b><br>%1 days, %2 hours<br>")
+                .arg(days)
+                    .arg(hours);
+            }
+            else
+            {
+                details += QString("<b style='color:red;'>Overdue By:</b><br>%1 hours<br>")
+                .arg(hours);
+            }
+        }
+        else
+        {
+            details += QString("<b style='color:orange;'>Due Now!</b><br>");
+        }
+    }
+
+    return details;
+}
+
+
+QString EventDetailsRenderer::buildTestEventDetails(const TimelineEvent& event)
+{
+    QString details;
+
+    // ========== DATE/TIME SECTION ==========
+    details += QString("<b>Date & Time:</b><br>");
+
+    // Check if all-day events
+    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
+    bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
+
+    if (isStartAllDay && isEndAllDay)
+    {
+        details += QString("Start: %1 (All Day)<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"));
+        details += QString("End: %1 (All Day)<br>")
+                       .arg(event.endDate.toString("yyyy-MM-dd"));
+    }
+    else
+    {
+        details += QString("Start: %1 at %2<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"))
+            .arg(event.startDate.time().toString("HH:mm"));
+        details += QString("End: %1 at %2<br>")
+                       .arg(event.endDate.toString("yyyy-MM-dd"))
+                       .arg(event.endDate.time().toString("HH:mm"));
+    }
+
+    // Duration calculation
+    int durationDays = event.startDate.daysTo(event.endDate) + 1;
+    details += QString("Duration: %1 days<br>").arg(durationDays);
+
+    // ========== TEST-SPECIFIC FIELDS ==========
+    if (!event.testCategory.isEmpty())
+    {
+        details += "<br>";  // Add spacing before category section
+        details += QString("<b>Event Category:</b><br>%1<br>").arg(event.testCategory);
+    }
+
+    // ========== PROGRESS SECTION ==========
+    if (!event.preparationChecklist.isEmpty())
+    {
+        details += "<br>";  // Add spacing before progress section
+
+        int completedCount = 0;
+        int totalCount = event.preparationChecklist.size();
+
+        for (bool completed : event.preparationChecklist.values())
+        {
+            if (completed) completedCount++;
+        }
+
+        double percentage = (totalCount > 0) ? (completedCount * 100.0 / totalCount) : 0.0;
+
+        details += QString("<b>Preparation Progress:</b><br>%1 / %2 completed (%3%)<br>")
+                       .arg(completedCount)
+                       .arg(totalCount)
+                       .arg(QString::number(percentage, 'f', 0));
+    }
+
+    // ========== IMPORTED RESULTS SECTION ==========
+    if (event.hasTestResults())
+    {
+        details += "<br>";  // Add spacing before results section
+
+        QString outcomeColor = event.testsFailed > 0 ? "#DC322F"
+                               : (event.testsSkipped > 0 ? "#E6A100" : "#4CAF50");
+
+        details += QString("<b>Test Results:</b><br>");
+        details += QString("<span style='color:%1;'>%2 passed, %3 failed, %4 skipped</span><br>")
+                       .arg(outcomeColor)
+                       .arg(event.testsPassed)
+                       .arg(event.testsFailed)
+                       .arg(event.testsSkipped);
+        details += QString("Duration: %1 s<br>").arg(QString::number(event.testDurationSecs, 'f', 1));
+        details += QString("Imported: %1<br>").arg(event.testResultsImported.toString("yyyy-MM-dd HH:mm"));
+    }
+
+    return details;
+}
+
+
+QString EventDetailsRenderer::buildReminderDetails(const TimelineEvent& event)
+{
+    QString details;
+
+    // ========== REMINDER DATE/TIME SECTION ==========
+    if (event.reminderDateTime.isValid())
+    {
+        details += QString("<b>Reminder:</b><br>");
+        details += QString("%1 at %2<br>")
+                       .arg(event.reminderDateTime.toString("yyyy-MM-dd"))
+                       .arg(event.reminderDateTime.time().toString("HH:mm"));
+    }
+
+    // ========== EVENT DATE/TIME SECTION ==========
+    if (event.startDate.isValid() && event.endDate.isValid())
+    {
+        details += "<br>";  // Add spacing before event timeline section
+        details += QString("<b>Event Date & Time:</b><br>");
+
+        bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
+        bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
+
+        if (isStartAllDay && isEndAllDay)
+        {
+            details += QString("Start: %1 (All Day)<br>")
+            .arg(event.startDate.toString("yyyy-MM-dd"));
+            details += QString("End: %1 (All Day)<br>")
+                           .arg(event.endDate.toString("yyyy-MM-dd"));
+        }
+        else
+        {
+            details += QString("Start: %1 at %2<br>")
+            .arg(event.startDate.toString("yyyy-MM-dd"))
+                .arg(event.startDate.time().toString("HH:mm"));
+            details += QString("End: %1 at %2<br>")
+                           .arg(event.endDate.toString("yyyy-MM-dd"))
+                           .arg(event.endDate.time().toString("HH:mm"));
+        }
+
+        // Duration calculation
+        int durationDays = event.startDate.daysTo(event.endDate) + 1;
+        if (durationDays > 1)
+        {
+            details += QString("Duration: %1 days<br>").arg(durationDays);
+        }
+    }
+
+    // ========== RECURRENCE SECTION ==========
+    if (!event.recurringRule.isEmpty() && event.recurringRule != "None")
+    {
+        details += "<br>";  // Add spacing before recurrence section
+        details += QString("<b>Recurrence:</b><br>%1<br>").arg(event.recurringRule);
+    }
+
+    // ========== TIME TRACKING SECTION ==========
+    if (event.reminderDateTime.isValid())
+    {
+        details += "<br>";  // Add spacing before time tracking
+
+        QDateTime now = QDateTime::currentDateTime();
+        qint64 secsUntilReminder = now.secsTo(event.reminderDateTime);
+
+        if (secsUntilReminder > 0)
+        {
+            int days = secsUntilReminder / 86400;
+            int hours = (secsUntilReminder % 86400) / 3600;
+            int mins = ((secsUntilReminder % 86400) % 3600) / 60;
+
+            if (days > 0)
+            {
+                details += QString("<b>Time Until Reminder:</b><br>%1 days, %2 hours, %3 minutes<br>")
+                .arg(days)
+                    .arg(hours)
+                    .arg(mins);
+            }
+            else if (hours > 0)
+            {
+                details += QString("<b>Time Until Reminder:</b><br>%1 hours, %2 minutes<br>")
+                .arg(hours)
+                    .arg(mins);
+            }
+            else
+            {
+                details += QString("<b>Time Until Reminder:</b><br>%1 minutes<br>").arg(mins);
+            }
+        }
+        else if (secsUntilReminder < 0)
+        {
+            details += QString("<b style='color:red;'>Reminder Past Due</b><br>");
+        }
+        else
+        {
+            details += QString("<b style='color:orange;'>Reminder is NOW!</b><br>");
+        }
+    }
+
+    return details;
+}
+
+
+QString EventDetailsRenderer::buildJiraTicketDetails(const TimelineEvent& event)
+{
+    QString details;
+
+    // ========== DATE/TIME SECTION ==========
+    details += QString("<b>Date & Time:</b><br>");
+
+    // Check if all-day events
+    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
+    bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
+
+    if (isStartAllDay)
+    {
+        details += QString("Start: %1 (All Day)<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"));
+    }
+    else
+    {
+        details += QString("Start: %1 at %2<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"))
+            .arg(event.startDate.time().toString("HH:mm"));
+    }
+
+    if (isEndAllDay)
+    {
+        details += QString("Due: %1 (All Day)<br>")
+        .arg(event.endDate.toString("yyyy-MM-dd"));
+    }
+    else
+    {
+        details += QString("Due: %1 at %2<br>")
+        .arg(event.endDate.toString("yyyy-MM-dd"))
+            .arg(event.endDate.time().toString("HH:mm"));
+    }
+
+    // Duration calculation
+    int durationDays = event.startDate.daysTo(event.endDate) + 1;
+    details += QString("Duration: %1 days<br>").arg(durationDays);
+
+    // ========== JIRA-SPECIFIC FIELDS ==========
+    if (!event.jiraKey.isEmpty() || !event.jiraType.isEmpty())
+    {
+        details += "<br>";  // Add spacing before Jira section
+    }
+
+    if (!event.jiraKey.isEmpty())
+    {
+        details += QString("<b>Jira Key:</b> %1<br>").arg(event.jiraKey);
+    }
+
+    if (!event.jiraType.isEmpty())
+    {
+        QString typeIcon = "📝";
+        if (event.jiraType == "Bug")
+            typeIcon = "🐛";
+        else if (event.jiraType == "Story")
+            typeIcon = "📖";
+        else if (event.jiraType == "Epic")
+            typeIcon = "🎯";
+        else if (event.jiraType == "Task")
+            typeIcon = "✅";
+
+        if (!event.jiraKey.isEmpty())
+        {
+            details += "<br>";  // Spacing between key and type
+        }
+        details += QString("<b>Type:</b> %1 %2<br>").arg(typeIcon).arg(event.jiraType);
+    }
+
+    // ========== STATUS SECTION ==========
+    if (!event.jiraStatus.isEmpty())
+    {
+        details += "<br>";  // Add spacing before status section
+
+        QString statusColor = "black";
+        if (event.jiraStatus == "Done")
+            statusColor = "green";
+        else if (event.jiraStatus == "In Progress")
+            statusColor = "blue";
+
+        details += QString("<b>Status:</b> <span style='color:%1;'>%2</span><br>")
+                       .arg(statusColor)
+                       .arg(event.jiraStatus);
+    }
+
+    // ========== TIME TRACKING SECTION ==========
+    details += "<br>";  // Add spacing before time tracking
+
+    QDate today = QDate::currentDate();
+    int daysRemaining = today.daysTo(event.endDate.date());
+
+    if (daysRemaining > 0)
+    {
+        details += QString("<b>Days Remaining:</b> %1<br>").arg(daysRemaining);
+    }
+    else if (daysRemaining < 0)
+    {
+        details += QString("<b style='color:red;'>Overdue By:</b> %1 days<br>").arg(-daysRemaining);
+    }
+    else
+    {
+        details += QString("<b style='color:orange;'>Due Today!</b><br>");
+    }
+
+    return details;
+}
+
+
+QString EventDetailsRenderer::buildGenericDetails(const TimelineEvent& event)
+{
+    QString details;
+
+    // ========== DATE/TIME SECTION ==========
+    details += QString("<b>Date & Time:</b><br>");
+
+    // Check if all-day events
+    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
+    bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
+
+    if (isStartAllDay && isEndAllDay)
+    {
+        details += QString("Start: %1 (All Day)<br>")
+        .arg(event.startDate.toString("yyyy-MM-dd"));
+        details += QString("End: %1 (All Day)<br>")
+                       .arg(event.endDate.toString("yyyy-MM-dd"));
+    }
+    else
+    {
+        if (isStartAllDay)
+        {
+            details += QString("Start: %1 (All Day)<br>")
+            .arg(event.startDate.toString("yyyy-MM-dd"));
+        }
+        else
+        {
+            details += QString("Start: %1 at %2<br>")
+            .arg(event.startDate.toString("yyyy-MM-dd"))
+                .arg(event.startDate.time().toString("HH:mm"));
+        }
+
+        if (isEndAllDay)
+        {
+            details += QString("End: %1 (All Day)<br>")
+            .arg(event.endDate.toString("yyyy-MM-dd"));
+        }
+        else
+        {
+            details += QString("End: %1 at %2<br>")
+            .arg(event.endDate.toString("yyyy-MM-dd"))
+                .arg(event.endDate.time().toString("HH:mm"));
+        }
+    }
+
+    // Duration calculation
+    int durationDays = event.startDate.daysTo(event.endDate) + 1;
+    if (durationDays > 1)
+    {
+        details += QString("Duration: %1 days<br>").arg(durationDays);
+    }
+
+    return details;
+}
@@ -0,0 +1,79 @@
+// EventDetailsRenderer.h
+
+
+#pragma once
+#include "TimelineModel.h"
+#include <QObject>
+#include <QCache>
+#include <QVector>
+#include <atomic>
+
+
+class QThread;
+
+
+/**
+ * @class EventDetailsRenderer
+ * @brief Builds the rich-text details shown for an event and keeps recent results in an LRU
+ *
+ * Entries are keyed by event ID and are valid for one event revision within one
+ * wall-clock minute (the details contain due/reminder countdowns). prefetch() renders
+ * events on a worker thread - the side panel passes the list neighbours of the
+ * selection - so stepping through the list finds the HTML already built.
+ *
+ * The HTML is cached rather than laid-out QTextDocuments: layout has to happen on
+ * the GUI thread and QTextEdit::setHtml() lays out its own document anyway.
+ */
+class EventDetailsRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventDetailsRenderer(QObject* parent = nullptr);
+    ~EventDetailsRenderer() override;
+
+    QString html(const TimelineEvent& event);                       ///< Cached details HTML, rendered synchronously on a miss
+    void prefetch(const QVector<TimelineEvent>& events);            ///< Render uncached events in the background (latest request wins)
+    void clear();                                                   ///< Drop all cached HTML
+
+    static QString renderHtml(const TimelineEvent& event);          ///< Build details HTML (no shared state; safe on any thread)
+
+    static constexpr int CACHE_CAPACITY = 128;                      ///< Number of events kept in the LRU
+
+private:
+    struct CachedHtml
+    {
+        quint64 revision = 0;
+        qint64 minute = 0;
+        QString html;
+    };
+
+    struct RenderedHtml
+    {
+        QString eventId;
+        quint64 revision = 0;
+        qint64 minute = 0;
+        QString html;
+    };
+
+    bool isCached(const TimelineEvent& event, qint64 minute) const;
+    void store(const RenderedHtml& rendered);
+    void startPrefetch(const QVector<TimelineEvent>& events);
+    void applyPrefetched(const QVector<RenderedHtml>& rendered);
+    void onPrefetchFinished();
+    void stopPrefetch();
+    static qint64 currentMinute();
+
+    static QString buildMeetingDetails(const TimelineEvent& event);
+    static QString buildActionDetails(const TimelineEvent& event);
+    static QString buildTestEventDetails(const TimelineEvent& event);
+    static QString buildReminderDetails(const TimelineEvent& event);
+    static QString buildJiraTicketDetails(const TimelineEvent& event);
+    static QString buildGenericDetails(const TimelineEvent& event);
+
+    QCache<QString, CachedHtml> cache_;                 ///< LRU of rendered HTML by event ID
+    QThread* prefetchThread_ = nullptr;                 ///< Running prefetch worker (owned)
+    std::atomic_bool prefetchCancelled_ { false };      ///< Set to stop the worker early
+    QVector<TimelineEvent> pendingPrefetch_;            ///< Latest request made while a worker was running
+    bool hasPendingPrefetch_ = false;                   ///< pendingPrefetch_ holds a request
+};
@@ -288,7 +288,16 @@ void EventDetailsWidget::setupConnections()
     // Model signals
     if (model_) {
         connect(model_, &TimelineModel::eventUpdated, this, &EventDetailsWidget::onEventUpdatedInModel);
+        connect(model_, &TimelineModel::eventsUpdated, this, [this](const QStringList& eventIds) {
+            if (eventIds.contains(currentEventId_)) onEventUpdatedInModel(currentEventId_);
+        });
         connect(model_, &TimelineModel::eventRemoved, this, &EventDetailsWidget::onEventRemovedFromModel);
+        connect(model_, &TimelineModel::eventsRemoved, this, [this](const QStringList& eventIds) {
+            if (eventIds.contains(currentEventId_)) onEventRemovedFromModel(currentEventId_);
+        });
+        connect(model_, &TimelineModel::eventsArchived, this, [this](const QStringList& eventIds) {
+            if (eventIds.contains(currentEventId_)) onEventRemovedFromModel(currentEventId_);
+        });
     }
 
     // Focus events for auto-save
@@ -352,8 +361,7 @@ void EventDetailsWidget::displayEvent(const QString& eventId)
     updateFieldsFromEvent(*event);
 
     // Update attachments
-    attachmentWidget_->setEventId(eventId);
-    attachmentWidget_->refresh();
+    attachmentWidget_->setEventId(eventId);     // Refreshes the list
 
     // Update visibility
     setEditMode(false);
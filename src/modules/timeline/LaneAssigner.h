@@ -4,7 +4,9 @@
 #include <QDate>
 #include <QVector>
 #include <QMap>
+#include <QHash>
 #include <algorithm>
+#include <limits>
 
 /**
  * @class LaneAssigner
@@ -22,6 +24,10 @@
  * NON-OVERLAPPING and CAN share the same lane. This is by design - a date
  * boundary means the first event has ended and the second event begins.
  *
+ * assignLanesPrecise() packs at datetime precision instead: a 09:00-10:00 and a
+ * 14:00-15:00 meeting on the same day share a lane as long as the space between them
+ * is at least the requested minimum gap.
+ *
  * Usage:
  * @code
  *   QVector<LaneAssigner::EventData> events;
@@ -53,6 +59,31 @@ public:
         {}
     };
 
+    /**
+     * @brief Event data structure for datetime-precision lane assignment
+     *
+     * start/end are seconds on any common scale and form the half-open interval
+     * [start, end) actually drawn on the timeline.
+     */
+    struct TimedEventData
+    {
+        QString id;
+        qint64 start = 0;
+        qint64 end = 0;
+        bool dayAligned = false;    ///< Both edges on midnight (all-day style); day-aligned neighbours may touch without a gap
+        int lane = 0;               ///< Assigned lane (0 = top)
+        void* userData = nullptr;   ///< Optional pointer to original event object
+
+        TimedEventData() = default;
+        TimedEventData(const QString& id_, qint64 start_, qint64 end_, bool dayAligned_, void* user = nullptr)
+            : id(id_)
+            , start(start_)
+            , end(end_)
+            , dayAligned(dayAligned_)
+            , userData(user)
+        {}
+    };
+
     /**
      * @brief Assigns lanes to all events to prevent visual overlap
      * @param events Vector of events to assign lanes (modified in place)
@@ -216,6 +247,90 @@ public:
         return qMax(maxLane, maxReservedLane);
     }
 
+    /**
+     * @brief Assigns lanes at datetime precision while respecting reserved (manual) lanes
+     * @param events Events to assign lanes (modified in place)
+     * @param reservedEvents Events with manually-controlled lanes (read-only)
+     * @param minGap Minimum space between neighbours in a lane, in the same unit as start/end
+     *               (not applied between two day-aligned events, which may touch as before)
+     * @return Maximum lane number used
+     */
+    static int assignLanesPrecise(QVector<TimedEventData>& events,
+                                  const QVector<TimedEventData>& reservedEvents,
+                                  qint64 minGap)
+    {
+        int maxLane = 0;
+
+        QHash<int, QVector<const TimedEventData*>> reservedByLane;
+        for (const auto& reserved : reservedEvents)
+        {
+            reservedByLane[reserved.lane].append(&reserved);
+            maxLane = std::max(maxLane, reserved.lane);
+        }
+
+        // Earlier first; for equal starts the longer event goes first
+        std::sort(events.begin(), events.end(),
+                  [](const TimedEventData& a, const TimedEventData& b)
+                  {
+                      if (a.start != b.start)
+                          return a.start < b.start;
+                      return a.end > b.end;
+                  });
+
+        // End of the last automatic event in each lane (sorted input keeps it the latest)
+        QVector<qint64> laneEnd;
+        QVector<bool> laneEndDayAligned;
+
+        auto gapBetween = [minGap](bool aDayAligned, bool bDayAligned)
+        {
+            return (aDayAligned && bDayAligned) ? qint64(0) : minGap;
+        };
+
+        for (auto& event : events)
+        {
+            int lane = 0;
+
+            while (true)
+            {
+                bool laneAvailable = lane >= laneEnd.size()
+                                     || laneEnd[lane] + gapBetween(laneEndDayAligned[lane], event.dayAligned) <= event.start;
+
+                if (laneAvailable)
+                {
+                    for (const TimedEventData* reserved : reservedByLane.value(lane))
+                    {
+                        const qint64 gap = gapBetween(reserved->dayAligned, event.dayAligned);
+                        if (event.start < reserved->end + gap && reserved->start < event.end + gap)
+                        {
+                            laneAvailable = false;
+                            break;
+                        }
+                    }
+                }
+
+                if (laneAvailable)
+                {
+                    break;
+                }
+
+                ++lane;
+            }
+
+            if (lane >= laneEnd.size())
+            {
+                laneEnd.resize(lane + 1, std::numeric_limits<qint64>::min() / 2);
+                laneEndDayAligned.resize(lane + 1, false);
+            }
+
+            event.lane = lane;
+            laneEnd[lane] = event.end;
+            laneEndDayAligned[lane] = event.dayAligned;
+            maxLane = std::max(maxLane, lane);
+        }
+
+        return maxLane;
+    }
+
 private:
     /**
      * @brief Finds the lowest available lane for an event starting on given date
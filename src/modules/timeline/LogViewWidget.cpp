@@ -0,0 +1,268 @@
+// LogViewWidget.cpp
+
+
+#include "LogViewWidget.h"
+#include "MappedLogFile.h"
+#include <QPainter>
+#include <QScrollBar>
+#include <QFontDatabase>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QApplication>
+#include <QClipboard>
+#include <algorithm>
+#include <climits>
+
+
+LogViewWidget::LogViewWidget(QWidget* parent)
+    : QAbstractScrollArea(parent)
+{
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    setFont(font);
+
+    viewport()->setBackgroundRole(QPalette::Base);
+    viewport()->setAutoFillBackground(true);
+    setFocusPolicy(Qt::StrongFocus);
+
+    verticalScrollBar()->setSingleStep(1);
+    horizontalScrollBar()->setSingleStep(fontMetrics().horizontalAdvance(QLatin1Char('M')));
+}
+
+
+void LogViewWidget::setLogFile(MappedLogFile* logFile)
+{
+    logFile_ = logFile;
+    matchLines_.clear();
+    currentLine_ = -1;
+
+    verticalScrollBar()->setValue(0);
+    horizontalScrollBar()->setValue(0);
+    updateScrollRange();
+}
+
+
+void LogViewWidget::setMatchLines(const QVector<qint64>& lines)
+{
+    matchLines_ = lines;
+    viewport()->update();
+}
+
+
+void LogViewWidget::jumpToLine(qint64 line)
+{
+    if (!logFile_ || logFile_->lineCount() == 0)
+    {
+        return;
+    }
+
+    line = std::clamp<qint64>(line, 0, logFile_->lineCount() - 1);
+
+    const qint64 top = std::max<qint64>(0, line - visibleLineCount() / 2);
+    verticalScrollBar()->setValue(static_cast<int>(std::min<qint64>(top, INT_MAX)));
+    setCurrentLine(line);
+}
+
+
+qint64 LogViewWidget::firstVisibleLine() const
+{
+    return verticalScrollBar()->value();
+}
+
+
+void LogViewWidget::updateScrollRange()
+{
+    const qint64 lines = logFile_ ? logFile_->lineCount() : 0;
+    const int page = visibleLineCount();
+
+    // The scroll bar is int-based; two billion lines is far beyond anything mappable in practice
+    const qint64 maximum = std::clamp<qint64>(lines - page, 0, INT_MAX);
+    verticalScrollBar()->setRange(0, static_cast<int>(maximum));
+    verticalScrollBar()->setPageStep(std::max(1, page - 1));
+
+    const int charWidth = fontMetrics().horizontalAdvance(QLatin1Char('M'));
+    const int maxChars = logFile_ ? logFile_->maxLineLength() : 0;
+    const int textWidth = viewport()->width() - gutterWidth() - TEXT_MARGIN;
+    horizontalScrollBar()->setRange(0, std::max(0, maxChars * charWidth + TEXT_MARGIN - textWidth));
+    horizontalScrollBar()->setPageStep(std::max(1, textWidth));
+
+    viewport()->update();
+}
+
+
+void LogViewWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(viewport());
+    painter.setFont(font());
+
+    const int height = lineHeight();
+    const int gutter = gutterWidth();
+    const int ascent = fontMetrics().ascent();
+    const QRect area = viewport()->rect();
+
+    painter.fillRect(QRect(0, 0, gutter, area.height()), QColor(245, 245, 245));
+    painter.setPen(QColor(220, 220, 220));
+    painter.drawLine(gutter - 1, 0, gutter - 1, area.height());
+
+    if (!logFile_)
+    {
+        return;
+    }
+
+    const qint64 first = firstVisibleLine();
+    const qint64 last = std::min(logFile_->lineCount(), first + visibleLineCount() + 1);
+    const int textX = gutter + TEXT_MARGIN - horizontalScrollBar()->value();
+    const QRect textClip(gutter, 0, area.width() - gutter, area.height());
+
+    for (qint64 line = first; line < last; ++line)
+    {
+        const int y = static_cast<int>(line - first) * height;
+        const QRect row(gutter, y, area.width() - gutter, height);
+
+        if (line == currentLine_)
+        {
+            painter.fillRect(row, QColor(204, 232, 255));
+        }
+        else if (isMatchLine(line))
+        {
+            painter.fillRect(row, QColor(255, 243, 176));
+        }
+
+        painter.setClipping(false);
+        painter.setPen(QColor(140, 140, 140));
+        painter.drawText(QRect(0, y, gutter - TEXT_MARGIN, height), Qt::AlignRight | Qt::AlignVCenter,
+                         QString::number(line + 1));
+
+        painter.setClipRect(textClip);
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(textX, y + ascent, logFile_->lineText(line));
+    }
+}
+
+
+void LogViewWidget::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollRange();
+}
+
+
+void LogViewWidget::keyPressEvent(QKeyEvent* event)
+{
+    if (!logFile_ || logFile_->lineCount() == 0)
+    {
+        QAbstractScrollArea::keyPressEvent(event);
+        return;
+    }
+
+    if (event->matches(QKeySequence::Copy) && currentLine_ >= 0)
+    {
+        QApplication::clipboard()->setText(QString::fromUtf8(logFile_->lineBytes(currentLine_)));
+        return;
+    }
+
+    const qint64 lastLine = logFile_->lineCount() - 1;
+    const qint64 current = currentLine_ >= 0 ? currentLine_ : firstVisibleLine();
+
+    switch (event->key())
+    {
+    case Qt::Key_Up:
+        setCurrentLine(std::max<qint64>(0, current - 1));
+        break;
+    case Qt::Key_Down:
+        setCurrentLine(std::min(lastLine, current + 1));
+        break;
+    case Qt::Key_PageUp:
+        setCurrentLine(std::max<qint64>(0, current - visibleLineCount()));
+        break;
+    case Qt::Key_PageDown:
+        setCurrentLine(std::min(lastLine, current + visibleLineCount()));
+        break;
+    case Qt::Key_Home:
+        if (!(event->modifiers() & Qt::ControlModifier))
+        {
+            horizontalScrollBar()->setValue(0);
+            return;
+        }
+        setCurrentLine(0);
+        break;
+    case Qt::Key_End:
+        if (!(event->modifiers() & Qt::ControlModifier))
+        {
+            horizontalScrollBar()->setValue(horizontalScrollBar()->maximum());
+            return;
+        }
+        setCurrentLine(lastLine);
+        break;
+    default:
+        QAbstractScrollArea::keyPressEvent(event);
+        return;
+    }
+
+    // Keep the selected line on screen
+    const qint64 top = firstVisibleLine();
+    const int page = visibleLineCount();
+    if (currentLine_ < top)
+    {
+        verticalScrollBar()->setValue(static_cast<int>(currentLine_));
+    }
+    else if (currentLine_ >= top + page)
+    {
+        verticalScrollBar()->setValue(static_cast<int>(currentLine_ - page + 1));
+    }
+}
+
+
+void LogViewWidget::mousePressEvent(QMouseEvent* event)
+{
+    if (logFile_ && event->button() == Qt::LeftButton)
+    {
+        const qint64 line = firstVisibleLine() + static_cast<int>(event->position().y()) / lineHeight();
+        if (line < logFile_->lineCount())
+        {
+            setCurrentLine(line);
+        }
+    }
+
+    QAbstractScrollArea::mousePressEvent(event);
+}
+
+
+int LogViewWidget::visibleLineCount() const
+{
+    return std::max(1, viewport()->height() / lineHeight());
+}
+
+
+int LogViewWidget::gutterWidth() const
+{
+    const qint64 lines = logFile_ ? std::max<qint64>(1, logFile_->lineCount()) : 1;
+    const int digits = std::max(4, static_cast<int>(QString::number(lines).size()));
+    return digits * fontMetrics().horizontalAdvance(QLatin1Char('9')) + 2 * TEXT_MARGIN;
+}
+
+
+int LogViewWidget::lineHeight() const
+{
+    return std::max(1, fontMetrics().height());
+}
+
+
+bool LogViewWidget::isMatchLine(qint64 line) const
+{
+    return std::binary_search(matchLines_.cbegin(), matchLines_.cend(), line);
+}
+
+
+void LogViewWidget::setCurrentLine(qint64 line)
+{
+    if (line == currentLine_)
+    {
+        return;
+    }
+
+    currentLine_ = line;
+    viewport()->update();
+    emit currentLineChanged(line);
+}
@@ -0,0 +1,57 @@
+// LogViewWidget.h
+
+
+#pragma once
+#include <QAbstractScrollArea>
+#include <QVector>
+
+
+class MappedLogFile;
+
+
+/**
+ * @class LogViewWidget
+ * @brief Scroll area that paints only the visible lines of a MappedLogFile
+ *
+ * The vertical scroll bar works in whole lines, so each repaint decodes roughly one
+ * screen of text from the mapping regardless of file size. Line numbers are drawn in
+ * a gutter; search hits and the current line are highlighted.
+ */
+class LogViewWidget : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    explicit LogViewWidget(QWidget* parent = nullptr);
+
+    void setLogFile(MappedLogFile* logFile);                        ///< @brief Display a file (not owned)
+    void setMatchLines(const QVector<qint64>& lines);               ///< @brief Highlight sorted search hits
+    void jumpToLine(qint64 line);                                   ///< @brief Select a 0-based line and centre it
+    qint64 currentLine() const { return currentLine_; }             ///< @brief Selected 0-based line (-1 if none)
+    qint64 firstVisibleLine() const;                                ///< @brief Line at the top of the viewport
+
+signals:
+    void currentLineChanged(qint64 line);
+
+public slots:
+    void updateScrollRange();                                       ///< @brief Re-read line count (index grew)
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+
+private:
+    int visibleLineCount() const;
+    int gutterWidth() const;
+    int lineHeight() const;
+    bool isMatchLine(qint64 line) const;
+    void setCurrentLine(qint64 line);
+
+    MappedLogFile* logFile_ = nullptr;
+    QVector<qint64> matchLines_;        ///< Sorted line numbers with search hits
+    qint64 currentLine_ = -1;
+
+    static constexpr int TEXT_MARGIN = 6;
+};
@@ -0,0 +1,278 @@
+// LogViewerDialog.cpp
+
+
+#include "LogViewerDialog.h"
+#include "MappedLogFile.h"
+#include "LogViewWidget.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QLabel>
+#include <QShortcut>
+#include <QFileInfo>
+#include <QLocale>
+#include <QDebug>
+#include <algorithm>
+#include <climits>
+
+
+LogViewerDialog::LogViewerDialog(const QString& filePath, const QString& title, QWidget* parent)
+    : QDialog(parent)
+    , logFile_(new MappedLogFile(this))
+{
+    setAttribute(Qt::WA_DeleteOnClose);
+    setWindowFlags(windowFlags() | Qt::WindowMaximizeButtonHint | Qt::WindowMinimizeButtonHint);
+    setWindowTitle(QString("Log Viewer - %1").arg(title.isEmpty() ? QFileInfo(filePath).fileName() : title));
+    resize(1100, 700);
+
+    setupUI();
+
+    connect(logFile_, &MappedLogFile::indexProgress, this, &LogViewerDialog::onIndexProgress);
+    connect(logFile_, &MappedLogFile::indexFinished, this, &LogViewerDialog::onIndexFinished);
+    connect(logFile_, &MappedLogFile::searchFinished, this, &LogViewerDialog::onSearchFinished);
+
+    QString error;
+    if (!logFile_->open(filePath, &error))
+    {
+        qWarning() << "LogViewerDialog:" << error;
+        statusLabel_->setText(error);
+        return;
+    }
+
+    view_->setLogFile(logFile_);
+    statusLabel_->setText(QString("%1 - indexing...").arg(QLocale().formattedDataSize(logFile_->size())));
+}
+
+
+LogViewerDialog::~LogViewerDialog()
+{
+    // Stop worker threads before the view (which reads the mapping) goes away
+    logFile_->close();
+}
+
+
+bool LogViewerDialog::isValid() const
+{
+    return logFile_->isOpen();
+}
+
+
+void LogViewerDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(6, 6, 6, 6);
+    mainLayout->setSpacing(4);
+
+    // Search / navigation bar
+    QHBoxLayout* barLayout = new QHBoxLayout();
+    barLayout->setSpacing(5);
+
+    searchEdit_ = new QLineEdit();
+    searchEdit_->setPlaceholderText("Search (Ctrl+F)");
+    searchEdit_->setClearButtonEnabled(true);
+    barLayout->addWidget(searchEdit_, 1);
+
+    regexCheck_ = new QCheckBox("Regex");
+    barLayout->addWidget(regexCheck_);
+
+    caseCheck_ = new QCheckBox("Match case");
+    barLayout->addWidget(caseCheck_);
+
+    findButton_ = new QPushButton("Find");
+    findButton_->setEnabled(false);
+    barLayout->addWidget(findButton_);
+
+    previousButton_ = new QPushButton("◀");
+    previousButton_->setToolTip("Previous match (Shift+F3)");
+    previousButton_->setMaximumWidth(32);
+    previousButton_->setEnabled(false);
+    barLayout->addWidget(previousButton_);
+
+    nextButton_ = new QPushButton("▶");
+    nextButton_->setToolTip("Next match (F3)");
+    nextButton_->setMaximumWidth(32);
+    nextButton_->setEnabled(false);
+    barLayout->addWidget(nextButton_);
+
+    matchLabel_ = new QLabel();
+    matchLabel_->setMinimumWidth(140);
+    barLayout->addWidget(matchLabel_);
+
+    barLayout->addSpacing(12);
+    barLayout->addWidget(new QLabel("Line:"));
+
+    lineSpin_ = new QSpinBox();
+    lineSpin_->setRange(1, 1);
+    lineSpin_->setMinimumWidth(100);
+    barLayout->addWidget(lineSpin_);
+
+    goToButton_ = new QPushButton("Go");
+    barLayout->addWidget(goToButton_);
+
+    mainLayout->addLayout(barLayout);
+
+    view_ = new LogViewWidget();
+    mainLayout->addWidget(view_, 1);
+
+    statusLabel_ = new QLabel();
+    statusLabel_->setStyleSheet("QLabel { color: #666; font-size: 9pt; }");
+    mainLayout->addWidget(statusLabel_);
+
+    connect(findButton_, &QPushButton::clicked, this, &LogViewerDialog::onFindClicked);
+    connect(searchEdit_, &QLineEdit::returnPressed, this, &LogViewerDialog::onFindClicked);
+    connect(previousButton_, &QPushButton::clicked, this, &LogViewerDialog::onPreviousMatch);
+    connect(nextButton_, &QPushButton::clicked, this, &LogViewerDialog::onNextMatch);
+    connect(goToButton_, &QPushButton::clicked, this, &LogViewerDialog::onGoToLine);
+    connect(lineSpin_, &QSpinBox::editingFinished, this, &LogViewerDialog::onGoToLine);
+
+    connect(view_, &LogViewWidget::currentLineChanged, this, [this](qint64 line)
+    {
+        lineSpin_->blockSignals(true);
+        lineSpin_->setValue(static_cast<int>(std::min<qint64>(line + 1, INT_MAX)));
+        lineSpin_->blockSignals(false);
+    });
+
+    // Keyboard shortcuts
+    connect(new QShortcut(QKeySequence::Find, this), &QShortcut::activated, this, [this]()
+    {
+        searchEdit_->setFocus();
+        searchEdit_->selectAll();
+    });
+    connect(new QShortcut(QKeySequence(Qt::CTRL | Qt::Key_G), this), &QShortcut::activated, this, [this]()
+    {
+        lineSpin_->setFocus();
+        lineSpin_->selectAll();
+    });
+    connect(new QShortcut(QKeySequence::FindNext, this), &QShortcut::activated, this, &LogViewerDialog::onNextMatch);
+    connect(new QShortcut(QKeySequence::FindPrevious, this), &QShortcut::activated, this, &LogViewerDialog::onPreviousMatch);
+}
+
+
+// ============================================================================
+// Indexing
+// ============================================================================
+
+void LogViewerDialog::onIndexProgress(qint64 linesIndexed, int percent)
+{
+    view_->updateScrollRange();
+    lineSpin_->setMaximum(static_cast<int>(std::clamp<qint64>(linesIndexed, 1, INT_MAX)));
+
+    statusLabel_->setText(QString("%1 - indexing... %2% (%3 lines)")
+                              .arg(QLocale().formattedDataSize(logFile_->size()))
+                              .arg(percent)
+                              .arg(QLocale().toString(linesIndexed)));
+}
+
+
+void LogViewerDialog::onIndexFinished(qint64 lineCount)
+{
+    view_->updateScrollRange();
+    lineSpin_->setMaximum(static_cast<int>(std::clamp<qint64>(lineCount, 1, INT_MAX)));
+    findButton_->setEnabled(true);
+
+    statusLabel_->setText(QString("%1 - %2 lines")
+                              .arg(QLocale().formattedDataSize(logFile_->size()))
+                              .arg(QLocale().toString(lineCount)));
+}
+
+
+// ============================================================================
+// Search
+// ============================================================================
+
+void LogViewerDialog::onFindClicked()
+{
+    if (!findButton_->isEnabled())
+    {
+        return;
+    }
+
+    QString error;
+    if (!logFile_->startSearch(searchEdit_->text(), regexCheck_->isChecked(), caseCheck_->isChecked(), &error))
+    {
+        matchLabel_->setText(error);
+        return;
+    }
+
+    matches_.clear();
+    currentMatch_ = -1;
+    view_->setMatchLines(matches_);
+    previousButton_->setEnabled(false);
+    nextButton_->setEnabled(false);
+    matchLabel_->setText("Searching...");
+}
+
+
+void LogViewerDialog::onSearchFinished(const QVector<qint64>& lines, bool truncated)
+{
+    matches_ = lines;
+    matchesTruncated_ = truncated;
+    view_->setMatchLines(matches_);
+
+    const bool hasMatches = !matches_.isEmpty();
+    previousButton_->setEnabled(hasMatches);
+    nextButton_->setEnabled(hasMatches);
+
+    if (!hasMatches)
+    {
+        currentMatch_ = -1;
+        updateMatchLabel();
+        return;
+    }
+
+    // Start from the first hit at or below the current position
+    const qint64 from = std::max<qint64>(view_->currentLine(), 0);
+    auto it = std::lower_bound(matches_.cbegin(), matches_.cend(), from);
+    showMatch(it == matches_.cend() ? 0 : static_cast<int>(it - matches_.cbegin()));
+}
+
+
+void LogViewerDialog::onNextMatch()
+{
+    if (!matches_.isEmpty())
+    {
+        showMatch((currentMatch_ + 1) % matches_.size());
+    }
+}
+
+
+void LogViewerDialog::onPreviousMatch()
+{
+    if (!matches_.isEmpty())
+    {
+        showMatch(currentMatch_ <= 0 ? matches_.size() - 1 : currentMatch_ - 1);
+    }
+}
+
+
+void LogViewerDialog::showMatch(int index)
+{
+    currentMatch_ = index;
+    view_->jumpToLine(matches_[index]);
+    updateMatchLabel();
+}
+
+
+void LogViewerDialog::updateMatchLabel()
+{
+    if (matches_.isEmpty())
+    {
+        matchLabel_->setText("No matches");
+        return;
+    }
+
+    matchLabel_->setText(QString("%1 of %2%3")
+                             .arg(currentMatch_ + 1)
+                             .arg(QLocale().toString(matches_.size()))
+                             .arg(matchesTruncated_ ? "+" : ""));
+}
+
+
+void LogViewerDialog::onGoToLine()
+{
+    view_->jumpToLine(lineSpin_->value() - 1);
+    view_->setFocus();
+}
@@ -0,0 +1,82 @@
+// LogViewerDialog.h
+
+
+#pragma once
+#include <QDialog>
+#include <QVector>
+
+
+class MappedLogFile;
+class LogViewWidget;
+class QLineEdit;
+class QCheckBox;
+class QPushButton;
+class QSpinBox;
+class QLabel;
+
+
+/**
+ * @class LogViewerDialog
+ * @brief Non-modal viewer for large text/log attachments
+ *
+ * The file is memory-mapped by MappedLogFile and shown through LogViewWidget, so a
+ * multi-gigabyte log opens immediately and becomes fully navigable once the background
+ * line index completes.
+ *
+ * Features:
+ * - Jump to line (Ctrl+G)
+ * - Substring / regex search across all CPU cores (Ctrl+F, F3 / Shift+F3 to step through hits)
+ * - Ctrl+C copies the selected line
+ *
+ * The dialog deletes itself on close.
+ */
+class LogViewerDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Open a viewer for a file
+     * @param filePath File to map
+     * @param title Name shown in the window title (defaults to the file name)
+     * @param parent Parent window
+     */
+    explicit LogViewerDialog(const QString& filePath, const QString& title = QString(), QWidget* parent = nullptr);
+    ~LogViewerDialog() override;
+
+    bool isValid() const;                                   ///< @brief Whether the file could be mapped
+
+private slots:
+    void onIndexProgress(qint64 linesIndexed, int percent);
+    void onIndexFinished(qint64 lineCount);
+    void onFindClicked();
+    void onSearchFinished(const QVector<qint64>& lines, bool truncated);
+    void onNextMatch();
+    void onPreviousMatch();
+    void onGoToLine();
+
+private:
+    void setupUI();
+    void showMatch(int index);
+    void updateMatchLabel();
+
+    MappedLogFile* logFile_ = nullptr;
+    LogViewWidget* view_ = nullptr;
+
+    QLineEdit* searchEdit_ = nullptr;
+    QCheckBox* regexCheck_ = nullptr;
+    QCheckBox* caseCheck_ = nullptr;
+    QPushButton* findButton_ = nullptr;
+    QPushButton* previousButton_ = nullptr;
+    QPushButton* nextButton_ = nullptr;
+    QLabel* matchLabel_ = nullptr;
+
+    QSpinBox* lineSpin_ = nullptr;
+    QPushButton* goToButton_ = nullptr;
+
+    QLabel* statusLabel_ = nullptr;
+
+    QVector<qint64> matches_;           ///< Sorted matching line numbers
+    int currentMatch_ = -1;
+    bool matchesTruncated_ = false;
+};
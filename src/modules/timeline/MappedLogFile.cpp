@@ -0,0 +1,598 @@
+// MappedLogFile.cpp
+
+
+#include "MappedLogFile.h"
+#include <QFile>
+#include <QThread>
+#include <QByteArrayMatcher>
+#include <QRegularExpression>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    constexpr qint64 INDEX_PUBLISH_BYTES = 32 * 1024 * 1024;   // Publish partial index every 32 MB
+    constexpr qint64 SEARCH_WINDOW_BYTES = 16 * 1024 * 1024;   // Byte search polls cancellation per window
+    constexpr qint64 SEARCH_CANCEL_LINES = 4096;                // Line search polls cancellation per N lines
+
+    inline const char* findNewline(const char* from, qint64 length)
+    {
+        return static_cast<const char*>(std::memchr(from, '\n', static_cast<size_t>(length)));
+    }
+}
+
+
+MappedLogFile::MappedLogFile(QObject* parent)
+    : QObject(parent)
+{
+}
+
+
+MappedLogFile::~MappedLogFile()
+{
+    close();
+}
+
+
+// ============================================================================
+// Open / Close
+// ============================================================================
+
+bool MappedLogFile::open(const QString& filePath, QString* errorString)
+{
+    close();
+
+    file_ = std::make_unique<QFile>(filePath);
+    if (!file_->open(QIODevice::ReadOnly))
+    {
+        if (errorString)
+        {
+            *errorString = QString("Cannot open %1: %2").arg(filePath, file_->errorString());
+        }
+        file_.reset();
+        return false;
+    }
+
+    filePath_ = filePath;
+    size_ = file_->size();
+
+    if (size_ == 0)
+    {
+        // Nothing to map; report an empty, complete index once the caller has connected
+        indexComplete_ = true;
+        const quint64 session = session_;
+        QMetaObject::invokeMethod(this, [this, session]()
+        {
+            if (session == session_)
+            {
+                emit indexFinished(0);
+            }
+        }, Qt::QueuedConnection);
+        return true;
+    }
+
+    uchar* mapped = file_->map(0, size_);
+    if (!mapped)
+    {
+        if (errorString)
+        {
+            *errorString = QString("Cannot map %1 into memory: %2").arg(filePath, file_->errorString());
+        }
+        close();
+        return false;
+    }
+
+    data_ = reinterpret_cast<const char*>(mapped);
+    checkpoints_.append(0);
+
+    startIndexing();
+    return true;
+}
+
+
+void MappedLogFile::close()
+{
+    cancelSearch();
+    stopIndexing();
+    ++session_;
+
+    if (file_)
+    {
+        if (data_)
+        {
+            file_->unmap(reinterpret_cast<uchar*>(const_cast<char*>(data_)));
+        }
+        file_->close();
+        file_.reset();
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    filePath_.clear();
+    checkpoints_.clear();
+    lineCount_ = 0;
+    maxLineLength_ = 0;
+    indexComplete_ = false;
+}
+
+
+// ============================================================================
+// Line Index
+// ============================================================================
+
+void MappedLogFile::startIndexing()
+{
+    indexCancelled_ = false;
+
+    const quint64 session = session_;
+    const char* data = data_;
+    const qint64 size = size_;
+
+    indexThread_ = QThread::create([this, session, data, size]()
+    {
+        scanIndex(data, size, &indexCancelled_, [this, session](const IndexChunk& chunk)
+        {
+            QMetaObject::invokeMethod(this, [this, session, chunk]() { applyIndexChunk(session, chunk); }, Qt::QueuedConnection);
+        });
+    });
+
+    indexThread_->start(QThread::LowPriority);
+}
+
+
+void MappedLogFile::stopIndexing()
+{
+    if (!indexThread_)
+    {
+        return;
+    }
+
+    indexCancelled_ = true;
+    indexThread_->wait();
+    delete indexThread_;
+    indexThread_ = nullptr;
+}
+
+
+void MappedLogFile::scanIndex(const char* data, qint64 size, const std::atomic_bool* cancelFlag,
+                              const std::function<void(const IndexChunk&)>& publish)
+{
+    IndexChunk chunk;
+    qint64 lines = 0;
+    qint64 pos = 0;
+    qint64 nextPublish = INDEX_PUBLISH_BYTES;
+
+    while (pos < size)
+    {
+        if (cancelFlag && *cancelFlag)
+        {
+            return;
+        }
+
+        const char* newline = findNewline(data + pos, size - pos);
+        const qint64 lineEnd = newline ? (newline - data) : size;
+
+        chunk.maxLineLength = static_cast<int>(std::max<qint64>(chunk.maxLineLength,
+                                                                std::min<qint64>(lineEnd - pos, MAX_DISPLAY_BYTES)));
+        ++lines;    // Also counts a final line without terminator
+        pos = lineEnd + 1;
+
+        if (pos >= size)
+        {
+            break;
+        }
+
+        if (lines % CHECKPOINT_STRIDE == 0)
+        {
+            chunk.checkpoints.append(pos);
+        }
+
+        if (pos >= nextPublish)
+        {
+            chunk.lineCount = lines;
+            chunk.bytesScanned = pos;
+            publish(chunk);
+
+            chunk.checkpoints.clear();
+            nextPublish = pos + INDEX_PUBLISH_BYTES;
+        }
+    }
+
+    chunk.lineCount = lines;
+    chunk.bytesScanned = size;
+    chunk.finished = true;
+    publish(chunk);
+}
+
+
+void MappedLogFile::applyIndexChunk(quint64 session, const IndexChunk& chunk)
+{
+    if (session != session_)
+    {
+        return;     // Chunk from a file that has since been closed
+    }
+
+    checkpoints_ += chunk.checkpoints;
+    lineCount_ = chunk.lineCount;
+    maxLineLength_ = std::max(maxLineLength_, chunk.maxLineLength);
+
+    if (!chunk.finished)
+    {
+        emit indexProgress(lineCount_, static_cast<int>(chunk.bytesScanned * 100 / size_));
+        return;
+    }
+
+    indexComplete_ = true;
+    stopIndexing();
+
+    qDebug() << "MappedLogFile: Indexed" << lineCount_ << "lines of" << filePath_;
+
+    emit indexProgress(lineCount_, 100);
+    emit indexFinished(lineCount_);
+}
+
+
+QByteArrayView MappedLogFile::lineBytes(qint64 line) const
+{
+    if (!data_ || line < 0 || line >= lineCount_)
+    {
+        return {};
+    }
+
+    qint64 pos = checkpoints_[line / CHECKPOINT_STRIDE];
+
+    for (qint64 skip = line % CHECKPOINT_STRIDE; skip > 0; --skip)
+    {
+        const char* newline = findNewline(data_ + pos, size_ - pos);
+        if (!newline)
+        {
+            return {};
+        }
+        pos = (newline - data_) + 1;
+    }
+
+    const char* newline = findNewline(data_ + pos, size_ - pos);
+    qint64 end = newline ? (newline - data_) : size_;
+
+    if (end > pos && data_[end - 1] == '\r')
+    {
+        --end;
+    }
+
+    return QByteArrayView(data_ + pos, end - pos);
+}
+
+
+QString MappedLogFile::lineText(qint64 line) const
+{
+    const QByteArrayView bytes = lineBytes(line);
+    const bool truncated = bytes.size() > MAX_DISPLAY_BYTES;
+
+    QString text = QString::fromUtf8(truncated ? bytes.first(MAX_DISPLAY_BYTES) : bytes);
+    text.replace(QLatin1Char('\t'), QLatin1String("    "));
+
+    if (truncated)
+    {
+        text += QStringLiteral(" …");
+    }
+
+    return text;
+}
+
+
+qint64 MappedLogFile::lineForOffset(qint64 offset) const
+{
+    if (!data_ || checkpoints_.isEmpty())
+    {
+        return 0;
+    }
+
+    offset = std::clamp<qint64>(offset, 0, size_);
+
+    auto it = std::upper_bound(checkpoints_.cbegin(), checkpoints_.cend(), offset);
+    const qint64 checkpoint = (it - checkpoints_.cbegin()) - 1;
+
+    qint64 line = checkpoint * CHECKPOINT_STRIDE;
+    qint64 pos = checkpoints_[checkpoint];
+
+    while (pos < offset)
+    {
+        const char* newline = findNewline(data_ + pos, offset - pos);
+        if (!newline)
+        {
+            break;
+        }
+        ++line;
+        pos = (newline - data_) + 1;
+    }
+
+    return line;
+}
+
+
+// ============================================================================
+// Search
+// ============================================================================
+
+bool MappedLogFile::startSearch(const QString& pattern, bool isRegex, bool caseSensitive, QString* errorString)
+{
+    auto fail = [errorString](const QString& message)
+    {
+        if (errorString)
+        {
+            *errorString = message;
+        }
+        return false;
+    };
+
+    if (!file_)
+    {
+        return fail("No file is open");
+    }
+    if (!indexComplete_)
+    {
+        return fail("The line index is still being built");
+    }
+    if (pattern.isEmpty())
+    {
+        return fail("Search pattern is empty");
+    }
+
+    cancelSearch();
+
+    // Case-sensitive plain text is matched on raw bytes; everything else goes through a regex
+    QByteArray needle;
+    QRegularExpression expression;
+
+    if (isRegex || !caseSensitive)
+    {
+        expression.setPattern(isRegex ? pattern : QRegularExpression::escape(pattern));
+        expression.setPatternOptions(caseSensitive ? QRegularExpression::NoPatternOption
+                                                   : QRegularExpression::CaseInsensitiveOption);
+        if (!expression.isValid())
+        {
+            return fail(QString("Invalid regular expression: %1").arg(expression.errorString()));
+        }
+        expression.optimize();
+    }
+    else
+    {
+        needle = pattern.toUtf8();
+    }
+
+    const quint64 generation = ++searchGeneration_;
+
+    if (size_ == 0)
+    {
+        QMetaObject::invokeMethod(this, [this, generation]() { applySearchResults(generation, {}, false); }, Qt::QueuedConnection);
+        return true;
+    }
+
+    searchCancelled_ = false;
+
+    const QVector<qint64> bounds = chunkBoundaries(std::max(1, QThread::idealThreadCount()));
+    const char* data = data_;
+    const std::atomic_bool* cancelFlag = &searchCancelled_;
+
+    searchThread_ = QThread::create([this, data, bounds, needle, expression, generation, cancelFlag]()
+    {
+        const int chunks = bounds.size() - 1;
+        QVector<QVector<qint64>> partial(chunks);
+        QVector<QThread*> workers;
+        workers.reserve(chunks);
+
+        for (int i = 0; i < chunks; ++i)
+        {
+            const qint64 begin = bounds[i];
+            const qint64 end = bounds[i + 1];
+            QVector<qint64>* result = &partial[i];
+
+            QThread* worker = QThread::create([data, begin, end, needle, expression, cancelFlag, result]()
+            {
+                *result = needle.isEmpty() ? searchLines(data, begin, end, expression, cancelFlag)
+                                           : searchBytes(data, begin, end, needle, cancelFlag);
+            });
+            worker->start();
+            workers.append(worker);
+        }
+
+        for (QThread* worker : workers)
+        {
+            worker->wait();
+            delete worker;
+        }
+
+        if (*cancelFlag)
+        {
+            return;
+        }
+
+        // Chunks are in file order, so concatenation keeps the offsets sorted
+        QVector<qint64> offsets;
+        bool truncated = false;
+
+        for (const QVector<qint64>& chunk : partial)
+        {
+            if (chunk.size() >= MAX_SEARCH_RESULTS)
+            {
+                truncated = true;
+            }
+
+            const qsizetype room = MAX_SEARCH_RESULTS - offsets.size();
+            if (chunk.size() > room)
+            {
+                offsets += chunk.mid(0, room);
+                truncated = true;
+                break;
+            }
+            offsets += chunk;
+        }
+
+        QMetaObject::invokeMethod(this, [this, generation, offsets, truncated]()
+        {
+            applySearchResults(generation, offsets, truncated);
+        }, Qt::QueuedConnection);
+    });
+
+    searchThread_->start(QThread::LowPriority);
+    return true;
+}
+
+
+void MappedLogFile::cancelSearch()
+{
+    ++searchGeneration_;
+
+    if (!searchThread_)
+    {
+        return;
+    }
+
+    searchCancelled_ = true;
+    searchThread_->wait();
+    delete searchThread_;
+    searchThread_ = nullptr;
+}
+
+
+void MappedLogFile::applySearchResults(quint64 generation, const QVector<qint64>& offsets, bool truncated)
+{
+    if (generation != searchGeneration_)
+    {
+        return;     // Superseded or cancelled
+    }
+
+    if (searchThread_)
+    {
+        searchThread_->wait();
+        delete searchThread_;
+        searchThread_ = nullptr;
+    }
+
+    QVector<qint64> lines;
+    lines.reserve(offsets.size());
+    for (qint64 offset : offsets)
+    {
+        lines.append(lineForOffset(offset));
+    }
+
+    emit searchFinished(lines, truncated);
+}
+
+
+QVector<qint64> MappedLogFile::chunkBoundaries(int chunks) const
+{
+    // Split at line starts so no line is shared between two workers
+    QVector<qint64> bounds;
+    bounds.append(0);
+
+    for (int i = 1; i < chunks; ++i)
+    {
+        qint64 pos = size_ * i / chunks;
+
+        if (pos <= bounds.last())
+        {
+            continue;
+        }
+
+        if (data_[pos - 1] != '\n')
+        {
+            const char* newline = findNewline(data_ + pos, size_ - pos);
+            pos = newline ? (newline - data_) + 1 : size_;
+        }
+
+        if (pos > bounds.last() && pos < size_)
+        {
+            bounds.append(pos);
+        }
+    }
+
+    bounds.append(size_);
+    return bounds;
+}
+
+
+QVector<qint64> MappedLogFile::searchBytes(const char* data, qint64 begin, qint64 end,
+                                           const QByteArray& needle, const std::atomic_bool* cancelFlag)
+{
+    QVector<qint64> lineStarts;
+    const QByteArrayMatcher matcher(needle);
+    const qint64 overlap = needle.size() - 1;
+
+    qint64 pos = begin;
+
+    while (pos < end && lineStarts.size() < MAX_SEARCH_RESULTS)
+    {
+        if (cancelFlag && *cancelFlag)
+        {
+            return {};
+        }
+
+        // Windows overlap by needle length - 1 so matches across a window edge are found
+        const qint64 windowEnd = std::min(end, pos + SEARCH_WINDOW_BYTES + overlap);
+        const qsizetype hit = matcher.indexIn(data + pos, windowEnd - pos);
+
+        if (hit < 0)
+        {
+            if (windowEnd == end)
+            {
+                break;
+            }
+            pos = windowEnd - overlap;
+            continue;
+        }
+
+        const qint64 matchAt = pos + hit;
+
+        qint64 lineStart = matchAt;
+        while (lineStart > begin && data[lineStart - 1] != '\n')
+        {
+            --lineStart;
+        }
+        lineStarts.append(lineStart);
+
+        // One hit per line: continue after the end of the matching line
+        const char* newline = findNewline(data + matchAt, end - matchAt);
+        pos = newline ? (newline - data) + 1 : end;
+    }
+
+    return lineStarts;
+}
+
+
+QVector<qint64> MappedLogFile::searchLines(const char* data, qint64 begin, qint64 end,
+                                           const QRegularExpression& expression, const std::atomic_bool* cancelFlag)
+{
+    QVector<qint64> lineStarts;
+    qint64 pos = begin;
+    qint64 linesScanned = 0;
+
+    while (pos < end && lineStarts.size() < MAX_SEARCH_RESULTS)
+    {
+        if (++linesScanned % SEARCH_CANCEL_LINES == 0 && cancelFlag && *cancelFlag)
+        {
+            return {};
+        }
+
+        const char* newline = findNewline(data + pos, end - pos);
+        const qint64 lineEnd = newline ? (newline - data) : end;
+
+        qint64 textEnd = lineEnd;
+        if (textEnd > pos && data[textEnd - 1] == '\r')
+        {
+            --textEnd;
+        }
+
+        const QString line = QString::fromUtf8(data + pos, textEnd - pos);
+        if (expression.match(line).hasMatch())
+        {
+            lineStarts.append(pos);
+        }
+
+        pos = lineEnd + 1;
+    }
+
+    return lineStarts;
+}
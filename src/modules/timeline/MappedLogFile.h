@@ -0,0 +1,123 @@
+// MappedLogFile.h
+
+
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+#include <QByteArrayView>
+#include <memory>
+#include <atomic>
+#include <functional>
+
+
+class QFile;
+class QThread;
+class QRegularExpression;
+
+
+/**
+ * @class MappedLogFile
+ * @brief Read-only memory mapping of a (potentially multi-gigabyte) text file with a sparse line index
+ *
+ * The whole file is mapped with QFile::map(), so nothing is copied into the heap. A worker
+ * thread scans the mapping with memchr() and records the byte offset of every
+ * CHECKPOINT_STRIDE-th line; partial results are published while the scan runs, so the
+ * first screens can be shown immediately. Any line is then located by jumping to its
+ * checkpoint and skipping at most CHECKPOINT_STRIDE - 1 newlines.
+ *
+ * Searching splits the mapping into line-aligned chunks, one per hardware thread:
+ * - Case-sensitive plain text is matched on raw UTF-8 bytes (QByteArrayMatcher)
+ * - Regex and case-insensitive text decode each line and use QRegularExpression
+ * Results are reported as sorted line numbers once all chunks finish.
+ *
+ * All public methods must be called from the GUI thread.
+ */
+class MappedLogFile : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 CHECKPOINT_STRIDE = 64;         ///< Lines between index checkpoints
+    static constexpr int MAX_DISPLAY_BYTES = 4096;          ///< Bytes of a line decoded for display
+    static constexpr int MAX_SEARCH_RESULTS = 100000;       ///< Matching lines kept per search
+
+    explicit MappedLogFile(QObject* parent = nullptr);
+    ~MappedLogFile() override;
+
+    bool open(const QString& filePath, QString* errorString = nullptr);    ///< @brief Map the file and start indexing
+    void close();                                                           ///< @brief Stop workers and unmap
+
+    bool isOpen() const { return file_ != nullptr; }                ///< @brief Whether a file is mapped
+    QString filePath() const { return filePath_; }                  ///< @brief Path of the mapped file
+    qint64 size() const { return size_; }                           ///< @brief File size in bytes
+
+    qint64 lineCount() const { return lineCount_; }                 ///< @brief Lines indexed so far
+    bool isIndexComplete() const { return indexComplete_; }         ///< @brief Whether lineCount() is final
+    int maxLineLength() const { return maxLineLength_; }            ///< @brief Longest line seen (capped at MAX_DISPLAY_BYTES)
+
+    QByteArrayView lineBytes(qint64 line) const;                    ///< @brief Raw bytes of a line without the line terminator
+    QString lineText(qint64 line) const;                            ///< @brief Decoded line (tabs expanded, truncated for display)
+    qint64 lineForOffset(qint64 offset) const;                      ///< @brief Line containing a byte offset
+
+    /**
+     * @brief Search the whole file on worker threads
+     * @param pattern Text or regular expression
+     * @param isRegex Treat pattern as a QRegularExpression
+     * @param caseSensitive Match case
+     * @param errorString Optional output: reason the search could not start
+     * @return false if the index is not complete or the pattern is invalid
+     *
+     * A running search is cancelled first. Emits searchFinished() when done.
+     */
+    bool startSearch(const QString& pattern, bool isRegex, bool caseSensitive, QString* errorString = nullptr);
+    void cancelSearch();                                            ///< @brief Abort the running search (no signal is emitted)
+    bool isSearching() const { return searchThread_ != nullptr; }
+
+signals:
+    void indexProgress(qint64 linesIndexed, int percent);           ///< @brief More lines are available
+    void indexFinished(qint64 lineCount);                           ///< @brief Index is complete
+    void searchFinished(const QVector<qint64>& lines, bool truncated);  ///< @brief Sorted matching line numbers
+
+private:
+    struct IndexChunk
+    {
+        QVector<qint64> checkpoints;    ///< New checkpoint offsets since the last chunk
+        qint64 lineCount = 0;           ///< Complete lines so far
+        int maxLineLength = 0;
+        qint64 bytesScanned = 0;
+        bool finished = false;
+    };
+
+    void startIndexing();
+    void applyIndexChunk(quint64 session, const IndexChunk& chunk);
+    void applySearchResults(quint64 generation, const QVector<qint64>& offsets, bool truncated);
+    void stopIndexing();
+    QVector<qint64> chunkBoundaries(int chunks) const;
+
+    static void scanIndex(const char* data, qint64 size, const std::atomic_bool* cancelFlag,
+                          const std::function<void(const IndexChunk&)>& publish);
+    static QVector<qint64> searchBytes(const char* data, qint64 begin, qint64 end,
+                                       const QByteArray& needle, const std::atomic_bool* cancelFlag);
+    static QVector<qint64> searchLines(const char* data, qint64 begin, qint64 end,
+                                       const QRegularExpression& expression, const std::atomic_bool* cancelFlag);
+
+    std::unique_ptr<QFile> file_;
+    QString filePath_;
+    const char* data_ = nullptr;
+    qint64 size_ = 0;
+
+    QVector<qint64> checkpoints_;       ///< Byte offset of line k * CHECKPOINT_STRIDE
+    qint64 lineCount_ = 0;
+    int maxLineLength_ = 0;
+    bool indexComplete_ = false;
+
+    QThread* indexThread_ = nullptr;
+    std::atomic_bool indexCancelled_ { false };
+    quint64 session_ = 0;               ///< Bumped on every open/close to drop stale index chunks
+
+    QThread* searchThread_ = nullptr;
+    std::atomic_bool searchCancelled_ { false };
+    quint64 searchGeneration_ = 0;      ///< Bumped on every search to drop stale results
+};
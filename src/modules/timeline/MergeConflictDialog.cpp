@@ -0,0 +1,98 @@
+// MergeConflictDialog.cpp
+
+
+#include "MergeConflictDialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QDialogButtonBox>
+#include <QLabel>
+#include <QFileInfo>
+
+
+MergeConflictDialog::MergeConflictDialog(const TimelineMergePlan& plan, const QString& filePath, QWidget* parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Resolve Conflicting Changes");
+    resize(900, 450);
+
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+
+    QLabel* explanation = new QLabel(
+        QString("<b>%1</b> was changed by someone else. Their other changes have been merged; "
+                "the %2 event(s) below were changed on both sides.<br>"
+                "Check an event to take the version on disk, leave it unchecked to keep yours.")
+            .arg(QFileInfo(filePath).fileName().toHtmlEscaped())
+            .arg(plan.conflicts.size()));
+    explanation->setWordWrap(true);
+    mainLayout->addWidget(explanation);
+
+    tree_ = new QTreeWidget();
+    tree_->setColumnCount(2);
+    tree_->setHeaderLabels({ "Your version", "Version on disk" });
+    tree_->setRootIsDecorated(false);
+    tree_->setAlternatingRowColors(true);
+    tree_->header()->setSectionResizeMode(QHeaderView::Stretch);
+
+    for (const TimelineMergeConflict& conflict : plan.conflicts)
+    {
+        QTreeWidgetItem* item = new QTreeWidgetItem(tree_);
+        item->setText(COLUMN_LOCAL, conflict.hasLocal ? TimelineMerge::describe(conflict.local) : "(deleted)");
+        item->setText(COLUMN_REMOTE, conflict.hasRemote ? TimelineMerge::describe(conflict.remote) : "(deleted)");
+        item->setToolTip(COLUMN_LOCAL, conflict.hasLocal ? conflict.local.description : QString());
+        item->setToolTip(COLUMN_REMOTE, conflict.hasRemote ? conflict.remote.description : QString());
+        item->setData(COLUMN_LOCAL, Qt::UserRole, conflict.eventId);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(COLUMN_REMOTE, Qt::Unchecked);
+    }
+
+    mainLayout->addWidget(tree_, 1);
+
+    // Bulk choices
+    QHBoxLayout* bulkLayout = new QHBoxLayout();
+
+    QPushButton* keepAllButton = new QPushButton("Keep All Mine");
+    connect(keepAllButton, &QPushButton::clicked, this, [this]() { setAllTakeRemote(false); });
+    bulkLayout->addWidget(keepAllButton);
+
+    QPushButton* takeAllButton = new QPushButton("Take All From Disk");
+    connect(takeAllButton, &QPushButton::clicked, this, [this]() { setAllTakeRemote(true); });
+    bulkLayout->addWidget(takeAllButton);
+
+    bulkLayout->addStretch();
+    mainLayout->addLayout(bulkLayout);
+
+    QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    buttons->button(QDialogButtonBox::Ok)->setText("Merge");
+    connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    mainLayout->addWidget(buttons);
+}
+
+
+QSet<QString> MergeConflictDialog::takeRemoteIds() const
+{
+    QSet<QString> ids;
+
+    for (int i = 0; i < tree_->topLevelItemCount(); ++i)
+    {
+        const QTreeWidgetItem* item = tree_->topLevelItem(i);
+        if (item->checkState(COLUMN_REMOTE) == Qt::Checked)
+        {
+            ids.insert(item->data(COLUMN_LOCAL, Qt::UserRole).toString());
+        }
+    }
+
+    return ids;
+}
+
+
+void MergeConflictDialog::setAllTakeRemote(bool takeRemote)
+{
+    for (int i = 0; i < tree_->topLevelItemCount(); ++i)
+    {
+        tree_->topLevelItem(i)->setCheckState(COLUMN_REMOTE, takeRemote ? Qt::Checked : Qt::Unchecked);
+    }
+}
@@ -0,0 +1,41 @@
+// MergeConflictDialog.h
+
+
+#pragma once
+#include "TimelineMerge.h"
+#include <QDialog>
+
+
+class QTreeWidget;
+
+
+/**
+ * @class MergeConflictDialog
+ * @brief Lets the user pick a side for each event that was changed both here and on disk
+ *
+ * Only conflicting events are listed; everything else has already been merged
+ * automatically. Each row shows both versions and a checkbox to take the
+ * version on disk; unchecked rows keep the local version.
+ */
+class MergeConflictDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param plan Merge plan whose conflicts are listed
+     * @param filePath Project file that changed (for the explanation)
+     * @param parent Parent window
+     */
+    MergeConflictDialog(const TimelineMergePlan& plan, const QString& filePath, QWidget* parent = nullptr);
+
+    QSet<QString> takeRemoteIds() const;            ///< @brief Conflicts resolved with the version on disk
+
+private:
+    void setAllTakeRemote(bool takeRemote);
+
+    QTreeWidget* tree_ = nullptr;
+
+    static constexpr int COLUMN_LOCAL = 0;
+    static constexpr int COLUMN_REMOTE = 1;
+};
@@ -0,0 +1,96 @@
+// RevisionMemo.h
+
+
+#pragma once
+#include <QHash>
+#include <QtGlobal>
+#include <utility>
+
+
+/**
+ * @class RevisionMemo
+ * @brief Caches values derived from model data, keyed by the revision they were computed at
+ *
+ * TimelineModel stamps every event with a revision that moves whenever the event
+ * changes, and keeps a model-wide generation that moves with any change. A consumer
+ * that derives something from an event (a label, detail HTML, an export row) asks
+ * the memo with the event's current revision; the value is recomputed only when the
+ * revision differs from the one it was stored under. Aggregates over the whole model
+ * use the generation the same way, usually with a single key.
+ *
+ * Revision 0 means "not from the model" (e.g. an event built in a dialog) and is
+ * never cached.
+ *
+ * The memo is bounded: when a new key would exceed maxEntries, it is emptied first.
+ * Not thread-safe; use one memo per thread.
+ *
+ * @code
+ *   RevisionMemo<QString, QString> labels;
+ *   const QString& label = labels.value(event.id, event.revision, [&]() { return formatLabel(event); });
+ * @endcode
+ */
+template <typename Key, typename Value>
+class RevisionMemo
+{
+public:
+    explicit RevisionMemo(int maxEntries = DEFAULT_MAX_ENTRIES)
+        : maxEntries_(maxEntries)
+    {
+    }
+
+    /**
+     * @brief Cached value for key at revision, computing it if missing or stale
+     * @param compute Callable returning Value, invoked only on a miss
+     */
+    template <typename Compute>
+    Value value(const Key& key, quint64 revision, Compute&& compute)
+    {
+        if (revision == 0)
+        {
+            ++misses_;
+            return std::forward<Compute>(compute)();
+        }
+
+        auto it = entries_.find(key);
+        if (it != entries_.end() && it->revision == revision)
+        {
+            ++hits_;
+            return it->value;
+        }
+
+        ++misses_;
+        if (it == entries_.end() && entries_.size() >= maxEntries_)
+        {
+            entries_.clear();
+        }
+
+        it = entries_.insert(key, Entry{revision, std::forward<Compute>(compute)()});
+        return it->value;
+    }
+
+    bool isCurrent(const Key& key, quint64 revision) const                  ///< @brief True if a value for this revision is cached
+    {
+        auto it = entries_.constFind(key);
+        return revision != 0 && it != entries_.constEnd() && it->revision == revision;
+    }
+
+    void remove(const Key& key) { entries_.remove(key); }                   ///< @brief Forget one key (e.g. the event was deleted)
+    void clear() { entries_.clear(); }                                      ///< @brief Forget everything
+    int size() const { return entries_.size(); }
+    quint64 hits() const { return hits_; }
+    quint64 misses() const { return misses_; }
+
+    static constexpr int DEFAULT_MAX_ENTRIES = 20000;
+
+private:
+    struct Entry
+    {
+        quint64 revision = 0;
+        Value value;
+    };
+
+    QHash<Key, Entry> entries_;
+    int maxEntries_;
+    quint64 hits_ = 0;
+    quint64 misses_ = 0;
+};
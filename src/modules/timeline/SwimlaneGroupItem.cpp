@@ -0,0 +1,113 @@
+// SwimlaneGroupItem.cpp
+
+
+#include "SwimlaneGroupItem.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+
+SwimlaneGroupItem::SwimlaneGroupItem(const QString& key, QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , key_(key)
+{
+    // Above marker lines (0) and ghosts (5), below event bars (10)
+    setZValue(8);
+    setAcceptedMouseButtons(Qt::NoButton);
+
+    // exposedRect keeps the label in view while scrolling horizontally
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+
+QRectF SwimlaneGroupItem::boundingRect() const
+{
+    return bounds_;
+}
+
+
+void SwimlaneGroupItem::setGroup(const QRectF& headerRect,
+                                 const QString& label,
+                                 int eventCount,
+                                 bool collapsed,
+                                 const QVector<SummaryRect>& summary)
+{
+    prepareGeometryChange();
+
+    headerRect_ = headerRect;
+    label_ = label;
+    eventCount_ = eventCount;
+    collapsed_ = collapsed;
+    summary_ = collapsed ? summary : QVector<SummaryRect>();
+
+    bounds_ = headerRect_;
+    for (const SummaryRect& bar : summary_)
+    {
+        bounds_ = bounds_.united(bar.rect);
+    }
+    bounds_.adjust(-1, -1, 1, 1);
+
+    setToolTip(QString("%1: %2 event(s)\nClick the header to %3")
+                   .arg(label_)
+                   .arg(eventCount_)
+                   .arg(collapsed_ ? "expand" : "collapse"));
+
+    update();
+}
+
+
+void SwimlaneGroupItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /*widget*/)
+{
+    // ========== HEADER BAND ==========
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(225, 232, 240, 230));
+    painter->drawRect(headerRect_);
+
+    painter->setPen(QPen(QColor(180, 200, 220), 1));
+    painter->drawLine(headerRect_.bottomLeft(), headerRect_.bottomRight());
+
+    QFont font = painter->font();
+    font.setPointSize(9);
+    font.setBold(true);
+    painter->setFont(font);
+    painter->setPen(QColor(40, 40, 40));
+
+    // Pin the label to the left edge of what is being painted so it stays on screen
+    const double labelLeft = qMax(headerRect_.left(), option->exposedRect.left()) + 6;
+    const QString text = QString("%1  %2  (%3)")
+                             .arg(collapsed_ ? QChar(0x25B8) : QChar(0x25BE))
+                             .arg(label_)
+                             .arg(eventCount_);
+    painter->drawText(QRectF(labelLeft, headerRect_.top(), headerRect_.right() - labelLeft, headerRect_.height()),
+                      Qt::AlignVCenter | Qt::AlignLeft, text);
+
+    // ========== SUMMARY STRIP ==========
+    if (!collapsed_ || summary_.isEmpty())
+    {
+        return;
+    }
+
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
+    font.setPointSize(8);
+    painter->setFont(font);
+
+    for (const SummaryRect& bar : summary_)
+    {
+        if (!bar.rect.intersects(option->exposedRect))
+        {
+            continue;
+        }
+
+        painter->setPen(QPen(QColor(90, 110, 140), 1));
+        painter->setBrush(QColor(130, 150, 180, 160));
+        painter->drawRoundedRect(bar.rect, 3, 3);
+
+        // Count only where it fits
+        const QString count = QString::number(bar.eventCount);
+        if (bar.eventCount > 1 && painter->fontMetrics().horizontalAdvance(count) + 6 < bar.rect.width())
+        {
+            painter->setPen(Qt::white);
+            painter->drawText(bar.rect, Qt::AlignCenter, count);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+// SwimlaneGroupItem.h
+
+
+#pragma once
+#include <QGraphicsItem>
+#include <QVector>
+
+
+/**
+ * @class SwimlaneGroupItem
+ * @brief Header row of a swimlane group and, while collapsed, its summary strip
+ *
+ * The header spans the scene width and shows the expand marker, the group label
+ * and the event count. A collapsed group also draws its merged busy intervals as
+ * one strip of aggregated bars, labelled with the number of events they cover.
+ *
+ * Geometry is supplied by TimelineScene, which owns the coordinate mapping and
+ * toggles the group when the header is clicked.
+ */
+class SwimlaneGroupItem : public QGraphicsItem
+{
+public:
+    struct SummaryRect
+    {
+        QRectF rect;                ///< Bar in scene coordinates
+        int eventCount = 0;         ///< Events merged into the bar
+    };
+
+    explicit SwimlaneGroupItem(const QString& key, QGraphicsItem* parent = nullptr);                              ///< @brief Construct an empty group header
+
+    QRectF boundingRect() const override;                                                                           ///< @brief Header band plus summary strip
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;      ///< @brief Paint header and summary bars
+
+    /**
+     * @brief Update the header and summary strip
+     * @param headerRect Header band in scene coordinates
+     * @param label Group label
+     * @param eventCount Events in the group
+     * @param collapsed Whether the summary strip is shown
+     * @param summary Aggregated bars (collapsed groups only)
+     */
+    void setGroup(const QRectF& headerRect,
+                  const QString& label,
+                  int eventCount,
+                  bool collapsed,
+                  const QVector<SummaryRect>& summary);
+
+    QString key() const { return key_; }                                                        ///< @brief Grouping value this item represents
+    bool headerContains(const QPointF& scenePos) const { return headerRect_.contains(scenePos); }  ///< @brief Whether a scene point hits the header band
+
+private:
+    QString key_;                       ///< Grouping value
+    QRectF headerRect_;                 ///< Header band in scene coordinates
+    QString label_;                     ///< Group label
+    int eventCount_ = 0;                ///< Events in the group
+    bool collapsed_ = true;             ///< Summary strip shown
+    QVector<SummaryRect> summary_;      ///< Aggregated bars
+    QRectF bounds_;                     ///< Cached bounding rect
+};
@@ -0,0 +1,417 @@
+// SwimlaneLayout.cpp
+
+
+#include "SwimlaneLayout.h"
+#include <QMap>
+#include <algorithm>
+
+
+void SwimlaneLayout::setGrouping(SwimlaneGrouping grouping)
+{
+    if (grouping_ == grouping)
+    {
+        return;
+    }
+
+    grouping_ = grouping;
+    expanded_.clear();
+    clear();
+}
+
+
+void SwimlaneLayout::setExpanded(const QString& key, bool expanded)
+{
+    if (expanded)
+    {
+        expanded_.insert(key);
+    }
+    else
+    {
+        expanded_.remove(key);
+    }
+}
+
+
+void SwimlaneLayout::setAllExpanded(bool expanded)
+{
+    expanded_.clear();
+
+    if (expanded)
+    {
+        for (const Group& group : groups_)
+        {
+            expanded_.insert(group.key);
+        }
+    }
+}
+
+
+void SwimlaneLayout::layout(const QVector<TimelineEvent>& events,
+                            qint64 minGapSecs,
+                            double top,
+                            double laneStride,
+                            double headerHeight)
+{
+    clear();
+    minGapSecs_ = minGapSecs;
+    top_ = top;
+    laneStride_ = laneStride;
+    headerHeight_ = headerHeight;
+    bottom_ = top;
+
+    if (!isActive())
+    {
+        return;
+    }
+
+    // Bucket by sort key, which orders the groups
+    QMap<QString, QVector<const TimelineEvent*>> buckets;
+
+    for (const TimelineEvent& event : events)
+    {
+        const QString key = groupKey(event, grouping_);
+        buckets[sortKey(key)].append(&event);
+        groupMembers_[key].insert(event.id);
+        eventGroups_.insert(event.id, key);
+    }
+
+    for (auto it = buckets.cbegin(); it != buckets.cend(); ++it)
+    {
+        // First spelling seen names the header
+        const TimelineEvent& first = *it.value().first();
+
+        Group group;
+        group.key = groupKey(first, grouping_);
+        group.label = groupLabel(groupValue(first, grouping_), grouping_);
+        layoutGroup(group, it.value());
+        groups_.append(group);
+    }
+
+    placeGroups();
+}
+
+
+QSet<QString> SwimlaneLayout::applyChanges(const TimelineModel& model, const QStringList& changedIds)
+{
+    QSet<QString> touched;
+
+    if (!isActive() || changedIds.isEmpty())
+    {
+        return touched;
+    }
+
+    // Absent from the model (removed or archived) means the event leaves its group
+    const QHash<QString, TimelineEvent> live = model.getEvents(changedIds);
+
+    for (const QString& eventId : changedIds)
+    {
+        auto oldIt = eventGroups_.find(eventId);
+        if (oldIt != eventGroups_.end())
+        {
+            touched.insert(oldIt.value());
+            groupMembers_[oldIt.value()].remove(eventId);
+            eventGroups_.erase(oldIt);
+            eventOffsets_.remove(eventId);
+        }
+
+        auto liveIt = live.constFind(eventId);
+        if (liveIt != live.constEnd())
+        {
+            const QString key = groupKey(liveIt.value(), grouping_);
+            touched.insert(key);
+            groupMembers_[key].insert(eventId);
+            eventGroups_.insert(eventId, key);
+        }
+    }
+
+    relayoutGroups(model, touched);
+
+    return touched;
+}
+
+
+void SwimlaneLayout::relayoutGroups(const TimelineModel& model, const QSet<QString>& keys)
+{
+    if (!isActive() || keys.isEmpty())
+    {
+        return;
+    }
+
+    // Every member of the touched groups, resolved in one model pass
+    QStringList memberIds;
+    for (const QString& key : keys)
+    {
+        memberIds += groupMembers_.value(key).values();
+    }
+
+    const QHash<QString, TimelineEvent> events = model.getEvents(memberIds);
+
+    for (const QString& key : keys)
+    {
+        const QSet<QString> ids = groupMembers_.value(key);
+
+        for (const QString& eventId : ids)
+        {
+            eventOffsets_.remove(eventId);
+        }
+
+        QVector<const TimelineEvent*> members;
+        members.reserve(ids.size());
+        for (const QString& eventId : ids)
+        {
+            auto it = events.constFind(eventId);
+            if (it != events.constEnd())
+            {
+                members.append(&it.value());
+            }
+            else
+            {
+                // Gone without being reported as changed; forget it
+                groupMembers_[key].remove(eventId);
+                eventGroups_.remove(eventId);
+            }
+        }
+
+        auto indexIt = groupIndex_.constFind(key);
+
+        if (members.isEmpty())
+        {
+            // Last event left the group
+            groupMembers_.remove(key);
+            if (indexIt != groupIndex_.constEnd())
+            {
+                groups_.remove(indexIt.value());
+                placeGroups();
+            }
+            continue;
+        }
+
+        if (indexIt == groupIndex_.constEnd())
+        {
+            // New grouping value: insert the group at its display position
+            Group group;
+            group.key = key;
+            group.label = groupLabel(groupValue(*members.first(), grouping_), grouping_);
+
+            const QString order = sortKey(key);
+            auto pos = std::lower_bound(groups_.begin(), groups_.end(), order,
+                                        [this] (const Group& g, const QString& k) { return sortKey(g.key) < k; });
+            layoutGroup(group, members);
+            groups_.insert(pos, group);
+            placeGroups();
+            continue;
+        }
+
+        layoutGroup(groups_[indexIt.value()], members);
+    }
+
+    placeGroups();
+}
+
+
+double SwimlaneLayout::eventTop(const QString& eventId) const
+{
+    auto offsetIt = eventOffsets_.constFind(eventId);
+    if (offsetIt == eventOffsets_.constEnd())
+    {
+        return -1.0;
+    }
+
+    const int index = groupIndex_.value(eventGroups_.value(eventId), -1);
+    if (index < 0)
+    {
+        return -1.0;
+    }
+
+    return groups_[index].top + headerHeight_ + offsetIt.value();
+}
+
+
+void SwimlaneLayout::clear()
+{
+    groups_.clear();
+    groupIndex_.clear();
+    groupMembers_.clear();
+    eventGroups_.clear();
+    eventOffsets_.clear();
+    bottom_ = top_;
+}
+
+
+QString SwimlaneLayout::sortKey(const QString& key) const
+{
+    return key.isEmpty()                          ? QString("~")
+           : grouping_ == SwimlaneGrouping::Type  ? key.rightJustified(4, '0')
+                                                  : key;
+}
+
+
+void SwimlaneLayout::layoutGroup(Group& group, const QVector<const TimelineEvent*>& members)
+{
+    group.eventCount = members.size();
+    group.collapsed = !expanded_.contains(group.key);
+    group.laneCount = 0;
+    group.summary.clear();
+
+    if (group.collapsed)
+    {
+        // No lanes and no items - just where the group is busy
+        group.summary = summarize(members, minGapSecs_);
+        group.height = headerHeight_ + laneStride_;
+        return;
+    }
+
+    QVector<TimelineEvent> packed;
+    packed.reserve(members.size());
+    for (const TimelineEvent* event : members)
+    {
+        packed.append(*event);
+    }
+
+    group.laneCount = TimelineModel::assignLanes(packed, minGapSecs_) + 1;
+
+    for (const TimelineEvent& event : packed)
+    {
+        eventOffsets_.insert(event.id, event.lane * laneStride_);
+    }
+
+    group.height = headerHeight_ + group.laneCount * laneStride_;
+}
+
+
+void SwimlaneLayout::placeGroups()
+{
+    groupIndex_.clear();
+
+    double y = top_;
+
+    for (int i = 0; i < groups_.size(); ++i)
+    {
+        groups_[i].top = y;
+        y += groups_[i].height;
+        groupIndex_.insert(groups_[i].key, i);
+    }
+
+    bottom_ = y;
+}
+
+
+QVector<SwimlaneLayout::SummaryBar> SwimlaneLayout::summarize(const QVector<const TimelineEvent*>& events, qint64 minGapSecs)
+{
+    struct Interval
+    {
+        qint64 start;
+        qint64 end;
+    };
+
+    QVector<Interval> intervals;
+    intervals.reserve(events.size());
+
+    for (const TimelineEvent* event : events)
+    {
+        const qint64 start = event->startDate.toSecsSinceEpoch();
+        intervals.append({ start, std::max(start, event->drawnEndDate().toSecsSinceEpoch()) });
+    }
+
+    std::sort(intervals.begin(), intervals.end(),
+              [] (const Interval& a, const Interval& b) { return a.start < b.start; });
+
+    // Bars closer than the lane gap would be indistinguishable on screen, so they merge
+    QVector<SummaryBar> bars;
+    qint64 barStart = 0;
+    qint64 barEnd = 0;
+    int barCount = 0;
+
+    for (const Interval& interval : intervals)
+    {
+        if (barCount > 0 && interval.start < barEnd + minGapSecs)
+        {
+            barEnd = std::max(barEnd, interval.end);
+            ++barCount;
+            continue;
+        }
+
+        if (barCount > 0)
+        {
+            bars.append({ QDateTime::fromSecsSinceEpoch(barStart), QDateTime::fromSecsSinceEpoch(barEnd), barCount });
+        }
+
+        barStart = interval.start;
+        barEnd = interval.end;
+        barCount = 1;
+    }
+
+    if (barCount > 0)
+    {
+        bars.append({ QDateTime::fromSecsSinceEpoch(barStart), QDateTime::fromSecsSinceEpoch(barEnd), barCount });
+    }
+
+    return bars;
+}
+
+
+QString SwimlaneLayout::groupKey(const TimelineEvent& event, SwimlaneGrouping grouping)
+{
+    // "Blocked" and "blocked" are one group, and its expanded state must not follow event order
+    return groupValue(event, grouping).toLower();
+}
+
+
+QString SwimlaneLayout::groupValue(const TimelineEvent& event, SwimlaneGrouping grouping)
+{
+    switch (grouping)
+    {
+    case SwimlaneGrouping::Type:
+        return QString::number(event.type);
+
+    case SwimlaneGrouping::Status:
+        // Actions carry a status; Jira tickets carry the tracker's status
+        return (!event.status.isEmpty() ? event.status : event.jiraStatus).trimmed();
+
+    case SwimlaneGrouping::TestCategory:
+        return event.testCategory.trimmed();
+
+    case SwimlaneGrouping::None:
+        break;
+    }
+
+    return QString();
+}
+
+
+QString SwimlaneLayout::groupLabel(const QString& key, SwimlaneGrouping grouping)
+{
+    if (grouping == SwimlaneGrouping::Type)
+    {
+        switch (key.toInt())
+        {
+        case TimelineEventType_Meeting:     return "Meetings";
+        case TimelineEventType_Action:      return "Actions";
+        case TimelineEventType_TestEvent:   return "Test Events";
+        case TimelineEventType_Reminder:    return "Reminders";
+        case TimelineEventType_JiraTicket:  return "Jira Tickets";
+        default:                            return QString("Type %1").arg(key);
+        }
+    }
+
+    if (key.isEmpty())
+    {
+        return grouping == SwimlaneGrouping::Status ? "(No status)" : "(No category)";
+    }
+
+    return key;
+}
+
+
+QString SwimlaneLayout::groupingName(SwimlaneGrouping grouping)
+{
+    switch (grouping)
+    {
+    case SwimlaneGrouping::None:            return "None";
+    case SwimlaneGrouping::Type:            return "Type";
+    case SwimlaneGrouping::Status:          return "Status";
+    case SwimlaneGrouping::TestCategory:    return "Test Category";
+    }
+
+    return QString();
+}
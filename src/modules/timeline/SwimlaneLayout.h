@@ -0,0 +1,126 @@
+// SwimlaneLayout.h
+
+
+#pragma once
+#include "TimelineModel.h"
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+
+/**
+ * @brief Event attribute the timeline rows are grouped by
+ */
+enum class SwimlaneGrouping
+{
+    None = 0,           ///< Single packed lane set (classic layout)
+    Type = 1,           ///< Meeting, Action, Test Event, ...
+    Status = 2,         ///< Action status, falling back to the Jira status
+    TestCategory = 3    ///< Dry Run, Preliminary, Formal
+};
+
+
+/**
+ * @class SwimlaneLayout
+ * @brief Vertical layout of the timeline when events are grouped into swimlanes
+ *
+ * Each group gets a header row followed by its own lane set, packed with
+ * TimelineModel::assignLanes() on the group's events only (manual lanes count
+ * from the top of the group). A collapsed group is a header plus one summary
+ * strip: its events get no lanes and no scene items, only merged busy intervals.
+ * Groups start collapsed, so a large program costs nothing beyond grouping and
+ * summarizing until a group is opened.
+ *
+ * After a full layout() the layout remembers which group every event belongs to,
+ * so an edit re-lays out only the groups it touched (applyChanges()); the other
+ * groups keep their lanes and summaries and merely shift vertically.
+ *
+ * Pure geometry: TimelineScene owns the items and the coordinate mapping.
+ */
+class SwimlaneLayout
+{
+public:
+    struct SummaryBar
+    {
+        QDateTime start;            ///< Start of the merged interval
+        QDateTime end;              ///< Drawn end of the merged interval
+        int eventCount = 0;         ///< Events merged into this bar
+    };
+
+    struct Group
+    {
+        QString key;                ///< Stable grouping value (empty = not set)
+        QString label;              ///< Header text
+        int eventCount = 0;         ///< Active events in the group
+        bool collapsed = true;      ///< Summary strip instead of lanes
+        double top = 0.0;           ///< Scene Y of the header
+        double height = 0.0;        ///< Header plus lanes (or the summary strip)
+        int laneCount = 0;          ///< Lanes used while expanded (0 while collapsed)
+        QVector<SummaryBar> summary;    ///< Merged bars while collapsed
+    };
+
+    void setGrouping(SwimlaneGrouping grouping);                        ///< Change the grouping attribute (all groups collapse)
+    SwimlaneGrouping grouping() const { return grouping_; }
+    bool isActive() const { return grouping_ != SwimlaneGrouping::None; }
+
+    void setExpanded(const QString& key, bool expanded);                ///< Expand or collapse one group (takes effect on the next layout())
+    bool isExpanded(const QString& key) const { return expanded_.contains(key); }
+    void setAllExpanded(bool expanded);                                 ///< Expand or collapse every known group
+
+    /**
+     * @brief Group the events and compute the vertical layout
+     * @param events Active events (archived ones are expected to be filtered out already)
+     * @param minGapSecs Minimum gap between bars sharing a lane (and between summary bars)
+     * @param top Scene Y of the first header
+     * @param laneStride Height of one lane including spacing
+     * @param headerHeight Height of a group header row
+     */
+    void layout(const QVector<TimelineEvent>& events,
+                qint64 minGapSecs,
+                double top,
+                double laneStride,
+                double headerHeight);
+
+    /**
+     * @brief Move changed events between groups and re-lay out only the groups involved
+     * @param model Model holding the current events (the changed ones and their group mates are looked up in one pass each)
+     * @param changedIds Events added, removed, archived, restored or edited since the last layout
+     * @return Keys of the groups that were re-laid out (old and new group of every changed event)
+     *
+     * Uses the gap and geometry of the last layout(); call layout() again when those change.
+     */
+    QSet<QString> applyChanges(const TimelineModel& model, const QStringList& changedIds);
+    void relayoutGroups(const TimelineModel& model, const QSet<QString>& keys);    ///< Re-lay out the given groups (e.g. after expanding one); others only shift
+
+    const QVector<Group>& groups() const { return groups_; }
+    QStringList groupMembers(const QString& key) const { return groupMembers_.value(key).values(); }   ///< IDs of the events in a group
+    bool isEventVisible(const QString& eventId) const { return eventOffsets_.contains(eventId); }       ///< Event sits in an expanded group
+    double eventTop(const QString& eventId) const;                                                      ///< Bar Y for a visible event (-1 if collapsed)
+    double bottom() const { return bottom_; }                                                           ///< Scene Y below the last group
+    qint64 minGapSecs() const { return minGapSecs_; }                                                   ///< Lane gap the groups were packed with
+
+    static QString groupValue(const TimelineEvent& event, SwimlaneGrouping grouping);   ///< Grouping value of an event as entered
+    static QString groupKey(const TimelineEvent& event, SwimlaneGrouping grouping);     ///< Case-normalized grouping value (identifies the group)
+    static QString groupLabel(const QString& key, SwimlaneGrouping grouping);           ///< Header text for a grouping value
+    static QString groupingName(SwimlaneGrouping grouping);                             ///< UI name of a grouping attribute
+
+private:
+    void clear();                                                       ///< Forget groups, membership and geometry
+    QString sortKey(const QString& key) const;                          ///< Display order key: unset values last, types by enum value
+    void layoutGroup(Group& group, const QVector<const TimelineEvent*>& members);   ///< Pack or summarize one group and size it
+    void placeGroups();                                                 ///< Stack the groups from the top and refresh the key index
+    static QVector<SummaryBar> summarize(const QVector<const TimelineEvent*>& events, qint64 minGapSecs);
+
+    SwimlaneGrouping grouping_ = SwimlaneGrouping::None;
+    QSet<QString> expanded_;                    ///< Keys of expanded groups (everything else is collapsed)
+    QVector<Group> groups_;                     ///< Groups in display order
+    QHash<QString, int> groupIndex_;            ///< Position of each group in groups_, by key
+    QHash<QString, QSet<QString>> groupMembers_;    ///< Event IDs per group key
+    QHash<QString, QString> eventGroups_;       ///< Group key of every laid out event
+    QHash<QString, double> eventOffsets_;       ///< Bar Y below its group's header, for events in expanded groups
+    qint64 minGapSecs_ = 0;                     ///< Geometry of the last layout(), reused by applyChanges()
+    double top_ = 0.0;
+    double laneStride_ = 0.0;
+    double headerHeight_ = 0.0;
+    double bottom_ = 0.0;
+};
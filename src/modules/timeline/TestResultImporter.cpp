@@ -0,0 +1,433 @@
+// TestResultImporter.cpp
+
+
+#include "TestResultImporter.h"
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <QXmlStreamReader>
+#include <QHash>
+#include <QSet>
+#include <QDebug>
+
+
+// Parser state for one open <testsuite>/<assembly> element
+struct SuiteFrame
+{
+    TestSuiteResult result;             ///< Counts from direct test case children
+    int recordedCases = 0;              ///< Number of test cases seen directly in this suite
+    bool hasChildSuites = false;        ///< Nested suites carry their own counts
+    int declaredTests = -1;             ///< "tests"/"total" attribute (-1 if absent)
+    int declaredFailed = 0;             ///< "failures"+"errors"/"failed" attributes
+    int declaredSkipped = 0;            ///< "skipped"/"disabled" attributes
+    double declaredTime = -1.0;         ///< "time" attribute (-1 if absent)
+};
+
+
+enum class CaseOutcome
+{
+    Passed,
+    Failed,
+    Skipped
+};
+
+
+// Helper: Parse a duration attribute, tolerating thousands separators ("1,234.5")
+static double parseSeconds(QStringView text)
+{
+    QString cleaned = text.toString();
+    cleaned.remove(',');
+
+    bool ok = false;
+    double value = cleaned.toDouble(&ok);
+    return ok ? value : 0.0;
+}
+
+
+// Helper: Count a finished test case against the innermost suite
+static void recordCase(QVector<SuiteFrame>& stack, CaseOutcome outcome, double seconds, const QString& fallbackName)
+{
+    if (stack.isEmpty())
+    {
+        // Test case outside any suite - collect under the file name
+        SuiteFrame loose;
+        loose.result.name = fallbackName;
+        stack.append(loose);
+    }
+
+    SuiteFrame& frame = stack.last();
+    frame.recordedCases++;
+    frame.result.durationSecs += seconds;
+
+    switch (outcome)
+    {
+    case CaseOutcome::Passed:   frame.result.passed++;  break;
+    case CaseOutcome::Failed:   frame.result.failed++;  break;
+    case CaseOutcome::Skipped:  frame.result.skipped++; break;
+    }
+}
+
+
+// Helper: Resolve a closed suite to its final counts
+static TestSuiteResult finalizeSuite(const SuiteFrame& frame)
+{
+    TestSuiteResult result = frame.result;
+
+    // Summary-only suites (no <testcase> children) fall back to their declared counts
+    if (frame.recordedCases == 0 && !frame.hasChildSuites && frame.declaredTests > 0)
+    {
+        result.failed = frame.declaredFailed;
+        result.skipped = frame.declaredSkipped;
+        result.passed = qMax(0, frame.declaredTests - result.failed - result.skipped);
+    }
+
+    // Declared suite time includes fixtures/setup, so prefer it over the sum of cases
+    if (frame.declaredTime >= 0.0)
+    {
+        result.durationSecs = frame.declaredTime;
+    }
+
+    return result;
+}
+
+
+TestResultImporter::TestResultImporter(QObject* parent)
+    : QObject(parent)
+    , cancelRequested_(false)
+{
+    qRegisterMetaType<TestResultReport>();
+}
+
+
+TestResultImporter::~TestResultImporter()
+{
+    cancel();
+
+    if (worker_)
+    {
+        worker_->wait();
+    }
+}
+
+
+bool TestResultImporter::startImport(const QStringList& filePaths)
+{
+    if (worker_)
+    {
+        qWarning() << "TestResultImporter: Import already in progress";
+        return false;
+    }
+
+    cancelRequested_ = false;
+
+    QThread* thread = QThread::create([this, filePaths]()
+    {
+        auto reportProgress = [this](int percent)
+        {
+            QMetaObject::invokeMethod(this, [this, percent]() { emit progressChanged(percent); }, Qt::QueuedConnection);
+        };
+
+        TestResultReport report = parseFiles(filePaths, &cancelRequested_, reportProgress);
+
+        // Hand the report back to the GUI thread
+        QMetaObject::invokeMethod(this, [this, report]()
+        {
+            worker_ = nullptr;
+            emit importFinished(report);
+        }, Qt::QueuedConnection);
+    });
+
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+
+    worker_ = thread;
+    worker_->start(QThread::LowPriority);
+
+    return true;
+}
+
+
+void TestResultImporter::cancel()
+{
+    cancelRequested_ = true;
+}
+
+
+TestResultReport TestResultImporter::parseFiles(const QStringList& filePaths,
+                                                const std::atomic_bool* cancelFlag,
+                                                const std::function<void(int)>& progress)
+{
+    TestResultReport report;
+
+    QHash<QString, int> suiteIndexByName;
+
+    auto mergeSuite = [&report, &suiteIndexByName](const TestSuiteResult& suite)
+    {
+        if (suite.total() == 0 && suite.durationSecs <= 0.0)
+        {
+            return;
+        }
+
+        auto it = suiteIndexByName.constFind(suite.name);
+        if (it == suiteIndexByName.constEnd())
+        {
+            suiteIndexByName.insert(suite.name, report.suites.size());
+            report.suites.append(suite);
+            return;
+        }
+
+        TestSuiteResult& existing = report.suites[it.value()];
+        existing.passed += suite.passed;
+        existing.failed += suite.failed;
+        existing.skipped += suite.skipped;
+        existing.durationSecs += suite.durationSecs;
+    };
+
+    // Progress is reported against the combined size of all files
+    qint64 totalBytes = 0;
+    for (const QString& path : filePaths)
+    {
+        totalBytes += QFileInfo(path).size();
+    }
+
+    qint64 bytesBefore = 0;
+    int lastPercent = -1;
+
+    for (const QString& path : filePaths)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            report.errorString = QString("Cannot open %1: %2").arg(path, file.errorString());
+            return report;
+        }
+
+        report.sourceFiles.append(path);
+
+        const QString fallbackName = QFileInfo(path).completeBaseName();
+
+        QXmlStreamReader xml(&file);
+        QVector<SuiteFrame> stack;
+        bool inCase = false;
+        CaseOutcome caseOutcome = CaseOutcome::Passed;
+        double caseSeconds = 0.0;
+        quint32 tokenCount = 0;
+
+        while (!xml.atEnd())
+        {
+            xml.readNext();
+
+            // Poll cancellation and progress every few thousand tokens
+            if ((++tokenCount & 0xFFF) == 0)
+            {
+                if (cancelFlag && cancelFlag->load())
+                {
+                    report.cancelled = true;
+                    return report;
+                }
+
+                if (progress && totalBytes > 0)
+                {
+                    int percent = int(((bytesBefore + file.pos()) * 100) / totalBytes);
+                    if (percent != lastPercent)
+                    {
+                        lastPercent = percent;
+                        progress(percent);
+                    }
+                }
+            }
+
+            if (xml.isStartElement())
+            {
+                const QStringView name = xml.name();
+                const QXmlStreamAttributes attrs = xml.attributes();
+
+                if (name == u"testsuite" || name == u"assembly")
+                {
+                    if (!stack.isEmpty())
+                    {
+                        stack.last().hasChildSuites = true;
+                    }
+
+                    SuiteFrame frame;
+                    QString suiteName = attrs.value(u"name").toString();
+
+                    // xUnit.net reports the assembly path - keep just the assembly name
+                    if (name == u"assembly")
+                    {
+                        suiteName = QFileInfo(suiteName).completeBaseName();
+                    }
+
+                    frame.result.name = suiteName.isEmpty() ? fallbackName : suiteName;
+
+                    if (attrs.hasAttribute(u"tests"))
+                        frame.declaredTests = attrs.value(u"tests").toInt();
+                    else if (attrs.hasAttribute(u"total"))
+                        frame.declaredTests = attrs.value(u"total").toInt();
+
+                    frame.declaredFailed = attrs.value(u"failures").toInt()
+                                           + attrs.value(u"errors").toInt()
+                                           + attrs.value(u"failed").toInt();
+                    frame.declaredSkipped = attrs.value(u"skipped").toInt()
+                                            + attrs.value(u"disabled").toInt();
+
+                    if (attrs.hasAttribute(u"time"))
+                        frame.declaredTime = parseSeconds(attrs.value(u"time"));
+
+                    stack.append(frame);
+                }
+                else if (name == u"testcase")
+                {
+                    inCase = true;
+                    caseOutcome = CaseOutcome::Passed;
+                    caseSeconds = parseSeconds(attrs.value(u"time"));
+                }
+                else if (inCase && (name == u"failure" || name == u"error"))
+                {
+                    caseOutcome = CaseOutcome::Failed;
+                }
+                else if (inCase && name == u"skipped" && caseOutcome != CaseOutcome::Failed)
+                {
+                    caseOutcome = CaseOutcome::Skipped;
+                }
+                else if (name == u"test" && attrs.hasAttribute(u"result"))
+                {
+                    // xUnit.net: outcome is an attribute, no need to look at children
+                    const QStringView result = attrs.value(u"result");
+                    CaseOutcome outcome = result == u"Pass" ? CaseOutcome::Passed
+                                          : result == u"Skip" ? CaseOutcome::Skipped
+                                                              : CaseOutcome::Failed;
+
+                    recordCase(stack, outcome, parseSeconds(attrs.value(u"time")), fallbackName);
+                }
+            }
+            else if (xml.isEndElement())
+            {
+                const QStringView name = xml.name();
+
+                if (name == u"testcase" && inCase)
+                {
+                    recordCase(stack, caseOutcome, caseSeconds, fallbackName);
+                    inCase = false;
+                }
+                else if ((name == u"testsuite" || name == u"assembly") && !stack.isEmpty())
+                {
+                    mergeSuite(finalizeSuite(stack.takeLast()));
+                }
+            }
+        }
+
+        if (xml.hasError())
+        {
+            report.errorString = QString("%1 (line %2): %3")
+                                     .arg(path)
+                                     .arg(xml.lineNumber())
+                                     .arg(xml.errorString());
+            return report;
+        }
+
+        // Flush loose test cases collected outside any suite
+        while (!stack.isEmpty())
+        {
+            mergeSuite(finalizeSuite(stack.takeLast()));
+        }
+
+        bytesBefore += file.size();
+    }
+
+    if (progress)
+    {
+        progress(100);
+    }
+
+    return report;
+}
+
+
+QVector<TimelineEvent> TestResultImporter::applyReport(const TimelineModel* model,
+                                                       const TestResultReport& report,
+                                                       int* matchedSuites)
+{
+    QVector<TimelineEvent> updated;
+
+    if (matchedSuites)
+    {
+        *matchedSuites = 0;
+    }
+
+    if (!model || report.suites.isEmpty())
+    {
+        return updated;
+    }
+
+    // Index suites by full name and by last dotted segment ("com.acme.LoginTests" -> "logintests")
+    QMultiHash<QString, int> suitesByKey;
+    for (int i = 0; i < report.suites.size(); ++i)
+    {
+        const QString fullKey = report.suites[i].name.trimmed().toLower();
+        suitesByKey.insert(fullKey, i);
+
+        const QString shortKey = fullKey.section('.', -1);
+        if (shortKey != fullKey)
+        {
+            suitesByKey.insert(shortKey, i);
+        }
+    }
+
+    QSet<int> matched;
+    const QDateTime importTime = QDateTime::currentDateTime();
+    const QVector<TimelineEvent> events = model->getAllEvents();
+
+    for (const TimelineEvent& event : events)
+    {
+        if (event.type != TimelineEventType_TestEvent)
+        {
+            continue;
+        }
+
+        const QString key = event.title.trimmed().toLower();
+        if (key.isEmpty())
+        {
+            continue;
+        }
+
+        const QList<int> indices = suitesByKey.values(key);
+        if (indices.isEmpty())
+        {
+            continue;
+        }
+
+        TimelineEvent result = event;
+        result.testsPassed = 0;
+        result.testsFailed = 0;
+        result.testsSkipped = 0;
+        result.testDurationSecs = 0.0;
+        result.testResultsImported = importTime;
+
+        // A suite can be indexed under both keys - count it once
+        QSet<int> counted;
+        for (int index : indices)
+        {
+            if (counted.contains(index))
+            {
+                continue;
+            }
+            counted.insert(index);
+            matched.insert(index);
+
+            const TestSuiteResult& suite = report.suites[index];
+            result.testsPassed += suite.passed;
+            result.testsFailed += suite.failed;
+            result.testsSkipped += suite.skipped;
+            result.testDurationSecs += suite.durationSecs;
+        }
+
+        updated.append(result);
+    }
+
+    if (matchedSuites)
+    {
+        *matchedSuites = matched.size();
+    }
+
+    return updated;
+}
@@ -0,0 +1,102 @@
+// TestResultImporter.h
+
+
+#pragma once
+#include "TimelineModel.h"
+#include <QObject>
+#include <QVector>
+#include <QStringList>
+#include <QMetaType>
+#include <atomic>
+#include <functional>
+
+
+class QThread;
+
+
+/**
+ * @struct TestSuiteResult
+ * @brief Aggregated outcome of one test suite across all imported files
+ */
+struct TestSuiteResult
+{
+    QString name;                   ///< Suite name as reported by the runner
+    int passed = 0;                 ///< Passing test cases
+    int failed = 0;                 ///< Failing + erroring test cases
+    int skipped = 0;                ///< Skipped/ignored test cases
+    double durationSecs = 0.0;      ///< Total suite duration in seconds
+
+    int total() const { return passed + failed + skipped; }
+};
+
+
+/**
+ * @struct TestResultReport
+ * @brief Result of parsing one or more JUnit/xUnit XML files
+ */
+struct TestResultReport
+{
+    QStringList sourceFiles;            ///< Files that were parsed
+    QVector<TestSuiteResult> suites;    ///< Per-suite aggregates (merged by name)
+    QString errorString;                ///< First parse error, empty on success
+    bool cancelled = false;             ///< True if the import was cancelled
+
+    bool isValid() const { return errorString.isEmpty() && !cancelled; }
+};
+
+Q_DECLARE_METATYPE(TestResultReport)
+
+
+/**
+ * @class TestResultImporter
+ * @brief Streams JUnit/xUnit XML result files on a worker thread and maps them onto test events
+ *
+ * Parsing uses QXmlStreamReader directly on the file device, so memory stays flat regardless
+ * of report size. Supported layouts:
+ * - JUnit / Surefire / pytest: <testsuites>/<testsuite>/<testcase> with <failure>, <error>, <skipped>
+ * - xUnit.net v2: <assemblies>/<assembly>/<collection>/<test result="Pass|Fail|Skip">
+ *
+ * Suites are matched to TimelineEventType_TestEvent events by title (case-insensitive),
+ * either against the full suite name or its last dotted segment (e.g. "com.acme.LoginTests").
+ */
+class TestResultImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestResultImporter(QObject* parent = nullptr);
+    ~TestResultImporter() override;
+
+    bool startImport(const QStringList& filePaths);         ///< @brief Start parsing on a worker thread (false if an import is already running)
+    void cancel();                                          ///< @brief Request cancellation of the running import
+    bool isRunning() const { return worker_ != nullptr; }   ///< @brief Whether an import is in progress
+
+    /**
+     * @brief Parse result files synchronously (called from the worker thread)
+     * @param filePaths Result files to parse; suites with the same name are merged
+     * @param cancelFlag Optional flag polled while parsing
+     * @param progress Optional callback receiving 0-100 as bytes are consumed
+     */
+    static TestResultReport parseFiles(const QStringList& filePaths,
+                                       const std::atomic_bool* cancelFlag = nullptr,
+                                       const std::function<void(int)>& progress = {});
+
+    /**
+     * @brief Build updated copies of the test events that match suites in the report
+     * @param model Timeline model to match against
+     * @param report Parsed results
+     * @param matchedSuites Optional output: number of suites that matched at least one event
+     * @return Updated events, ready for a single batched model update
+     */
+    static QVector<TimelineEvent> applyReport(const TimelineModel* model,
+                                              const TestResultReport& report,
+                                              int* matchedSuites = nullptr);
+
+signals:
+    void progressChanged(int percent);                      ///< @brief Parse progress (0-100), delivered on the GUI thread
+    void importFinished(const TestResultReport& report);    ///< @brief Parsing finished (check report.isValid())
+
+private:
+    QThread* worker_ = nullptr;             ///< Running worker thread (nullptr when idle)
+    std::atomic_bool cancelRequested_;      ///< Polled by the parser
+};
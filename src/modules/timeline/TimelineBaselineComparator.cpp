@@ -0,0 +1,342 @@
+// TimelineBaselineComparator.cpp
+
+
+#include "TimelineBaselineComparator.h"
+#include "TimelineSerializer.h"
+#include <QFileInfo>
+#include <QSet>
+#include <QDebug>
+
+
+TimelineBaselineComparator::TimelineBaselineComparator(TimelineModel* model, QObject* parent)
+    : QObject(parent)
+    , model_(model)
+{
+    connect(model_, &TimelineModel::eventAdded, this, &TimelineBaselineComparator::onEventChanged);
+    connect(model_, &TimelineModel::eventRemoved, this, &TimelineBaselineComparator::onEventChanged);
+    connect(model_, &TimelineModel::eventUpdated, this, &TimelineBaselineComparator::onEventChanged);
+    connect(model_, &TimelineModel::eventsUpdated, this, &TimelineBaselineComparator::onEventsChanged);
+    connect(model_, &TimelineModel::eventArchived, this, &TimelineBaselineComparator::onEventChanged);
+    connect(model_, &TimelineModel::eventRestored, this, &TimelineBaselineComparator::onEventChanged);
+    connect(model_, &TimelineModel::eventsAdded, this, &TimelineBaselineComparator::onEventsChanged);
+    connect(model_, &TimelineModel::eventsRemoved, this, &TimelineBaselineComparator::onEventsChanged);
+    connect(model_, &TimelineModel::eventsArchived, this, &TimelineBaselineComparator::onEventsChanged);
+    connect(model_, &TimelineModel::eventsRestored, this, &TimelineBaselineComparator::onEventsChanged);
+    connect(model_, &TimelineModel::eventsCleared, this, &TimelineBaselineComparator::onEventsCleared);
+}
+
+
+bool TimelineBaselineComparator::loadBaseline(const QString& filePath)
+{
+    QVector<TimelineEvent> events;
+    QString versionName;
+
+    if (!TimelineSerializer::readEventsFromFile(filePath, events, &versionName))
+    {
+        qWarning() << "TimelineBaselineComparator: Failed to read baseline from" << filePath;
+        return false;
+    }
+
+    QString label = versionName.isEmpty() ? QFileInfo(filePath).fileName() : versionName;
+    setBaseline(events, label);
+
+    return true;
+}
+
+
+void TimelineBaselineComparator::setBaseline(const QVector<TimelineEvent>& events, const QString& label)
+{
+    baseline_.clear();
+    baseline_.reserve(events.size());
+
+    for (const TimelineEvent& event : events)
+    {
+        BaselineEntry entry;
+        entry.title = event.title;
+        entry.type = event.type;
+        entry.startDate = event.startDate;
+        entry.endDate = event.endDate;
+        entry.lane = event.lane;
+        entry.contentHash = contentHash(event);
+
+        baseline_.insert(event.id, entry);
+    }
+
+    baselineLabel_ = label;
+    hasBaseline_ = true;
+
+    recompute();
+}
+
+
+void TimelineBaselineComparator::clearBaseline()
+{
+    baseline_.clear();
+    diffs_.clear();
+    summary_ = Summary();
+    baselineLabel_.clear();
+    hasBaseline_ = false;
+
+    emit comparisonReset();
+}
+
+
+TimelineBaselineComparator::ChangeFlags TimelineBaselineComparator::changesFor(const QString& eventId) const
+{
+    auto it = diffs_.constFind(eventId);
+    return it != diffs_.constEnd() ? it->flags : ChangeFlags(Unchanged);
+}
+
+
+const TimelineBaselineComparator::EventDiff* TimelineBaselineComparator::diffFor(const QString& eventId) const
+{
+    auto it = diffs_.constFind(eventId);
+    return it != diffs_.constEnd() ? &it.value() : nullptr;
+}
+
+
+const TimelineBaselineComparator::BaselineEntry* TimelineBaselineComparator::baselineEntry(const QString& eventId) const
+{
+    auto it = baseline_.constFind(eventId);
+    return it != baseline_.constEnd() ? &it.value() : nullptr;
+}
+
+
+QVector<TimelineBaselineComparator::EventDiff> TimelineBaselineComparator::changedEvents() const
+{
+    QVector<EventDiff> result;
+    result.reserve(diffs_.size());
+
+    for (auto it = diffs_.constBegin(); it != diffs_.constEnd(); ++it)
+    {
+        result.append(it.value());
+    }
+
+    return result;
+}
+
+
+size_t TimelineBaselineComparator::contentHash(const TimelineEvent& event)
+{
+    // Dates and lanes are deliberately excluded - schedule movement is reported as
+    // Slipped/Resized, and lanes are a layout artifact that changes with neighbours.
+    size_t seed = qHashMulti(0, event.type, event.title, event.description, event.priority,
+                             event.color.rgba(), event.location, event.participants, event.status);
+
+    seed = qHashMulti(seed, event.testCategory, event.recurringRule, event.reminderDateTime, event.dueDateTime,
+                      event.jiraKey, event.jiraSummary, event.jiraType, event.jiraStatus);
+
+    for (auto it = event.preparationChecklist.constBegin(); it != event.preparationChecklist.constEnd(); ++it)
+    {
+        seed = qHashMulti(seed, it.key(), it.value());
+    }
+
+    return seed;
+}
+
+
+QString TimelineBaselineComparator::describeChange(ChangeFlags flags)
+{
+    if (flags.testFlag(Added))
+        return "Added";
+    if (flags.testFlag(Removed))
+        return "Removed";
+
+    QStringList parts;
+    if (flags.testFlag(Slipped))
+        parts << "Slipped";
+    if (flags.testFlag(Resized))
+        parts << "Resized";
+    if (flags.testFlag(Edited))
+        parts << "Edited";
+
+    return parts.isEmpty() ? QString("Unchanged") : parts.join(", ");
+}
+
+
+void TimelineBaselineComparator::onEventChanged(const QString& eventId)
+{
+    if (!hasBaseline_)
+    {
+        return;
+    }
+
+    if (reclassify(eventId, model_->getEvent(eventId)))
+    {
+        emit eventDiffChanged(eventId);
+    }
+}
+
+
+void TimelineBaselineComparator::onEventsChanged(const QStringList& eventIds)
+{
+    if (!hasBaseline_)
+    {
+        return;
+    }
+
+    // One model pass for the whole batch; removed events are simply absent
+    const QHash<QString, TimelineEvent> live = model_->getEvents(eventIds);
+
+    QStringList changedIds;
+    for (const QString& eventId : eventIds)
+    {
+        auto it = live.constFind(eventId);
+        if (reclassify(eventId, it != live.constEnd() ? &it.value() : nullptr))
+        {
+            changedIds.append(eventId);
+        }
+    }
+
+    // One signal naming only the reclassified events, so listeners need not start over
+    if (!changedIds.isEmpty())
+    {
+        emit eventDiffsChanged(changedIds);
+    }
+}
+
+
+void TimelineBaselineComparator::onEventsCleared()
+{
+    if (!hasBaseline_)
+    {
+        return;
+    }
+
+    recompute();
+}
+
+
+void TimelineBaselineComparator::recompute()
+{
+    diffs_.clear();
+    summary_ = Summary();
+    summary_.baselineCount = baseline_.size();
+
+    const QVector<TimelineEvent> events = model_->getAllEvents();
+
+    QSet<QString> liveIds;
+    liveIds.reserve(events.size());
+
+    // Pass 1: every live event against its baseline entry (if any)
+    for (const TimelineEvent& event : events)
+    {
+        liveIds.insert(event.id);
+
+        EventDiff diff = classify(event.id, baselineEntry(event.id), &event);
+        if (diff.flags != Unchanged)
+        {
+            diffs_.insert(event.id, diff);
+            accumulate(diff, 1);
+        }
+    }
+
+    // Pass 2: baseline entries with no live counterpart were removed
+    for (auto it = baseline_.constBegin(); it != baseline_.constEnd(); ++it)
+    {
+        if (!liveIds.contains(it.key()))
+        {
+            EventDiff diff = classify(it.key(), &it.value(), nullptr);
+            diffs_.insert(it.key(), diff);
+            accumulate(diff, 1);
+        }
+    }
+
+    qDebug() << "TimelineBaselineComparator: Compared" << events.size() << "live events against"
+             << baseline_.size() << "baseline events -" << diffs_.size() << "changed";
+
+    emit comparisonReset();
+}
+
+
+bool TimelineBaselineComparator::reclassify(const QString& eventId, const TimelineEvent* live)
+{
+    EventDiff next = classify(eventId, baselineEntry(eventId), live);
+
+    auto it = diffs_.find(eventId);
+    if (it != diffs_.end())
+    {
+        if (it->flags == next.flags
+            && it->startSlipSecs == next.startSlipSecs
+            && it->endSlipSecs == next.endSlipSecs)
+        {
+            return false;
+        }
+
+        accumulate(it.value(), -1);
+        diffs_.erase(it);
+    }
+    else if (next.flags == Unchanged)
+    {
+        return false;
+    }
+
+    if (next.flags != Unchanged)
+    {
+        diffs_.insert(eventId, next);
+        accumulate(next, 1);
+    }
+
+    return true;
+}
+
+
+TimelineBaselineComparator::EventDiff TimelineBaselineComparator::classify(const QString& eventId,
+                                                                           const BaselineEntry* base,
+                                                                           const TimelineEvent* live) const
+{
+    EventDiff diff;
+    diff.eventId = eventId;
+
+    if (!base && !live)
+    {
+        return diff;
+    }
+
+    if (!base)
+    {
+        diff.flags = Added;
+        return diff;
+    }
+
+    if (!live)
+    {
+        diff.flags = Removed;
+        return diff;
+    }
+
+    diff.startSlipSecs = base->startDate.secsTo(live->startDate);
+    diff.endSlipSecs = base->endDate.secsTo(live->endDate);
+
+    if (diff.startSlipSecs != 0)
+    {
+        diff.flags |= Slipped;
+    }
+
+    if (diff.endSlipSecs != diff.startSlipSecs)
+    {
+        diff.flags |= Resized;
+    }
+
+    if (contentHash(*live) != base->contentHash)
+    {
+        diff.flags |= Edited;
+    }
+
+    return diff;
+}
+
+
+void TimelineBaselineComparator::accumulate(const EventDiff& diff, int sign)
+{
+    if (diff.flags.testFlag(Added))
+        summary_.added += sign;
+    if (diff.flags.testFlag(Removed))
+        summary_.removed += sign;
+    if (diff.flags.testFlag(Slipped))
+        summary_.slipped += sign;
+    if (diff.flags.testFlag(Resized))
+        summary_.resized += sign;
+    if (diff.flags.testFlag(Edited))
+        summary_.edited += sign;
+}
@@ -0,0 +1,109 @@
+// TimelineBaselineComparator.h
+
+
+#pragma once
+#include "TimelineModel.h"
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QDateTime>
+
+
+/**
+ * @class TimelineBaselineComparator
+ * @brief Diffs the live timeline model against a baselined snapshot of the schedule
+ *
+ * The baseline is held as a hash of lightweight entries keyed by event ID, each with a
+ * precomputed content hash. A full comparison is a single O(N) pass over both sides;
+ * afterwards the comparator listens to the model and reclassifies only the events that
+ * changed, so the diff stays current while the user edits the schedule. Batch edits are
+ * reported as one eventDiffsChanged() listing just the reclassified events.
+ *
+ * Only events that differ from the baseline are stored in the diff table.
+ */
+class TimelineBaselineComparator : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum ChangeFlag
+    {
+        Unchanged   = 0x00,     ///< Same dates and content as the baseline
+        Added       = 0x01,     ///< Not present in the baseline
+        Removed     = 0x02,     ///< Present in the baseline, no longer on the live timeline
+        Slipped     = 0x04,     ///< Start moved relative to the baseline
+        Resized     = 0x08,     ///< Duration changed relative to the baseline
+        Edited      = 0x10      ///< Non-schedule content (title, status, fields) changed
+    };
+    Q_DECLARE_FLAGS(ChangeFlags, ChangeFlag)
+
+    struct BaselineEntry
+    {
+        QString title;                                  ///< Title at baseline time
+        TimelineEventType type = TimelineEventType_Meeting;
+        QDateTime startDate;                            ///< Baselined start
+        QDateTime endDate;                              ///< Baselined end
+        int lane = 0;                                   ///< Lane stored in the baseline file
+        size_t contentHash = 0;                         ///< Hash of non-schedule fields
+    };
+
+    struct EventDiff
+    {
+        QString eventId;
+        ChangeFlags flags;
+        qint64 startSlipSecs = 0;                       ///< Live start minus baseline start
+        qint64 endSlipSecs = 0;                         ///< Live end minus baseline end
+    };
+
+    struct Summary
+    {
+        int baselineCount = 0;
+        int added = 0;
+        int removed = 0;
+        int slipped = 0;
+        int resized = 0;
+        int edited = 0;
+    };
+
+    explicit TimelineBaselineComparator(TimelineModel* model, QObject* parent = nullptr);
+
+    bool loadBaseline(const QString& filePath);                                 ///< @brief Read a project file as the baseline and run a full comparison
+    void setBaseline(const QVector<TimelineEvent>& events, const QString& label);  ///< @brief Use the given events as the baseline
+    void clearBaseline();                                                       ///< @brief Drop the baseline and all diff results
+    bool hasBaseline() const { return hasBaseline_; }                           ///< @brief Whether a baseline is loaded
+    QString baselineLabel() const { return baselineLabel_; }                    ///< @brief Display name of the loaded baseline
+
+    ChangeFlags changesFor(const QString& eventId) const;                       ///< @brief Change flags for an event (Unchanged if not in the diff)
+    const EventDiff* diffFor(const QString& eventId) const;                     ///< @brief Diff record for an event, nullptr if unchanged
+    const BaselineEntry* baselineEntry(const QString& eventId) const;           ///< @brief Baseline record for an event, nullptr if not baselined
+    QVector<EventDiff> changedEvents() const;                                   ///< @brief All events that differ from the baseline
+    Summary summary() const { return summary_; }                                ///< @brief Running totals per change category
+
+    static size_t contentHash(const TimelineEvent& event);                      ///< @brief Hash of the fields that count as an "edit"
+    static QString describeChange(ChangeFlags flags);                           ///< @brief Human-readable change description
+
+signals:
+    void comparisonReset();                                                     ///< @brief Emitted after a full recomparison (or when the baseline is cleared)
+    void eventDiffChanged(const QString& eventId);                              ///< @brief Emitted when a single event's classification changed
+    void eventDiffsChanged(const QStringList& eventIds);                        ///< @brief Emitted once per batch edit with the events whose classification changed
+
+private slots:
+    void onEventChanged(const QString& eventId);
+    void onEventsChanged(const QStringList& eventIds);
+    void onEventsCleared();
+
+private:
+    void recompute();                                                           ///< Full O(N) comparison
+    bool reclassify(const QString& eventId, const TimelineEvent* live);         ///< Reclassify one event, returns true if its diff changed
+    EventDiff classify(const QString& eventId, const BaselineEntry* base, const TimelineEvent* live) const;
+    void accumulate(const EventDiff& diff, int sign);                           ///< Add/remove a diff from the running summary
+
+    TimelineModel* model_;                          ///< Live model (not owned)
+    QHash<QString, BaselineEntry> baseline_;        ///< Baseline entries keyed by event ID
+    QHash<QString, EventDiff> diffs_;               ///< Changed events only, keyed by event ID
+    Summary summary_;
+    QString baselineLabel_;
+    bool hasBaseline_ = false;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(TimelineBaselineComparator::ChangeFlags)
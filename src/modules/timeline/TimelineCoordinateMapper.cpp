@@ -24,8 +24,8 @@ double TimelineCoordinateMapper::dateToX(const QDate& date) const
         return 0.0;
     }
 
-    // Calculate days from version start
-    int dayOffset = versionStart_.daysTo(date);
+    // Calculate days from the epoch
+    qint64 dayOffset = date.toJulianDay() - EPOCH_JULIAN_DAY;
 
     // Convert to pixel coordinate
     return dayOffset * pixelsPerDay_;
@@ -39,8 +39,8 @@ double TimelineCoordinateMapper::dateTimeToX(const QDateTime& dateTime) const
         return 0.0;
     }
 
-    // Calculate days from version start
-    int dayOffset = versionStart_.daysTo(dateTime.date());
+    // Calculate days from the epoch
+    qint64 dayOffset = dateTime.date().toJulianDay() - EPOCH_JULIAN_DAY;
 
     // Add fractional day based on time
     double fractionalDay = dateTime.time().hour() / 24.0 +
@@ -90,10 +90,10 @@ QRectF TimelineCoordinateMapper::dateTimeRangeToRect(const QDateTime& start,
 QDate TimelineCoordinateMapper::xToDate(double xCoord) const
 {
     // Convert pixel position back to days offset
-    int daysOffset = static_cast<int>(std::round(xCoord / pixelsPerDay_));
+    qint64 daysOffset = static_cast<qint64>(std::round(xCoord / pixelsPerDay_));
 
-    // Add offset to version start
-    return versionStart_.addDays(daysOffset);
+    // Add offset to the epoch
+    return QDate::fromJulianDay(EPOCH_JULIAN_DAY + daysOffset);
 }
 
 
@@ -101,7 +101,7 @@ QDateTime TimelineCoordinateMapper::xToDateTime(double xCoord) const
 {
     // Convert pixel position to days offset (with fractional part)
     double daysOffsetFloat = xCoord / pixelsPerDay_;
-    int daysOffset = static_cast<int>(std::floor(daysOffsetFloat));
+    qint64 daysOffset = static_cast<qint64>(std::floor(daysOffsetFloat));
     double fractionalDay = daysOffsetFloat - daysOffset;
 
     // Calculate time from fractional day - ROUND instead of truncate
@@ -123,7 +123,7 @@ QDateTime TimelineCoordinateMapper::xToDateTime(double xCoord) const
     }
 
     // Construct date-time
-    QDate date = versionStart_.addDays(daysOffset);
+    QDate date = QDate::fromJulianDay(EPOCH_JULIAN_DAY + daysOffset);
     QTime time(hours, minutes, seconds);
 
     return QDateTime(date, time);
@@ -16,6 +16,11 @@
  * This class handles the mathematical mapping between calendar dates and
  * pixel positions on the timeline canvas. It supports dynamic zoom levels,
  * including fine-grained zoom for hour and half-hour precision.
+ *
+ * X is measured from a fixed epoch (EPOCH_JULIAN_DAY), not from the version
+ * start, so item positions depend only on their dates and the zoom level.
+ * Changing the version dates moves the boundary markers and the scene rect,
+ * never the items.
  */
 class TimelineCoordinateMapper
 {
@@ -57,7 +62,7 @@ public:
     double minPixelsPerDay() const { return minPixelsPerDay_; } ///< @brief Get current minimum zoom level
 
 
-    // Version date range management
+    // Version date range management (does not affect X coordinates)
     void setVersionDates(const QDate& start, const QDate& end);
     QDate versionStart() const { return versionStart_; }
     QDate versionEnd() const { return versionEnd_; }
@@ -67,10 +72,14 @@ public:
     double totalWidth() const;
 
 
+    static QDate epoch() { return QDate::fromJulianDay(EPOCH_JULIAN_DAY); }   ///< @brief Date at X = 0
+
+
     // Constants
     static constexpr double DEFAULT_PIXELS_PER_DAY = 20.0;
     static constexpr double ABSOLUTE_MIN_PIXELS_PER_DAY = 0.5;
     static constexpr double MAX_PIXELS_PER_DAY = 2000.0;
+    static constexpr qint64 EPOCH_JULIAN_DAY = 2451545;     ///< 2000-01-01, scene X origin
 
 
 private:
@@ -459,6 +459,8 @@ void TimelineDateScale::setTimelineHeight(double height)
 
 void TimelineDateScale::setPaddedDateRange(const QDate& paddedStart, const QDate& paddedEnd)
 {
+    // The bounding rect follows the padded range
+    prepareGeometryChange();
     paddedStart_ = paddedStart;
     paddedEnd_ = paddedEnd;
     update();
@@ -4,6 +4,9 @@
 #include "TimelineExporter.h"
 #include "TimelineScene.h"
 #include "TimelineView.h"
+#include "TimelineBaselineComparator.h"
+#include "XlsxWriter.h"
+#include "RevisionMemo.h"
 #include <QFile>
 #include <QTextStream>
 #include <QPainter>
@@ -15,6 +18,7 @@
 #include <QPageLayout>
 #include <QPageSize>
 #include <QDateTime>
+#include <algorithm>
 
 
 bool TimelineExporter::exportToCSV(const TimelineModel* model, const QString& filePath)
@@ -84,6 +88,13 @@ QString TimelineExporter::getCSVHeader()
 }
 
 QString TimelineExporter::eventToCSVRow(const TimelineEvent& event)
+{
+    // Repeated exports of an unchanged model reuse rows (exports run on the GUI thread only)
+    static RevisionMemo<QString, QString> rowMemo;
+    return rowMemo.value(event.id, event.revision, [&]() { return buildCSVRow(event); });
+}
+
+QString TimelineExporter::buildCSVRow(const TimelineEvent& event)
 {
     QStringList fields;
 
@@ -263,6 +274,241 @@ bool TimelineExporter::exportEventsToCSV(const QVector<TimelineEvent>& events,
 }
 
 
+bool TimelineExporter::exportSlipReportToCSV(const TimelineModel* model,
+                                             const TimelineBaselineComparator* comparator,
+                                             const QString& filePath)
+{
+    if (!model || !comparator || !comparator->hasBaseline())
+    {
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream out(&file);
+
+    // Worst finish slip first; removed events (no finish) go last
+    QVector<TimelineBaselineComparator::EventDiff> diffs = comparator->changedEvents();
+    std::sort(diffs.begin(), diffs.end(), [](const auto& a, const auto& b)
+              {
+                  bool aRemoved = a.flags.testFlag(TimelineBaselineComparator::Removed);
+                  bool bRemoved = b.flags.testFlag(TimelineBaselineComparator::Removed);
+
+                  if (aRemoved != bRemoved)
+                      return bRemoved;
+
+                  return a.endSlipSecs > b.endSlipSecs;
+              });
+
+    const double secsPerDay = 86400.0;
+
+    out << "ID,Title,Type,Change,Baseline Start,Baseline End,Current Start,Current End,"
+           "Start Slip (days),Finish Slip (days),Duration Change (days)\n";
+
+    for (const auto& diff : diffs)
+    {
+        const TimelineBaselineComparator::BaselineEntry* base = comparator->baselineEntry(diff.eventId);
+        const TimelineEvent* live = model->getEvent(diff.eventId);
+
+        QString title = live ? live->title : (base ? base->title : QString());
+        TimelineEventType type = live ? live->type : (base ? base->type : TimelineEventType_Meeting);
+
+        QStringList fields;
+        fields << escapeCSVField(diff.eventId);
+        fields << escapeCSVField(title);
+        fields << escapeCSVField(eventTypeToDisplayString(type));
+        fields << escapeCSVField(TimelineBaselineComparator::describeChange(diff.flags));
+        fields << (base ? base->startDate.toString("yyyy-MM-dd HH:mm") : QString());
+        fields << (base ? base->endDate.toString("yyyy-MM-dd HH:mm") : QString());
+        fields << (live ? live->startDate.toString("yyyy-MM-dd HH:mm") : QString());
+        fields << (live ? live->endDate.toString("yyyy-MM-dd HH:mm") : QString());
+
+        if (base && live)
+        {
+            fields << QString::number(diff.startSlipSecs / secsPerDay, 'f', 2);
+            fields << QString::number(diff.endSlipSecs / secsPerDay, 'f', 2);
+            fields << QString::number((diff.endSlipSecs - diff.startSlipSecs) / secsPerDay, 'f', 2);
+        }
+        else
+        {
+            fields << "" << "" << "";
+        }
+
+        out << fields.join(",") << "\n";
+    }
+
+    file.close();
+
+    return true;
+}
+
+
+bool TimelineExporter::exportToXLSX(const QVector<TimelineEvent>& events,
+                                    const QString& filePath,
+                                    const std::atomic_bool* cancelFlag,
+                                    const std::function<void(int)>& progress,
+                                    QString* errorString)
+{
+    static const TimelineEventType sheetTypes[] = {
+        TimelineEventType_Meeting,
+        TimelineEventType_Action,
+        TimelineEventType_TestEvent,
+        TimelineEventType_Reminder,
+        TimelineEventType_JiraTicket
+    };
+
+    // Bucket row indices per type in one pass instead of filtering the event list five times
+    QVector<int> rowsByType[5];
+    for (int i = 0; i < events.size(); ++i)
+    {
+        for (int t = 0; t < 5; ++t)
+        {
+            if (events[i].type == sheetTypes[t])
+            {
+                rowsByType[t].append(i);
+                break;
+            }
+        }
+    }
+
+    XlsxWriter xlsx;
+    if (!xlsx.open(filePath))
+    {
+        if (errorString)
+        {
+            *errorString = xlsx.errorString();
+        }
+        return false;
+    }
+
+    const QStringList commonHeaders = { "ID", "Title", "Start", "End", "Duration (days)", "Priority", "Lane" };
+
+    qint64 rowsWritten = 0;
+    int lastPercent = -1;
+
+    for (int t = 0; t < 5; ++t)
+    {
+        const TimelineEventType type = sheetTypes[t];
+
+        QStringList headers = commonHeaders;
+        switch (type)
+        {
+        case TimelineEventType_Meeting:     headers << "Location" << "Participants"; break;
+        case TimelineEventType_Action:      headers << "Status" << "Due"; break;
+        case TimelineEventType_TestEvent:   headers << "Category" << "Passed" << "Failed" << "Skipped"; break;
+        case TimelineEventType_Reminder:    headers << "Reminder" << "Recurrence"; break;
+        case TimelineEventType_JiraTicket:  headers << "Jira Key" << "Jira Summary" << "Jira Type" << "Jira Status"; break;
+        }
+        headers << "Description";
+
+        xlsx.beginSheet(eventTypeToDisplayString(type) + "s", headers);
+
+        for (int index : rowsByType[t])
+        {
+            const TimelineEvent& event = events[index];
+
+            // Per-row text is written inline; only repeated values go to the shared string table
+            xlsx.beginRow();
+            xlsx.addInlineString(event.id);
+            xlsx.addInlineString(event.title);
+            xlsx.addDateTime(event.startDate);
+            xlsx.addDateTime(event.endDate);
+            xlsx.addNumber(event.startDate.secsTo(event.endDate) / 86400.0);
+            xlsx.addNumber(event.priority);
+            xlsx.addNumber(event.lane);
+
+            switch (type)
+            {
+            case TimelineEventType_Meeting:
+                xlsx.addString(event.location);
+                xlsx.addInlineString(event.participants);
+                break;
+            case TimelineEventType_Action:
+                xlsx.addString(event.status);
+                xlsx.addDateTime(event.dueDateTime);
+                break;
+            case TimelineEventType_TestEvent:
+                xlsx.addString(event.testCategory);
+                if (event.hasTestResults())
+                {
+                    xlsx.addNumber(event.testsPassed);
+                    xlsx.addNumber(event.testsFailed);
+                    xlsx.addNumber(event.testsSkipped);
+                }
+                else
+                {
+                    xlsx.addEmpty();
+                    xlsx.addEmpty();
+                    xlsx.addEmpty();
+                }
+                break;
+            case TimelineEventType_Reminder:
+                xlsx.addDateTime(event.reminderDateTime);
+                xlsx.addString(event.recurringRule);
+                break;
+            case TimelineEventType_JiraTicket:
+                xlsx.addInlineString(event.jiraKey);
+                xlsx.addInlineString(event.jiraSummary);
+                xlsx.addString(event.jiraType);
+                xlsx.addString(event.jiraStatus);
+                break;
+            }
+
+            xlsx.addInlineString(event.description);
+            xlsx.endRow();
+
+            ++rowsWritten;
+
+            // Poll cancellation and report progress every 1024 rows
+            if ((rowsWritten & 0x3FF) == 0)
+            {
+                if (cancelFlag && cancelFlag->load())
+                {
+                    xlsx.close();
+                    QFile::remove(filePath);
+
+                    if (errorString)
+                    {
+                        *errorString = "Export cancelled";
+                    }
+                    return false;
+                }
+
+                if (progress && !events.isEmpty())
+                {
+                    const int percent = int(rowsWritten * 100 / events.size());
+                    if (percent != lastPercent)
+                    {
+                        lastPercent = percent;
+                        progress(percent);
+                    }
+                }
+            }
+        }
+
+        xlsx.endSheet();
+    }
+
+    const bool ok = xlsx.close();
+
+    if (!ok && errorString)
+    {
+        *errorString = xlsx.errorString();
+    }
+
+    if (ok && progress)
+    {
+        progress(100);
+    }
+
+    return ok;
+}
+
+
 bool TimelineExporter::exportToPDF(const TimelineModel* model,
                                    TimelineView* view,
                                    const QString& filePath,
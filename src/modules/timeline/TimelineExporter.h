@@ -5,9 +5,12 @@
 #include <QPixmap>
 #include <QVector>
 #include "TimelineModel.h"
+#include <atomic>
+#include <functional>
 
 class TimelineView;
 class QGraphicsScene;
+class TimelineBaselineComparator;
 
 /**
  * @class TimelineExporter
@@ -17,6 +20,7 @@ class QGraphicsScene;
  * - Screenshot export (PNG, JPG)
  * - CSV export (event list)
  * - PDF export (formatted event list with timeline image)
+ * - XLSX export (one worksheet per event type, streamed)
  * - Filtered exports (only specific events)
  */
 class TimelineExporter
@@ -49,6 +53,37 @@ public:
      */
     static bool exportEventsToCSV(const QVector<TimelineEvent>& events, const QString& filePath);
 
+    /**
+     * @brief Export a baseline slip report to CSV
+     * @param model Live timeline model
+     * @param comparator Comparator holding the loaded baseline and current diff
+     * @param filePath Output CSV file path
+     * @return true if export succeeded
+     *
+     * Only events that differ from the baseline are written, worst finish slip first.
+     */
+    static bool exportSlipReportToCSV(const TimelineModel* model,
+                                      const TimelineBaselineComparator* comparator,
+                                      const QString& filePath);
+
+    /**
+     * @brief Export events to an Excel workbook with one worksheet per event type
+     * @param events Events to export (pass a copy when calling from a worker thread)
+     * @param filePath Output .xlsx path
+     * @param cancelFlag Optional flag polled between rows
+     * @param progress Optional callback receiving 0-100
+     * @param errorString Optional output: reason for failure
+     * @return true if export succeeded
+     *
+     * Rows are streamed through XlsxWriter, so memory does not grow with the event count.
+     * Dates are written as typed date cells rather than text.
+     */
+    static bool exportToXLSX(const QVector<TimelineEvent>& events,
+                             const QString& filePath,
+                             const std::atomic_bool* cancelFlag = nullptr,
+                             const std::function<void(int)>& progress = {},
+                             QString* errorString = nullptr);
+
     /**
      * @brief Export timeline to PDF document
      * @param model Timeline model containing events
@@ -92,10 +127,15 @@ private:
     static QString getCSVHeader();
 
     /**
-     * @brief Convert event to CSV row
+     * @brief Convert event to CSV row (memoized per event revision)
      */
     static QString eventToCSVRow(const TimelineEvent& event);
 
+    /**
+     * @brief Build the CSV row for an event from scratch
+     */
+    static QString buildCSVRow(const TimelineEvent& event);
+
     /**
      * @brief Escape CSV field (handle quotes and commas)
      */
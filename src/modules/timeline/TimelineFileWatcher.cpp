@@ -0,0 +1,137 @@
+// TimelineFileWatcher.cpp
+
+
+#include "TimelineFileWatcher.h"
+#include <QFileSystemWatcher>
+#include <QCryptographicHash>
+#include <QTimer>
+#include <QFile>
+#include <QDebug>
+
+
+TimelineFileWatcher::TimelineFileWatcher(QObject* parent)
+    : QObject(parent)
+    , watcher_(new QFileSystemWatcher(this))
+    , settleTimer_(new QTimer(this))
+{
+    settleTimer_->setSingleShot(true);
+    settleTimer_->setInterval(SETTLE_DELAY_MS);
+
+    connect(watcher_, &QFileSystemWatcher::fileChanged, this, &TimelineFileWatcher::onFileChanged);
+    connect(settleTimer_, &QTimer::timeout, this, &TimelineFileWatcher::checkNow);
+}
+
+
+QByteArray TimelineFileWatcher::hashContent(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+
+QByteArray TimelineFileWatcher::hashFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return QByteArray();
+    }
+
+    return hashContent(file.readAll());
+}
+
+
+void TimelineFileWatcher::watch(const QString& filePath, const QByteArray& knownHash)
+{
+    if (!watcher_->files().isEmpty())
+    {
+        watcher_->removePaths(watcher_->files());
+    }
+    settleTimer_->stop();
+
+    filePath_ = filePath;
+    knownHash_ = knownHash;
+    reportedHash_.clear();
+
+    if (!filePath_.isEmpty())
+    {
+        watcher_->addPath(filePath_);
+    }
+}
+
+
+void TimelineFileWatcher::acceptContent(const QByteArray& knownHash)
+{
+    knownHash_ = knownHash;
+    reportedHash_.clear();
+
+    // Saving replaces the file (QSaveFile renames over it), which drops it from the watcher
+    if (!filePath_.isEmpty() && !watcher_->files().contains(filePath_))
+    {
+        watcher_->addPath(filePath_);
+    }
+}
+
+
+bool TimelineFileWatcher::isChangedOnDisk(QByteArray* data) const
+{
+    if (filePath_.isEmpty() || knownHash_.isEmpty())
+    {
+        return false;
+    }
+
+    // Text mode, like TimelineProjectLoader, so line endings hash the same
+    QFile file(filePath_);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return false;       // Deleted or unreachable: nothing to merge, the next save recreates it
+    }
+
+    const QByteArray content = file.readAll();
+    if (hashContent(content) == knownHash_)
+    {
+        return false;
+    }
+
+    if (data)
+    {
+        *data = content;
+    }
+    return true;
+}
+
+
+void TimelineFileWatcher::onFileChanged()
+{
+    settleTimer_->start();
+}
+
+
+void TimelineFileWatcher::checkNow()
+{
+    if (filePath_.isEmpty())
+    {
+        return;
+    }
+
+    // Re-arm: a replaced file is no longer watched
+    if (!watcher_->files().contains(filePath_))
+    {
+        watcher_->addPath(filePath_);
+    }
+
+    QByteArray data;
+    if (!isChangedOnDisk(&data))
+    {
+        return;     // Our own save, a touch, or a change that was reverted
+    }
+
+    const QByteArray hash = hashContent(data);
+    if (hash == reportedHash_)
+    {
+        return;
+    }
+    reportedHash_ = hash;
+
+    qDebug() << "TimelineFileWatcher: Project file changed on disk:" << filePath_;
+    emit fileChangedExternally(filePath_, data);
+}
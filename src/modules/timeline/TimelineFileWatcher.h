@@ -0,0 +1,62 @@
+// TimelineFileWatcher.h
+
+
+#pragma once
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+
+class QFileSystemWatcher;
+class QTimer;
+
+
+/**
+ * @class TimelineFileWatcher
+ * @brief Notices when someone else replaces the open project file
+ *
+ * Change notifications from network drives are unreliable: they arrive late,
+ * several times per save, or for our own writes. Each notification is therefore
+ * only a prompt to hash the file; fileChangedExternally() is emitted when the
+ * content differs from what was last loaded or saved here. Savers call
+ * isChangedOnDisk() right before writing, which catches changes the watcher
+ * missed altogether.
+ */
+class TimelineFileWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimelineFileWatcher(QObject* parent = nullptr);
+
+    static QByteArray hashContent(const QByteArray& data);                  ///< Digest used to compare file contents
+    static QByteArray hashFile(const QString& filePath);                    ///< Digest of a file read in text mode, like the loader (empty if unreadable)
+
+    void watch(const QString& filePath, const QByteArray& knownHash);      ///< Track a file whose content we know (empty path stops watching)
+    void acceptContent(const QByteArray& knownHash);                        ///< The file now holds this content (after a save or merge)
+    QString filePath() const { return filePath_; }
+
+    /**
+     * @brief Re-read the file and compare it with the known content
+     * @param data Receives the current content when it differs
+     */
+    bool isChangedOnDisk(QByteArray* data = nullptr) const;
+
+public slots:
+    void checkNow();                    ///< Hash the file now and report an external change (at most once per content)
+
+signals:
+    void fileChangedExternally(const QString& filePath, const QByteArray& data);
+
+private slots:
+    void onFileChanged();
+
+private:
+    QFileSystemWatcher* watcher_;
+    QTimer* settleTimer_;               ///< Waits for a burst of notifications (and the writer) to finish
+    QString filePath_;
+    QByteArray knownHash_;              ///< Content last loaded, saved or merged here
+    QByteArray reportedHash_;           ///< Content last reported, so one change is reported once
+
+    static constexpr int SETTLE_DELAY_MS = 750;
+};
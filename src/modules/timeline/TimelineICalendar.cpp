@@ -0,0 +1,940 @@
+// TimelineICalendar.cpp
+
+
+#include "TimelineICalendar.h"
+#include <QFile>
+#include <QTextStream>
+#include <QTimeZone>
+#include <QHash>
+#include <QDebug>
+
+
+static const QLatin1String UID_SUFFIX("@testleadtoolbox");
+static const int MAX_LINE_OCTETS = 75;
+
+
+// ============================================================================
+// Parsing helpers
+// ============================================================================
+
+// Helper: Case-insensitive comparison of a property/parameter name
+static bool nameIs(QStringView name, QLatin1String expected)
+{
+    return name.compare(expected, Qt::CaseInsensitive) == 0;
+}
+
+
+// Helper: Value of a parameter in ";KEY=value;KEY2="quoted"" (empty if absent)
+static QStringView paramValue(QStringView params, QLatin1String key)
+{
+    qsizetype pos = 0;
+
+    while (pos < params.size())
+    {
+        // Each parameter starts after a ';'
+        if (params[pos] != u';')
+        {
+            ++pos;
+            continue;
+        }
+
+        const qsizetype keyStart = pos + 1;
+        const qsizetype eq = params.indexOf(u'=', keyStart);
+        if (eq < 0)
+        {
+            break;
+        }
+
+        qsizetype valueStart = eq + 1;
+        qsizetype valueEnd = valueStart;
+        bool quoted = valueStart < params.size() && params[valueStart] == u'"';
+
+        if (quoted)
+        {
+            ++valueStart;
+            valueEnd = params.indexOf(u'"', valueStart);
+            if (valueEnd < 0)
+            {
+                valueEnd = params.size();
+            }
+        }
+        else
+        {
+            valueEnd = params.indexOf(u';', valueStart);
+            if (valueEnd < 0)
+            {
+                valueEnd = params.size();
+            }
+        }
+
+        if (nameIs(params.sliced(keyStart, eq - keyStart), key))
+        {
+            return params.sliced(valueStart, valueEnd - valueStart);
+        }
+
+        pos = quoted ? valueEnd + 1 : valueEnd;
+    }
+
+    return QStringView();
+}
+
+
+// Helper: Parse a fixed-width run of digits, -1 on malformed input
+static int parseDigits(QStringView text, qsizetype from, qsizetype count)
+{
+    if (from + count > text.size())
+    {
+        return -1;
+    }
+
+    int value = 0;
+    for (qsizetype i = from; i < from + count; ++i)
+    {
+        const char16_t c = text[i].unicode();
+        if (c < u'0' || c > u'9')
+        {
+            return -1;
+        }
+        value = value * 10 + (c - u'0');
+    }
+
+    return value;
+}
+
+
+// Helper: Parse DATE ("20250131") or DATE-TIME ("20250131T093000[Z]") into local time
+static QDateTime parseDateTime(QStringView value, QStringView params, bool* dateOnly,
+                               QHash<QString, QTimeZone>& zoneCache)
+{
+    const QDate date(parseDigits(value, 0, 4), parseDigits(value, 4, 2), parseDigits(value, 6, 2));
+    if (!date.isValid())
+    {
+        return QDateTime();
+    }
+
+    *dateOnly = value.size() == 8 || nameIs(paramValue(params, QLatin1String("VALUE")), QLatin1String("DATE"));
+    if (*dateOnly)
+    {
+        return QDateTime(date, QTime(0, 0));
+    }
+
+    if (value.size() < 15 || value[8] != u'T')
+    {
+        return QDateTime();
+    }
+
+    const QTime time(parseDigits(value, 9, 2), parseDigits(value, 11, 2), parseDigits(value, 13, 2));
+    if (!time.isValid())
+    {
+        return QDateTime();
+    }
+
+    // UTC
+    if (value.size() > 15 && value[15] == u'Z')
+    {
+        return QDateTime(date, time, QTimeZone::utc()).toLocalTime();
+    }
+
+    // Named zone - QTimeZone construction is not cheap, so cache per TZID
+    const QStringView tzid = paramValue(params, QLatin1String("TZID"));
+    if (!tzid.isEmpty())
+    {
+        const QString key = tzid.toString();
+        auto it = zoneCache.constFind(key);
+        if (it == zoneCache.constEnd())
+        {
+            it = zoneCache.insert(key, QTimeZone(key.toUtf8()));
+        }
+
+        if (it->isValid())
+        {
+            return QDateTime(date, time, it.value()).toLocalTime();
+        }
+    }
+
+    // Floating time - interpreted as local
+    return QDateTime(date, time);
+}
+
+
+// Helper: Parse a DURATION value ("P1D", "PT1H30M", "-P2W") into seconds
+static qint64 parseDuration(QStringView value)
+{
+    qint64 sign = 1;
+    qsizetype pos = 0;
+
+    if (pos < value.size() && (value[pos] == u'-' || value[pos] == u'+'))
+    {
+        sign = value[pos] == u'-' ? -1 : 1;
+        ++pos;
+    }
+
+    if (pos >= value.size() || value[pos] != u'P')
+    {
+        return 0;
+    }
+    ++pos;
+
+    qint64 total = 0;
+    qint64 number = 0;
+
+    for (; pos < value.size(); ++pos)
+    {
+        const char16_t c = value[pos].unicode();
+
+        if (c >= u'0' && c <= u'9')
+        {
+            number = number * 10 + (c - u'0');
+            continue;
+        }
+
+        switch (c)
+        {
+        case u'W': total += number * 7 * 86400; break;
+        case u'D': total += number * 86400;     break;
+        case u'H': total += number * 3600;      break;
+        case u'M': total += number * 60;        break;
+        case u'S': total += number;             break;
+        default:                                break;     // 'T' separator
+        }
+        number = 0;
+    }
+
+    return sign * total;
+}
+
+
+// Helper: Map the RRULE frequency onto the reminder recurrence names used by the dialogs
+static QString recurrenceFromRule(QStringView rule)
+{
+    const qsizetype freqPos = rule.indexOf(QLatin1String("FREQ="), 0, Qt::CaseInsensitive);
+    if (freqPos < 0)
+    {
+        return QString();
+    }
+
+    QStringView freq = rule.sliced(freqPos + 5);
+    const qsizetype end = freq.indexOf(u';');
+    if (end >= 0)
+    {
+        freq = freq.first(end);
+    }
+
+    if (nameIs(freq, QLatin1String("DAILY")))
+        return "Daily";
+    if (nameIs(freq, QLatin1String("WEEKLY")))
+        return "Weekly";
+    if (nameIs(freq, QLatin1String("MONTHLY")))
+        return "Monthly";
+
+    return QString();
+}
+
+
+static QLatin1String typeToIcsName(TimelineEventType type)
+{
+    switch (type)
+    {
+    case TimelineEventType_Meeting:     return QLatin1String("Meeting");
+    case TimelineEventType_Action:      return QLatin1String("Action");
+    case TimelineEventType_TestEvent:   return QLatin1String("TestEvent");
+    case TimelineEventType_Reminder:    return QLatin1String("Reminder");
+    case TimelineEventType_JiraTicket:  return QLatin1String("JiraTicket");
+    }
+
+    return QLatin1String("Meeting");
+}
+
+
+static bool typeFromIcsName(QStringView name, TimelineEventType* type)
+{
+    static const TimelineEventType types[] = {
+        TimelineEventType_Meeting, TimelineEventType_Action, TimelineEventType_TestEvent,
+        TimelineEventType_Reminder, TimelineEventType_JiraTicket
+    };
+
+    for (TimelineEventType candidate : types)
+    {
+        if (nameIs(name, typeToIcsName(candidate)))
+        {
+            *type = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// Parser state for the VEVENT being read
+struct PendingEvent
+{
+    TimelineEvent event;
+    QDateTime start;
+    QDateTime end;
+    bool startDateOnly = false;
+    bool endDateOnly = false;
+    bool hasEnd = false;
+    bool hasDuration = false;
+    bool hasType = false;
+    qint64 durationSecs = 0;
+    QStringList participants;
+};
+
+
+// Helper: Turn a completed VEVENT into a timeline event, false if it has no usable start
+static bool finishEvent(PendingEvent& pending)
+{
+    TimelineEvent& event = pending.event;
+
+    if (!pending.start.isValid())
+    {
+        return false;
+    }
+
+    QDateTime end;
+    if (pending.hasEnd && pending.end.isValid())
+    {
+        end = pending.end;
+    }
+    else if (pending.hasDuration)
+    {
+        end = pending.start.addSecs(pending.durationSecs);
+    }
+    else
+    {
+        // RFC 5545: a DATE start without an end spans one day, a DATE-TIME start is instantaneous
+        end = pending.startDateOnly ? pending.start.addDays(1) : pending.start;
+    }
+
+    // iCalendar all-day ends are exclusive; the timeline uses an inclusive 23:59:59 end
+    if (pending.startDateOnly)
+    {
+        end = end.addSecs(-1);
+    }
+
+    if (end < pending.start)
+    {
+        end = pending.start;
+    }
+
+    if (!pending.hasType)
+    {
+        event.type = (!pending.startDateOnly && end == pending.start) ? TimelineEventType_Reminder
+                                                                       : TimelineEventType_Meeting;
+    }
+
+    event.startDate = pending.start;
+    event.endDate = end;
+
+    // Legacy fields
+    event.startTime = event.startDate.time();
+    event.endTime = event.endDate.time();
+
+    if (event.type == TimelineEventType_Reminder)
+    {
+        event.reminderDateTime = event.startDate;
+    }
+    else if (event.type == TimelineEventType_Action)
+    {
+        event.dueDateTime = event.endDate;
+    }
+
+    if (!pending.participants.isEmpty())
+    {
+        event.participants = pending.participants.join(", ");
+    }
+
+    if (event.title.isEmpty())
+    {
+        event.title = "(No title)";
+    }
+
+    return true;
+}
+
+
+// Helper: Apply one unfolded content line to the VEVENT being read
+static void applyProperty(PendingEvent& pending, QStringView line, QHash<QString, QTimeZone>& zoneCache)
+{
+    // Split "NAME;PARAMS:VALUE" - ':' inside quoted parameter values does not end the name part
+    qsizetype colon = -1;
+    bool inQuotes = false;
+    for (qsizetype i = 0; i < line.size(); ++i)
+    {
+        const QChar c = line[i];
+        if (c == u'"')
+        {
+            inQuotes = !inQuotes;
+        }
+        else if (c == u':' && !inQuotes)
+        {
+            colon = i;
+            break;
+        }
+    }
+
+    if (colon < 0)
+    {
+        return;
+    }
+
+    const QStringView head = line.first(colon);
+    const QStringView value = line.sliced(colon + 1);
+    const qsizetype semicolon = head.indexOf(u';');
+    const QStringView name = semicolon < 0 ? head : head.first(semicolon);
+    const QStringView params = semicolon < 0 ? QStringView() : head.sliced(semicolon);
+
+    TimelineEvent& event = pending.event;
+
+    if (nameIs(name, QLatin1String("DTSTART")))
+    {
+        pending.start = parseDateTime(value, params, &pending.startDateOnly, zoneCache);
+    }
+    else if (nameIs(name, QLatin1String("DTEND")))
+    {
+        pending.end = parseDateTime(value, params, &pending.endDateOnly, zoneCache);
+        pending.hasEnd = true;
+    }
+    else if (nameIs(name, QLatin1String("DURATION")))
+    {
+        pending.durationSecs = parseDuration(value);
+        pending.hasDuration = true;
+    }
+    else if (nameIs(name, QLatin1String("SUMMARY")))
+    {
+        event.title = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("DESCRIPTION")))
+    {
+        event.description = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("LOCATION")))
+    {
+        event.location = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("UID")))
+    {
+        // Only UIDs we wrote ourselves map back onto event IDs
+        if (value.endsWith(UID_SUFFIX))
+        {
+            event.id = value.chopped(UID_SUFFIX.size()).toString();
+        }
+    }
+    else if (nameIs(name, QLatin1String("RRULE")))
+    {
+        event.recurringRule = recurrenceFromRule(value);
+    }
+    else if (nameIs(name, QLatin1String("ATTENDEE")))
+    {
+        QStringView display = paramValue(params, QLatin1String("CN"));
+        if (display.isEmpty())
+        {
+            display = value.startsWith(QLatin1String("mailto:"), Qt::CaseInsensitive) ? value.sliced(7) : value;
+        }
+
+        if (!display.isEmpty())
+        {
+            pending.participants.append(display.toString());
+        }
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-TYPE")))
+    {
+        pending.hasType = typeFromIcsName(value, &event.type);
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-PRIORITY")))
+    {
+        event.priority = qBound(0, value.toInt(), 5);
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-STATUS")))
+    {
+        event.status = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-TEST-CATEGORY")))
+    {
+        event.testCategory = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-JIRA-KEY")))
+    {
+        event.jiraKey = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-JIRA-SUMMARY")))
+    {
+        event.jiraSummary = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-JIRA-TYPE")))
+    {
+        event.jiraType = TimelineICalendar::unescape(value);
+    }
+    else if (nameIs(name, QLatin1String("X-TESTLEAD-JIRA-STATUS")))
+    {
+        event.jiraStatus = TimelineICalendar::unescape(value);
+    }
+}
+
+
+// ============================================================================
+// Writing helpers
+// ============================================================================
+
+/**
+ * @brief Writes content lines straight into the stream, folding at 75 octets
+ *
+ * Values are escaped and folded while they are copied, so nothing is assembled
+ * in a temporary string first.
+ */
+class IcsLineWriter
+{
+public:
+    explicit IcsLineWriter(QTextStream& out) : out_(out) {}
+
+    void begin(QLatin1String head)
+    {
+        out_ << head;
+        octets_ = int(head.size());
+    }
+
+    void end()
+    {
+        out_ << "\r\n";
+    }
+
+    void raw(QStringView value)
+    {
+        write(value, false);
+    }
+
+    void text(QStringView value)
+    {
+        write(value, true);
+    }
+
+    void line(QLatin1String nameAndParams, QStringView value, bool escape = false)
+    {
+        begin(nameAndParams);
+        write(u":", false);
+        write(value, escape);
+        end();
+    }
+
+private:
+    void write(QStringView value, bool escape)
+    {
+        qsizetype chunkStart = 0;
+
+        for (qsizetype i = 0; i < value.size(); ++i)
+        {
+            const char16_t c = value[i].unicode();
+
+            const char* escaped = nullptr;
+            if (escape)
+            {
+                switch (c)
+                {
+                case u'\\': escaped = "\\\\"; break;
+                case u';':  escaped = "\\;";  break;
+                case u',':  escaped = "\\,";  break;
+                case u'\n': escaped = "\\n";  break;
+                case u'\r': escaped = "";     break;     // CRLF collapses onto the \n escape
+                default:                      break;
+                }
+            }
+
+            int width = escaped ? int(qstrlen(escaped))
+                        : c < 0x80           ? 1
+                        : c < 0x800          ? 2
+                        : QChar::isHighSurrogate(c) ? 4
+                        : QChar::isLowSurrogate(c)  ? 0      // counted with its high surrogate
+                                                    : 3;
+
+            if (width > 0 && octets_ + width > MAX_LINE_OCTETS)
+            {
+                out_ << value.sliced(chunkStart, i - chunkStart) << "\r\n ";
+                chunkStart = i;
+                octets_ = 1;
+            }
+
+            if (escaped)
+            {
+                out_ << value.sliced(chunkStart, i - chunkStart) << escaped;
+                chunkStart = i + 1;
+            }
+
+            octets_ += width;
+        }
+
+        out_ << value.sliced(chunkStart);
+    }
+
+    QTextStream& out_;
+    int octets_ = 0;
+};
+
+
+// Helper: Format a UTC DATE-TIME ("20250131T083000Z") into a caller-provided buffer
+static QStringView formatUtc(const QDateTime& dateTime, char16_t (&buffer)[16])
+{
+    const QDateTime utc = dateTime.toUTC();
+    const QDate d = utc.date();
+    const QTime t = utc.time();
+
+    const int fields[] = { d.year(), d.month(), d.day(), t.hour(), t.minute(), t.second() };
+    const int widths[] = { 4, 2, 2, 2, 2, 2 };
+
+    int pos = 0;
+    for (int f = 0; f < 6; ++f)
+    {
+        if (f == 3)
+        {
+            buffer[pos++] = u'T';
+        }
+
+        int value = fields[f];
+        for (int w = widths[f] - 1; w >= 0; --w)
+        {
+            buffer[pos + w] = char16_t(u'0' + value % 10);
+            value /= 10;
+        }
+        pos += widths[f];
+    }
+
+    buffer[pos++] = u'Z';
+    return QStringView(buffer, pos);
+}
+
+
+// Helper: Format a DATE ("20250131") into a caller-provided buffer
+static QStringView formatDate(const QDate& date, char16_t (&buffer)[16])
+{
+    int value = date.year() * 10000 + date.month() * 100 + date.day();
+    for (int i = 7; i >= 0; --i)
+    {
+        buffer[i] = char16_t(u'0' + value % 10);
+        value /= 10;
+    }
+
+    return QStringView(buffer, 8);
+}
+
+
+// Helper: Events entered as "all day" use 00:00 - 23:59:59 (or legacy midnight-to-midnight)
+static bool isAllDay(const QDateTime& start, const QDateTime& end)
+{
+    return start.time() == QTime(0, 0)
+           && (end.time() == QTime(23, 59, 59) || end.time() == QTime(0, 0))
+           && end.date() >= start.date();
+}
+
+
+static void writeEvent(IcsLineWriter& writer, const TimelineEvent& event, QStringView stamp)
+{
+    char16_t buffer[16];
+
+    const QDateTime start = (event.type == TimelineEventType_Reminder && event.reminderDateTime.isValid())
+                                ? event.reminderDateTime
+                                : event.startDate;
+    const QDateTime end = event.endDate.isValid() ? event.endDate : start;
+
+    writer.line(QLatin1String("BEGIN"), u"VEVENT");
+
+    writer.begin(QLatin1String("UID:"));
+    writer.raw(event.id);
+    writer.raw(UID_SUFFIX);
+    writer.end();
+
+    writer.line(QLatin1String("DTSTAMP"), stamp);
+
+    if (isAllDay(start, end))
+    {
+        writer.line(QLatin1String("DTSTART;VALUE=DATE"), formatDate(start.date(), buffer));
+        writer.line(QLatin1String("DTEND;VALUE=DATE"), formatDate(end.date().addDays(1), buffer));
+    }
+    else
+    {
+        writer.line(QLatin1String("DTSTART"), formatUtc(start, buffer));
+
+        // Point-in-time reminders have no end
+        if (end > start)
+        {
+            writer.line(QLatin1String("DTEND"), formatUtc(end, buffer));
+        }
+    }
+
+    writer.line(QLatin1String("SUMMARY"), event.title, true);
+
+    if (!event.description.isEmpty())
+        writer.line(QLatin1String("DESCRIPTION"), event.description, true);
+    if (!event.location.isEmpty())
+        writer.line(QLatin1String("LOCATION"), event.location, true);
+
+    if (!event.participants.isEmpty())
+    {
+        for (QStringView participant : QStringView(event.participants).split(u','))
+        {
+            participant = participant.trimmed();
+            if (participant.isEmpty() || participant.contains(u'"'))
+            {
+                continue;
+            }
+
+            if (participant.contains(u'@'))
+            {
+                writer.begin(QLatin1String("ATTENDEE:mailto:"));
+                writer.raw(participant);
+            }
+            else
+            {
+                // Name-only participants - keep the name in CN, the value must still be a URI
+                writer.begin(QLatin1String("ATTENDEE;CN=\""));
+                writer.raw(participant);
+                writer.raw(u"\":urn:x-testlead:participant");
+            }
+            writer.end();
+        }
+    }
+
+    if (event.recurringRule == "Daily")
+        writer.line(QLatin1String("RRULE"), u"FREQ=DAILY");
+    else if (event.recurringRule == "Weekly")
+        writer.line(QLatin1String("RRULE"), u"FREQ=WEEKLY");
+    else if (event.recurringRule == "Monthly")
+        writer.line(QLatin1String("RRULE"), u"FREQ=MONTHLY");
+
+    const QLatin1String typeName = typeToIcsName(event.type);
+    writer.line(QLatin1String("CATEGORIES"), QString(typeName));
+    writer.line(QLatin1String("X-TESTLEAD-TYPE"), QString(typeName));
+
+    if (event.priority != 0)
+        writer.line(QLatin1String("X-TESTLEAD-PRIORITY"), QString::number(event.priority));
+    if (!event.status.isEmpty())
+        writer.line(QLatin1String("X-TESTLEAD-STATUS"), event.status, true);
+    if (!event.testCategory.isEmpty())
+        writer.line(QLatin1String("X-TESTLEAD-TEST-CATEGORY"), event.testCategory, true);
+    if (!event.jiraKey.isEmpty())
+        writer.line(QLatin1String("X-TESTLEAD-JIRA-KEY"), event.jiraKey, true);
+    if (!event.jiraSummary.isEmpty())
+        writer.line(QLatin1String("X-TESTLEAD-JIRA-SUMMARY"), event.jiraSummary, true);
+    if (!event.jiraType.isEmpty())
+        writer.line(QLatin1String("X-TESTLEAD-JIRA-TYPE"), event.jiraType, true);
+    if (!event.jiraStatus.isEmpty())
+        writer.line(QLatin1String("X-TESTLEAD-JIRA-STATUS"), event.jiraStatus, true);
+
+    writer.line(QLatin1String("END"), u"VEVENT");
+}
+
+
+// ============================================================================
+// TimelineICalendar
+// ============================================================================
+
+bool TimelineICalendar::importFromFile(const QString& filePath,
+                                       QVector<TimelineEvent>& events,
+                                       QString* errorString)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        if (errorString)
+        {
+            *errorString = file.errorString();
+        }
+        qWarning() << "TimelineICalendar: Cannot open" << filePath << "-" << file.errorString();
+        return false;
+    }
+
+    QTextStream in(&file);
+
+    QHash<QString, QTimeZone> zoneCache;
+    PendingEvent pending;
+    bool sawCalendar = false;
+    bool inEvent = false;
+    int nestedDepth = 0;                // VALARM etc. inside the current VEVENT
+    int skipped = 0;
+
+    QString physical;
+    QString logical;
+    bool haveLogical = false;
+
+    auto processLine = [&](QStringView line)
+    {
+        if (line.startsWith(QLatin1String("BEGIN:"), Qt::CaseInsensitive))
+        {
+            const QStringView component = line.sliced(6);
+
+            if (nameIs(component, QLatin1String("VCALENDAR")))
+            {
+                sawCalendar = true;
+            }
+            else if (inEvent)
+            {
+                ++nestedDepth;
+            }
+            else if (nameIs(component, QLatin1String("VEVENT")))
+            {
+                inEvent = true;
+                nestedDepth = 0;
+                pending = PendingEvent();
+            }
+            return;
+        }
+
+        if (line.startsWith(QLatin1String("END:"), Qt::CaseInsensitive))
+        {
+            if (!inEvent)
+            {
+                return;
+            }
+
+            if (nestedDepth > 0)
+            {
+                --nestedDepth;
+            }
+            else if (nameIs(line.sliced(4), QLatin1String("VEVENT")))
+            {
+                inEvent = false;
+
+                if (finishEvent(pending))
+                {
+                    events.append(std::move(pending.event));
+                }
+                else
+                {
+                    ++skipped;
+                }
+            }
+            return;
+        }
+
+        if (inEvent && nestedDepth == 0)
+        {
+            applyProperty(pending, line, zoneCache);
+        }
+    };
+
+    // Unfold on the fly: a line starting with a space or tab continues the previous one
+    while (in.readLineInto(&physical))
+    {
+        if (!physical.isEmpty() && (physical[0] == u' ' || physical[0] == u'\t'))
+        {
+            logical += QStringView(physical).sliced(1);
+            continue;
+        }
+
+        if (haveLogical)
+        {
+            processLine(logical);
+        }
+
+        logical.swap(physical);
+        haveLogical = true;
+    }
+
+    if (haveLogical)
+    {
+        processLine(logical);
+    }
+
+    if (!sawCalendar)
+    {
+        if (errorString)
+        {
+            *errorString = "The file does not contain a VCALENDAR object.";
+        }
+        qWarning() << "TimelineICalendar: No VCALENDAR in" << filePath;
+        return false;
+    }
+
+    qDebug() << "TimelineICalendar: Imported" << events.size() << "events from" << filePath
+             << "(" << skipped << "skipped without a start date )";
+
+    return true;
+}
+
+
+bool TimelineICalendar::exportToFile(const TimelineModel* model, const QString& filePath)
+{
+    if (!model)
+    {
+        return false;
+    }
+
+    return exportEventsToFile(model->getAllEvents(), filePath);
+}
+
+
+bool TimelineICalendar::exportEventsToFile(const QVector<TimelineEvent>& events, const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "TimelineICalendar: Cannot write" << filePath << "-" << file.errorString();
+        return false;
+    }
+
+    // Binary mode: iCalendar mandates CRLF regardless of platform
+    QTextStream out(&file);
+    IcsLineWriter writer(out);
+
+    // DTSTAMP is the same for every event in one export
+    char16_t stampBuffer[16];
+    const QStringView stamp = formatUtc(QDateTime::currentDateTimeUtc(), stampBuffer);
+
+    writer.line(QLatin1String("BEGIN"), u"VCALENDAR");
+    writer.line(QLatin1String("VERSION"), u"2.0");
+    writer.line(QLatin1String("PRODID"), u"-//TestLeadToolbox//Timeline//EN");
+    writer.line(QLatin1String("CALSCALE"), u"GREGORIAN");
+
+    for (const TimelineEvent& event : events)
+    {
+        writeEvent(writer, event, stamp);
+    }
+
+    writer.line(QLatin1String("END"), u"VCALENDAR");
+
+    out.flush();
+
+    if (out.status() != QTextStream::Ok)
+    {
+        qWarning() << "TimelineICalendar: Write error on" << filePath;
+        return false;
+    }
+
+    qDebug() << "TimelineICalendar: Exported" << events.size() << "events to" << filePath;
+    return true;
+}
+
+
+QString TimelineICalendar::unescape(QStringView text)
+{
+    // Fast path: most values contain no escapes
+    if (!text.contains(u'\\'))
+    {
+        return text.toString();
+    }
+
+    QString result;
+    result.reserve(text.size());
+
+    for (qsizetype i = 0; i < text.size(); ++i)
+    {
+        const QChar c = text[i];
+
+        if (c != u'\\' || i + 1 >= text.size())
+        {
+            result.append(c);
+            continue;
+        }
+
+        const QChar next = text[++i];
+        if (next == u'n' || next == u'N')
+        {
+            result.append(u'\n');
+        }
+        else
+        {
+            result.append(next);        // \\ \; \, and anything unknown
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,58 @@
+// TimelineICalendar.h
+
+
+#pragma once
+#include "TimelineModel.h"
+#include <QString>
+#include <QVector>
+
+
+/**
+ * @class TimelineICalendar
+ * @brief Streams timeline events to and from iCalendar (RFC 5545) .ics files
+ *
+ * Both directions work line by line on a QTextStream, so memory stays proportional
+ * to the resulting event list rather than to the file:
+ * - Import unfolds continuation lines on the fly and maps each VEVENT into a
+ *   TimelineEvent. Nested components (VALARM) and VTIMEZONE blocks are skipped;
+ *   TZID parameters are resolved through QTimeZone.
+ * - Export writes each property straight into the stream, folding at 75 octets,
+ *   without assembling a per-event string.
+ *
+ * Events exported by this class carry their ID in the UID ("<id>@testleadtoolbox")
+ * and their type in X-TESTLEAD-TYPE, so a round trip restores both.
+ */
+class TimelineICalendar
+{
+public:
+    /**
+     * @brief Parse an .ics file into timeline events
+     * @param filePath Calendar file to read
+     * @param events Output: parsed events (appended)
+     * @param errorString Optional output: reason for failure
+     * @return true if the file was read (an empty calendar is not an error)
+     *
+     * The result is meant to be inserted with TimelineModel::addEvents() in one batch.
+     */
+    static bool importFromFile(const QString& filePath,
+                               QVector<TimelineEvent>& events,
+                               QString* errorString = nullptr);
+
+    /**
+     * @brief Write all events of the model to an .ics file
+     * @param model Timeline model to export
+     * @param filePath Output .ics path
+     * @return true if export succeeded
+     */
+    static bool exportToFile(const TimelineModel* model, const QString& filePath);
+
+    /**
+     * @brief Write the given events to an .ics file (filtered export)
+     */
+    static bool exportEventsToFile(const QVector<TimelineEvent>& events, const QString& filePath);
+
+    /**
+     * @brief Decode a TEXT value (\n, \, \; \\ escapes)
+     */
+    static QString unescape(QStringView text);
+};
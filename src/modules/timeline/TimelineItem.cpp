@@ -113,6 +113,12 @@ void TimelineItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* opti
                 painter->drawText(rect_.adjusted(5, 0, -5, 0), Qt::AlignVCenter | Qt::AlignLeft, elidedText);
             }
 
+            // Imported test results (pass/fail/skip) along the bottom edge
+            if (event->type == TimelineEventType_TestEvent && event->hasTestResults())
+            {
+                drawTestResultStrip(painter, *event);
+            }
+
             // Calculate icon positioning based on what icons need to be shown
             // Icons are positioned right-to-left: [Lock Icon] [Attachment Icon] (right edge)
             const double LOCK_ICON_SIZE = 16.0;
@@ -177,6 +183,51 @@ void TimelineItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* opti
 }
 
 
+void TimelineItem::drawTestResultStrip(QPainter* painter, const TimelineEvent& event)
+{
+    const double STRIP_HEIGHT = 4.0;
+
+    QRectF strip(rect_.left() + 1, rect_.bottom() - STRIP_HEIGHT - 1, rect_.width() - 2, STRIP_HEIGHT);
+    if (strip.width() <= 0)
+    {
+        return;
+    }
+
+    painter->save();
+    painter->setPen(Qt::NoPen);
+
+    int total = event.testsPassed + event.testsFailed + event.testsSkipped;
+    if (total == 0)
+    {
+        // Results imported but no test cases ran
+        painter->setBrush(QColor(158, 158, 158));
+        painter->drawRect(strip);
+        painter->restore();
+        return;
+    }
+
+    // Segments proportional to outcome counts: passed (green), failed (red), skipped (amber)
+    const QColor colors[3] = { QColor(76, 175, 80), QColor(220, 50, 47), QColor(255, 193, 7) };
+    const int counts[3] = { event.testsPassed, event.testsFailed, event.testsSkipped };
+
+    double x = strip.left();
+    for (int i = 0; i < 3; ++i)
+    {
+        if (counts[i] == 0)
+        {
+            continue;
+        }
+
+        double width = strip.width() * counts[i] / total;
+        painter->setBrush(colors[i]);
+        painter->drawRect(QRectF(x, strip.top(), width, strip.height()));
+        x += width;
+    }
+
+    painter->restore();
+}
+
+
 void TimelineItem::drawLockIcon(QPainter* painter) {
     QRectF itemRect = rect();
 
@@ -339,7 +390,7 @@ QVariant TimelineItem::itemChange(GraphicsItemChange change, const QVariant& val
                         {
                             itemIsLocked = event->isLocked;
                             itemIsFixed = event->isFixed;
-                            itemLaneControlEnabled = event->laneControlEnabled;
+                            itemLaneControlEnabled = event->laneControlEnabled && timelineItem->verticalDragEnabled_;
                         }
                     }
 
@@ -383,7 +434,7 @@ QVariant TimelineItem::itemChange(GraphicsItemChange change, const QVariant& val
                 const TimelineEvent* event = model_->getEvent(eventId_);
                 if (event)
                 {
-                    laneControlEnabled = event->laneControlEnabled;
+                    laneControlEnabled = event->laneControlEnabled && verticalDragEnabled_;
                 }
             }
 
@@ -416,7 +467,7 @@ QVariant TimelineItem::itemChange(GraphicsItemChange change, const QVariant& val
                 const TimelineEvent* event = model_->getEvent(eventId_);
                 if (event)
                 {
-                    laneControlEnabled = event->laneControlEnabled;
+                    laneControlEnabled = event->laneControlEnabled && verticalDragEnabled_;
                 }
             }
 
@@ -840,7 +891,7 @@ void TimelineItem::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
                         updatedEvent.endDate = newEndDateTime;
 
                         // If lane control is enabled, update the lane
-                        if (currentEvent->laneControlEnabled)
+                        if (currentEvent->laneControlEnabled && timelineItem->verticalDragEnabled_)
                         {
                             qDebug() << "║ Lane control enabled - calculating lane from Y position";
                             qDebug() << "║ Current event lane (before):" << currentEvent->lane;
@@ -1191,7 +1242,7 @@ void TimelineItem::updateModelFromPosition()
     }
 
     // If lane control is enabled, update the lane based on Y position
-    if (currentEvent->laneControlEnabled)
+    if (currentEvent->laneControlEnabled && verticalDragEnabled_)
     {
         int newLane = calculateLaneFromYPosition();
 
@@ -11,6 +11,7 @@
 
 
 class TimelineModel;
+struct TimelineEvent;
 class TimelineCoordinateMapper;
 class QGraphicsSceneMouseEvent;
 class QGraphicsSceneHoverEvent;
@@ -58,6 +59,10 @@ public:
 
     void setEventId(const QString& eventId) { eventId_ = eventId; }                     ///< @brief Set the event ID this item represents
     QString eventId() const { return eventId_; }                                        ///< @brief Get the event ID
+    void setModelRevision(quint64 revision) { modelRevision_ = revision; }              ///< @brief Record the event revision this item was last built from
+    quint64 modelRevision() const { return modelRevision_; }                            ///< @brief Event revision this item was last built from
+    void setVerticalDragEnabled(bool enabled) { verticalDragEnabled_ = enabled; }       ///< @brief Allow manual-lane items to be dragged between lanes (off while swimlanes are grouped)
+    bool verticalDragEnabled() const { return verticalDragEnabled_; }                   ///< @brief Whether manual-lane items may be dragged between lanes
     void setModel(TimelineModel* model) { model_ = model; }                             ///< @brief Set the model reference (required for updates)
     void setCoordinateMapper(TimelineCoordinateMapper* mapper) { mapper_ = mapper; }    ///< @brief Set the coordinate mapper (required for date conversion)
     void setUndoStack(QUndoStack* undoStack) { undoStack_ = undoStack; }                ///< @brief Set the undo stack (required for undo/redo support)
@@ -105,6 +110,7 @@ private:
     void updateCursor(ResizeHandle handle);                                     ///< @brief Update cursor based on resize handle
     void drawAttachmentIndicator(QPainter* painter, double iconX);              ///<
     void drawDragOverlay(QPainter* painter);                                    ///<
+    void drawTestResultStrip(QPainter* painter, const TimelineEvent& event);    ///< Pass/fail/skip strip along the bottom edge
 
     TimelineModel* model_ = nullptr;                        ///< Model reference (not owned)
     TimelineCoordinateMapper* mapper_ = nullptr;            ///< Coordinate mapper (not owned)
@@ -123,6 +129,8 @@ private:
     QBrush brush_;                                          ///< Fill brush
     QPen pen_;                                              ///< Border pen
     QString eventId_;                                       ///< ID of the event this item represents
+    quint64 modelRevision_ = 0;                             ///< Event revision the geometry and styling reflect
+    bool verticalDragEnabled_ = true;                       ///< Whether Y follows the mouse for manual-lane events
 
     QPointF dragStartPos_;                                  ///< Position when drag started
     QRectF resizeStartRect_;                                ///< Rectangle when resize started
@@ -0,0 +1,317 @@
+// TimelineMerge.cpp
+
+
+#include "TimelineMerge.h"
+#include <QDebug>
+#include <algorithm>
+#include <utility>
+
+
+TimelineMergeBase TimelineMerge::snapshot(const TimelineModel* model)
+{
+    TimelineMergeBase base;
+    base.versionStart = model->versionStartDate();
+    base.versionEnd = model->versionEndDate();
+    base.versionName = model->versionName();
+
+    const QVector<TimelineEvent> events = model->getAllEvents();
+    const QVector<TimelineEvent> archived = model->getAllArchivedEvents();
+    base.eventHashes.reserve(events.size() + archived.size());
+
+    for (const TimelineEvent& event : events)
+    {
+        base.eventHashes.insert(event.id, TimelineSerializer::eventHash(event));
+    }
+    for (const TimelineEvent& event : archived)
+    {
+        base.eventHashes.insert(event.id, TimelineSerializer::eventHash(event));
+    }
+
+    return base;
+}
+
+
+TimelineMergeBase TimelineMerge::snapshot(const TimelineProjectData& project)
+{
+    TimelineMergeBase base;
+    base.versionStart = project.versionStart;
+    base.versionEnd = project.versionEnd;
+    base.versionName = project.versionName;
+
+    const QHash<QString, TimelineEvent> events = normalized(project);
+    base.eventHashes.reserve(events.size());
+
+    for (auto it = events.cbegin(); it != events.cend(); ++it)
+    {
+        base.eventHashes.insert(it.key(), TimelineSerializer::eventHash(it.value()));
+    }
+
+    return base;
+}
+
+
+QHash<QString, TimelineEvent> TimelineMerge::normalized(const TimelineProjectData& project)
+{
+    QHash<QString, TimelineEvent> events;
+    events.reserve(project.events.size() + project.archivedEvents.size());
+
+    // Same defaults as TimelineProjectLoader and the model apply, or every event would look changed
+    auto add = [&events](TimelineEvent event, bool archived)
+    {
+        if (event.id.isEmpty() || events.contains(event.id))
+        {
+            return;
+        }
+
+        if (!event.color.isValid())
+        {
+            event.color = TimelineModel::colorForType(event.type);
+        }
+        event.archived = archived;
+
+        events.insert(event.id, event);
+    };
+
+    for (const TimelineEvent& event : project.events)
+    {
+        add(event, false);
+    }
+    for (const TimelineEvent& event : project.archivedEvents)
+    {
+        add(event, true);
+    }
+
+    return events;
+}
+
+
+TimelineMergePlan TimelineMerge::plan(const TimelineMergeBase& base, const TimelineModel* model, const TimelineProjectData& remote)
+{
+    TimelineMergePlan plan;
+
+    // ========== EVENTS ==========
+    QHash<QString, TimelineEvent> local;
+    for (const TimelineEvent& event : model->getAllEvents())
+    {
+        local.insert(event.id, event);
+    }
+    for (const TimelineEvent& event : model->getAllArchivedEvents())
+    {
+        local.insert(event.id, event);
+    }
+
+    const QHash<QString, TimelineEvent> disk = normalized(remote);
+
+    QHash<QString, QByteArray> localHashes;
+    localHashes.reserve(local.size());
+    for (auto it = local.cbegin(); it != local.cend(); ++it)
+    {
+        localHashes.insert(it.key(), TimelineSerializer::eventHash(it.value()));
+    }
+
+    QHash<QString, QByteArray> diskHashes;
+    diskHashes.reserve(disk.size());
+    for (auto it = disk.cbegin(); it != disk.cend(); ++it)
+    {
+        diskHashes.insert(it.key(), TimelineSerializer::eventHash(it.value()));
+    }
+
+    QSet<QString> ids;
+    ids.reserve(base.eventHashes.size() + local.size() + disk.size());
+    for (auto it = base.eventHashes.cbegin(); it != base.eventHashes.cend(); ++it)
+    {
+        ids.insert(it.key());
+    }
+    for (auto it = local.cbegin(); it != local.cend(); ++it)
+    {
+        ids.insert(it.key());
+    }
+    for (auto it = disk.cbegin(); it != disk.cend(); ++it)
+    {
+        ids.insert(it.key());
+    }
+
+    // An empty hash stands for "absent" (never added, or deleted)
+    for (const QString& id : ids)
+    {
+        const QByteArray baseHash = base.eventHashes.value(id);
+        const QByteArray localHash = localHashes.value(id);
+        const QByteArray diskHash = diskHashes.value(id);
+
+        if (localHash == diskHash)
+        {
+            continue;                       // Unchanged, or both sides made the same change
+        }
+
+        if (diskHash == baseHash)
+        {
+            ++plan.keptLocal;               // Only we changed it
+            continue;
+        }
+
+        if (localHash == baseHash)
+        {
+            if (diskHash.isEmpty())         // Only they changed it
+            {
+                plan.removeLocal.append(id);
+            }
+            else
+            {
+                plan.takeRemote.append(disk.value(id));
+            }
+            continue;
+        }
+
+        TimelineMergeConflict conflict;
+        conflict.eventId = id;
+        conflict.hasLocal = !localHash.isEmpty();
+        conflict.hasRemote = !diskHash.isEmpty();
+        conflict.local = local.value(id);
+        conflict.remote = disk.value(id);
+        plan.conflicts.append(conflict);
+    }
+
+    // Date order for the conflict dialog
+    std::sort(plan.conflicts.begin(), plan.conflicts.end(), [](const TimelineMergeConflict& a, const TimelineMergeConflict& b)
+    {
+        const QDateTime aStart = a.hasLocal ? a.local.startDate : a.remote.startDate;
+        const QDateTime bStart = b.hasLocal ? b.local.startDate : b.remote.startDate;
+        return aStart != bStart ? aStart < bStart : a.eventId < b.eventId;
+    });
+
+    // ========== VERSION FIELDS ==========
+    plan.remoteVersionStart = remote.versionStart;
+    plan.remoteVersionEnd = remote.versionEnd;
+    plan.remoteVersionName = remote.versionName;
+
+    const bool diskDatesChanged = remote.versionStart.isValid() && remote.versionEnd.isValid()
+                                  && (remote.versionStart != base.versionStart || remote.versionEnd != base.versionEnd);
+    const bool localDatesChanged = model->versionStartDate() != base.versionStart || model->versionEndDate() != base.versionEnd;
+    const bool datesDiffer = remote.versionStart != model->versionStartDate() || remote.versionEnd != model->versionEndDate();
+
+    plan.takeVersionDates = diskDatesChanged && !localDatesChanged;
+    plan.versionConflict = diskDatesChanged && localDatesChanged && datesDiffer;
+
+    const bool diskNameChanged = remote.hasVersionName && remote.versionName != base.versionName;
+    const bool localNameChanged = model->versionName() != base.versionName;
+
+    plan.takeVersionName = diskNameChanged && !localNameChanged;
+    plan.versionConflict = plan.versionConflict
+                           || (diskNameChanged && localNameChanged && remote.versionName != model->versionName());
+
+    qDebug() << "TimelineMerge:" << plan.takeRemote.size() << "changed on disk,"
+             << plan.removeLocal.size() << "deleted on disk," << plan.keptLocal << "changed locally,"
+             << plan.conflicts.size() << "conflicts";
+
+    return plan;
+}
+
+
+void TimelineMerge::apply(TimelineModel* model, const TimelineMergePlan& plan, const QSet<QString>& takeRemoteConflicts)
+{
+    QVector<TimelineEvent> incoming = plan.takeRemote;
+    QStringList deleted = plan.removeLocal;
+
+    for (const TimelineMergeConflict& conflict : plan.conflicts)
+    {
+        if (!takeRemoteConflicts.contains(conflict.eventId))
+        {
+            continue;
+        }
+
+        if (conflict.hasRemote)
+        {
+            incoming.append(conflict.remote);
+        }
+        else
+        {
+            deleted.append(conflict.eventId);
+        }
+    }
+
+    // Sort everything into batch operations, so the model relayouts a handful of times at most
+    QStringList removeActive;
+    QStringList removeArchived;
+    QVector<TimelineEvent> updates;
+    QVector<TimelineEvent> adds;
+    QVector<TimelineEvent> archivedAdds;
+
+    QSet<QString> activeIds;
+    for (const TimelineEvent& event : model->getAllEvents())
+    {
+        activeIds.insert(event.id);
+    }
+
+    QSet<QString> archivedIds;
+    for (const TimelineEvent& event : model->getAllArchivedEvents())
+    {
+        archivedIds.insert(event.id);
+    }
+
+    auto removeLocalCopy = [&](const QString& id)
+    {
+        if (activeIds.contains(id))
+        {
+            removeActive.append(id);
+        }
+        else if (archivedIds.contains(id))
+        {
+            removeArchived.append(id);
+        }
+    };
+
+    for (const QString& id : std::as_const(deleted))
+    {
+        removeLocalCopy(id);
+    }
+
+    for (const TimelineEvent& event : std::as_const(incoming))
+    {
+        if (!event.archived && activeIds.contains(event.id))
+        {
+            updates.append(event);          // Stays active: edit in place
+            continue;
+        }
+
+        removeLocalCopy(event.id);
+        (event.archived ? archivedAdds : adds).append(event);
+    }
+
+    model->removeEvents(removeActive);
+    model->permanentlyDeleteArchivedEvents(removeArchived);
+    model->updateEvents(updates);
+    model->addEvents(adds);
+    model->addArchivedEvents(archivedAdds);
+
+    if (plan.takeVersionDates)
+    {
+        model->setVersionDates(plan.remoteVersionStart, plan.remoteVersionEnd);
+    }
+    if (plan.takeVersionName)
+    {
+        model->setVersionName(plan.remoteVersionName);
+    }
+}
+
+
+QString TimelineMerge::describe(const TimelineEvent& event)
+{
+    QString text = QString("%1 (%2").arg(event.title, event.startDate.toString("yyyy-MM-dd HH:mm"));
+
+    if (event.endDate.isValid() && event.endDate != event.startDate)
+    {
+        text += " - " + event.endDate.toString("yyyy-MM-dd HH:mm");
+    }
+    text += ")";
+
+    if (!event.status.isEmpty())
+    {
+        text += " [" + event.status + "]";
+    }
+    if (event.archived)
+    {
+        text += " [archived]";
+    }
+
+    return text;
+}
@@ -0,0 +1,98 @@
+// TimelineMerge.h
+
+
+#pragma once
+#include "TimelineModel.h"
+#include "TimelineSerializer.h"
+#include <QHash>
+#include <QSet>
+#include <QByteArray>
+
+
+/**
+ * @struct TimelineMergeBase
+ * @brief Common ancestor of a merge: what the project file held when it was last loaded or saved
+ */
+struct TimelineMergeBase
+{
+    QHash<QString, QByteArray> eventHashes;     ///< Active and archived events by ID (see TimelineSerializer::eventHash)
+    QDate versionStart;
+    QDate versionEnd;
+    QString versionName;
+};
+
+
+/**
+ * @struct TimelineMergeConflict
+ * @brief An event changed both locally and on disk, in different ways
+ */
+struct TimelineMergeConflict
+{
+    QString eventId;
+    bool hasLocal = false;          ///< False if deleted locally
+    bool hasRemote = false;         ///< False if deleted on disk
+    TimelineEvent local;
+    TimelineEvent remote;
+};
+
+
+/**
+ * @struct TimelineMergePlan
+ * @brief Outcome of comparing base, local and disk versions
+ */
+struct TimelineMergePlan
+{
+    QVector<TimelineEvent> takeRemote;          ///< Changed or added on disk only (archived flag tells where they go)
+    QStringList removeLocal;                    ///< Deleted on disk, unchanged locally
+    QVector<TimelineMergeConflict> conflicts;   ///< Changed on both sides
+    int keptLocal = 0;                          ///< Changed locally only (nothing to do)
+
+    bool takeVersionDates = false;              ///< Version range changed on disk only
+    bool takeVersionName = false;
+    bool versionConflict = false;               ///< Version fields changed on both sides (local kept)
+    QDate remoteVersionStart;
+    QDate remoteVersionEnd;
+    QString remoteVersionName;
+
+    bool hasRemoteChanges() const
+    {
+        return !takeRemote.isEmpty() || !removeLocal.isEmpty() || !conflicts.isEmpty() || takeVersionDates || takeVersionName;
+    }
+};
+
+
+/**
+ * @class TimelineMerge
+ * @brief Event-granular three-way merge of a project file edited by several people
+ *
+ * Every event is reduced to a content hash, so deciding who changed what is one
+ * hash lookup per event ID across base, local and disk versions. An event that
+ * only one side changed (including additions and deletions) takes that side's
+ * version; an event both sides changed differently is a conflict for the user to
+ * resolve. Moving an event to or from the archive counts as a change.
+ */
+class TimelineMerge
+{
+public:
+    static TimelineMergeBase snapshot(const TimelineModel* model);              ///< Base for a model that matches its file
+    static TimelineMergeBase snapshot(const TimelineProjectData& project);      ///< Base for a file as read from disk
+
+    /**
+     * @brief Decide what to take from disk
+     * @param base State of the file when it was last loaded or saved
+     * @param model Local state
+     * @param remote File as it is on disk now
+     */
+    static TimelineMergePlan plan(const TimelineMergeBase& base, const TimelineModel* model, const TimelineProjectData& remote);
+
+    /**
+     * @brief Apply the non-conflicting disk changes plus the conflicts resolved in favour of disk
+     * @param takeRemoteConflicts IDs of conflicts to resolve with the disk version (the rest keep the local one)
+     */
+    static void apply(TimelineModel* model, const TimelineMergePlan& plan, const QSet<QString>& takeRemoteConflicts);
+
+    static QString describe(const TimelineEvent& event);    ///< One-line summary for conflict lists
+
+private:
+    static QHash<QString, TimelineEvent> normalized(const TimelineProjectData& project);   ///< Disk events by ID, with the defaults loading applies
+};
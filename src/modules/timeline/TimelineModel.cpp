@@ -5,6 +5,10 @@
 #include "LaneAssigner.h"
 #include <QUuid>
 #include <QUndoStack>
+#include <QHash>
+#include <QSet>
+#include <algorithm>
+#include <utility>
 
 
 TimelineModel::TimelineModel(QObject* parent)
@@ -16,6 +20,7 @@ TimelineModel::TimelineModel(QObject* parent)
 
     // Connect to AttachmentManager signals
     connect(&AttachmentManager::instance(), &AttachmentManager::attachmentsChanged, this, &TimelineModel::onAttachmentsChanged);
+    connect(&AttachmentManager::instance(), &AttachmentManager::attachmentsReset, this, &TimelineModel::onAttachmentsReset);
 }
 
 
@@ -29,7 +34,9 @@ void TimelineModel::setVersionDates(const QDate& start, const QDate& end)
 
     versionStart_ = start;
     versionEnd_ = end;
+    bumpGeneration();
     emit versionDatesChanged(start, end);
+    emit generationChanged(generation_);
 }
 
 
@@ -38,7 +45,9 @@ void TimelineModel::setVersionName(const QString& name)
     if (versionName_ != name)
     {
         versionName_ = name;
+        bumpGeneration();
         emit versionNameChanged(name);
+        emit generationChanged(generation_);
     }
 }
 
@@ -74,6 +83,7 @@ QString TimelineModel::addEvent(const TimelineEvent& event)
     }
 
     // Add to internal storage
+    stamp(newEvent);
     events_.append(newEvent);
 
     // Recalculate lanes after adding new event
@@ -81,10 +91,141 @@ QString TimelineModel::addEvent(const TimelineEvent& event)
 
     // Emit signal
     emit eventAdded(newEvent.id);
+    emit generationChanged(generation_);
 
     return newEvent.id;
 }
 
+QStringList TimelineModel::addEvents(const QVector<TimelineEvent>& events)
+{
+    QStringList addedIds;
+    addedIds.reserve(events.size());
+
+    // Index existing IDs once instead of a linear duplicate check per event
+    QSet<QString> existingIds;
+    existingIds.reserve(events_.size() + events.size());
+    for (const TimelineEvent& existing : events_)
+    {
+        existingIds.insert(existing.id);
+    }
+
+    events_.reserve(events_.size() + events.size());
+
+    for (const TimelineEvent& event : events)
+    {
+        TimelineEvent newEvent = event;
+        if (newEvent.id.isEmpty())
+        {
+            newEvent.id = generateEventId();
+        }
+
+        if (existingIds.contains(newEvent.id))
+        {
+            qWarning() << "Event with ID" << newEvent.id << "already exists";
+            continue;
+        }
+
+        if (!newEvent.color.isValid())
+        {
+            newEvent.color = colorForType(newEvent.type);
+        }
+
+        existingIds.insert(newEvent.id);
+        stamp(newEvent);
+        events_.append(newEvent);
+        addedIds.append(newEvent.id);
+    }
+
+    if (addedIds.isEmpty())
+    {
+        return addedIds;
+    }
+
+    // Single relayout and a single notification for the whole batch
+    assignLanesToEvents();
+    emit eventsAdded(addedIds);
+    emit generationChanged(generation_);
+
+    return addedIds;
+}
+
+QStringList TimelineModel::addLaidOutEvents(const QVector<TimelineEvent>& events)
+{
+    QStringList addedIds;
+    addedIds.reserve(events.size());
+    events_.reserve(events_.size() + events.size());
+
+    // Lanes were assigned against the complete set, so earlier batches keep their positions
+    for (const TimelineEvent& event : events)
+    {
+        events_.append(event);
+        stamp(events_.last());
+        addedIds.append(event.id);
+        maxLane_ = std::max(maxLane_, event.lane);
+    }
+
+    if (!addedIds.isEmpty())
+    {
+        emit eventsAdded(addedIds);
+        emit generationChanged(generation_);
+    }
+
+    return addedIds;
+}
+
+void TimelineModel::addArchivedEvents(const QVector<TimelineEvent>& events)
+{
+    archivedEvents_.reserve(archivedEvents_.size() + events.size());
+
+    for (TimelineEvent event : events)
+    {
+        event.archived = true;
+        if (!event.color.isValid())
+        {
+            event.color = colorForType(event.type);
+        }
+        stamp(event);
+        archivedEvents_.append(event);
+    }
+
+    if (!events.isEmpty())
+    {
+        emit generationChanged(generation_);
+    }
+}
+
+int TimelineModel::removeEvents(const QStringList& eventIds)
+{
+    const QSet<QString> toRemove(eventIds.cbegin(), eventIds.cend());
+
+    QStringList removedIds;
+    removedIds.reserve(eventIds.size());
+
+    // Single compaction pass
+    auto newEnd = std::remove_if(events_.begin(), events_.end(), [&](const TimelineEvent& event)
+                                 {
+                                     if (toRemove.contains(event.id))
+                                     {
+                                         removedIds.append(event.id);
+                                         return true;
+                                     }
+                                     return false;
+                                 });
+    events_.erase(newEnd, events_.end());
+
+    if (removedIds.isEmpty())
+    {
+        return 0;
+    }
+
+    bumpGeneration();
+    assignLanesToEvents();
+    emit eventsRemoved(removedIds);
+    emit generationChanged(generation_);
+
+    return removedIds.size();
+}
+
 bool TimelineModel::removeEvent(const QString& eventId)
 {
     for(int i = 0; i < events_.size(); ++i)
@@ -92,8 +233,10 @@ bool TimelineModel::removeEvent(const QString& eventId)
         if(events_[i].id == eventId)
         {
             events_.removeAt(i);
+            bumpGeneration();
             assignLanesToEvents();
             emit eventRemoved(eventId);
+            emit generationChanged(generation_);
             return true;
         }
     }
@@ -110,15 +253,58 @@ bool TimelineModel::updateEvent(const QString& eventId, const TimelineEvent& upd
             TimelineEvent updated = updatedEvent;
             updated.id = eventId;
             events_[i] = updated;
+            stamp(events_[i]);
 
             assignLanesToEvents();
             emit eventUpdated(eventId);
+            emit generationChanged(generation_);
             return true;
         }
     }
     return false;
 }
 
+int TimelineModel::updateEvents(const QVector<TimelineEvent>& updatedEvents)
+{
+    // Index once so a large batch stays linear instead of one search per event
+    QHash<QString, int> indexById;
+    indexById.reserve(events_.size());
+    for (int i = 0; i < events_.size(); ++i)
+    {
+        indexById.insert(events_[i].id, i);
+    }
+
+    QStringList updatedIds;
+    updatedIds.reserve(updatedEvents.size());
+
+    for (const TimelineEvent& updated : updatedEvents)
+    {
+        auto it = indexById.constFind(updated.id);
+        if (it == indexById.constEnd())
+        {
+            qWarning() << "TimelineModel::updateEvents - unknown event ID" << updated.id;
+            continue;
+        }
+
+        events_[it.value()] = updated;
+        stamp(events_[it.value()]);
+        updatedIds.append(updated.id);
+    }
+
+    if (updatedIds.isEmpty())
+    {
+        return 0;
+    }
+
+    // Single relayout and a single notification for the whole batch
+    assignLanesToEvents();
+
+    emit eventsUpdated(updatedIds);
+    emit generationChanged(generation_);
+
+    return updatedIds.size();
+}
+
 TimelineEvent* TimelineModel::getEvent(const QString& eventId)
 {
     for(int i = 0; i < events_.size(); ++i)
@@ -143,6 +329,22 @@ const TimelineEvent* TimelineModel::getEvent(const QString& eventId) const
     return nullptr;
 }
 
+QHash<QString, TimelineEvent> TimelineModel::getEvents(const QStringList& eventIds) const
+{
+    const QSet<QString> wanted(eventIds.cbegin(), eventIds.cend());
+
+    QHash<QString, TimelineEvent> found;
+    found.reserve(wanted.size());
+    for (const TimelineEvent& event : events_)
+    {
+        if (wanted.contains(event.id))
+        {
+            found.insert(event.id, event);
+        }
+    }
+    return found;
+}
+
 QVector<TimelineEvent> TimelineModel::getEventsInRange(const QDate& start, const QDate& end) const
 {
     QVector<TimelineEvent> result;
@@ -203,7 +405,9 @@ void TimelineModel::clear()
     events_.clear();
     archivedEvents_.clear();
     maxLane_ = 0;
+    bumpGeneration();
     emit eventsCleared();
+    emit generationChanged(generation_);
 }
 
 QColor TimelineModel::colorForType(TimelineEventType type)
@@ -230,110 +434,104 @@ QString TimelineModel::generateEventId() const
     return QUuid::createUuid().toString(QUuid::WithoutBraces);
 }
 
-void TimelineModel::assignLanesToEvents()
+void TimelineModel::setLaneGapSeconds(qint64 secs)
+{
+    secs = std::max<qint64>(0, secs);
+    if (secs == laneGapSecs_)
+    {
+        return;
+    }
+
+    laneGapSecs_ = secs;
+    assignLanesToEvents();
+    emit generationChanged(generation_);
+}
+
+void TimelineModel::recalculateLanes()
 {
-    qDebug() << "";
-    qDebug() << "╔══════════════════════════════════════════════════════════";
-    qDebug() << "║ ASSIGN LANES TO EVENTS";
-    qDebug() << "╠══════════════════════════════════════════════════════════";
-    qDebug() << "║ Total events:" << events_.size();
+    assignLanesToEvents();
+    emit generationChanged(generation_);
+}
 
+void TimelineModel::assignLanesToEvents()
+{
     if (events_.isEmpty())
     {
         maxLane_ = 0;
-        qDebug() << "║ No events to assign";
-        qDebug() << "╚══════════════════════════════════════════════════════════";
         return;
     }
 
-    // Separate events into manually-controlled and auto-assigned
-    QVector<LaneAssigner::EventData> autoEvents;
-    QVector<LaneAssigner::EventData> manualEvents;
+    // Events whose lane moves count as changed
+    QVector<int> previousLanes;
+    previousLanes.reserve(events_.size());
+    for (const TimelineEvent& event : events_)
+    {
+        previousLanes.append(event.lane);
+    }
+
+    maxLane_ = assignLanes(events_, laneGapSecs_);
 
     for (int i = 0; i < events_.size(); ++i)
     {
-        TimelineEvent& event = events_[i];
-
-        qDebug() << "║";
-        qDebug() << "║ Event:" << event.title;
-        qDebug() << "║   ID:" << event.id;
-        qDebug() << "║   Dates:" << event.startDate.date().toString("yyyy-MM-dd")
-                 << "to" << event.endDate.date().toString("yyyy-MM-dd");
-        qDebug() << "║   Current Lane:" << event.lane;
-        qDebug() << "║   Lane Control Enabled:" << event.laneControlEnabled;
-        if (event.laneControlEnabled)
+        if (events_[i].lane != previousLanes[i])
         {
-            qDebug() << "║   Manual Lane:" << event.manualLane;
+            stamp(events_[i]);
         }
+    }
+
+    qDebug() << "TimelineModel: Lanes assigned for" << events_.size() << "events, max lane" << maxLane_;
+
+    emit lanesRecalculated();
+}
+
+int TimelineModel::assignLanes(QVector<TimelineEvent>& events, qint64 minGapSecs)
+{
+    if (events.isEmpty())
+    {
+        return 0;
+    }
+
+    // Separate events into manually-controlled and auto-assigned
+    QVector<LaneAssigner::TimedEventData> autoEvents;
+    QVector<LaneAssigner::TimedEventData> manualEvents;
 
-        // Use date portion for lane assignment
-        LaneAssigner::EventData data(
-            event.id,
-            event.startDate.date(),
-            event.endDate.date(),
-            &event
-            );
+    for (TimelineEvent& event : events)
+    {
+        // Pack on the interval the scene draws: midnight-to-midnight events cover their end day too
+        LaneAssigner::TimedEventData data(event.id, event.startDate.toSecsSinceEpoch(), event.drawnEndDate().toSecsSinceEpoch(),
+                                          event.isDayAligned(), &event);
 
         if (event.laneControlEnabled)
         {
             data.lane = event.manualLane;
             manualEvents.append(data);
-            qDebug() << "║   → Added to MANUAL events (will NOT be auto-reassigned)";
         }
         else
         {
             autoEvents.append(data);
-            qDebug() << "║   → Added to AUTO events (WILL be reassigned)";
         }
     }
 
-    qDebug() << "║";
-    qDebug() << "╠══════════════════════════════════════════════════════════";
-    qDebug() << "║ Summary:";
-    qDebug() << "║   Auto events:" << autoEvents.size();
-    qDebug() << "║   Manual events:" << manualEvents.size();
-    qDebug() << "╠══════════════════════════════════════════════════════════";
-
-    // Assign lanes to auto events, respecting manual events
-    if (!autoEvents.isEmpty())
-    {
-        qDebug() << "║ Running lane assignment for auto events...";
-
-        int maxLaneUsed = LaneAssigner::assignLanesWithReserved(autoEvents, manualEvents);
-
-        qDebug() << "║ Lane assignment complete:";
-        // Apply assigned lanes back to events
-        for (const auto& data : autoEvents)
-        {
-            if (data.userData)
-            {
-                TimelineEvent* event = static_cast<TimelineEvent*>(data.userData);
-                qDebug() << "║   Event" << event->title << "assigned to lane" << data.lane;
-                event->lane = data.lane;
-            }
-        }
-
-        maxLane_ = maxLaneUsed;
-        qDebug() << "║ Max lane used:" << maxLane_;
-    }
-    else
+    if (autoEvents.isEmpty())
     {
         // Only manual events, find max lane
-        maxLane_ = 0;
+        int maxLane = 0;
         for (const auto& data : manualEvents)
         {
-            if (data.lane > maxLane_)
-            {
-                maxLane_ = data.lane;
-            }
+            maxLane = std::max(maxLane, data.lane);
         }
-        qDebug() << "║ No auto events - max lane from manual events:" << maxLane_;
+        return maxLane;
     }
 
-    qDebug() << "╚══════════════════════════════════════════════════════════";
-    qDebug() << "";
+    // Assign lanes to auto events at datetime precision, respecting manual events
+    const int maxLaneUsed = LaneAssigner::assignLanesPrecise(autoEvents, manualEvents, minGapSecs);
 
-    emit lanesRecalculated();
+    for (const auto& data : autoEvents)
+    {
+        static_cast<TimelineEvent*>(data.userData)->lane = data.lane;
+    }
+
+    return maxLaneUsed;
 }
 
 bool TimelineModel::archiveEvent(const QString& eventId)
@@ -343,10 +541,12 @@ bool TimelineModel::archiveEvent(const QString& eventId)
         if (events_[i].id == eventId)
         {
             events_[i].archived = true;
+            stamp(events_[i]);
             archivedEvents_.append(events_[i]);
             events_.removeAt(i);
             assignLanesToEvents();
             emit eventArchived(eventId);
+            emit generationChanged(generation_);
             qDebug() << "Event archived:" << eventId;
             return true;
         }
@@ -363,10 +563,12 @@ bool TimelineModel::restoreEvent(const QString& eventId)
         if (archivedEvents_[i].id == eventId)
         {
             archivedEvents_[i].archived = false;
+            stamp(archivedEvents_[i]);
             events_.append(archivedEvents_[i]);
             archivedEvents_.removeAt(i);
             assignLanesToEvents();
             emit eventRestored(eventId);
+            emit generationChanged(generation_);
             qDebug() << "Event restored:" << eventId;
             return true;
         }
@@ -376,6 +578,95 @@ bool TimelineModel::restoreEvent(const QString& eventId)
     return false;
 }
 
+QStringList TimelineModel::archiveEvents(const QStringList& eventIds)
+{
+    const QSet<QString> toArchive(eventIds.cbegin(), eventIds.cend());
+
+    QStringList archivedIds;
+    archivedIds.reserve(toArchive.size());
+    archivedEvents_.reserve(archivedEvents_.size() + toArchive.size());
+
+    // Single compaction pass: victims move to the archive, survivors slide down in order
+    int kept = 0;
+    for (int i = 0; i < events_.size(); ++i)
+    {
+        TimelineEvent& event = events_[i];
+
+        if (toArchive.contains(event.id))
+        {
+            event.archived = true;
+            stamp(event);
+            archivedIds.append(event.id);
+            archivedEvents_.append(std::move(event));
+        }
+        else
+        {
+            if (kept != i)
+            {
+                events_[kept] = std::move(event);
+            }
+            ++kept;
+        }
+    }
+
+    if (archivedIds.isEmpty())
+    {
+        return archivedIds;
+    }
+
+    events_.resize(kept);
+    assignLanesToEvents();
+    emit eventsArchived(archivedIds);
+    emit generationChanged(generation_);
+    qDebug() << "Events archived:" << archivedIds.size();
+
+    return archivedIds;
+}
+
+QStringList TimelineModel::restoreEvents(const QStringList& eventIds)
+{
+    const QSet<QString> toRestore(eventIds.cbegin(), eventIds.cend());
+
+    QStringList restoredIds;
+    restoredIds.reserve(toRestore.size());
+    events_.reserve(events_.size() + toRestore.size());
+
+    int kept = 0;
+    for (int i = 0; i < archivedEvents_.size(); ++i)
+    {
+        TimelineEvent& event = archivedEvents_[i];
+
+        if (toRestore.contains(event.id))
+        {
+            event.archived = false;
+            stamp(event);
+            restoredIds.append(event.id);
+            events_.append(std::move(event));
+        }
+        else
+        {
+            if (kept != i)
+            {
+                archivedEvents_[kept] = std::move(event);
+            }
+            ++kept;
+        }
+    }
+
+    if (restoredIds.isEmpty())
+    {
+        return restoredIds;
+    }
+
+    archivedEvents_.resize(kept);
+    assignLanesToEvents();
+    emit eventsRestored(restoredIds);
+    emit generationChanged(generation_);
+    qDebug() << "Events restored:" << restoredIds.size();
+
+    return restoredIds;
+}
+
 bool TimelineModel::permanentlyDeleteArchivedEvent(const QString& eventId)
 {
     for (int i = 0; i < archivedEvents_.size(); ++i)
@@ -383,7 +674,9 @@ bool TimelineModel::permanentlyDeleteArchivedEvent(const QString& eventId)
         if (archivedEvents_[i].id == eventId)
         {
             archivedEvents_.removeAt(i);
+            bumpGeneration();
             emit eventRemoved(eventId);
+            emit generationChanged(generation_);
             qDebug() << "Archived event permanently deleted:" << eventId;
             return true;
         }
@@ -393,6 +686,79 @@ bool TimelineModel::permanentlyDeleteArchivedEvent(const QString& eventId)
     return false;
 }
 
+int TimelineModel::permanentlyDeleteArchivedEvents(const QStringList& eventIds)
+{
+    const QSet<QString> toRemove(eventIds.cbegin(), eventIds.cend());
+
+    QStringList removedIds;
+    removedIds.reserve(eventIds.size());
+
+    auto newEnd = std::remove_if(archivedEvents_.begin(), archivedEvents_.end(), [&](const TimelineEvent& event)
+                                 {
+                                     if (toRemove.contains(event.id))
+                                     {
+                                         removedIds.append(event.id);
+                                         return true;
+                                     }
+                                     return false;
+                                 });
+    archivedEvents_.erase(newEnd, archivedEvents_.end());
+
+    if (removedIds.isEmpty())
+    {
+        return 0;
+    }
+
+    // Archived events have no items, so no relayout
+    bumpGeneration();
+    emit eventsRemoved(removedIds);
+    emit generationChanged(generation_);
+
+    return removedIds.size();
+}
+
+int TimelineModel::updateArchivedEvents(const QVector<TimelineEvent>& updatedEvents)
+{
+    QHash<QString, int> indexById;
+    indexById.reserve(archivedEvents_.size());
+    for (int i = 0; i < archivedEvents_.size(); ++i)
+    {
+        indexById.insert(archivedEvents_[i].id, i);
+    }
+
+    QStringList updatedIds;
+    updatedIds.reserve(updatedEvents.size());
+
+    for (const TimelineEvent& updated : updatedEvents)
+    {
+        auto it = indexById.constFind(updated.id);
+        if (it == indexById.constEnd())
+        {
+            qWarning() << "TimelineModel::updateArchivedEvents - unknown event ID" << updated.id;
+            continue;
+        }
+
+        TimelineEvent& event = archivedEvents_[it.value()];
+        event = updated;
+        event.archived = true;
+        stamp(event);
+        updatedIds.append(updated.id);
+    }
+
+    if (updatedIds.isEmpty())
+    {
+        return 0;
+    }
+
+    for (const QString& eventId : updatedIds)
+    {
+        emit eventUpdated(eventId);
+    }
+    emit generationChanged(generation_);
+
+    return updatedIds.size();
+}
+
 const TimelineEvent* TimelineModel::getArchivedEvent(const QString& eventId) const
 {
     for (int i = 0; i < archivedEvents_.size(); ++i)
@@ -410,6 +776,17 @@ QVector<TimelineEvent> TimelineModel::getAllArchivedEvents() const
     return archivedEvents_;
 }
 
+quint64 TimelineModel::eventRevision(const QString& eventId) const
+{
+    if (const TimelineEvent* event = getEvent(eventId))
+    {
+        return event->revision;
+    }
+
+    const TimelineEvent* archived = getArchivedEvent(eventId);
+    return archived ? archived->revision : 0;
+}
+
 bool TimelineModel::hasLaneConflict(const QDateTime& startDateTime, const QDateTime& endDateTime,
                                     int manualLane, const QString& excludeEventId) const
 {
@@ -447,12 +824,9 @@ bool TimelineModel::hasLaneConflict(const QDateTime& startDateTime, const QDateT
 
 int TimelineModel::getAttachmentCount(const QString& eventId) const
 {
-    // Convert UUID to stable numeric ID using hash
+    // Convert UUID to stable numeric ID using hash (count is a table lookup in the manager)
     int numericId = qHash(eventId);
 
-    qDebug() << "TimelineModel::getAttachmentCount - UUID:" << eventId
-             << "-> Hash:" << numericId;
-
     return AttachmentManager::instance().getAttachmentCount(numericId);
 }
 
@@ -468,12 +842,14 @@ void TimelineModel::onAttachmentsChanged(int eventId)
     // This is tricky - we need to find which UUID maps to this numeric ID
     // For now, we'll iterate through all events and check their hashes
 
-    for (const TimelineEvent& event : events_)
+    for (TimelineEvent& event : events_)
     {
         if (qHash(event.id) == eventId)
         {
             qDebug() << "TimelineModel: Attachments changed for event" << event.id;
+            stamp(event);
             emit eventAttachmentsChanged(event.id);
+            emit generationChanged(generation_);
             return;
         }
     }
@@ -482,6 +858,23 @@ void TimelineModel::onAttachmentsChanged(int eventId)
 }
 
 
+void TimelineModel::onAttachmentsReset()
+{
+    // Attachment counts feed tooltips and details, so every event changed
+    for (TimelineEvent& event : events_)
+    {
+        stamp(event);
+    }
+    for (TimelineEvent& event : archivedEvents_)
+    {
+        stamp(event);
+    }
+
+    emit eventAttachmentsReset();
+    emit generationChanged(generation_);
+}
+
+
 bool TimelineModel::setEventLockState(const QString& eventId, bool fixed, bool locked)
 {
     TimelineEvent* event = getEvent(eventId);
@@ -507,8 +900,10 @@ bool TimelineModel::setEventLockState(const QString& eventId, bool fixed, bool l
     // Only emit if actually changed
     if (oldFixed != event->isFixed || oldLocked != event->isLocked)
     {
+        stamp(*event);
         emit eventLockStateChanged(eventId);
         emit eventUpdated(eventId);
+        emit generationChanged(generation_);
         return true;
     }
 
@@ -11,6 +11,7 @@
 #include <QString>
 #include <QColor>
 #include <QMap>
+#include <QHash>
 
 
 class QUndoStack;
@@ -41,6 +42,7 @@ struct TimelineEvent
     int priority = 0;           ///< Priority level (0-5, lower = more important)
     int lane = 0;               ///< Vertical lane for collision avoidance
     bool archived = false;      ///< Soft-delete flag
+    quint64 revision = 0;       ///< Change stamp assigned by TimelineModel (0 = not from the model; not serialized)
 
     // ========== LANE CONTROL FIELDS ==========
     bool laneControlEnabled = false;    ///< If true, user has manually set the lane
@@ -72,6 +74,11 @@ struct TimelineEvent
     // ========== TEST EVENT-SPECIFIC FIELDS ==========
     QString testCategory;       ///< Category: Dry Run, Preliminary, Formal
     QMap<QString, bool> preparationChecklist;  ///< Checklist items with completion status
+    int testsPassed = 0;                ///< Imported result: passing test cases
+    int testsFailed = 0;                ///< Imported result: failing/erroring test cases
+    int testsSkipped = 0;               ///< Imported result: skipped test cases
+    double testDurationSecs = 0.0;      ///< Imported result: total suite duration (seconds)
+    QDateTime testResultsImported;      ///< When results were last imported (invalid = no results)
 
     // ========== REMINDER-SPECIFIC FIELDS ==========
     QString recurringRule;      ///< Recurrence rule: Daily, Weekly, Monthly
@@ -94,6 +101,16 @@ struct TimelineEvent
         return !(endDate < other.startDate || startDate > other.endDate);
     }
 
+    bool isDayAligned() const                                                   ///< Midnight-to-midnight (all-day style); drawn through the end day
+    {
+        return startDate.time() == QTime(0, 0) && endDate.time() == QTime(0, 0) && endDate >= startDate;
+    }
+
+    QDateTime drawnEndDate() const                                              ///< End of the interval actually drawn on the timeline
+    {
+        return isDayAligned() ? endDate.addDays(1) : endDate;
+    }
+
     int durationDays() const                                                    ///< Returns duration in days (inclusive)
     {
         return startDate.date().daysTo(endDate.date()) + 1;
@@ -133,6 +150,7 @@ struct TimelineEvent
         }
     }
 
+    bool hasTestResults() const         { return testResultsImported.isValid(); }   ///< Check if test results have been imported for this event
     bool canManipulateInView() const    { return !isFixed && !isLocked; }       ///< Check if event can be manipulated in the timeline view
     bool canEditInDialog() const        { return !isLocked; }                   ///< Check if event can be edited in dialog
 };
@@ -141,6 +159,11 @@ struct TimelineEvent
 /**
  * @class TimelineModel
  * @brief Data model with collision avoidance and lane tracking
+ *
+ * Every change increments the model generation. Each event carries the generation
+ * at which it last changed as its revision (including lane moves from relayout and
+ * attachment changes), so consumers can tell whether an event, or anything at all,
+ * changed since they last derived data from it (see RevisionMemo).
  */
 class TimelineModel : public QObject
 {
@@ -160,23 +183,38 @@ public:
     void setVersionName(const QString& name);
     QString versionName() const { return versionName_; }
     QString addEvent(const TimelineEvent& event);
+    QStringList addEvents(const QVector<TimelineEvent>& events);
+    QStringList addLaidOutEvents(const QVector<TimelineEvent>& events);     ///< Append events whose lanes were already assigned for the whole project (no relayout)
+    void addArchivedEvents(const QVector<TimelineEvent>& events);           ///< Append straight to the archive (project load)
     bool removeEvent(const QString& eventId);
+    int removeEvents(const QStringList& eventIds);
     bool updateEvent(const QString& eventId, const TimelineEvent& updatedEvent);
+    int updateEvents(const QVector<TimelineEvent>& updatedEvents);
 
     TimelineEvent* getEvent(const QString& eventId);
     const TimelineEvent* getEvent(const QString& eventId) const;
+    QHash<QString, TimelineEvent> getEvents(const QStringList& eventIds) const;    ///< Active events among eventIds, found in one pass (unknown IDs are skipped)
     QVector<TimelineEvent> getAllEvents() const;
     QVector<TimelineEvent> getEventsInRange(const QDate& start, const QDate& end) const;
     QVector<TimelineEvent> getEventsForToday() const;
     QVector<TimelineEvent> getEventsLookahead(int days = 14) const;
     int eventCount() const { return events_.size(); }
+    quint64 generation() const { return generation_; }                     ///< Model-wide change counter (monotonic)
+    quint64 eventRevision(const QString& eventId) const;                    ///< Revision of an active or archived event (0 if unknown)
     int maxLane() const { return maxLane_; }
     void clear();
     void recalculateLanes();
+    static int assignLanes(QVector<TimelineEvent>& events, qint64 minGapSecs = 0);  ///< Assign auto lanes around manual ones at datetime precision; returns max lane (no model state, thread-safe)
+    void setLaneGapSeconds(qint64 secs);                                    ///< Minimum space between events sharing a lane (relayouts when changed)
+    qint64 laneGapSeconds() const { return laneGapSecs_; }
     static QColor colorForType(TimelineEventType type);
     bool archiveEvent(const QString& eventId);
     bool restoreEvent(const QString& eventId);
+    QStringList archiveEvents(const QStringList& eventIds);                 ///< Archive a set in one pass and one relayout; returns the IDs archived
+    QStringList restoreEvents(const QStringList& eventIds);                 ///< Restore a set in one pass and one relayout; returns the IDs restored
     bool permanentlyDeleteArchivedEvent(const QString& eventId);
+    int permanentlyDeleteArchivedEvents(const QStringList& eventIds);       ///< Drop a set from the archive in one pass; returns the number removed
+    int updateArchivedEvents(const QVector<TimelineEvent>& updatedEvents);  ///< Replace archived events in place (no relayout); returns the number updated
     const TimelineEvent* getArchivedEvent(const QString& eventId) const;
     QVector<TimelineEvent> getAllArchivedEvents() const;
 
@@ -189,20 +227,30 @@ signals:
     void versionDatesChanged(const QDate& start, const QDate& end);
     void versionNameChanged(const QString& name);
     void eventAdded(const QString& eventId);
+    void eventsAdded(const QStringList& eventIds);      ///< Batch insert (emitted instead of per-event eventAdded)
     void eventRemoved(const QString& eventId);
+    void eventsRemoved(const QStringList& eventIds);    ///< Batch removal (emitted instead of per-event eventRemoved)
     void eventUpdated(const QString& eventId);
+    void eventsUpdated(const QStringList& eventIds);    ///< Batch update (emitted instead of per-event eventUpdated)
     void eventArchived(const QString& eventId);
     void eventRestored(const QString& eventId);
+    void eventsArchived(const QStringList& eventIds);   ///< Batch archive (emitted instead of per-event eventArchived)
+    void eventsRestored(const QStringList& eventIds);   ///< Batch restore (emitted instead of per-event eventRestored)
     void lanesRecalculated();
     void eventsCleared();
     void eventAttachmentsChanged(const QString& eventId);
+    void eventAttachmentsReset();                   ///< All attachment lists were replaced (project load)
     void eventLockStateChanged(const QString& eventId);
+    void generationChanged(quint64 generation);    ///< Emitted after any change, following the specific signals
 
 private slots:
     void onAttachmentsChanged(int eventId);
+    void onAttachmentsReset();
 
 private:
     void assignLanesToEvents();
+    void stamp(TimelineEvent& event) { event.revision = ++generation_; }   ///< Mark an event as changed now
+    void bumpGeneration() { ++generation_; }                                ///< Model changed without a surviving event to stamp
     QString generateEventId() const;
     QUndoStack* undoStack_ = nullptr;
     QDate versionStart_;
@@ -211,4 +259,6 @@ private:
     QVector<TimelineEvent> events_;
     QVector<TimelineEvent> archivedEvents_;
     int maxLane_ = 0;
+    quint64 generation_ = 0;
+    qint64 laneGapSecs_ = 0;        ///< Minimum space between neighbours in a lane (follows the zoom, see TimelineScene)
 };
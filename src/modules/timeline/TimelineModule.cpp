@@ -22,6 +22,17 @@
 #include "TimelineSettings.h"
 #include "ConfirmationDialog.h"
 #include "ArchivedEventsDialog.h"
+#include "TimelineBaselineComparator.h"
+#include "TestResultImporter.h"
+#include "TimelineICalendar.h"
+#include "TimelineProjectLoader.h"
+#include "TimelineShardStore.h"
+#include "TimelineFileWatcher.h"
+#include "MergeConflictDialog.h"
+#include "TimelineSyncSession.h"
+#include "TimelineSyncProtocol.h"
+#include "TimelineReminderScheduler.h"
+#include "../../shared/models/AttachmentIntegrityScanner.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QPushButton>
@@ -32,15 +43,58 @@
 #include <QToolBar>
 #include <QAction>
 #include <QMenu>
+#include <QActionGroup>
 #include <QLabel>
 #include <QPainter>
 #include <QPixmap>
+#include <QProgressDialog>
+#include <QProgressBar>
+#include <QLocale>
+#include <QThread>
+#include <QTimer>
+#include <QScrollBar>
+#include <QScopedValueRollback>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QInputDialog>
+#include <QLineEdit>
+#include <QHostInfo>
+#include <QCoreApplication>
+#include <QApplication>
+#include <QSystemTrayIcon>
+#include <QStyle>
+#include <QJsonDocument>
+#include <QSet>
+#include <algorithm>
 
 
 TimelineModule::TimelineModule(QWidget* parent)
     : QWidget(parent)
     , autoSaveManager_(nullptr)
     , scrollAnimator_(nullptr)
+    , baselineComparator_(nullptr)
+    , exportSlipReportAction_(nullptr)
+    , clearBaselineAction_(nullptr)
+    , testResultImporter_(nullptr)
+    , importProgressDialog_(nullptr)
+    , attachmentScanner_(nullptr)
+    , scanProgressDialog_(nullptr)
+    , projectLoader_(nullptr)
+    , shardStore_(nullptr)
+    , shardLoadTimer_(nullptr)
+    , fileWatcher_(nullptr)
+    , syncSession_(nullptr)
+    , relayProcess_(nullptr)
+    , liveSessionButton_(nullptr)
+    , hostSessionAction_(nullptr)
+    , joinSessionAction_(nullptr)
+    , leaveSessionAction_(nullptr)
+    , reminderScheduler_(nullptr)
+    , reminderTrayIcon_(nullptr)
+    , loadProgressBar_(nullptr)
+    , cancelLoadButton_(nullptr)
+    , xlsxExportThread_(nullptr)
+    , xlsxExportCancelled_(false)
     , editAction_(nullptr)
     , deleteAction_(nullptr)
     , zoomInButton_(nullptr)
@@ -70,12 +124,25 @@ TimelineModule::TimelineModule(QWidget* parent)
 
     model_->setUndoStack(undoStack_);
 
+    // Project files are parsed off the GUI thread and streamed in viewport first. The session
+    // project starts parsing now, in parallel with the rest of window construction.
+    projectLoader_ = new TimelineProjectLoader(model_, this);
+    shardStore_ = new TimelineShardStore(model_, this);
+    fileWatcher_ = new TimelineFileWatcher(this);
+    syncSession_ = new TimelineSyncSession(model_, this);
+    reminderScheduler_ = new TimelineReminderScheduler(model_, this);
+    loadTimelineData();
+
     setupUi();
     setupConnections();
     setupAutoSave();
 
-    // Try to load existing timeline data
-    loadTimelineData();
+    sidePanel_->setCurrentTab(sessionState_.sidePanelTab);
+    if (projectLoader_->isRunning())
+    {
+        setLoadProgressVisible(true);
+        statusLabel_->setText("Restoring session: " + loadingFilePath_);
+    }
 
     // Create the legend (initially hidden)
     createLegend();
@@ -84,10 +151,26 @@ TimelineModule::TimelineModule(QWidget* parent)
 
 TimelineModule::~TimelineModule()
 {
+    saveSessionState();
+
     // Only save on exit if we have a file path (user has saved at least once)
     if (autoSaveManager_ && !currentFilePath_.isEmpty())
     {
-        autoSaveManager_->saveNow();
+        // Refused while a merge is pending - the edits must not vanish with the model
+        if (!autoSaveManager_->saveNow() && autoSaveManager_->hasUnsavedChanges() && recoveryCopyPath_.isEmpty())
+        {
+            writeRecoveryCopy();
+        }
+    }
+
+    onLeaveLiveSession();
+
+    // The export worker reads its own copy of the events, but must not outlive the module
+    if (xlsxExportThread_)
+    {
+        xlsxExportCancelled_ = true;
+        xlsxExportThread_->wait();
+        delete xlsxExportThread_;
     }
 
     delete mapper_;
@@ -127,6 +210,19 @@ void TimelineModule::setupUi()
     // Create scroll animator
     scrollAnimator_ = new TimelineScrollAnimator(view_, mapper_, this);
 
+    // Test result import runs its parsing on a worker thread
+    testResultImporter_ = new TestResultImporter(this);
+
+    // Attachment hashing and disk walks run on worker threads
+    attachmentScanner_ = new AttachmentIntegrityScanner(this);
+
+    // Baseline comparison stays idle until a baseline is loaded
+    baselineComparator_ = new TimelineBaselineComparator(model_, this);
+    view_->timelineScene()->setBaselineComparator(baselineComparator_);
+
+    // Swimlane grouping is a view preference
+    view_->timelineScene()->setSwimlaneGrouping(static_cast<SwimlaneGrouping>(TimelineSettings::instance().swimlaneGrouping()));
+
     // ✅ NOW create side panel WITH view_ parameter
     sidePanel_ = new TimelineSidePanel(model_, view_, this);
     sidePanel_->setMinimumWidth(300);
@@ -145,6 +241,18 @@ void TimelineModule::setupUi()
     statusLayout->addWidget(statusLabel_);
     statusLayout->addStretch();
 
+    loadProgressBar_ = new QProgressBar();
+    loadProgressBar_->setMaximumWidth(200);
+    loadProgressBar_->setMaximumHeight(16);
+    statusLayout->addWidget(loadProgressBar_);
+
+    cancelLoadButton_ = new QPushButton("Cancel");
+    cancelLoadButton_->setToolTip("Stop opening the project");
+    connect(cancelLoadButton_, &QPushButton::clicked, projectLoader_, &TimelineProjectLoader::cancel);
+    statusLayout->addWidget(cancelLoadButton_);
+
+    setLoadProgressVisible(false);
+
     unsavedIndicator_ = new QLabel();
     statusLayout->addWidget(unsavedIndicator_);
 
@@ -234,6 +342,21 @@ QToolBar* TimelineModule::createToolbar()
     archiveAction->setShortcutContext(Qt::WindowShortcut);  // Works anywhere in module
     connect(archiveAction, &QAction::triggered, this, &TimelineModule::onShowArchivedEvents);
 
+    // Import Test Results - MODULE-SPECIFIC
+    auto importResultsAction = toolbar->addAction("🧪 Import Results");
+    importResultsAction->setToolTip("Import JUnit/xUnit XML test results into matching test events");
+    connect(importResultsAction, &QAction::triggered, this, &TimelineModule::onImportTestResults);
+
+    // Check Attachments - MODULE-SPECIFIC
+    auto checkAttachmentsAction = toolbar->addAction("📎 Check Attachments");
+    checkAttachmentsAction->setToolTip("Verify attachment files, find orphans and measure disk usage");
+    connect(checkAttachmentsAction, &QAction::triggered, this, &TimelineModule::onCheckAttachments);
+
+    // Import Calendar - MODULE-SPECIFIC
+    auto importICSAction = toolbar->addAction("📅 Import Calendar");
+    importICSAction->setToolTip("Import events from an iCalendar (.ics) file");
+    connect(importICSAction, &QAction::triggered, this, &TimelineModule::onImportICS);
+
     toolbar->addSeparator();
 
     // ========== EXPORT OPERATIONS ==========
@@ -242,15 +365,56 @@ QToolBar* TimelineModule::createToolbar()
     auto exportScreenshotAction = exportMenu->addAction("Export Screenshot (PNG)");
     auto exportCSVAction = exportMenu->addAction("Export to CSV");
     auto exportPDFAction = exportMenu->addAction("Export to PDF");
+    auto exportXLSXAction = exportMenu->addAction("Export to Excel (.xlsx)");
+    auto exportICSAction = exportMenu->addAction("Export to iCalendar (.ics)");
 
     connect(exportScreenshotAction, &QAction::triggered, this, &TimelineModule::onExportScreenshot);
     connect(exportCSVAction, &QAction::triggered, this, &TimelineModule::onExportCSV);
     connect(exportPDFAction, &QAction::triggered, this, &TimelineModule::onExportPDF);
+    connect(exportXLSXAction, &QAction::triggered, this, &TimelineModule::onExportXLSX);
+    connect(exportICSAction, &QAction::triggered, this, &TimelineModule::onExportICS);
 
     auto exportButton = new QPushButton("📤 Export");
     exportButton->setMenu(exportMenu);
     toolbar->addWidget(exportButton);
 
+    // ========== BASELINE COMPARISON ==========
+
+    auto baselineMenu = new QMenu();
+    auto loadBaselineAction = baselineMenu->addAction("Load Baseline...");
+    exportSlipReportAction_ = baselineMenu->addAction("Export Slip Report (CSV)...");
+    baselineMenu->addSeparator();
+    clearBaselineAction_ = baselineMenu->addAction("Clear Baseline");
+
+    exportSlipReportAction_->setEnabled(false);
+    clearBaselineAction_->setEnabled(false);
+
+    connect(loadBaselineAction, &QAction::triggered, this, &TimelineModule::onLoadBaselineClicked);
+    connect(exportSlipReportAction_, &QAction::triggered, this, &TimelineModule::onExportSlipReport);
+    connect(clearBaselineAction_, &QAction::triggered, this, &TimelineModule::onClearBaselineClicked);
+
+    auto baselineButton = new QPushButton("📊 Baseline");
+    baselineButton->setToolTip("Compare the timeline against a baselined project file");
+    baselineButton->setMenu(baselineMenu);
+    toolbar->addWidget(baselineButton);
+
+    // ========== LIVE SESSION ==========
+
+    auto liveMenu = new QMenu();
+    hostSessionAction_ = liveMenu->addAction("Host Live Session");
+    joinSessionAction_ = liveMenu->addAction("Join Live Session...");
+    liveMenu->addSeparator();
+    leaveSessionAction_ = liveMenu->addAction("Leave Session");
+
+    connect(hostSessionAction_, &QAction::triggered, this, &TimelineModule::onHostLiveSession);
+    connect(joinSessionAction_, &QAction::triggered, this, &TimelineModule::onJoinLiveSession);
+    connect(leaveSessionAction_, &QAction::triggered, this, &TimelineModule::onLeaveLiveSession);
+
+    liveSessionButton_ = new QPushButton("⇄ Live");
+    liveSessionButton_->setMenu(liveMenu);
+    toolbar->addWidget(liveSessionButton_);
+    updateLiveSessionState();
+
     toolbar->addSeparator();
 
     // ========== NAVIGATION OPERATIONS (MODULE-SPECIFIC) ==========
@@ -336,6 +500,37 @@ QToolBar* TimelineModule::createToolbar()
     });
     addAction(legendAction);
 
+    // Swimlane Grouping Menu - MODULE-SPECIFIC
+    auto groupMenu = new QMenu();
+    auto groupingActions = new QActionGroup(groupMenu);
+    const int savedGrouping = TimelineSettings::instance().swimlaneGrouping();
+
+    for (SwimlaneGrouping grouping : { SwimlaneGrouping::None, SwimlaneGrouping::Type,
+                                       SwimlaneGrouping::Status, SwimlaneGrouping::TestCategory })
+    {
+        auto action = groupMenu->addAction(SwimlaneLayout::groupingName(grouping));
+        action->setCheckable(true);
+        action->setChecked(static_cast<int>(grouping) == savedGrouping);
+        action->setData(static_cast<int>(grouping));
+        groupingActions->addAction(action);
+    }
+    connect(groupingActions, &QActionGroup::triggered, this, &TimelineModule::onSwimlaneGroupingSelected);
+
+    groupMenu->addSeparator();
+    auto expandGroupsAction = groupMenu->addAction("Expand All Groups");
+    auto collapseGroupsAction = groupMenu->addAction("Collapse All Groups");
+    connect(expandGroupsAction, &QAction::triggered, this, [this]() {
+        view_->timelineScene()->setAllSwimlaneGroupsExpanded(true);
+    });
+    connect(collapseGroupsAction, &QAction::triggered, this, [this]() {
+        view_->timelineScene()->setAllSwimlaneGroupsExpanded(false);
+    });
+
+    auto groupButton = new QPushButton("☰ Group");
+    groupButton->setToolTip("Group rows into swimlanes by type, status or test category");
+    groupButton->setMenu(groupMenu);
+    toolbar->addWidget(groupButton);
+
     // Add spacer
     QWidget* spacer = new QWidget();
     spacer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
@@ -405,6 +600,106 @@ void TimelineModule::setupConnections()
     connect(sidePanel_, &TimelineSidePanel::selectionChanged, this, &TimelineModule::updateDeleteActionState);
     connect(sidePanel_, &TimelineSidePanel::selectionChanged, this, &TimelineModule::updateEditActionState);
 
+    // Test result import
+    connect(testResultImporter_, &TestResultImporter::importFinished, this, [this](const TestResultReport& report)
+            {
+                applyTestResults(report);
+            });
+    connect(testResultImporter_, &TestResultImporter::progressChanged, this, [this](int percent)
+            {
+                if (importProgressDialog_)
+                {
+                    importProgressDialog_->setValue(percent);
+                }
+            });
+
+    // Asynchronous project open
+    connect(projectLoader_, &TimelineProjectLoader::parseFinished, this, &TimelineModule::onProjectParsed);
+    connect(projectLoader_, &TimelineProjectLoader::publishFinished, this, &TimelineModule::onProjectPublished);
+    connect(projectLoader_, &TimelineProjectLoader::parseProgress, this, [this](int percent)
+            {
+                loadProgressBar_->setValue(percent);
+            });
+    connect(projectLoader_, &TimelineProjectLoader::publishProgress, this, [this](int published, int total)
+            {
+                loadProgressBar_->setRange(0, std::max(total, 1));
+                loadProgressBar_->setValue(published);
+                loadProgressBar_->setFormat(QString("%1 / %2 events").arg(published).arg(total));
+            });
+
+    // Sharded projects: periods scrolled into view are read in the background
+    shardLoadTimer_ = new QTimer(this);
+    shardLoadTimer_->setSingleShot(true);
+    shardLoadTimer_->setInterval(200);
+    connect(shardLoadTimer_, &QTimer::timeout, this, &TimelineModule::requestVisibleShards);
+    connect(view_->horizontalScrollBar(), &QScrollBar::valueChanged, shardLoadTimer_, qOverload<>(&QTimer::start));
+    connect(model_, &TimelineModel::versionDatesChanged, shardLoadTimer_, qOverload<>(&QTimer::start));
+    connect(shardStore_, &TimelineShardStore::shardsLoaded, this, [this](int /*shardCount*/, int eventCount)
+            {
+                statusLabel_->setText(QString("Loaded %1 more events (%2 of %3 periods in memory)")
+                                          .arg(eventCount)
+                                          .arg(shardStore_->loadedShardCount())
+                                          .arg(shardStore_->shardCount()));
+            });
+    connect(shardStore_, &TimelineShardStore::shardLoadFailed, this, [this](const QString& error)
+            {
+                statusLabel_->setText("Failed to load part of the project");
+                QMessageBox::warning(this, "Error", "Failed to load part of the timeline.\n\n" + error);
+            });
+
+    // Saves by other users of the same project file
+    connect(fileWatcher_, &TimelineFileWatcher::fileChangedExternally, this, &TimelineModule::onProjectFileChangedExternally);
+
+    // Live co-editing
+    connect(syncSession_, &TimelineSyncSession::connectionChanged, this, [this](bool connected)
+            {
+                if (syncSession_->isActive())
+                {
+                    statusLabel_->setText(connected ? "Live session connected: " + syncSession_->address()
+                                                    : "Live session disconnected - reconnecting...");
+                }
+                updateLiveSessionState();
+            });
+    connect(syncSession_, &TimelineSyncSession::participantsChanged, this, &TimelineModule::updateLiveSessionState);
+    connect(syncSession_, &TimelineSyncSession::remoteChangesApplied, this, [this](int eventCount)
+            {
+                statusLabel_->setText(QString("Live session: %1 event(s) changed by others").arg(eventCount));
+            });
+    connect(syncSession_, &TimelineSyncSession::sessionError, this, [this](const QString& message)
+            {
+                // A session that ended on its own leaves no relay of ours behind
+                if (!syncSession_->isActive() && relayProcess_)
+                {
+                    onLeaveLiveSession();
+                }
+                statusLabel_->setText("Live session: " + message);
+                updateLiveSessionState();
+            });
+
+    // Reminder and due notifications
+    connect(reminderScheduler_, &TimelineReminderScheduler::remindersDue, this, &TimelineModule::onRemindersDue);
+
+    // Attachment integrity scan
+    connect(attachmentScanner_, &AttachmentIntegrityScanner::scanFinished, this, &TimelineModule::showAttachmentScanReport);
+    connect(&AttachmentManager::instance(), &AttachmentManager::metadataRefreshed, this, [this]()
+            {
+                // Refreshed sizes and scan records only help the next launch once they are saved
+                hasUnsavedChanges_ = true;
+                autoSaveManager_->markDirty();
+            });
+    connect(attachmentScanner_, &AttachmentIntegrityScanner::progressChanged, this, [this](int percent)
+            {
+                if (scanProgressDialog_)
+                {
+                    scanProgressDialog_->setValue(percent);
+                }
+            });
+
+    // Baseline diff summary follows every reclassification
+    connect(baselineComparator_, &TimelineBaselineComparator::comparisonReset, this, &TimelineModule::updateBaselineStatus);
+    connect(baselineComparator_, &TimelineBaselineComparator::eventDiffChanged, this, &TimelineModule::updateBaselineStatus);
+    connect(baselineComparator_, &TimelineBaselineComparator::eventDiffsChanged, this, &TimelineModule::updateBaselineStatus);
+
     // Scroll animator completion
     connect(scrollAnimator_, &TimelineScrollAnimator::scrollCompleted, [this](const QDate& date)
             {
@@ -429,10 +724,13 @@ void TimelineModule::setupAutoSave()
     // Create auto-save manager but don't set file path or start it yet
     // It will be configured after the first manual save
     autoSaveManager_ = new AutoSaveManager(model_, "", this);
+    autoSaveManager_->setShardStore(shardStore_);
+    autoSaveManager_->setFileWatcher(fileWatcher_);
 
     // Connect to auto-save signals (unchanged)
     connect(autoSaveManager_, &AutoSaveManager::autoSaveCompleted, [this](const QString& filePath)
             {
+                rememberFileState(filePath, TimelineFileWatcher::hashFile(filePath));
                 statusLabel_->setText("Auto-saved to: " + filePath);
             });
 
@@ -450,21 +748,58 @@ void TimelineModule::setupAutoSave()
 
 void TimelineModule::loadTimelineData()
 {
-    QString defaultPath = TimelineSerializer::getDefaultSaveLocation();
+    sessionState_ = TimelineSettings::instance().sessionState();
 
-    if (QFile::exists(defaultPath))
+    // Last session's project, falling back to the default location
+    QString filePath = sessionState_.projectPath;
+    if (filePath.isEmpty() || !QFile::exists(filePath))
     {
-        bool success = TimelineSerializer::loadFromFile(model_, defaultPath);
-        if (success)
-        {
-            // Rebuild view
-            mapper_->setVersionDates(model_->versionStartDate(), model_->versionEndDate());
-            view_->timelineScene()->rebuildFromModel();
+        filePath = TimelineSerializer::getDefaultSaveLocation();
+    }
 
-            setCurrentFilePath(defaultPath);  // Enable auto-save to this file
-            statusLabel_->setText("Timeline loaded from: " + defaultPath);
-        }
+    // Lanes are packed for the zoom the project will be shown at
+    const bool restoring = (filePath == sessionState_.projectPath);
+    const double pixelsPerDay = restoring && sessionState_.hasViewport() ? sessionState_.pixelsPerDay : mapper_->pixelsPerday();
+
+    if (!QFile::exists(filePath) || !projectLoader_->startLoad(filePath, TimelineScene::laneGapSecondsAt(pixelsPerDay)))
+    {
+        return;
+    }
+
+    loadingFilePath_ = filePath;
+    restoringSession_ = restoring;
+}
+
+
+void TimelineModule::saveSessionState()
+{
+    // A project still loading has not replaced the saved session yet
+    if (projectLoader_->isRunning())
+    {
+        return;
+    }
+
+    TimelineSessionState state = sessionState_;
+    state.projectPath = currentFilePath_;
+    state.sidePanelTab = sidePanel_->currentTab();
+    state.selectedEventIds = getAllSelectedEventIds();
+
+    // Keep the stored viewport if the timeline never made it on screen this session
+    if (activatedThisSession_)
+    {
+        const QPointF center = view_->mapToScene(view_->viewport()->rect().center());
+        const TimelineViewportHint hint = currentViewportHint();
+
+        state.pixelsPerDay = mapper_->pixelsPerday();
+        state.centerDateTime = mapper_->xToDateTime(center.x());
+        state.centerY = center.y();
+        state.visibleStartDate = hint.startDate;
+        state.visibleEndDate = hint.endDate;
+        state.firstVisibleLane = hint.firstLane;
+        state.lastVisibleLane = hint.lastLane;
     }
+
+    TimelineSettings::instance().setSessionState(state);
 }
 
 
@@ -525,15 +860,10 @@ void TimelineModule::onVersionSettingsClicked()
         // Update model version name (this will trigger versionNameChanged signal)
         model_->setVersionName(newName);
 
-        // Update model (this will trigger versionDatesChanged signal)
+        // Update model (versionDatesChanged moves the boundary markers and grows the scene rect;
+        // item positions are epoch-based and stay where they are)
         model_->setVersionDates(newStart, newEnd);
 
-        // Update mapper
-        mapper_->setVersionDates(newStart, newEnd);
-
-        // Rebuild the entire scene with new date range
-        view_->timelineScene()->rebuildFromModel();
-
         QString statusMessage = QString("Version dates updated: %1 to %2")
                                     .arg(newStart.toString("yyyy-MM-dd"))
                                     .arg(newEnd.toString("yyyy-MM-dd"));
@@ -730,11 +1060,42 @@ void TimelineModule::onEventSelectedInPanel(const QString& eventId)
 
 bool TimelineModule::saveToFile(const QString& filePath)
 {
-    bool success = TimelineSerializer::saveToFile(model_, filePath);
+    if (projectLoader_->isRunning())
+    {
+        statusLabel_->setText("Wait for the project to finish loading before saving");
+        return false;
+    }
+
+    // Someone else saved since we loaded: merge their changes instead of overwriting them
+    QByteArray diskData;
+    if (filePath == fileWatcher_->filePath() && fileWatcher_->isChangedOnDisk(&diskData)
+        && !mergeFromDisk(filePath, diskData))
+    {
+        statusLabel_->setText("Not saved - the changes on disk have to be merged first");
+        return false;
+    }
+
+    QString errorString;
+    bool success = false;
+
+    if (TimelineShardStore::isShardedPath(filePath))
+    {
+        success = shardStore_->save(filePath, &errorString);
+    }
+    else if (shardStore_->loadAll(&errorString))
+    {
+        // The single file now holds the whole history; the shards stay as they were
+        success = TimelineSerializer::saveToFile(model_, filePath);
+        if (success)
+        {
+            shardStore_->reset();
+        }
+    }
 
     if (success)
     {
         setCurrentFilePath(filePath);
+        rememberFileState(filePath, TimelineFileWatcher::hashFile(filePath));
         autoSaveManager_->markClean();
         hasUnsavedChanges_ = false;
         statusLabel_->setText("Timeline saved to: " + filePath);
@@ -742,7 +1103,8 @@ bool TimelineModule::saveToFile(const QString& filePath)
     }
     else
     {
-        QMessageBox::warning(this, "Error", "Failed to save timeline.");
+        QMessageBox::warning(this, "Error", errorString.isEmpty() ? QString("Failed to save timeline.")
+                                                                  : "Failed to save timeline.\n\n" + errorString);
         return false;
     }
 }
@@ -755,197 +1117,1302 @@ void TimelineModule::setCurrentFilePath(const QString& filePath)
     // Update auto-save manager with new path
     autoSaveManager_->setSaveFilePath(filePath);
 
-    // Enable auto-save now that we have a file path (if user has it enabled)
-    if (!filePath.isEmpty() && TimelineSettings::instance().autoSaveEnabled())
-    {
-        if (!autoSaveManager_->isAutoSaveEnabled())
-        {
-            autoSaveManager_->startAutoSave(300000);  // 5 minutes
-        }
-    }
-    else
+    // Enable auto-save now that we have a file path (if user has it enabled)
+    if (!filePath.isEmpty() && TimelineSettings::instance().autoSaveEnabled())
+    {
+        if (!autoSaveManager_->isAutoSaveEnabled())
+        {
+            autoSaveManager_->startAutoSave(300000);  // 5 minutes
+        }
+    }
+    else
+    {
+        autoSaveManager_->stopAutoSave();
+    }
+}
+
+
+void TimelineModule::rememberFileState(const QString& filePath, const QByteArray& contentHash)
+{
+    // Sharded projects are merged shard by shard through their checksums, not watched as one file
+    if (filePath.isEmpty() || contentHash.isEmpty() || TimelineShardStore::isShardedPath(filePath))
+    {
+        fileWatcher_->watch(QString(), QByteArray());
+        mergeBase_ = TimelineMergeBase();
+        return;
+    }
+
+    if (fileWatcher_->filePath() == filePath)
+    {
+        fileWatcher_->acceptContent(contentHash);
+    }
+    else
+    {
+        fileWatcher_->watch(filePath, contentHash);
+    }
+
+    mergeBase_ = TimelineMerge::snapshot(model_);
+}
+
+
+void TimelineModule::onHostLiveSession()
+{
+    if (syncSession_->isActive())
+    {
+        return;
+    }
+
+    // Listening beyond this machine has to be a deliberate choice
+    QMessageBox scopeBox(QMessageBox::Question, "Host Live Session",
+                         "Who should be able to join?\n\n"
+                         "Sharing with other computers opens a network port on this machine. "
+                         "Joining requires the session token, but the edits travel unencrypted, "
+                         "so share only on a network you trust.",
+                         QMessageBox::Cancel, this);
+    QPushButton* shareButton = scopeBox.addButton("Other Computers", QMessageBox::AcceptRole);
+    QPushButton* localButton = scopeBox.addButton("This Computer Only", QMessageBox::AcceptRole);
+    scopeBox.setDefaultButton(localButton);
+    scopeBox.exec();
+
+    const bool shared = scopeBox.clickedButton() == shareButton;
+    if (!shared && scopeBox.clickedButton() != localButton)
+    {
+        return;
+    }
+
+    const int port = TimelineSettings::instance().syncPort();
+    const QString token = TimelineSyncProtocol::generateToken();
+
+    // The relay is this executable in headless mode; it runs until we leave the session.
+    // The token goes through the environment so other users cannot read it from the process list.
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert(TimelineSyncProtocol::TOKEN_VARIABLE, token);
+
+    QStringList arguments = { "--sync-relay", "--sync-port", QString::number(port) };
+    if (shared)
+    {
+        arguments.append("--sync-shared");
+    }
+
+    relayProcess_ = new QProcess(this);
+    relayProcess_->setProcessChannelMode(QProcess::ForwardedChannels);
+    relayProcess_->setProcessEnvironment(environment);
+    relayProcess_->start(QCoreApplication::applicationFilePath(), arguments);
+
+    if (!relayProcess_->waitForStarted(3000))
+    {
+        QMessageBox::warning(this, "Live Session", "Failed to start the session relay.\n\n" + relayProcess_->errorString());
+        relayProcess_->deleteLater();
+        relayProcess_ = nullptr;
+        return;
+    }
+
+    // Leaving disconnects this first, so any exit reported here is unexpected
+    QProcess* process = relayProcess_;
+    connect(process, &QProcess::finished, this, [this, process, port](int exitCode, QProcess::ExitStatus status)
+            {
+                if (relayProcess_ != process)
+                {
+                    return;
+                }
+
+                relayProcess_ = nullptr;
+                process->deleteLater();
+                syncSession_->stop();
+                liveSessionToken_.clear();
+                updateLiveSessionState();
+
+                const QString reason = status == QProcess::CrashExit ? QString("crashed")
+                                                                     : QString("exited with code %1").arg(exitCode);
+                statusLabel_->setText("Live session ended - the relay " + reason);
+                QMessageBox::warning(this, "Live Session",
+                                     QString("The live session relay %1, so the session has ended.\n\n"
+                                             "If it could not start, check that port %2 is not in use "
+                                             "and host again.")
+                                         .arg(reason)
+                                         .arg(port));
+            });
+
+    // The session retries until the relay is listening
+    syncSession_->start("127.0.0.1", static_cast<quint16>(port), token);
+    liveSessionToken_ = token;
+
+    const QString address = QString("%1:%2").arg(shared ? QHostInfo::localHostName() : QString("127.0.0.1")).arg(port);
+    statusLabel_->setText(QString("Hosting live session at %1%2")
+                              .arg(address, shared ? QString() : QString(" (this computer only)")));
+    updateLiveSessionState();
+
+    QMessageBox inviteBox(QMessageBox::Information, "Live Session",
+                          QString("Others choose Join Live Session and enter:\n\n"
+                                  "Address:\t%1\nToken:\t%2")
+                              .arg(address, token),
+                          QMessageBox::Ok, this);
+    inviteBox.setTextInteractionFlags(Qt::TextSelectableByMouse);
+    inviteBox.exec();
+}
+
+
+void TimelineModule::onJoinLiveSession()
+{
+    if (syncSession_->isActive())
+    {
+        return;
+    }
+
+    bool ok = false;
+    const QString address = QInputDialog::getText(this, "Join Live Session",
+                                                  "Relay address (host:port).\n"
+                                                  "The open timeline is replaced by the host's project unless it already matches.",
+                                                  QLineEdit::Normal,
+                                                  TimelineSettings::instance().syncLastAddress(),
+                                                  &ok).trimmed();
+    if (!ok || address.isEmpty())
+    {
+        return;
+    }
+
+    const int separator = address.lastIndexOf(':');
+    const QString host = separator > 0 ? address.left(separator) : address;
+    const int port = separator > 0 ? address.mid(separator + 1).toInt() : TimelineSettings::instance().syncPort();
+
+    if (host.isEmpty() || port <= 0 || port > 65535)
+    {
+        QMessageBox::warning(this, "Live Session", "Enter the relay address as host:port.");
+        return;
+    }
+
+    // Not remembered: a token is only good for the session it was made for
+    const QString token = QInputDialog::getText(this, "Join Live Session",
+                                                "Session token (shown to the host when the session started):",
+                                                QLineEdit::Normal, QString(), &ok).trimmed();
+    if (!ok || TimelineSyncProtocol::normalizeToken(token).isEmpty())
+    {
+        return;
+    }
+
+    TimelineSettings::instance().setSyncLastAddress(address);
+
+    syncSession_->start(host, static_cast<quint16>(port), token);
+    statusLabel_->setText("Joining live session at " + syncSession_->address() + "...");
+    updateLiveSessionState();
+}
+
+
+void TimelineModule::onLeaveLiveSession()
+{
+    const bool wasActive = syncSession_->isActive();
+    syncSession_->stop();
+
+    if (relayProcess_)
+    {
+        relayProcess_->disconnect(this);
+        relayProcess_->kill();
+        relayProcess_->waitForFinished(1000);
+        relayProcess_->deleteLater();
+        relayProcess_ = nullptr;
+    }
+    liveSessionToken_.clear();
+
+    if (wasActive)
+    {
+        statusLabel_->setText("Left the live session");
+    }
+    updateLiveSessionState();
+}
+
+
+void TimelineModule::updateLiveSessionState()
+{
+    if (!liveSessionButton_)
+    {
+        return;
+    }
+
+    const bool active = syncSession_->isActive();
+    hostSessionAction_->setEnabled(!active);
+    joinSessionAction_->setEnabled(!active);
+    leaveSessionAction_->setEnabled(active);
+
+    liveSessionButton_->setToolTip(liveSessionToken_.isEmpty()
+                                       ? QString("Edit this project together with other users in real time")
+                                       : QString("Hosting a live session - session token %1").arg(liveSessionToken_));
+
+    if (!active)
+    {
+        liveSessionButton_->setText("⇄ Live");
+    }
+    else if (syncSession_->isConnected())
+    {
+        liveSessionButton_->setText(QString("⇄ Live (%1)").arg(syncSession_->participantCount()));
+    }
+    else
+    {
+        liveSessionButton_->setText("⇄ Live (offline)");
+    }
+}
+
+
+void TimelineModule::onRemindersDue(const QVector<TimelineReminder>& reminders)
+{
+    QStringList lines;
+    for (const TimelineReminder& reminder : reminders)
+    {
+        const TimelineEvent* event = model_->getEvent(reminder.eventId);
+        if (!event)
+        {
+            continue;
+        }
+
+        lines.append(QString("%1: %2 (%3)")
+                         .arg(reminder.kind == TimelineReminder::Due ? "Due" : "Reminder")
+                         .arg(event->title)
+                         .arg(reminder.when.toLocalTime().toString("yyyy-MM-dd HH:mm")));
+        lastReminderEventId_ = reminder.eventId;
+    }
+
+    if (lines.isEmpty())
+    {
+        return;
+    }
+
+    statusLabel_->setText(lines.size() == 1 ? lines.first() : QString("%1 reminders due").arg(lines.size()));
+    QApplication::alert(window());
+
+    // Desktop notification, where the platform has a tray to show it from
+    if (QSystemTrayIcon::isSystemTrayAvailable() && QSystemTrayIcon::supportsMessages())
+    {
+        if (!reminderTrayIcon_)
+        {
+            QIcon icon = QApplication::windowIcon();
+            if (icon.isNull())
+            {
+                icon = style()->standardIcon(QStyle::SP_MessageBoxInformation);
+            }
+
+            reminderTrayIcon_ = new QSystemTrayIcon(icon, this);
+            reminderTrayIcon_->setToolTip("Timeline reminders");
+            connect(reminderTrayIcon_, &QSystemTrayIcon::messageClicked, this, &TimelineModule::showReminderEvent);
+        }
+
+        constexpr int maxTrayLines = 5;
+        QString message = QStringList(lines.mid(0, maxTrayLines)).join('\n');
+        if (lines.size() > maxTrayLines)
+        {
+            message += QString("\n...and %1 more").arg(lines.size() - maxTrayLines);
+        }
+
+        reminderTrayIcon_->show();
+        reminderTrayIcon_->showMessage(lines.size() == 1 ? "Timeline reminder" : "Timeline reminders",
+                                       message, QSystemTrayIcon::Information, 10000);
+    }
+
+    // In-app list, non-modal so a burst of reminders never blocks editing
+    if (!reminderBox_)
+    {
+        reminderBox_ = new QMessageBox(QMessageBox::Information, "Reminders", QString(), QMessageBox::Close, this);
+        reminderBox_->setModal(false);
+        reminderBox_->setAttribute(Qt::WA_DeleteOnClose);
+
+        auto showButton = reminderBox_->addButton("Show Event", QMessageBox::ActionRole);
+        connect(showButton, &QPushButton::clicked, this, &TimelineModule::showReminderEvent);
+    }
+
+    // Newest last; older lines are dropped once the list gets long
+    constexpr int maxBoxLines = 20;
+    QStringList shown = reminderBox_->text().split('\n', Qt::SkipEmptyParts) + lines;
+    if (shown.size() > maxBoxLines)
+    {
+        shown = shown.mid(shown.size() - maxBoxLines);
+    }
+    reminderBox_->setText(shown.join('\n'));
+    reminderBox_->show();
+    reminderBox_->raise();
+}
+
+
+void TimelineModule::showReminderEvent()
+{
+    if (QWidget* topLevel = window())
+    {
+        if (topLevel->isMinimized())
+        {
+            topLevel->showNormal();
+        }
+        topLevel->raise();
+        topLevel->activateWindow();
+    }
+
+    if (!lastReminderEventId_.isEmpty() && model_->getEvent(lastReminderEventId_))
+    {
+        onEventSelectedInPanel(lastReminderEventId_);
+    }
+}
+
+
+void TimelineModule::onProjectFileChangedExternally(const QString& filePath, const QByteArray& data)
+{
+    // A load in progress replaces the model anyway; a second notification waits for the open dialog
+    if (projectLoader_->isRunning() || merging_ || filePath != currentFilePath_)
+    {
+        return;
+    }
+
+    mergeFromDisk(filePath, data);
+}
+
+
+bool TimelineModule::mergeFromDisk(const QString& filePath, const QByteArray& data)
+{
+    if (merging_)
+    {
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    if (!doc.isObject() || TimelineSerializer::isShardManifest(doc.object()))
+    {
+        // Most likely caught mid-write; the watcher reports again once the writer is done
+        statusLabel_->setText("The project file changed on disk but could not be read yet");
+        return false;
+    }
+
+    TimelineProjectData remote;
+    TimelineSerializer::readProject(doc.object(), remote);
+
+    const TimelineMergePlan plan = TimelineMerge::plan(mergeBase_, model_, remote);
+
+    QSet<QString> takeRemote;
+    if (!plan.conflicts.isEmpty())
+    {
+        QScopedValueRollback<bool> guard(merging_, true);
+
+        MergeConflictDialog dialog(plan, filePath, this);
+        if (dialog.exec() != QDialog::Accepted)
+        {
+            statusLabel_->setText("Merge postponed - saving is paused until the changes on disk are merged");
+            return false;
+        }
+        takeRemote = dialog.takeRemoteIds();
+    }
+
+    if (plan.hasRemoteChanges())
+    {
+        TimelineMerge::apply(model_, plan, takeRemote);
+        AttachmentManager::instance().mergeRegistry(remote.attachmentRegistry);
+
+        // Undo history refers to events as they were before the merge
+        undoStack_->clear();
+    }
+
+    // The file on disk is the new common ancestor
+    mergeBase_ = TimelineMerge::snapshot(remote);
+    fileWatcher_->acceptContent(TimelineFileWatcher::hashContent(data));
+
+    // Anything kept from our side still has to be written
+    const bool localChangesRemain = plan.keptLocal > 0 || plan.versionConflict
+                                    || takeRemote.size() < plan.conflicts.size();
+    if (localChangesRemain)
+    {
+        autoSaveManager_->markDirty();
+    }
+    else
+    {
+        autoSaveManager_->markClean();
+    }
+    hasUnsavedChanges_ = localChangesRemain;
+
+    const int fromDisk = plan.takeRemote.size() + plan.removeLocal.size() + takeRemote.size();
+    statusLabel_->setText(QString("Merged changes from disk: %1 event(s) updated, %2 conflict(s) resolved")
+                              .arg(fromDisk)
+                              .arg(plan.conflicts.size()));
+    return true;
+}
+
+
+void TimelineModule::onSaveClicked()
+{
+    // If we have a current file path, save directly to it
+    if (!currentFilePath_.isEmpty())
+    {
+        if (saveToFile(currentFilePath_))
+        {
+            QMessageBox::information(this, "Success", "Timeline saved successfully!");
+        }
+    }
+    else
+    {
+        // No current file path - this is the first save, show dialog
+        onSaveAsClicked();
+    }
+}
+
+
+void TimelineModule::onSaveAsClicked()
+{
+    QString initialPath = currentFilePath_.isEmpty()
+    ? TimelineSerializer::getDefaultSaveLocation()
+    : currentFilePath_;
+
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        "Save Timeline As",
+        initialPath,
+        "JSON Files (*.json);;Sharded Timeline Project (*.tlproj);;All Files (*)"
+        );
+
+    if (!filePath.isEmpty())
+    {
+        if (saveToFile(filePath))
+        {
+            QMessageBox::information(this, "Success", "Timeline saved successfully!");
+        }
+    }
+}
+
+
+void TimelineModule::onLoadClicked()
+{
+    if (!confirmReplaceProject())
+    {
+        return;
+    }
+
+    // Use current path's directory if available
+    QString initialPath = currentFilePath_.isEmpty()
+                              ? TimelineSerializer::getDefaultSaveLocation()
+                              : QFileInfo(currentFilePath_).absolutePath();
+
+    QString filePath = QFileDialog::getOpenFileName(
+        this,
+        "Load Timeline",
+        initialPath,
+        "Timeline Files (*.json *.tlproj);;All Files (*)"
+        );
+
+    if (!filePath.isEmpty())
+    {
+        openProject(filePath);
+    }
+}
+
+
+void TimelineModule::loadFile(const QString& filePath)
+{
+    // Opened once the running load is done; a session restore is not worth finishing first
+    if (projectLoader_->isRunning())
+    {
+        queuedFilePath_ = filePath;
+        if (restoringSession_)
+        {
+            projectLoader_->cancel();
+        }
+        statusLabel_->setText("Opening next: " + filePath);
+        return;
+    }
+
+    if (QFileInfo(filePath).absoluteFilePath() == QFileInfo(currentFilePath_).absoluteFilePath())
+    {
+        statusLabel_->setText("Already open: " + filePath);
+        return;
+    }
+
+    if (confirmReplaceProject())
+    {
+        openProject(filePath);
+    }
+}
+
+
+void TimelineModule::openQueuedFile()
+{
+    if (queuedFilePath_.isEmpty())
+    {
+        return;
+    }
+
+    // Let the loader finish emitting before the next load starts
+    QTimer::singleShot(0, this, [this, filePath = std::exchange(queuedFilePath_, QString())]()
+                       {
+                           loadFile(filePath);
+                       });
+}
+
+
+bool TimelineModule::confirmReplaceProject()
+{
+    if (projectLoader_->isRunning())
+    {
+        statusLabel_->setText("A project is already being opened");
+        return false;
+    }
+
+    // Warn if unsaved changes
+    if (autoSaveManager_->hasUnsavedChanges())
+    {
+        auto result = QMessageBox::question(
+            this,
+            "Unsaved Changes",
+            "You have unsaved changes. Do you want to save before loading?",
+            QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel
+            );
+
+        if (result == QMessageBox::Save)
+        {
+            onSaveClicked();
+        }
+        else if (result == QMessageBox::Cancel)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void TimelineModule::openProject(const QString& filePath)
+{
+    // Opening keeps the current zoom, so lanes are packed for it
+    if (!projectLoader_->startLoad(filePath, TimelineScene::laneGapSecondsAt(mapper_->pixelsPerday())))
+    {
+        return;
+    }
+
+    loadingFilePath_ = filePath;
+    restoringSession_ = false;
+
+    setLoadProgressVisible(true);
+
+    statusLabel_->setText("Opening: " + filePath);
+}
+
+
+void TimelineModule::onProjectParsed(const TimelineLoadResult& result)
+{
+    // Parsing never touched the model, so a failed or cancelled open leaves the current project as it was
+    if (!result.isValid())
+    {
+        setLoadProgressVisible(false);
+        loadingFilePath_.clear();
+        restoringSession_ = false;
+
+        if (result.cancelled)
+        {
+            statusLabel_->setText("Open cancelled");
+        }
+        else
+        {
+            statusLabel_->setText("Failed to load: " + result.filePath);
+            QMessageBox::warning(this, "Error", "Failed to load timeline.\n\n" + result.errorString);
+        }
+
+        openQueuedFile();
+        return;
+    }
+
+    // No auto-save, no merging and no undo into the previous project while the new one streams in
+    setCurrentFilePath(QString());
+    rememberFileState(QString(), QByteArray());
+    pendingContentHash_ = result.contentHash;
+    undoStack_->clear();
+
+    // Other participants must not receive the new project as edits
+    onLeaveLiveSession();
+
+    model_->clear();
+
+    const TimelineProjectData& project = result.project;
+    if (project.sharded)
+    {
+        shardStore_->attach(result.filePath, project);
+    }
+    else
+    {
+        shardStore_->reset();
+    }
+    if (project.versionStart.isValid() && project.versionEnd.isValid())
+    {
+        model_->setVersionDates(project.versionStart, project.versionEnd);
+    }
+    if (project.hasVersionName)
+    {
+        model_->setVersionName(project.versionName);
+    }
+
+    // Empty scene laid out for the new version range (and the session's zoom level)
+    const bool restoreViewport = restoringSession_ && sessionState_.hasViewport();
+    mapper_->setVersionDates(model_->versionStartDate(), model_->versionEndDate());
+    if (restoreViewport)
+    {
+        mapper_->setPixelsPerDay(sessionState_.pixelsPerDay);
+    }
+    view_->timelineScene()->rebuildFromModel();
+
+    const double sessionCenterX = restoreViewport ? mapper_->dateTimeToX(sessionState_.centerDateTime) : 0.0;
+    if (restoreViewport)
+    {
+        view_->centerOn(sessionCenterX, sessionState_.centerY);
+    }
+
+    // Attachment counts must be known before the first items are created; checking the
+    // files themselves waits until the project is fully loaded
+    AttachmentManager::instance().setProjectDirectory(QFileInfo(result.filePath).absolutePath());
+    AttachmentManager::instance().importRegistry(project.attachmentRegistry, false);
+
+    // Archived events are not shown, so they are installed once publishing is done
+    pendingArchivedEvents_ = project.archivedEvents;
+
+    TimelineViewportHint viewport = currentViewportHint();
+    if (restoreViewport && sessionState_.visibleStartDate.isValid() && sessionState_.visibleEndDate.isValid())
+    {
+        // The scene is still empty, so only the stored hint knows which lanes will be on screen
+        viewport.startDate = sessionState_.visibleStartDate;
+        viewport.endDate = sessionState_.visibleEndDate;
+        viewport.firstLane = sessionState_.firstVisibleLane;
+        viewport.lastLane = sessionState_.lastVisibleLane;
+    }
+
+    loadProgressBar_->setValue(0);
+    publishedLaneGapSecs_ = result.laneGapSecs;
+    projectLoader_->publish(result, viewport);
+
+    // The on-screen events are in now, so the scene is tall enough for the stored vertical position
+    if (restoreViewport)
+    {
+        view_->centerOn(sessionCenterX, sessionState_.centerY);
+    }
+
+    statusLabel_->setText("Loading: " + result.filePath);
+}
+
+
+void TimelineModule::onProjectPublished(bool cancelled)
+{
+    setLoadProgressVisible(false);
+
+    const QString filePath = loadingFilePath_;
+    loadingFilePath_.clear();
+
+    const bool restoredSession = restoringSession_;
+    restoringSession_ = false;
+
+    if (cancelled)
+    {
+        pendingArchivedEvents_.clear();
+
+        // A partially loaded project must not be saved over anything; close it instead
+        shardStore_->reset();
+        pendingContentHash_.clear();
+        model_->clear();
+        AttachmentManager::instance().importRegistry({});
+        view_->timelineScene()->rebuildFromModel();
+        undoStack_->clear();
+        autoSaveManager_->markClean();
+
+        statusLabel_->setText("Open cancelled - project closed");
+        openQueuedFile();
+        return;
+    }
+
+    // Zooming while the project streamed in changed the gap; pack once for the complete set
+    if (model_->laneGapSeconds() != publishedLaneGapSecs_)
+    {
+        model_->recalculateLanes();
+    }
+
+    setCurrentFilePath(filePath);
+    autoSaveManager_->markClean();
+    statusLabel_->setText(QString("Timeline loaded from: %1 (%2 events)").arg(filePath).arg(model_->eventCount()));
+
+    if (restoredSession)
+    {
+        TimelineScene* scene = view_->timelineScene();
+        for (const QString& eventId : std::as_const(sessionState_.selectedEventIds))
+        {
+            if (TimelineItem* item = scene->findItemByEventId(eventId))
+            {
+                item->setSelected(true);
+            }
+        }
+
+        if (!sessionState_.selectedEventIds.isEmpty() && model_->getEvent(sessionState_.selectedEventIds.first()))
+        {
+            sidePanel_->displayEventDetails(sessionState_.selectedEventIds.first());
+        }
+    }
+
+    // Work nobody is looking at yet runs once the event loop is idle again
+    QTimer::singleShot(0, this, [this, archived = std::move(pendingArchivedEvents_)]()
+                       {
+                           model_->addArchivedEvents(archived);
+                           AttachmentManager::instance().requestFileValidation();
+
+                           // Everything read so far matches the shard files; later edits make them dirty
+                           shardStore_->markLoadedClean();
+                           requestVisibleShards();
+
+                           // The complete project is in, so it is the base for merging other users' saves
+                           rememberFileState(currentFilePath_, std::exchange(pendingContentHash_, QByteArray()));
+                       });
+    pendingArchivedEvents_.clear();
+
+    openQueuedFile();
+}
+
+
+void TimelineModule::setLoadProgressVisible(bool visible)
+{
+    if (visible)
+    {
+        loadProgressBar_->setRange(0, 100);
+        loadProgressBar_->setValue(0);
+        loadProgressBar_->setFormat("Reading... %p%");
+    }
+
+    loadProgressBar_->setVisible(visible);
+    cancelLoadButton_->setVisible(visible);
+}
+
+
+TimelineViewportHint TimelineModule::currentViewportHint() const
+{
+    const QRectF visible = view_->mapToScene(view_->viewport()->rect()).boundingRect();
+
+    TimelineViewportHint hint;
+    hint.startDate = mapper_->xToDate(visible.left());
+    hint.endDate = mapper_->xToDate(visible.right());
+    hint.firstLane = TimelineScene::laneAtY(visible.top());
+    hint.lastLane = TimelineScene::laneAtY(visible.bottom());
+
+    return hint;
+}
+
+
+void TimelineModule::requestVisibleShards()
+{
+    // The loader owns the model until publishing is done
+    if (!shardStore_->isActive() || projectLoader_->isRunning())
+    {
+        return;
+    }
+
+    // One screen of lookahead on either side, so scrolling rarely reaches an unloaded period
+    const TimelineViewportHint viewport = currentViewportHint();
+    const qint64 span = std::max<qint64>(viewport.startDate.daysTo(viewport.endDate), 1);
+    shardStore_->ensureLoaded(viewport.startDate.addDays(-span), viewport.endDate.addDays(span));
+}
+
+
+void TimelineModule::onExportScreenshot()
+{
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        "Export Screenshot",
+        "timeline_screenshot.png",
+        "PNG Images (*.png);;JPEG Images (*.jpg *.jpeg);;All Files (*)"
+        );
+
+    if (!filePath.isEmpty())
+    {
+        bool success = TimelineExporter::exportScreenshot(view_, filePath, true);
+
+        if (success)
+        {
+            statusLabel_->setText("Screenshot exported to: " + filePath);
+            QMessageBox::information(this, "Success", "Screenshot exported successfully!");
+        }
+        else
+        {
+            QMessageBox::warning(this, "Error", "Failed to export screenshot.");
+        }
+    }
+}
+
+
+void TimelineModule::onExportCSV()
+{
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        "Export to CSV",
+        "timeline_events.csv",
+        "CSV Files (*.csv);;All Files (*)"
+        );
+
+    if (!filePath.isEmpty())
+    {
+        bool success = TimelineExporter::exportToCSV(model_, filePath);
+
+        if (success)
+        {
+            statusLabel_->setText("CSV exported to: " + filePath);
+            QMessageBox::information(this, "Success",
+                                     QString("Exported %1 events to CSV successfully!")
+                                         .arg(model_->eventCount()));
+        }
+        else
+        {
+            QMessageBox::warning(this, "Error", "Failed to export to CSV.");
+        }
+    }
+}
+
+
+void TimelineModule::onExportXLSX()
+{
+    if (xlsxExportThread_)
+    {
+        statusLabel_->setText("An Excel export is already running");
+        return;
+    }
+
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        "Export to Excel",
+        "timeline_events.xlsx",
+        "Excel Workbook (*.xlsx);;All Files (*)"
+        );
+
+    if (filePath.isEmpty())
+    {
+        return;
+    }
+
+    // The worker gets its own copy, so the user can keep editing while the file is written
+    const QVector<TimelineEvent> events = model_->getAllEvents();
+
+    auto progressDialog = new QProgressDialog("Writing workbook...", "Cancel", 0, 100, this);
+    progressDialog->setWindowTitle("Export to Excel");
+    progressDialog->setMinimumDuration(500);
+    connect(progressDialog, &QProgressDialog::canceled, this, [this]() { xlsxExportCancelled_ = true; });
+
+    xlsxExportCancelled_ = false;
+
+    xlsxExportThread_ = QThread::create([this, events, filePath, progressDialog]()
+    {
+        auto reportProgress = [progressDialog](int percent)
+        {
+            QMetaObject::invokeMethod(progressDialog, [progressDialog, percent]() { progressDialog->setValue(percent); }, Qt::QueuedConnection);
+        };
+
+        QString errorString;
+        const bool success = TimelineExporter::exportToXLSX(events, filePath, &xlsxExportCancelled_, reportProgress, &errorString);
+
+        // Report back on the GUI thread
+        QMetaObject::invokeMethod(this, [this, success, errorString, filePath, progressDialog, count = events.size()]()
+        {
+            progressDialog->deleteLater();
+
+            if (success)
+            {
+                statusLabel_->setText(QString("Exported %1 events to: %2").arg(count).arg(filePath));
+            }
+            else if (xlsxExportCancelled_)
+            {
+                statusLabel_->setText("Excel export cancelled");
+            }
+            else
+            {
+                QMessageBox::warning(this, "Error", "Failed to export to Excel:\n\n" + errorString);
+            }
+        }, Qt::QueuedConnection);
+    });
+
+    connect(xlsxExportThread_, &QThread::finished, this, [this]()
     {
-        autoSaveManager_->stopAutoSave();
-    }
+        xlsxExportThread_->deleteLater();
+        xlsxExportThread_ = nullptr;
+    });
+
+    xlsxExportThread_->start(QThread::LowPriority);
+    statusLabel_->setText(QString("Exporting %1 events to Excel...").arg(events.size()));
 }
 
 
-void TimelineModule::onSaveClicked()
+void TimelineModule::onExportICS()
 {
-    // If we have a current file path, save directly to it
-    if (!currentFilePath_.isEmpty())
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        "Export to iCalendar",
+        "timeline_events.ics",
+        "iCalendar Files (*.ics);;All Files (*)"
+        );
+
+    if (!filePath.isEmpty())
     {
-        if (saveToFile(currentFilePath_))
+        bool success = TimelineICalendar::exportToFile(model_, filePath);
+
+        if (success)
         {
-            QMessageBox::information(this, "Success", "Timeline saved successfully!");
+            statusLabel_->setText(QString("Exported %1 events to: %2").arg(model_->eventCount()).arg(filePath));
+        }
+        else
+        {
+            QMessageBox::warning(this, "Error", "Failed to export to iCalendar.");
         }
-    }
-    else
-    {
-        // No current file path - this is the first save, show dialog
-        onSaveAsClicked();
     }
 }
 
 
-void TimelineModule::onSaveAsClicked()
+void TimelineModule::onImportICS()
 {
     QString initialPath = currentFilePath_.isEmpty()
-    ? TimelineSerializer::getDefaultSaveLocation()
-    : currentFilePath_;
+                              ? QString()
+                              : QFileInfo(currentFilePath_).absolutePath();
 
-    QString filePath = QFileDialog::getSaveFileName(
+    QString filePath = QFileDialog::getOpenFileName(
         this,
-        "Save Timeline As",
+        "Import Calendar",
         initialPath,
-        "JSON Files (*.json);;All Files (*)"
+        "iCalendar Files (*.ics);;All Files (*)"
         );
 
-    if (!filePath.isEmpty())
+    if (filePath.isEmpty())
     {
-        if (saveToFile(filePath))
-        {
-            QMessageBox::information(this, "Success", "Timeline saved successfully!");
-        }
+        return;
+    }
+
+    QVector<TimelineEvent> events;
+    QString errorString;
+
+    if (!TimelineICalendar::importFromFile(filePath, events, &errorString))
+    {
+        QMessageBox::warning(this, "Error", "Failed to import calendar:\n\n" + errorString);
+        return;
+    }
+
+    // Re-importing an exported calendar keeps the original IDs - skip events already on the timeline
+    QSet<QString> existingIds;
+    for (const TimelineEvent& event : model_->getAllEvents())
+    {
+        existingIds.insert(event.id);
+    }
+
+    const qsizetype parsedCount = events.size();
+    events.erase(std::remove_if(events.begin(), events.end(), [&existingIds](const TimelineEvent& event)
+                                {
+                                    return !event.id.isEmpty() && existingIds.contains(event.id);
+                                }),
+                 events.end());
+
+    const QString fileName = QFileInfo(filePath).fileName();
+
+    if (events.isEmpty())
+    {
+        QMessageBox::information(this, "Import Calendar",
+                                 parsedCount == 0 ? QString("The calendar does not contain any events.")
+                                                  : QString("All %1 events are already on the timeline.").arg(parsedCount));
+        return;
     }
+
+    // Single batched insert: one relayout and one model notification for the whole calendar
+    undoStack_->push(new BatchAddEventsCommand(model_, events,
+                                               QString("Import calendar (%1 events)").arg(events.size())));
+
+    statusLabel_->setText(QString("Imported %1 of %2 events from %3")
+                              .arg(events.size())
+                              .arg(parsedCount)
+                              .arg(fileName));
 }
 
 
-void TimelineModule::onLoadClicked()
+void TimelineModule::onExportPDF()
 {
-    // Warn if unsaved changes
-    if (autoSaveManager_->hasUnsavedChanges())
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        "Export to PDF",
+        "timeline_report.pdf",
+        "PDF Files (*.pdf);;All Files (*)"
+        );
+
+    if (!filePath.isEmpty())
     {
-        auto result = QMessageBox::question(
-            this,
-            "Unsaved Changes",
-            "You have unsaved changes. Do you want to save before loading?",
-            QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel
-            );
+        bool success = TimelineExporter::exportToPDF(model_, view_, filePath, true);
 
-        if (result == QMessageBox::Save)
+        if (success)
         {
-            onSaveClicked();
+            statusLabel_->setText("PDF exported to: " + filePath);
+            QMessageBox::information(this, "Success", "PDF report generated successfully!");
         }
-        else if (result == QMessageBox::Cancel)
+        else
         {
-            return;
+            QMessageBox::warning(this, "Error", "Failed to export to PDF.");
         }
     }
+}
 
-    // Use current path's directory if available
+
+void TimelineModule::onLoadBaselineClicked()
+{
     QString initialPath = currentFilePath_.isEmpty()
                               ? TimelineSerializer::getDefaultSaveLocation()
                               : QFileInfo(currentFilePath_).absolutePath();
 
     QString filePath = QFileDialog::getOpenFileName(
         this,
-        "Load Timeline",
+        "Load Baseline",
         initialPath,
         "JSON Files (*.json);;All Files (*)"
         );
 
-    if (!filePath.isEmpty())
+    if (filePath.isEmpty())
     {
-        bool success = TimelineSerializer::loadFromFile(model_, filePath);
+        return;
+    }
 
-        if (success)
-        {
-            // Rebuild view
-            mapper_->setVersionDates(model_->versionStartDate(), model_->versionEndDate());
-            view_->timelineScene()->rebuildFromModel();
-
-            // Set current file path and enable auto-save
-            setCurrentFilePath(filePath);
-            statusLabel_->setText("Timeline loaded from: " + filePath);
-            autoSaveManager_->markClean();
-            QMessageBox::information(this, "Success", "Timeline loaded successfully!");
-        }
-        else
-        {
-            QMessageBox::warning(this, "Error", "Failed to load timeline.");
-        }
+    if (!baselineComparator_->loadBaseline(filePath))
+    {
+        QMessageBox::warning(this, "Error", "Failed to load baseline.");
+        return;
     }
+
+    exportSlipReportAction_->setEnabled(true);
+    clearBaselineAction_->setEnabled(true);
+
+    updateBaselineStatus();
 }
 
 
-void TimelineModule::onExportScreenshot()
+void TimelineModule::onClearBaselineClicked()
 {
-    QString filePath = QFileDialog::getSaveFileName(
-        this,
-        "Export Screenshot",
-        "timeline_screenshot.png",
-        "PNG Images (*.png);;JPEG Images (*.jpg *.jpeg);;All Files (*)"
-        );
+    baselineComparator_->clearBaseline();
 
-    if (!filePath.isEmpty())
-    {
-        bool success = TimelineExporter::exportScreenshot(view_, filePath, true);
+    exportSlipReportAction_->setEnabled(false);
+    clearBaselineAction_->setEnabled(false);
 
-        if (success)
-        {
-            statusLabel_->setText("Screenshot exported to: " + filePath);
-            QMessageBox::information(this, "Success", "Screenshot exported successfully!");
-        }
-        else
-        {
-            QMessageBox::warning(this, "Error", "Failed to export screenshot.");
-        }
-    }
+    statusLabel_->setText("Baseline cleared");
 }
 
 
-void TimelineModule::onExportCSV()
+void TimelineModule::onExportSlipReport()
 {
+    if (!baselineComparator_->hasBaseline())
+    {
+        return;
+    }
+
     QString filePath = QFileDialog::getSaveFileName(
         this,
-        "Export to CSV",
-        "timeline_events.csv",
+        "Export Slip Report",
+        "timeline_slip_report.csv",
         "CSV Files (*.csv);;All Files (*)"
         );
 
     if (!filePath.isEmpty())
     {
-        bool success = TimelineExporter::exportToCSV(model_, filePath);
+        bool success = TimelineExporter::exportSlipReportToCSV(model_, baselineComparator_, filePath);
 
         if (success)
         {
-            statusLabel_->setText("CSV exported to: " + filePath);
+            statusLabel_->setText("Slip report exported to: " + filePath);
             QMessageBox::information(this, "Success",
-                                     QString("Exported %1 events to CSV successfully!")
-                                         .arg(model_->eventCount()));
+                                     QString("Exported %1 changed events to slip report successfully!")
+                                         .arg(baselineComparator_->changedEvents().size()));
         }
         else
         {
-            QMessageBox::warning(this, "Error", "Failed to export to CSV.");
+            QMessageBox::warning(this, "Error", "Failed to export slip report.");
         }
     }
 }
 
 
-void TimelineModule::onExportPDF()
+void TimelineModule::updateBaselineStatus()
 {
-    QString filePath = QFileDialog::getSaveFileName(
+    if (!baselineComparator_->hasBaseline())
+    {
+        return;
+    }
+
+    const auto summary = baselineComparator_->summary();
+
+    statusLabel_->setText(QString("Baseline '%1': %2 slipped, %3 resized, %4 edited, %5 added, %6 removed")
+                              .arg(baselineComparator_->baselineLabel())
+                              .arg(summary.slipped)
+                              .arg(summary.resized)
+                              .arg(summary.edited)
+                              .arg(summary.added)
+                              .arg(summary.removed));
+}
+
+
+void TimelineModule::onImportTestResults()
+{
+    if (testResultImporter_->isRunning())
+    {
+        statusLabel_->setText("A test result import is already running");
+        return;
+    }
+
+    QString initialPath = currentFilePath_.isEmpty()
+                              ? QString()
+                              : QFileInfo(currentFilePath_).absolutePath();
+
+    QStringList filePaths = QFileDialog::getOpenFileNames(
         this,
-        "Export to PDF",
-        "timeline_report.pdf",
-        "PDF Files (*.pdf);;All Files (*)"
+        "Import Test Results",
+        initialPath,
+        "JUnit/xUnit XML (*.xml);;All Files (*)"
         );
 
-    if (!filePath.isEmpty())
+    if (filePaths.isEmpty())
     {
-        bool success = TimelineExporter::exportToPDF(model_, view_, filePath, true);
+        return;
+    }
 
-        if (success)
-        {
-            statusLabel_->setText("PDF exported to: " + filePath);
-            QMessageBox::information(this, "Success", "PDF report generated successfully!");
-        }
-        else
+    if (!testResultImporter_->startImport(filePaths))
+    {
+        return;
+    }
+
+    importProgressDialog_ = new QProgressDialog("Parsing test results...", "Cancel", 0, 100, this);
+    importProgressDialog_->setWindowTitle("Import Test Results");
+    importProgressDialog_->setMinimumDuration(500);
+    connect(importProgressDialog_, &QProgressDialog::canceled, testResultImporter_, &TestResultImporter::cancel);
+
+    statusLabel_->setText(QString("Importing test results from %1 file(s)...").arg(filePaths.size()));
+}
+
+
+void TimelineModule::applyTestResults(const TestResultReport& report)
+{
+    if (importProgressDialog_)
+    {
+        importProgressDialog_->deleteLater();
+        importProgressDialog_ = nullptr;
+    }
+
+    if (report.cancelled)
+    {
+        statusLabel_->setText("Test result import cancelled");
+        return;
+    }
+
+    if (!report.errorString.isEmpty())
+    {
+        QMessageBox::warning(this, "Error", "Failed to import test results:\n\n" + report.errorString);
+        return;
+    }
+
+    int matchedSuites = 0;
+    QVector<TimelineEvent> updatedEvents = TestResultImporter::applyReport(model_, report, &matchedSuites);
+
+    if (updatedEvents.isEmpty())
+    {
+        QMessageBox::information(this, "Import Test Results",
+                                 QString("Parsed %1 suite(s), but none matched a test event title.")
+                                     .arg(report.suites.size()));
+        return;
+    }
+
+    // One undoable, single-relayout update for every matched test event
+    undoStack_->push(new BatchUpdateEventsCommand(model_, updatedEvents,
+                                                  QString("Import test results (%1 events)").arg(updatedEvents.size())));
+
+    int passed = 0;
+    int failed = 0;
+    int skipped = 0;
+    for (const TimelineEvent& event : updatedEvents)
+    {
+        passed += event.testsPassed;
+        failed += event.testsFailed;
+        skipped += event.testsSkipped;
+    }
+
+    statusLabel_->setText(QString("Test results applied to %1 event(s) from %2 of %3 suite(s): %4 passed, %5 failed, %6 skipped")
+                              .arg(updatedEvents.size())
+                              .arg(matchedSuites)
+                              .arg(report.suites.size())
+                              .arg(passed)
+                              .arg(failed)
+                              .arg(skipped));
+}
+
+
+void TimelineModule::onCheckAttachments()
+{
+    if (attachmentScanner_->isRunning())
+    {
+        statusLabel_->setText("An attachment check is already running");
+        return;
+    }
+
+    if (!attachmentScanner_->startScan())
+    {
+        return;
+    }
+
+    scanProgressDialog_ = new QProgressDialog("Checking attachments...", "Cancel", 0, 100, this);
+    scanProgressDialog_->setWindowTitle("Check Attachments");
+    scanProgressDialog_->setMinimumDuration(500);
+    connect(scanProgressDialog_, &QProgressDialog::canceled, attachmentScanner_, &AttachmentIntegrityScanner::cancel);
+
+    statusLabel_->setText("Checking attachments...");
+}
+
+
+void TimelineModule::showAttachmentScanReport(const AttachmentScanReport& report)
+{
+    if (scanProgressDialog_)
+    {
+        scanProgressDialog_->deleteLater();
+        scanProgressDialog_ = nullptr;
+    }
+
+    if (report.cancelled)
+    {
+        statusLabel_->setText("Attachment check cancelled");
+        return;
+    }
+
+    const QLocale locale;
+    const int missing = report.issueCount(AttachmentScanIssue::MissingFile);
+    const int changed = report.issueCount(AttachmentScanIssue::ContentChanged);
+    const int orphanFiles = report.issueCount(AttachmentScanIssue::OrphanFile);
+    const int orphanDirectories = report.issueCount(AttachmentScanIssue::OrphanDirectory);
+
+    QString summary = QString("Checked %1 attachment file(s) in %2 ms.\n\n"
+                              "Project store: %3 (of which orphaned: %4)\n"
+                              "Linked files: %5\n\n"
+                              "Missing files: %6\n"
+                              "Changed content: %7\n"
+                              "Orphan files: %8\n"
+                              "Orphan directories: %9")
+                          .arg(report.filesChecked)
+                          .arg(report.elapsedMs)
+                          .arg(locale.formattedDataSize(report.storeBytes))
+                          .arg(locale.formattedDataSize(report.orphanBytes))
+                          .arg(locale.formattedDataSize(report.linkedBytes))
+                          .arg(missing)
+                          .arg(changed)
+                          .arg(orphanFiles)
+                          .arg(orphanDirectories);
+
+    QMessageBox box(report.issues.isEmpty() ? QMessageBox::Information : QMessageBox::Warning,
+                    "Check Attachments", summary, QMessageBox::Ok, this);
+
+    if (!report.issues.isEmpty())
+    {
+        QStringList lines;
+        lines.reserve(report.issues.size());
+        for (const AttachmentScanIssue& issue : report.issues)
         {
-            QMessageBox::warning(this, "Error", "Failed to export to PDF.");
+            QString line = QString("%1: %2").arg(issue.kindString(), issue.path);
+            if (issue.bytes > 0)
+            {
+                line += QString(" (%1)").arg(locale.formattedDataSize(issue.bytes));
+            }
+            lines.append(line);
         }
+        box.setDetailedText(lines.join('\n'));
     }
+
+    statusLabel_->setText(QString("Attachments: %1 in store, %2 linked, %3 issue(s)")
+                              .arg(locale.formattedDataSize(report.storeBytes))
+                              .arg(locale.formattedDataSize(report.linkedBytes))
+                              .arg(report.issues.size()));
+
+    box.exec();
 }
 
 
@@ -1609,6 +3076,19 @@ void TimelineModule::onLegendToggled(bool checked)
 }
 
 
+void TimelineModule::onSwimlaneGroupingSelected(QAction* action)
+{
+    const auto grouping = static_cast<SwimlaneGrouping>(action->data().toInt());
+
+    view_->timelineScene()->setSwimlaneGrouping(grouping);
+    TimelineSettings::instance().setSwimlaneGrouping(static_cast<int>(grouping));
+
+    statusLabel_->setText(grouping == SwimlaneGrouping::None
+                              ? QString("Swimlanes ungrouped")
+                              : QString("Grouped by %1 (click a group header to expand it)").arg(SwimlaneLayout::groupingName(grouping)));
+}
+
+
 void TimelineModule::onSplitterMoved(int pos, int index)
 {
     // When the splitter moves, update the legend position
@@ -1680,6 +3160,7 @@ QString TimelineModule::moduleId() const
 
 void TimelineModule::onActivate()
 {
+    activatedThisSession_ = true;
     qDebug() << "TimelineModule: Activated";
 }
 
@@ -1708,3 +3189,47 @@ bool TimelineModule::save()
 
     return saveToFile(currentFilePath_);
 }
+
+bool TimelineModule::prepareToClose()
+{
+    recoveryCopyPath_.clear();
+
+    if (currentFilePath_.isEmpty() || !hasUnsavedChanges()
+        || currentFilePath_ != fileWatcher_->filePath() || !fileWatcher_->isChangedOnDisk())
+    {
+        return true;    // The save in the destructor goes through
+    }
+
+    // Someone else saved meanwhile: the destructor's save would be refused, so merge and save now
+    if (saveToFile(currentFilePath_))
+    {
+        return true;
+    }
+
+    const QString recoveryPath = writeRecoveryCopy();
+    const QString message = recoveryPath.isEmpty()
+                                ? QString("Your changes could not be merged into %1, and no recovery copy could be written.\n\n"
+                                          "Quit anyway and lose them?").arg(currentFilePath_)
+                                : QString("Your changes could not be merged into %1.\n\n"
+                                          "They were saved to a recovery copy:\n%2\n\nQuit now?").arg(currentFilePath_, recoveryPath);
+
+    return QMessageBox::question(this, "Unsaved Changes", message, QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes;
+}
+
+QString TimelineModule::writeRecoveryCopy()
+{
+    const QFileInfo projectInfo(currentFilePath_);
+    const QString path = projectInfo.dir().filePath(QString("%1.recovered-%2.json")
+                                                        .arg(projectInfo.completeBaseName(),
+                                                             QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+
+    if (!TimelineSerializer::saveToFile(model_, path))
+    {
+        qWarning() << "TimelineModule: Failed to write recovery copy" << path;
+        return QString();
+    }
+
+    qDebug() << "TimelineModule: Unsaved changes written to recovery copy" << path;
+    recoveryCopyPath_ = path;
+    return path;
+}
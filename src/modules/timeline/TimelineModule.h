@@ -4,8 +4,12 @@
 #pragma once
 #include "shared/interfaces/IModule.h"
 #include <QWidget>
+#include <QPointer>
 #include <qundostack.h>
 #include "DateRangeHighlight.h"
+#include "TimelineSettings.h"
+#include "TimelineMerge.h"
+#include <atomic>
 
 
 class TimelineView;
@@ -14,6 +18,25 @@ class TimelineCoordinateMapper;
 class TimelineSidePanel;
 class AutoSaveManager;
 class TimelineScrollAnimator;
+class TimelineBaselineComparator;
+class TestResultImporter;
+struct TestResultReport;
+class AttachmentIntegrityScanner;
+struct AttachmentScanReport;
+class TimelineProjectLoader;
+class TimelineShardStore;
+class TimelineFileWatcher;
+class TimelineSyncSession;
+class TimelineReminderScheduler;
+struct TimelineReminder;
+class QSystemTrayIcon;
+class QMessageBox;
+class QProcess;
+struct TimelineLoadResult;
+struct TimelineViewportHint;
+class QProgressBar;
+class QProgressDialog;
+class QThread;
 class QPushButton;
 class QToolBar;
 class QLabel;
@@ -44,6 +67,7 @@ public:
     void onDeactivate() override;
     bool hasUnsavedChanges() const override;
     bool save() override;
+    bool prepareToClose() override;         ///< @brief Merge changes on disk and save before teardown (offers a recovery copy otherwise)
 
     TimelineModel* model() const { return model_; }
     QUndoStack* undoStack() const { return undoStack_; }
@@ -52,6 +76,7 @@ public slots:
     // File menu
     void saveAs();                                              ///< @brief Public slot to trigger save-as operation (exposed for MainWindow)
     void load();                                                ///< @brief Public slot to trigger load operation (exposed for MainWindow)
+    void loadFile(const QString& filePath);                     ///< @brief Open a given file (e.g. handed over by a second instance)
 
 protected:
     void resizeEvent(QResizeEvent* event) override;
@@ -70,6 +95,17 @@ private slots:
     void onExportScreenshot();                                  ///< @brief Handle Export Screenshot action
     void onExportCSV();                                         ///< @brief Handle Export CSV action
     void onExportPDF();                                         ///< @brief Handle Export PDF action
+    void onExportICS();                                         ///< @brief Handle Export iCalendar action
+    void onExportXLSX();                                        ///< @brief Handle Export Excel action (written on a worker thread)
+    void onImportICS();                                         ///< @brief Import an .ics calendar as one undoable batch insert
+
+    void onLoadBaselineClicked();                               ///< @brief Load a second project file as the comparison baseline
+    void onClearBaselineClicked();                              ///< @brief Leave compare mode and remove baseline overlays
+    void onExportSlipReport();                                  ///< @brief Export baseline slip report to CSV
+    void updateBaselineStatus();                                ///< @brief Show the current baseline diff summary in the status bar
+
+    void onImportTestResults();                                 ///< @brief Pick JUnit/xUnit XML files and parse them in the background
+    void onCheckAttachments();                                  ///< @brief Verify attachment files and measure disk usage in the background
 
     void onScrollToDate();                                      ///< @brief Handle Scroll to Date action
     void onGoToCurrentDay();                                    ///< @brief Handle Go to Current Day action
@@ -89,7 +125,14 @@ private slots:
     void updateEditActionState();                               ///< @brief Update edit button enabled state based on selection
     void onToggleSidePanelClicked();                            ///< @brief Handle side panel toggle button click
     void onLegendToggled(bool checked);
+    void onSwimlaneGroupingSelected(QAction* action);           ///< @brief Apply and persist the swimlane grouping picked in the Group menu
     void onSplitterMoved(int pos, int index);
+    void onProjectFileChangedExternally(const QString& filePath, const QByteArray& data);   ///< @brief Merge someone else's save into the open project
+    void onHostLiveSession();                                   ///< @brief Start a relay on this machine and join it
+    void onJoinLiveSession();                                   ///< @brief Join a relay started by someone else
+    void onLeaveLiveSession();                                  ///< @brief Leave the live session (and stop a relay we host)
+    void onRemindersDue(const QVector<TimelineReminder>& reminders);    ///< @brief Announce arrived reminder and due times (desktop and in-app)
+    void showReminderEvent();                                   ///< @brief Bring the window up on the last announced event
 
 private:
     void setupUi();
@@ -99,6 +142,9 @@ private:
     void setupUndoStack();
     bool saveToFile(const QString& filePath);                           ///< @brief Save timeline to specified file path
     void setCurrentFilePath(const QString& filePath);                   ///< @brief Set current file path and update auto-save state
+    void rememberFileState(const QString& filePath, const QByteArray& contentHash);     ///< @brief The model now matches this file: new merge base, watch for other writers
+    bool mergeFromDisk(const QString& filePath, const QByteArray& data);               ///< @brief Three-way merge the file's current content into the model (false if postponed)
+    QString writeRecoveryCopy();                                        ///< @brief Save the model next to the project file; returns the path (empty on failure)
 
     QToolBar* createToolbar();                                          ///< @brief Create toolbar with all actions
 
@@ -118,6 +164,20 @@ private:
 
     QStringList getAllSelectedEventIds() const;                         ///< @brief Get all currently selected event IDs from both scene and side panel
 
+    void applyTestResults(const TestResultReport& report);              ///< @brief Apply parsed test results to matching test events as one undoable update
+
+    void openQueuedFile();                                              ///< @brief Open a file that arrived while another load was running
+    bool confirmReplaceProject();                                       ///< @brief Offer to save unsaved changes before another project is opened
+    void openProject(const QString& filePath);                          ///< @brief Open a timeline file asynchronously (viewport first)
+    void onProjectParsed(const TimelineLoadResult& result);             ///< @brief Install the parsed project and start streaming its events
+    void onProjectPublished(bool cancelled);                            ///< @brief Finish (or roll back) an asynchronous open
+    void setLoadProgressVisible(bool visible);                          ///< @brief Show or hide the status bar load progress
+    TimelineViewportHint currentViewportHint() const;                   ///< @brief Visible dates and lanes of the view
+    void requestVisibleShards();                                        ///< @brief Load the shards around the view of a sharded project
+    void saveSessionState();                                            ///< @brief Remember project, viewport, selection and tab for the next launch
+    void showAttachmentScanReport(const AttachmentScanReport& report);  ///< @brief Summarize a finished attachment scan
+    void updateLiveSessionState();                                      ///< @brief Live menu button text and enabled actions
+
     TimelineModel* model_;
     TimelineCoordinateMapper* mapper_;
     TimelineView* view_;
@@ -126,6 +186,43 @@ private:
     QPushButton* versionSettingsButton_;
     AutoSaveManager* autoSaveManager_;
     TimelineScrollAnimator* scrollAnimator_;
+    TimelineBaselineComparator* baselineComparator_;    ///< Baseline compare mode (owned via QObject parent)
+    QAction* exportSlipReportAction_;
+    QAction* clearBaselineAction_;
+    TestResultImporter* testResultImporter_;            ///< Background JUnit/xUnit parser (owned via QObject parent)
+    QProgressDialog* importProgressDialog_;             ///< Progress for the running result import (nullable)
+    AttachmentIntegrityScanner* attachmentScanner_;     ///< Background attachment verifier (owned via QObject parent)
+    QProgressDialog* scanProgressDialog_;               ///< Progress for the running attachment scan (nullable)
+    TimelineProjectLoader* projectLoader_;              ///< Asynchronous project open (owned via QObject parent)
+    TimelineShardStore* shardStore_;                    ///< Loaded/dirty shards of a sharded project (owned via QObject parent)
+    QTimer* shardLoadTimer_;                            ///< Debounces shard loads while scrolling
+    TimelineFileWatcher* fileWatcher_;                  ///< Detects saves by other users (owned via QObject parent)
+    TimelineMergeBase mergeBase_;                       ///< Project file as last loaded, saved or merged
+    QByteArray pendingContentHash_;                     ///< Digest of the file being opened, adopted after publishing
+    bool merging_ = false;                              ///< A conflict dialog is open
+    QString recoveryCopyPath_;                          ///< Recovery copy written while closing (empty if none)
+    qint64 publishedLaneGapSecs_ = 0;                   ///< Lane gap the project being published was packed with
+    TimelineSyncSession* syncSession_;                  ///< Live co-editing with other users (owned via QObject parent)
+    QProcess* relayProcess_;                            ///< Relay we host for a live session (nullptr if none)
+    QString liveSessionToken_;                          ///< Token of the session we host (empty if none)
+    QPushButton* liveSessionButton_;
+    QAction* hostSessionAction_;
+    QAction* joinSessionAction_;
+    QAction* leaveSessionAction_;
+    TimelineReminderScheduler* reminderScheduler_;      ///< Fires reminder and due times (owned via QObject parent)
+    QSystemTrayIcon* reminderTrayIcon_;                 ///< Desktop notifications (created on the first reminder)
+    QPointer<QMessageBox> reminderBox_;                 ///< Open in-app reminder list (non-modal)
+    QString lastReminderEventId_;                       ///< Event of the most recent notification
+    QString loadingFilePath_;                           ///< File being opened (empty when idle)
+    QString queuedFilePath_;                            ///< File to open after the running load (empty if none)
+    QVector<TimelineEvent> pendingArchivedEvents_;      ///< Archive of the file being opened, installed after publishing
+    QProgressBar* loadProgressBar_;                     ///< Status bar progress while opening a project
+    QPushButton* cancelLoadButton_;
+    TimelineSessionState sessionState_;                 ///< Session read at startup
+    bool restoringSession_ = false;                     ///< The running load is the session project (apply its viewport/selection)
+    bool activatedThisSession_ = false;                 ///< View has been on screen, so its viewport is worth saving
+    QThread* xlsxExportThread_;                         ///< Running XLSX export (nullptr when idle)
+    std::atomic_bool xlsxExportCancelled_;              ///< Polled by the XLSX export worker
     QLabel* statusLabel_;
     QLabel* unsavedIndicator_;
     QAction* editAction_;
@@ -0,0 +1,324 @@
+// TimelineProjectLoader.cpp
+
+
+#include "TimelineProjectLoader.h"
+#include "TimelineFileWatcher.h"
+#include <QThread>
+#include <QTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QUuid>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+
+
+TimelineProjectLoader::TimelineProjectLoader(TimelineModel* model, QObject* parent)
+    : QObject(parent)
+    , model_(model)
+    , cancelRequested_(false)
+    , publishTimer_(new QTimer(this))
+{
+    qRegisterMetaType<TimelineLoadResult>();
+
+    // Interval 0: one batch per event loop pass, so input and painting interleave with publishing
+    publishTimer_->setInterval(0);
+    connect(publishTimer_, &QTimer::timeout, this, &TimelineProjectLoader::publishNextBatch);
+}
+
+
+TimelineProjectLoader::~TimelineProjectLoader()
+{
+    cancel();
+
+    if (worker_)
+    {
+        worker_->wait();
+    }
+}
+
+
+bool TimelineProjectLoader::startLoad(const QString& filePath, qint64 laneGapSecs)
+{
+    if (isRunning())
+    {
+        qWarning() << "TimelineProjectLoader: Load already in progress";
+        return false;
+    }
+
+    cancelRequested_ = false;
+
+    QThread* thread = QThread::create([this, filePath, laneGapSecs]()
+    {
+        auto reportProgress = [this](int percent)
+        {
+            QMetaObject::invokeMethod(this, [this, percent]() { emit parseProgress(percent); }, Qt::QueuedConnection);
+        };
+
+        TimelineLoadResult result = parseFile(filePath, &cancelRequested_, reportProgress, laneGapSecs);
+
+        // Hand the parsed project back to the GUI thread
+        QMetaObject::invokeMethod(this, [this, result]()
+        {
+            worker_ = nullptr;
+            emit parseFinished(result);
+        }, Qt::QueuedConnection);
+    });
+
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+
+    worker_ = thread;
+    worker_->start();
+
+    return true;
+}
+
+
+void TimelineProjectLoader::publish(const TimelineLoadResult& result, const TimelineViewportHint& viewport)
+{
+    publishTimer_->stop();
+    cancelRequested_ = false;
+
+    pending_ = result.project.events;
+    published_ = 0;
+
+    // Everything on screen goes in at once so the visible area is complete and interactive
+    const int visibleCount = prioritize(pending_, viewport);
+    if (visibleCount > 0)
+    {
+        model_->addLaidOutEvents(pending_.mid(0, visibleCount));
+        published_ = visibleCount;
+    }
+
+    emit publishProgress(published_, pending_.size());
+
+    // The remainder (and the finished notification) follow from the event loop
+    publishTimer_->start();
+}
+
+
+void TimelineProjectLoader::cancel()
+{
+    cancelRequested_ = true;
+}
+
+
+bool TimelineProjectLoader::isRunning() const
+{
+    return worker_ != nullptr || publishTimer_->isActive();
+}
+
+
+void TimelineProjectLoader::publishNextBatch()
+{
+    const bool cancelled = cancelRequested_;
+
+    if (!cancelled)
+    {
+        const int count = std::min<int>(PUBLISH_BATCH_SIZE, pending_.size() - published_);
+        if (count > 0)
+        {
+            model_->addLaidOutEvents(pending_.mid(published_, count));
+            published_ += count;
+            emit publishProgress(published_, pending_.size());
+        }
+    }
+
+    if (cancelled || published_ >= pending_.size())
+    {
+        publishTimer_->stop();
+        pending_.clear();
+        pending_.squeeze();
+        published_ = 0;
+
+        emit publishFinished(cancelled);
+    }
+}
+
+
+TimelineLoadResult TimelineProjectLoader::parseFile(const QString& filePath,
+                                                    const std::atomic_bool* cancelFlag,
+                                                    const std::function<void(int)>& progress,
+                                                    qint64 laneGapSecs)
+{
+    TimelineLoadResult result;
+    result.filePath = filePath;
+    result.laneGapSecs = laneGapSecs;
+
+    auto isCancelled = [cancelFlag]() { return cancelFlag && *cancelFlag; };
+    auto reportProgress = [&progress](int percent)
+    {
+        if (progress)
+        {
+            progress(percent);
+        }
+    };
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        result.errorString = QString("Failed to open file for reading: %1").arg(file.errorString());
+        return result;
+    }
+
+    const QByteArray data = file.readAll();
+    file.close();
+    result.contentHash = TimelineFileWatcher::hashContent(data);
+    reportProgress(10);
+
+    if (isCancelled())
+    {
+        result.cancelled = true;
+        return result;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    if (doc.isNull() || !doc.isObject())
+    {
+        result.errorString = QString("Invalid JSON format: %1").arg(parseError.errorString());
+        return result;
+    }
+    reportProgress(40);
+
+    // Event parsing maps to 40-85%
+    auto parseProgress = [&reportProgress](int percent)
+    {
+        reportProgress(40 + percent * 45 / 100);
+    };
+
+    bool completed = false;
+    const QJsonObject json = doc.object();
+
+    if (TimelineSerializer::isShardManifest(json))
+    {
+        // Only the shards the scene can show on open; TimelineShardStore loads the rest on demand
+        const QDate versionStart = QDate::fromString(json["versionStart"].toString(), Qt::ISODate);
+        const QDate versionEnd = QDate::fromString(json["versionEnd"].toString(), Qt::ISODate);
+        const QDate loadFrom = versionStart.isValid() ? versionStart.addMonths(-SHARD_WINDOW_PADDING_MONTHS) : QDate();
+        const QDate loadTo = versionEnd.isValid() ? versionEnd.addMonths(SHARD_WINDOW_PADDING_MONTHS) : QDate();
+
+        QString shardError;
+        completed = TimelineSerializer::readShardedProject(filePath, json, result.project, loadFrom, loadTo,
+                                                           &shardError, cancelFlag, parseProgress);
+        if (!completed && !isCancelled())
+        {
+            result.errorString = shardError;
+            return result;
+        }
+    }
+    else
+    {
+        completed = TimelineSerializer::readProject(json, result.project, cancelFlag, parseProgress);
+    }
+
+    if (!completed || isCancelled())
+    {
+        result.cancelled = true;
+        return result;
+    }
+
+    // Same normalization TimelineModel::addEvents() applies, done here so publishing is a plain append
+    QVector<TimelineEvent>& events = result.project.events;
+    QSet<QString> ids;
+    ids.reserve(events.size());
+
+    QVector<TimelineEvent> uniqueEvents;
+    uniqueEvents.reserve(events.size());
+
+    for (TimelineEvent& event : events)
+    {
+        if (event.id.isEmpty())
+        {
+            event.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+        }
+
+        if (ids.contains(event.id))
+        {
+            qWarning() << "Event with ID" << event.id << "already exists";
+            continue;
+        }
+        ids.insert(event.id);
+
+        if (!event.color.isValid())
+        {
+            event.color = TimelineModel::colorForType(event.type);
+        }
+
+        uniqueEvents.append(std::move(event));
+    }
+    events = std::move(uniqueEvents);
+    reportProgress(90);
+
+    // Final lanes for the complete set, so published events never move as later batches arrive
+    TimelineModel::assignLanes(events, laneGapSecs);
+    reportProgress(100);
+
+    return result;
+}
+
+
+int TimelineProjectLoader::prioritize(QVector<TimelineEvent>& events, const TimelineViewportHint& viewport)
+{
+    if (!viewport.startDate.isValid() || !viewport.endDate.isValid() || events.isEmpty())
+    {
+        return 0;
+    }
+
+    struct PublishKey
+    {
+        int tier;           // 0 = inside the viewport, 1 = visible dates only, 2 = off screen
+        qint64 distance;    // Days between the event and the visible date range
+        int index;          // Original position (keeps file order stable)
+    };
+
+    const qint64 viewStart = viewport.startDate.toJulianDay();
+    const qint64 viewEnd = viewport.endDate.toJulianDay();
+
+    QVector<PublishKey> keys;
+    keys.reserve(events.size());
+
+    for (int i = 0; i < events.size(); ++i)
+    {
+        const TimelineEvent& event = events[i];
+        const qint64 start = event.startDate.date().toJulianDay();
+        const qint64 end = event.endDate.date().toJulianDay();
+
+        const bool inDates = start <= viewEnd && end >= viewStart;
+        const bool inLanes = viewport.lastLane < 0
+                             || (event.lane >= viewport.firstLane && event.lane <= viewport.lastLane);
+
+        PublishKey key;
+        key.tier = inDates ? (inLanes ? 0 : 1) : 2;
+        key.distance = inDates ? 0 : (end < viewStart ? viewStart - end : start - viewEnd);
+        key.index = i;
+        keys.append(key);
+    }
+
+    std::sort(keys.begin(), keys.end(), [](const PublishKey& a, const PublishKey& b)
+    {
+        if (a.tier != b.tier)
+        {
+            return a.tier < b.tier;
+        }
+        if (a.distance != b.distance)
+        {
+            return a.distance < b.distance;
+        }
+        return a.index < b.index;
+    });
+
+    QVector<TimelineEvent> ordered;
+    ordered.reserve(events.size());
+
+    int visibleCount = 0;
+    for (const PublishKey& key : keys)
+    {
+        ordered.append(std::move(events[key.index]));
+        visibleCount += key.tier == 0 ? 1 : 0;
+    }
+
+    events = std::move(ordered);
+    return visibleCount;
+}
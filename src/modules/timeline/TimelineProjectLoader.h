@@ -0,0 +1,129 @@
+// TimelineProjectLoader.h
+
+
+#pragma once
+#include "TimelineSerializer.h"
+#include <QObject>
+#include <QDate>
+#include <QMetaType>
+#include <atomic>
+#include <functional>
+
+
+class QThread;
+class QTimer;
+
+
+/**
+ * @struct TimelineLoadResult
+ * @brief A timeline file parsed and laid out on the worker thread, ready to publish
+ */
+struct TimelineLoadResult
+{
+    QString filePath;                   ///< File that was read
+    TimelineProjectData project;        ///< Events have unique IDs, colors and final lanes
+    QByteArray contentHash;             ///< Digest of the file as read (see TimelineFileWatcher)
+    QString errorString;                ///< Read/parse error, empty on success
+    bool cancelled = false;             ///< True if the load was cancelled before publishing
+    qint64 laneGapSecs = 0;             ///< Lane gap the events were packed with
+
+    bool isValid() const { return errorString.isEmpty() && !cancelled; }
+};
+
+Q_DECLARE_METATYPE(TimelineLoadResult)
+
+
+/**
+ * @struct TimelineViewportHint
+ * @brief Visible part of the timeline, used to decide which events are published first
+ */
+struct TimelineViewportHint
+{
+    QDate startDate;                    ///< First visible day
+    QDate endDate;                      ///< Last visible day
+    int firstLane = 0;                  ///< Topmost visible lane
+    int lastLane = -1;                  ///< Bottommost visible lane (-1 = no vertical limit)
+};
+
+
+/**
+ * @class TimelineProjectLoader
+ * @brief Opens a timeline file without blocking the GUI
+ *
+ * Loading runs in two phases:
+ * 1. startLoad() reads and parses the file on a worker thread and assigns lanes for the
+ *    complete event set, so nothing moves once it is on screen (parseFinished)
+ * 2. publish() streams the events into the model: everything inside the viewport in the
+ *    first batch, the rest in batches of PUBLISH_BATCH_SIZE ordered by distance from the
+ *    viewport, one batch per event loop pass (publishProgress / publishFinished)
+ *
+ * For a sharded project only the shards around the version dates are read here; the
+ * rest is left to TimelineShardStore.
+ *
+ * cancel() stops either phase. Cancelling while parsing leaves the model untouched;
+ * cancelling while publishing leaves the events published so far in the model.
+ */
+class TimelineProjectLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimelineProjectLoader(TimelineModel* model, QObject* parent = nullptr);
+    ~TimelineProjectLoader() override;
+
+    /**
+     * @brief Start parsing on a worker thread
+     * @param filePath Timeline file
+     * @param laneGapSecs Lane gap the model will have once the project is shown (the gap at
+     *        the zoom it opens with, see TimelineScene::laneGapSecondsAt())
+     * @return False if a load is already running
+     */
+    bool startLoad(const QString& filePath, qint64 laneGapSecs);
+    void publish(const TimelineLoadResult& result,
+                 const TimelineViewportHint& viewport);     ///< @brief Stream parsed events into the model, viewport first
+    void cancel();                                          ///< @brief Cancel parsing or publishing
+    bool isRunning() const;                                 ///< @brief Whether a load is parsing or publishing
+
+    /**
+     * @brief Read, parse and lay out a timeline file synchronously (called from the worker thread)
+     * @param filePath Timeline file
+     * @param cancelFlag Optional flag polled while parsing
+     * @param progress Optional callback receiving 0-100
+     * @param laneGapSecs Minimum space between events sharing a lane (TimelineModel::laneGapSeconds())
+     */
+    static TimelineLoadResult parseFile(const QString& filePath,
+                                        const std::atomic_bool* cancelFlag = nullptr,
+                                        const std::function<void(int)>& progress = {},
+                                        qint64 laneGapSecs = 0);
+
+    /**
+     * @brief Order events for publishing
+     * @param events Events to reorder in place
+     * @param viewport Visible area
+     * @return Number of leading events that lie inside the viewport
+     *
+     * Events inside the viewport come first, then events in the visible date range but
+     * outside the visible lanes, then the rest by distance in days from the viewport.
+     */
+    static int prioritize(QVector<TimelineEvent>& events, const TimelineViewportHint& viewport);
+
+    static constexpr int PUBLISH_BATCH_SIZE = 500;          ///< Events added to the model per event loop pass
+    static constexpr int SHARD_WINDOW_PADDING_MONTHS = 1;   ///< Sharded projects: months loaded around the version dates on open (the scene padding)
+
+signals:
+    void parseProgress(int percent);                        ///< @brief Parse progress (0-100), delivered on the GUI thread
+    void parseFinished(const TimelineLoadResult& result);   ///< @brief Parsing finished (check result.isValid())
+    void publishProgress(int published, int total);         ///< @brief Events in the model so far
+    void publishFinished(bool cancelled);                   ///< @brief All events published (or publishing was cancelled)
+
+private slots:
+    void publishNextBatch();
+
+private:
+    TimelineModel* model_;
+    QThread* worker_ = nullptr;             ///< Running parse thread (nullptr when idle)
+    std::atomic_bool cancelRequested_;      ///< Polled by the parser
+    QTimer* publishTimer_;                  ///< Drives batch publishing
+    QVector<TimelineEvent> pending_;        ///< Prioritized events not yet published
+    int published_ = 0;                     ///< Index of the next event in pending_
+};
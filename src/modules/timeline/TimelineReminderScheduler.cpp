@@ -0,0 +1,369 @@
+// TimelineReminderScheduler.cpp
+
+
+#include "TimelineReminderScheduler.h"
+#include "TimelineModel.h"
+#include <QTimer>
+#include <QSet>
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+
+TimelineReminderScheduler::TimelineReminderScheduler(TimelineModel* model, QObject* parent)
+    : QObject(parent)
+    , model_(model)
+    , timer_(new QTimer(this))
+    , current_(QDateTime::currentSecsSinceEpoch())
+{
+    timer_->setSingleShot(true);
+    timer_->setTimerType(Qt::PreciseTimer);     // Coarse timers may be minutes late on hour-long sleeps
+    connect(timer_, &QTimer::timeout, this, &TimelineReminderScheduler::onTimeout);
+
+    connectModel();
+
+    const QVector<TimelineEvent> events = model_->getAllEvents();
+    for (const TimelineEvent& event : events)
+    {
+        refreshEvent(event.id, &event);
+    }
+    rearm();
+}
+
+
+void TimelineReminderScheduler::connectModel()
+{
+    auto changed = [this](const QString& eventId) { refresh({ eventId }); };
+    auto changedMany = [this](const QStringList& eventIds) { refresh(eventIds); };
+    auto gone = [this](const QString& eventId) { unschedule({ eventId }); };
+    auto goneMany = [this](const QStringList& eventIds) { unschedule(eventIds); };
+
+    connect(model_, &TimelineModel::eventAdded, this, changed);
+    connect(model_, &TimelineModel::eventsAdded, this, changedMany);
+    connect(model_, &TimelineModel::eventUpdated, this, changed);
+    connect(model_, &TimelineModel::eventsUpdated, this, changedMany);
+    connect(model_, &TimelineModel::eventRestored, this, changed);
+    connect(model_, &TimelineModel::eventsRestored, this, changedMany);
+
+    // Archived events stay quiet until restored
+    connect(model_, &TimelineModel::eventRemoved, this, gone);
+    connect(model_, &TimelineModel::eventsRemoved, this, goneMany);
+    connect(model_, &TimelineModel::eventArchived, this, gone);
+    connect(model_, &TimelineModel::eventsArchived, this, goneMany);
+
+    connect(model_, &TimelineModel::eventsCleared, this, &TimelineReminderScheduler::clearAll);
+}
+
+
+// ============================================================================
+// Following the model
+// ============================================================================
+
+void TimelineReminderScheduler::refresh(const QStringList& eventIds)
+{
+    if (eventIds.size() > INDEX_THRESHOLD)
+    {
+        // One pass over the model instead of a search per event
+        QSet<QString> remaining(eventIds.cbegin(), eventIds.cend());
+
+        const QVector<TimelineEvent> events = model_->getAllEvents();
+        for (const TimelineEvent& event : events)
+        {
+            if (remaining.remove(event.id))
+            {
+                refreshEvent(event.id, &event);
+            }
+        }
+        for (const QString& eventId : std::as_const(remaining))
+        {
+            refreshEvent(eventId, nullptr);
+        }
+    }
+    else
+    {
+        for (const QString& eventId : eventIds)
+        {
+            refreshEvent(eventId, model_->getEvent(eventId));
+        }
+    }
+
+    compact();
+    rearm();
+}
+
+
+void TimelineReminderScheduler::refreshEvent(const QString& eventId, const TimelineEvent* event)
+{
+    if (!event || event->archived)
+    {
+        unschedule({ eventId });
+        return;
+    }
+
+    schedule(eventId, TimelineReminder::Reminder, event->reminderDateTime);
+
+    // A finished action has nothing left to be due
+    schedule(eventId, TimelineReminder::Due, event->status == "Completed" ? QDateTime() : event->dueDateTime);
+}
+
+
+void TimelineReminderScheduler::unschedule(const QStringList& eventIds)
+{
+    for (const QString& eventId : eventIds)
+    {
+        auto it = schedules_.find(eventId);
+        if (it == schedules_.end())
+        {
+            continue;
+        }
+
+        for (quint64 token : it->token)
+        {
+            if (token != 0)
+            {
+                --liveCount_;
+                ++staleCount_;
+            }
+        }
+        schedules_.erase(it);
+    }
+
+    compact();
+}
+
+
+void TimelineReminderScheduler::clearAll()
+{
+    timer_->stop();
+
+    for (auto& level : wheel_)
+    {
+        for (QVector<Entry>& slot : level)
+        {
+            slot.clear();
+        }
+    }
+    occupied_.fill(0);
+    current_ = std::max(current_, QDateTime::currentSecsSinceEpoch());
+
+    schedules_.clear();
+    liveCount_ = 0;
+    staleCount_ = 0;
+}
+
+
+void TimelineReminderScheduler::schedule(const QString& eventId, TimelineReminder::Kind kind, const QDateTime& when)
+{
+    const qint64 due = when.isValid() ? when.toSecsSinceEpoch() : 0;
+
+    auto it = schedules_.find(eventId);
+    if (it == schedules_.end())
+    {
+        if (due == 0)
+        {
+            return;
+        }
+        it = schedules_.insert(eventId, Schedule());
+    }
+
+    // Unchanged: either still pending or already announced
+    Schedule& scheduled = *it;
+    if (scheduled.due[kind] == due)
+    {
+        return;
+    }
+
+    // The old entry stays in the wheel and is skipped when reached
+    if (scheduled.token[kind] != 0)
+    {
+        scheduled.token[kind] = 0;
+        --liveCount_;
+        ++staleCount_;
+    }
+    scheduled.due[kind] = due;
+
+    if (scheduled.due[TimelineReminder::Reminder] == 0 && scheduled.due[TimelineReminder::Due] == 0)
+    {
+        schedules_.erase(it);
+        return;
+    }
+
+    // An empty wheel can jump to the present, so new entries start on low levels
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    if (std::all_of(occupied_.cbegin(), occupied_.cend(), [](quint64 mask) { return mask == 0; }))
+    {
+        current_ = std::max(current_, now);
+    }
+
+    // Times already past are not announced; times beyond the top level never arrive
+    if (due <= std::max(now, current_) || due >= (qint64(1) << (LEVELS * SLOT_BITS)))
+    {
+        return;
+    }
+
+    scheduled.token[kind] = nextToken_++;
+    ++liveCount_;
+
+    QVector<Entry> dueNow;
+    insert(Entry{ eventId, due, scheduled.token[kind], kind }, dueNow);
+}
+
+
+// ============================================================================
+// Timer wheel
+// ============================================================================
+
+void TimelineReminderScheduler::insert(Entry&& entry, QVector<Entry>& dueNow)
+{
+    if (entry.due <= current_)
+    {
+        dueNow.append(std::move(entry));
+        return;
+    }
+
+    // The level is the highest 6-bit digit in which the time differs from the wheel time,
+    // so every entry on level k lies in the current level-(k+1) slot, after the wheel time
+    const quint64 difference = static_cast<quint64>(entry.due ^ current_);
+    const int level = (static_cast<int>(std::bit_width(difference)) - 1) / SLOT_BITS;
+    const int slot = static_cast<int>((entry.due >> (level * SLOT_BITS)) & (SLOTS - 1));
+
+    wheel_[level][slot].append(std::move(entry));
+    occupied_[level] |= quint64(1) << slot;
+}
+
+
+bool TimelineReminderScheduler::isLive(const Entry& entry) const
+{
+    auto it = schedules_.constFind(entry.eventId);
+    return it != schedules_.constEnd() && it->token[entry.kind] == entry.token;
+}
+
+
+qint64 TimelineReminderScheduler::nextExpiry() const
+{
+    // Any entry on a lower level is earlier than every entry on a higher one
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        if (occupied_[level] != 0)
+        {
+            const int shift = level * SLOT_BITS;
+            const int slot = std::countr_zero(occupied_[level]);
+            const qint64 base = (current_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            return base | (qint64(slot) << shift);
+        }
+    }
+    return -1;
+}
+
+
+void TimelineReminderScheduler::advance(qint64 now, QVector<Entry>& fired)
+{
+    for (qint64 slotTime = nextExpiry(); slotTime >= 0 && slotTime <= now; slotTime = nextExpiry())
+    {
+        const int level = static_cast<int>(std::find_if(occupied_.cbegin(), occupied_.cend(),
+                                                        [](quint64 mask) { return mask != 0; }) - occupied_.cbegin());
+        const int slot = std::countr_zero(occupied_[level]);
+
+        current_ = slotTime;
+        QVector<Entry> entries = std::exchange(wheel_[level][slot], QVector<Entry>());
+        occupied_[level] &= ~(quint64(1) << slot);
+
+        // Level 0 slots are single seconds; higher slots cascade into the levels below
+        for (Entry& entry : entries)
+        {
+            if (!isLive(entry))
+            {
+                --staleCount_;
+            }
+            else if (level == 0)
+            {
+                fired.append(std::move(entry));
+            }
+            else
+            {
+                insert(std::move(entry), fired);
+            }
+        }
+    }
+
+    // Every remaining slot starts after now, so the wheel can move up to it
+    current_ = std::max(current_, now);
+}
+
+
+void TimelineReminderScheduler::compact()
+{
+    if (staleCount_ <= liveCount_ + COMPACT_SLACK)
+    {
+        return;
+    }
+
+    QVector<Entry> live;
+    live.reserve(liveCount_);
+
+    for (auto& level : wheel_)
+    {
+        for (QVector<Entry>& slot : level)
+        {
+            for (Entry& entry : slot)
+            {
+                if (isLive(entry))
+                {
+                    live.append(std::move(entry));
+                }
+            }
+            slot.clear();
+        }
+    }
+    occupied_.fill(0);
+    staleCount_ = 0;
+
+    QVector<Entry> dueNow;
+    for (Entry& entry : live)
+    {
+        insert(std::move(entry), dueNow);
+    }
+}
+
+
+void TimelineReminderScheduler::rearm()
+{
+    const qint64 slotTime = nextExpiry();
+    if (slotTime < 0)
+    {
+        timer_->stop();
+        return;
+    }
+
+    const qint64 delayMs = slotTime * 1000 - QDateTime::currentMSecsSinceEpoch();
+    timer_->start(static_cast<int>(std::clamp<qint64>(delayMs, 0, MAX_SLEEP_MS)));
+}
+
+
+void TimelineReminderScheduler::onTimeout()
+{
+    QVector<Entry> fired;
+    advance(QDateTime::currentSecsSinceEpoch(), fired);
+
+    if (!fired.isEmpty())
+    {
+        // Cascades can hand over entries of several seconds at once (after a sleep)
+        std::stable_sort(fired.begin(), fired.end(), [](const Entry& a, const Entry& b) { return a.due < b.due; });
+
+        QVector<TimelineReminder> reminders;
+        reminders.reserve(fired.size());
+
+        for (const Entry& entry : std::as_const(fired))
+        {
+            schedules_[entry.eventId].token[entry.kind] = 0;   // Announced; due time kept so it is not announced again
+            --liveCount_;
+
+            reminders.append({ entry.eventId, entry.kind, QDateTime::fromSecsSinceEpoch(entry.due) });
+        }
+
+        emit remindersDue(reminders);
+    }
+
+    compact();
+    rearm();
+}
@@ -0,0 +1,113 @@
+// TimelineReminderScheduler.h
+
+
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QDateTime>
+#include <array>
+
+
+class TimelineModel;
+struct TimelineEvent;
+class QTimer;
+
+
+/**
+ * @struct TimelineReminder
+ * @brief One reminder or due time that has arrived
+ */
+struct TimelineReminder
+{
+    enum Kind { Reminder = 0, Due = 1 };
+
+    QString eventId;
+    Kind kind = Reminder;
+    QDateTime when;             ///< The reminder or due time (earlier than now if the machine was asleep)
+};
+
+
+/**
+ * @class TimelineReminderScheduler
+ * @brief Fires the reminder and due times of the model's events as they arrive
+ *
+ * Every reminderDateTime and every dueDateTime of an unfinished action is kept in a
+ * hierarchical timer wheel: LEVELS levels of 64 slots at one-second resolution, each
+ * level 64 times coarser than the one below. Scheduling is a bit scan and an append;
+ * an entry moves down at most once per level before it fires, so the cost per
+ * reminder is O(1) amortized however many are scheduled. A 64-bit occupancy mask per
+ * level finds the next non-empty slot directly, and a single timer sleeps until it,
+ * so nothing is polled.
+ *
+ * Rescheduling does not search the wheel: each event keeps a token per kind and an
+ * entry whose token is no longer current is dropped when it is reached. The wheel
+ * is rebuilt once such stale entries outnumber the live ones.
+ *
+ * Follows the model incrementally. Times already past when an event is loaded or
+ * edited are not announced.
+ */
+class TimelineReminderScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimelineReminderScheduler(TimelineModel* model, QObject* parent = nullptr);
+
+    int scheduledCount() const { return liveCount_; }  ///< Reminder and due times still to come
+
+signals:
+    void remindersDue(const QVector<TimelineReminder>& reminders);     ///< One batch per wake-up, in time order
+
+private slots:
+    void onTimeout();
+
+private:
+    struct Entry
+    {
+        QString eventId;
+        qint64 due = 0;             ///< Seconds since epoch
+        quint64 token = 0;
+        TimelineReminder::Kind kind = TimelineReminder::Reminder;
+    };
+
+    struct Schedule
+    {
+        std::array<qint64, 2> due = { 0, 0 };       ///< Last time seen per kind (0 = none)
+        std::array<quint64, 2> token = { 0, 0 };    ///< Token of the live entry per kind (0 = none pending)
+    };
+
+    void connectModel();
+    void refresh(const QStringList& eventIds);
+    void refreshEvent(const QString& eventId, const TimelineEvent* event);
+    void unschedule(const QStringList& eventIds);
+    void clearAll();
+
+    void schedule(const QString& eventId, TimelineReminder::Kind kind, const QDateTime& when);
+    void insert(Entry&& entry, QVector<Entry>& dueNow);
+    bool isLive(const Entry& entry) const;
+    void advance(qint64 now, QVector<Entry>& fired);
+    qint64 nextExpiry() const;                      ///< Start of the earliest non-empty slot (-1 if none)
+    void compact();
+    void rearm();
+
+    TimelineModel* model_;
+    QTimer* timer_;
+
+    static constexpr int LEVELS = 6;                ///< 64^6 seconds (over 2000 years) ahead
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+
+    std::array<std::array<QVector<Entry>, SLOTS>, LEVELS> wheel_;
+    std::array<quint64, LEVELS> occupied_ = {};     ///< Bit i of level k set = slot i has entries
+    qint64 current_ = 0;                            ///< Wheel time (seconds); every entry is later
+
+    QHash<QString, Schedule> schedules_;
+    quint64 nextToken_ = 1;
+    int liveCount_ = 0;
+    int staleCount_ = 0;                            ///< Superseded entries still in the wheel
+
+    static constexpr int INDEX_THRESHOLD = 16;      ///< Above this many changed events, scan the model once instead of searching per event
+    static constexpr int COMPACT_SLACK = 1024;      ///< Stale entries tolerated on top of the live count
+    static constexpr qint64 MAX_SLEEP_MS = 3600000; ///< Re-check the wall clock at least hourly (clock changes)
+};
@@ -10,23 +10,36 @@
 #include "TimelineDateScale.h"
 #include "CurrentDateMarker.h"
 #include "VersionBoundaryMarker.h"
+#include "TimelineBaselineComparator.h"
+#include "BaselineGhostItem.h"
+#include "SwimlaneGroupItem.h"
+#include "TimelineSettings.h"
 #include <QGraphicsSceneMouseEvent>
 #include <QPen>
 #include <QKeyEvent>
 #include <QMessageBox>
 #include <QTimer>
+#include <QSet>
 #include <qpainter.h>
 #include <qgraphicsview.h>
+#include <algorithm>
+#include <cmath>
 
 
 // Helper: Treat midnight-to-midnight events as "all-day style" for display purposes
+static bool isAllDayStyleRange(const QDateTime& start, const QDateTime& end)
+{
+    return start.isValid()
+    && end.isValid()
+        && start.time() == QTime(0, 0)
+        && end.time() == QTime(0, 0)
+        && end.date() >= start.date();
+}
+
+
 static bool isAllDayStyleEvent(const TimelineEvent& e)
 {
-    return e.startDate.isValid()
-    && e.endDate.isValid()
-        && e.startDate.time() == QTime(0, 0)
-        && e.endDate.time() == QTime(0, 0)
-        && e.endDate.date() >= e.startDate.date();
+    return isAllDayStyleRange(e.startDate, e.endDate);
 }
 
 
@@ -43,13 +56,21 @@ TimelineScene::TimelineScene(TimelineModel* model, TimelineCoordinateMapper* map
     // Connect to model signals
     connect(model_, &TimelineModel::eventAdded, this, &TimelineScene::onEventAdded);
     connect(model_, &TimelineModel::eventRemoved, this, &TimelineScene::onEventRemoved);
+    connect(model_, &TimelineModel::eventsAdded, this, &TimelineScene::onEventsAdded);
+    connect(model_, &TimelineModel::eventsRemoved, this, &TimelineScene::onEventsRemoved);
     connect(model_, &TimelineModel::eventUpdated, this, &TimelineScene::onEventUpdated);
+    connect(model_, &TimelineModel::eventsUpdated, this, &TimelineScene::onEventsUpdated);
     connect(model_, &TimelineModel::versionDatesChanged, this, &TimelineScene::onVersionDatesChanged);
     connect(model_, &TimelineModel::versionNameChanged, this, &TimelineScene::onVersionNameChanged);
     connect(model_, &TimelineModel::lanesRecalculated, this, &TimelineScene::onLanesRecalculated);
     connect(model_, &TimelineModel::eventArchived, this, &TimelineScene::onEventRemoved);
     connect(model_, &TimelineModel::eventRestored, this, &TimelineScene::onEventAdded);
+    connect(model_, &TimelineModel::eventsArchived, this, &TimelineScene::onEventsRemoved);
+    connect(model_, &TimelineModel::eventsRestored, this, &TimelineScene::onEventsAdded);
     connect(model_, &TimelineModel::eventAttachmentsChanged, this, &TimelineScene::onEventAttachmentsChanged);
+    connect(model_, &TimelineModel::eventAttachmentsReset, this, &TimelineScene::onEventAttachmentsReset);
+    connect(model_, &TimelineModel::generationChanged, this, &TimelineScene::onModelGenerationChanged);
+    connect(model_, &TimelineModel::eventsCleared, this, [this]() { swimlanesStale_ = true; });
 
     setupDateScale();
     setupVersionBoundaryMarkers();
@@ -220,61 +241,33 @@ void TimelineScene::rebuildFromModel()
     }
     eventIdToItem_.clear();
 
-    // Create items for all events in the model
-    const auto& events = model_->getAllEvents();
+    // Lane packing keeps a minimum on-screen gap, so lanes follow the zoom
+    syncLaneGap();
 
-    for (const auto& event : events)
+    if (swimlaneLayout_.isActive())
     {
-        createItemForEvent(event.id);
+        // Items only for expanded groups
+        relayoutSwimlanes();
     }
-
-    // Calculate scene rect with +1 month padding before/after version dates
-    QDate paddedStart = model_->versionStartDate().addMonths(-1);
-    QDate paddedEnd = model_->versionEndDate().addMonths(1);
-
-    double startX = mapper_->dateToX(paddedStart);
-    double endX = mapper_->dateToX(paddedEnd);
-    double width = endX - startX;
-
-    double height = DATE_SCALE_OFFSET + LaneAssigner::calculateSceneHeight(model_->maxLane(), ITEM_HEIGHT, LANE_SPACING);
-
-    // Extend scene rect upward to include header area (version name + legend)
-    // Version name is at Y = -150, so we need to start the scene rect above that
-    const double HEADER_TOP = -180.0;               // Provides space for version name and legend
-    double totalHeight = height - HEADER_TOP;       // Total height from header top to scene bottom
-
-    // Set scene rect with padding
-    setSceneRect(startX, HEADER_TOP, width, totalHeight);
-
-    // Update date scale and current date marker heights
-    if (dateScale_)
-    {
-        dateScale_->setPaddedDateRange(paddedStart, paddedEnd);
-        dateScale_->setTimelineHeight(height);
-        dateScale_->updateScale();
-    }
-
-    if (currentDateMarker_)
+    else
     {
-        currentDateMarker_->setTimelineHeight(height);
-        currentDateMarker_->updatePosition();
-    }
+        // Create items for all events in the model
+        const auto& events = model_->getAllEvents();
 
-    // Update version boundary markers
-    if (versionStartMarker_)
-    {
-        versionStartMarker_->setTimelineHeight(height);
-        versionStartMarker_->updatePosition();
+        for (const auto& event : events)
+        {
+            createItemForEvent(event.id);
+        }
     }
 
-    if (versionEndMarker_)
-    {
-        versionEndMarker_->setTimelineHeight(height);
-        versionEndMarker_->updatePosition();
-    }
+    // Scene rect, date scale and markers follow the new zoom
+    updateSceneRect();
 
     // Update version name label text and position
     updateVersionNameLabel();
+
+    // Ghost geometry depends on zoom and lanes
+    refreshGhostItems();
 }
 
 
@@ -286,20 +279,47 @@ TimelineItem* TimelineScene::findItemByEventId(const QString& eventId) const
 
 void TimelineScene::mousePressEvent(QGraphicsSceneMouseEvent* event)
 {
-    // Just call base implementation - items will emit their own clicked signals
+    // Swimlane headers toggle their group
+    if (event->button() == Qt::LeftButton)
+    {
+        for (SwimlaneGroupItem* group : groupItems_)
+        {
+            if (group->headerContains(event->scenePos()))
+            {
+                const QString key = group->key();
+                setSwimlaneGroupExpanded(key, !swimlaneLayout_.isExpanded(key));
+                event->accept();
+                return;
+            }
+        }
+    }
+
+    // Otherwise call base implementation - items will emit their own clicked signals
     QGraphicsScene::mousePressEvent(event);
 }
 
 
 void TimelineScene::onEventAdded(const QString& eventId)
 {
+    if (swimlaneLayout_.isActive())
+    {
+        pendingSwimlaneIds_.insert(eventId);
+        return;     // Grouped layout follows generationChanged
+    }
+
     createItemForEvent(eventId);
-    updateSceneHeight();            // Adjust scene height for new lane
+    updateSceneRect();            // Adjust scene height for new lane
 }
 
 
 void TimelineScene::onEventRemoved(const QString& eventId)
 {
+    if (swimlaneLayout_.isActive())
+    {
+        pendingSwimlaneIds_.insert(eventId);
+        return;     // Grouped layout follows generationChanged
+    }
+
     TimelineItem* item = findItemByEventId(eventId);
 
     if (item)
@@ -308,7 +328,52 @@ void TimelineScene::onEventRemoved(const QString& eventId)
         removeItem(item);
         delete item;
     }
-    updateSceneHeight(); // Adjust scene height after removal
+    updateSceneRect(); // Adjust scene height after removal
+}
+
+
+void TimelineScene::onEventsAdded(const QStringList& eventIds)
+{
+    if (swimlaneLayout_.isActive())
+    {
+        queueSwimlaneChanges(eventIds);
+        return;     // Grouped layout follows generationChanged
+    }
+
+    // One pass over the model instead of a linear getEvent() lookup per new event
+    const QSet<QString> added(eventIds.cbegin(), eventIds.cend());
+    const QVector<TimelineEvent> events = model_->getAllEvents();
+
+    for (const TimelineEvent& event : events)
+    {
+        if (added.contains(event.id))
+        {
+            createItemForEvent(event);
+        }
+    }
+    updateSceneRect();
+}
+
+
+void TimelineScene::onEventsRemoved(const QStringList& eventIds)
+{
+    if (swimlaneLayout_.isActive())
+    {
+        queueSwimlaneChanges(eventIds);
+        return;     // Grouped layout follows generationChanged
+    }
+
+    for (const QString& eventId : eventIds)
+    {
+        TimelineItem* item = eventIdToItem_.take(eventId);
+
+        if (item)
+        {
+            removeItem(item);
+            delete item;
+        }
+    }
+    updateSceneRect();
 }
 
 
@@ -316,7 +381,18 @@ void TimelineScene::onEventUpdated(const QString& eventId)
 {
     TimelineItem* item = findItemByEventId(eventId);
 
-    if (item)
+    if (swimlaneLayout_.isActive())
+    {
+        pendingSwimlaneIds_.insert(eventId);
+    }
+
+    if (item && swimlaneLayout_.isActive())
+    {
+        // The event may have changed group; onModelGenerationChanged() re-lays out its old and new group
+        item->setSkipNextUpdate(false);
+        emit itemDragCompleted(eventId);
+    }
+    else if (item)
     {
         qDebug() << "=== SCENE ON EVENT UPDATED ===" << eventId;
         qDebug() << "Should skip next update?" << item->shouldSkipNextUpdate();
@@ -343,10 +419,56 @@ void TimelineScene::onEventUpdated(const QString& eventId)
 }
 
 
+void TimelineScene::onEventsUpdated(const QStringList& eventIds)
+{
+    // Imports, merges and live sessions: no drag to complete, and the side panel refreshes on its own
+    const bool grouped = swimlaneLayout_.isActive();
+    const QHash<QString, TimelineEvent> events = model_->getEvents(eventIds);
+
+    if (grouped)
+    {
+        queueSwimlaneChanges(eventIds);
+    }
+
+    for (auto it = events.cbegin(); it != events.cend(); ++it)
+    {
+        TimelineItem* item = findItemByEventId(it.key());
+        if (!item)
+        {
+            continue;
+        }
+
+        if (item->shouldSkipNextUpdate())
+        {
+            item->setSkipNextUpdate(false);
+        }
+        else if (!grouped && item->modelRevision() != it->revision)
+        {
+            // Usually already done by the relayout that preceded this signal
+            updateItemFromEvent(item, it.value());
+        }
+    }
+}
+
+
 void TimelineScene::onVersionDatesChanged()
 {
-    // Version dates changed - need to recalculate all positions
-    rebuildFromModel();
+    // Items are positioned from the epoch, so only the boundaries and the scene rect move
+    mapper_->setVersionDates(model_->versionStartDate(), model_->versionEndDate());
+
+    // Keep each view on the same dates while the scene rect changes under it
+    QList<QPointF> viewCenters;
+    for (QGraphicsView* view : views())
+    {
+        viewCenters.append(view->mapToScene(view->viewport()->rect().center()));
+    }
+
+    updateSceneRect();
+
+    for (int i = 0; i < viewCenters.size(); ++i)
+    {
+        views().at(i)->centerOn(viewCenters.at(i));
+    }
 }
 
 
@@ -358,6 +480,11 @@ void TimelineScene::onVersionNameChanged()
 
 void TimelineScene::onLanesRecalculated()
 {
+    if (swimlaneLayout_.isActive())
+    {
+        return;     // Groups pack their own lanes
+    }
+
     // When lanes are recalculated, update all item positions
     const auto& events = model_->getAllEvents();
 
@@ -365,12 +492,19 @@ void TimelineScene::onLanesRecalculated()
     {
         TimelineItem* item = findItemByEventId(event.id);
 
-        if (item)
+        // Relayout stamps every event whose lane moved, so unchanged items are already in place
+        if (item && item->modelRevision() != event.revision)
+        {
+            updateItemFromEvent(item, event);
+        }
+
+        // Ghosts follow their live bar's row; removed events keep their baseline lane
+        if (ghostItems_.contains(event.id))
         {
-            updateItemFromEvent(item, event.id);
+            updateGhostItem(event.id, &event);
         }
     }
-    updateSceneHeight();
+    updateSceneRect();
 }
 
 
@@ -383,15 +517,28 @@ TimelineItem* TimelineScene::createItemForEvent(const QString& eventId)
         return nullptr;
     }
 
-    // Calculate Y position based on lane (offset by date scale height)
-    double yPos = DATE_SCALE_OFFSET + LaneAssigner::laneToY(event->lane, ITEM_HEIGHT, LANE_SPACING);
+    return createItemForEvent(*event);
+}
+
+
+TimelineItem* TimelineScene::createItemForEvent(const TimelineEvent& event)
+{
+    const QString& eventId = event.id;
+
+    // Calculate Y position based on lane (offset by date scale height) or swimlane group
+    double yPos = eventTop(event);
+
+    if (yPos < 0.0)
+    {
+        return nullptr;     // Collapsed groups have no items
+    }
 
     // Always render using DateTime precision so timed events remain accurate at any zoom level.
     // Preserve legacy "inclusive day" look for all-day style events (midnight-to-midnight).
-    QDateTime displayStart = event->startDate;
-    QDateTime displayEnd = event->endDate;
+    QDateTime displayStart = event.startDate;
+    QDateTime displayEnd = event.endDate;
 
-    if (isAllDayStyleEvent(*event))
+    if (isAllDayStyleEvent(event))
     {
         displayEnd = displayEnd.addDays(1);
     }
@@ -404,37 +551,20 @@ TimelineItem* TimelineScene::createItemForEvent(const QString& eventId)
     // Create the item
     TimelineItem* item = new TimelineItem(rect);
     item->setEventId(eventId);
+    item->setModelRevision(event.revision);
     item->setModel(model_);
     item->setCoordinateMapper(mapper_);
     item->setUndoStack(undoStack_);
+    item->setVerticalDragEnabled(!swimlaneLayout_.isActive());     // Lanes are per group while grouped
 
     // Set visual properties
-    item->setBrush(QBrush(event->color));
+    item->setBrush(QBrush(event.color));
     item->setPen(QPen(Qt::black, 1));
-    item->setToolTip(QString("%1\n%2 to %3\nLane: %4")
-                         .arg(event->title)
-                         .arg(event->startDate.toString(Qt::ISODate))
-                         .arg(event->endDate.toString(Qt::ISODate))
-                         .arg(event->lane));
 
     // Set attachment count for visual indicator
     int attachmentCount = model_->getAttachmentCount(eventId);
     item->setAttachmentCount(attachmentCount);
-
-    // Build tooltip with attachment info
-    QString tooltip = QString("%1\n%2 to %3\nLane: %4")
-                          .arg(event->title)
-                          .arg(event->startDate.toString(Qt::ISODate))
-                          .arg(event->endDate.toString(Qt::ISODate))
-                          .arg(event->lane);
-
-    // Add attachment info to tooltip
-    if (attachmentCount > 0)
-    {
-        tooltip += QString("\nAttachments: %1").arg(attachmentCount);
-    }
-
-    item->setToolTip(tooltip);
+    item->setToolTip(itemToolTip(event, attachmentCount));
 
     // Set Z-value to draw events above marker lines
     item->setZValue(10);
@@ -453,20 +583,31 @@ void TimelineScene::updateItemFromEvent(TimelineItem* item, const QString& event
 {
     const TimelineEvent* event = model_->getEvent(eventId);
 
-    if (!event)
+    if (event)
     {
-        return;
+        updateItemFromEvent(item, *event);
     }
+}
+
+
+void TimelineScene::updateItemFromEvent(TimelineItem* item, const TimelineEvent& event)
+{
+    const QString& eventId = event.id;
+
+    // Calculate Y position based on lane (offset by date scale height) or swimlane group
+    double yPos = eventTop(event);
 
-    // Calculate Y position based on lane (offset by date scale height)
-    double yPos = DATE_SCALE_OFFSET + LaneAssigner::laneToY(event->lane, ITEM_HEIGHT, LANE_SPACING);
+    if (yPos < 0.0)
+    {
+        return;     // Collapsed group; relayoutSwimlanes() drops the item
+    }
 
     // Always render using DateTime precision so timed events remain accurate at any zoom level.
     // Preserve legacy "inclusive day" look for all-day style events (midnight-to-midnight).
-    QDateTime displayStart = event->startDate;
-    QDateTime displayEnd = event->endDate;
+    QDateTime displayStart = event.startDate;
+    QDateTime displayEnd = event.endDate;
 
-    if (isAllDayStyleEvent(*event))
+    if (isAllDayStyleEvent(event))
     {
         displayEnd = displayEnd.addDays(1);
     }
@@ -487,45 +628,57 @@ void TimelineScene::updateItemFromEvent(TimelineItem* item, const QString& event
     // Update attachment count
     int attachmentCount = model_->getAttachmentCount(eventId);
     item->setAttachmentCount(attachmentCount);
+    item->setToolTip(itemToolTip(event, attachmentCount));
 
-    // Build tooltip with attachment info
-    QString tooltip = QString("%1\n%2 to %3\nLane: %4")
-                          .arg(event->title)
-                          .arg(event->startDate.toString(Qt::ISODate))
-                          .arg(event->endDate.toString(Qt::ISODate))
-                          .arg(event->lane);
+    // Update visual properties
+    item->setBrush(QBrush(event.color));
+    item->setModelRevision(event.revision);
+}
 
-    if (attachmentCount > 0)
-    {
-        tooltip += QString("\nAttachments: %1").arg(attachmentCount);
-    }
 
-    item->setToolTip(tooltip);
+qint64 TimelineScene::laneGapSecondsAt(double pixelsPerDay)
+{
+    // Round to whole minutes so small zoom steps don't relayout for sub-minute differences
+    const double gapDays = TimelineSettings::instance().laneMinGapPixels() / pixelsPerDay;
+    const qint64 gapMinutes = static_cast<qint64>(std::ceil(gapDays * 1440.0));
 
-    // Update visual properties
-    item->setBrush(QBrush(event->color));
+    return gapMinutes * 60;
 }
 
 
-void TimelineScene::updateSceneHeight()
+void TimelineScene::syncLaneGap()
 {
-    // Calculate scene width with +1 month padding
-    QDate paddedStart = model_->versionStartDate().addMonths(-1);
-    QDate paddedEnd = model_->versionEndDate().addMonths(1);
+    model_->setLaneGapSeconds(laneGapSecondsAt(mapper_->pixelsPerday()));
+}
+
+
+void TimelineScene::updateSceneRect()
+{
+    // Scene rect spans the version dates plus padding; X itself is epoch-based,
+    // so only the rect and the markers move when the version changes
+    QDate paddedStart = model_->versionStartDate().addMonths(-SCENE_PADDING_MONTHS);
+    QDate paddedEnd = model_->versionEndDate().addMonths(SCENE_PADDING_MONTHS);
 
     double startX = mapper_->dateToX(paddedStart);
     double endX = mapper_->dateToX(paddedEnd);
     double width = endX - startX;
 
-    // Dynamically adjust scene height based on lane count
-    double height = DATE_SCALE_OFFSET + LaneAssigner::calculateSceneHeight(model_->maxLane(), ITEM_HEIGHT, LANE_SPACING);
+    // Dynamically adjust scene height based on lane count (or the stacked swimlane groups,
+    // with the same bottom padding as LaneAssigner::calculateSceneHeight())
+    double height = swimlaneLayout_.isActive()
+                        ? swimlaneLayout_.bottom() + 50
+                        : DATE_SCALE_OFFSET + LaneAssigner::calculateSceneHeight(model_->maxLane(), ITEM_HEIGHT, LANE_SPACING);
 
-    // Extend scene rect upward to include header area
+    // Extend scene rect upward to include header area (version name + legend)
+    // Version name is at Y = -150, so we need to start the scene rect above that
     const double HEADER_TOP = -180.0;
     double totalHeight = height - HEADER_TOP;
 
     setSceneRect(startX, HEADER_TOP, width, totalHeight);
 
+    // Group headers span the same width
+    syncSwimlaneGroupItems(startX, endX);
+
     // Update date scale and marker heights
     if (dateScale_)
     {
@@ -628,23 +781,60 @@ void TimelineScene::onEventAttachmentsChanged(const QString& eventId)
         const TimelineEvent* event = model_->getEvent(eventId);
         if (event)
         {
-            QString tooltip = QString("%1\n%2 to %3\nLane: %4")
-            .arg(event->title)
-                .arg(event->startDate.toString(Qt::ISODate))
-                .arg(event->endDate.toString(Qt::ISODate))
-                .arg(event->lane);
+            item->setToolTip(itemToolTip(*event, count));
+        }
+    }
+}
 
-            if (count > 0)
-            {
-                tooltip += QString("\nAttachments: %1").arg(count);
-            }
 
-            item->setToolTip(tooltip);
+void TimelineScene::onEventAttachmentsReset()
+{
+    // One pass over the model; counts come from the manager's table instead of per-item lookups
+    const QHash<int, int> counts = AttachmentManager::instance().attachmentCounts();
+    const QVector<TimelineEvent> events = model_->getAllEvents();
+
+    for (const TimelineEvent& event : events)
+    {
+        TimelineItem* item = eventIdToItem_.value(event.id, nullptr);
+        if (!item)
+        {
+            continue;
+        }
+
+        const int count = counts.value(static_cast<int>(qHash(event.id)), 0);
+        if (count != item->attachmentCount())
+        {
+            item->setAttachmentCount(count);
+            item->setToolTip(itemToolTip(event, count));
         }
     }
 }
 
 
+int TimelineScene::laneAtY(double y)
+{
+    const double laneStride = LaneAssigner::laneToY(1, ITEM_HEIGHT, LANE_SPACING);
+    return std::max(0, static_cast<int>(std::floor((y - DATE_SCALE_OFFSET) / laneStride)));
+}
+
+
+QString TimelineScene::itemToolTip(const TimelineEvent& event, int attachmentCount)
+{
+    QString tooltip = QString("%1\n%2 to %3\nLane: %4")
+                          .arg(event.title)
+                          .arg(event.startDate.toString(Qt::ISODate))
+                          .arg(event.endDate.toString(Qt::ISODate))
+                          .arg(event.lane);
+
+    if (attachmentCount > 0)
+    {
+        tooltip += QString("\nAttachments: %1").arg(attachmentCount);
+    }
+
+    return tooltip;
+}
+
+
 void TimelineScene::onFilesDropped(const QString& eventId, const QStringList& filePaths)
 {
     qDebug() << "TimelineScene: Files dropped on event" << eventId;
@@ -701,3 +891,398 @@ void TimelineScene::onFilesDropped(const QString& eventId, const QStringList& fi
         qDebug() << "TimelineScene: Manually triggered attachment indicator update for" << eventId;
     }
 }
+
+
+void TimelineScene::setBaselineComparator(TimelineBaselineComparator* comparator)
+{
+    if (baselineComparator_)
+    {
+        disconnect(baselineComparator_, nullptr, this, nullptr);
+    }
+
+    baselineComparator_ = comparator;
+
+    if (baselineComparator_)
+    {
+        connect(baselineComparator_, &TimelineBaselineComparator::comparisonReset, this, &TimelineScene::onBaselineReset);
+        connect(baselineComparator_, &TimelineBaselineComparator::eventDiffChanged, this, &TimelineScene::onBaselineDiffChanged);
+        connect(baselineComparator_, &TimelineBaselineComparator::eventDiffsChanged, this, &TimelineScene::onBaselineDiffsChanged);
+    }
+
+    refreshGhostItems();
+}
+
+
+void TimelineScene::onBaselineReset()
+{
+    refreshGhostItems();
+}
+
+
+void TimelineScene::onBaselineDiffChanged(const QString& eventId)
+{
+    updateGhostItem(eventId, model_->getEvent(eventId));
+}
+
+
+void TimelineScene::onBaselineDiffsChanged(const QStringList& eventIds)
+{
+    const QHash<QString, TimelineEvent> events = model_->getEvents(eventIds);
+
+    for (const QString& eventId : eventIds)
+    {
+        auto it = events.constFind(eventId);
+        updateGhostItem(eventId, it != events.constEnd() ? &it.value() : nullptr);
+    }
+}
+
+
+QRectF TimelineScene::displayRectFor(const QDateTime& start, const QDateTime& end, double yPos) const
+{
+    // Same "inclusive day" rule as the live bars so ghosts line up exactly
+    QDateTime displayEnd = isAllDayStyleRange(start, end) ? end.addDays(1) : end;
+
+    return mapper_->dateTimeRangeToRect(start, displayEnd, yPos, ITEM_HEIGHT);
+}
+
+
+void TimelineScene::updateGhostItem(const QString& eventId, const TimelineEvent* live)
+{
+    const TimelineBaselineComparator::EventDiff* diff = baselineComparator_ ? baselineComparator_->diffFor(eventId) : nullptr;
+
+    if (!diff)
+    {
+        // Unchanged (or no baseline) - drop any stale ghost
+        BaselineGhostItem* ghost = ghostItems_.take(eventId);
+        if (ghost)
+        {
+            removeItem(ghost);
+            delete ghost;
+        }
+        return;
+    }
+
+    const TimelineBaselineComparator::BaselineEntry* base = baselineComparator_->baselineEntry(eventId);
+
+    // Keep the ghost on the live bar's row so the arrow reads horizontally
+    double yPos = live ? eventTop(*live)
+                  : swimlaneLayout_.isActive() ? -1.0
+                  : DATE_SCALE_OFFSET + LaneAssigner::laneToY(base ? base->lane : 0, ITEM_HEIGHT, LANE_SPACING);
+
+    if (yPos < 0.0)
+    {
+        // Collapsed group, or a removed event while grouped (it belongs to no group)
+        BaselineGhostItem* ghost = ghostItems_.take(eventId);
+        if (ghost)
+        {
+            removeItem(ghost);
+            delete ghost;
+        }
+        return;
+    }
+
+    QRectF baselineRect = base ? displayRectFor(base->startDate, base->endDate, yPos) : QRectF();
+    QRectF liveRect = live ? displayRectFor(live->startDate, live->endDate, yPos) : QRectF();
+    QString title = live ? live->title : (base ? base->title : QString());
+
+    BaselineGhostItem* ghost = ghostItems_.value(eventId, nullptr);
+    if (!ghost)
+    {
+        ghost = new BaselineGhostItem();
+        addItem(ghost);
+        ghostItems_.insert(eventId, ghost);
+    }
+
+    ghost->setGhost(diff->flags, baselineRect, liveRect, title);
+}
+
+
+void TimelineScene::refreshGhostItems()
+{
+    const auto changed = (baselineComparator_ && baselineComparator_->hasBaseline())
+                             ? baselineComparator_->changedEvents()
+                             : QVector<TimelineBaselineComparator::EventDiff>();
+
+    QStringList changedIds;
+    changedIds.reserve(changed.size());
+    for (const auto& diff : changed)
+    {
+        changedIds.append(diff.eventId);
+    }
+
+    // Ghosts of events that are no longer in the diff
+    for (auto it = ghostItems_.begin(); it != ghostItems_.end();)
+    {
+        if (!baselineComparator_ || !baselineComparator_->diffFor(it.key()))
+        {
+            removeItem(it.value());
+            delete it.value();
+            it = ghostItems_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Only changed events carry a ghost, so this is proportional to the diff; the live
+    // events are resolved in one model pass and existing ghosts are moved, not recreated
+    const QHash<QString, TimelineEvent> events = model_->getEvents(changedIds);
+
+    for (const QString& eventId : changedIds)
+    {
+        auto it = events.constFind(eventId);
+        updateGhostItem(eventId, it != events.constEnd() ? &it.value() : nullptr);
+    }
+}
+
+
+double TimelineScene::eventTop(const TimelineEvent& event) const
+{
+    if (swimlaneLayout_.isActive())
+    {
+        return swimlaneLayout_.eventTop(event.id);
+    }
+
+    return DATE_SCALE_OFFSET + LaneAssigner::laneToY(event.lane, ITEM_HEIGHT, LANE_SPACING);
+}
+
+
+void TimelineScene::setSwimlaneGrouping(SwimlaneGrouping grouping)
+{
+    if (grouping == swimlaneLayout_.grouping())
+    {
+        return;
+    }
+
+    swimlaneLayout_.setGrouping(grouping);
+
+    // Items are recreated for the new layout (and with the right vertical drag mode)
+    rebuildFromModel();
+}
+
+
+void TimelineScene::setSwimlaneGroupExpanded(const QString& key, bool expanded)
+{
+    if (!swimlaneLayout_.isActive() || swimlaneLayout_.isExpanded(key) == expanded)
+    {
+        return;
+    }
+
+    swimlaneLayout_.setExpanded(key, expanded);
+
+    // Only this group gains or loses lanes; the ones below it just shift
+    swimlaneLayout_.relayoutGroups(*model_, { key });
+    syncSwimlaneItems({ key });
+    updateSceneRect();
+    refreshGhostItems();
+}
+
+
+void TimelineScene::setAllSwimlaneGroupsExpanded(bool expanded)
+{
+    if (!swimlaneLayout_.isActive())
+    {
+        return;
+    }
+
+    swimlaneLayout_.setAllExpanded(expanded);
+
+    relayoutSwimlanes();
+    updateSceneRect();
+    refreshGhostItems();
+}
+
+
+void TimelineScene::onModelGenerationChanged()
+{
+    // Emitted once, last, per mutation - so several add/remove/lane signals regroup only once
+    if (!swimlaneLayout_.isActive())
+    {
+        return;
+    }
+
+    if (swimlanesStale_ || swimlaneLayout_.minGapSecs() != model_->laneGapSeconds())
+    {
+        // Cleared model or a new lane gap: every group packs differently
+        relayoutSwimlanes();
+    }
+    else if (!pendingSwimlaneIds_.isEmpty())
+    {
+        // Only the old and new groups of the changed events are re-laid out
+        const QStringList changedIds(pendingSwimlaneIds_.cbegin(), pendingSwimlaneIds_.cend());
+        pendingSwimlaneIds_.clear();
+
+        syncSwimlaneItems(swimlaneLayout_.applyChanges(*model_, changedIds));
+    }
+    else
+    {
+        return;     // Attachments, version dates: nothing regroups
+    }
+
+    updateSceneRect();
+    refreshGhostItems();
+}
+
+
+void TimelineScene::relayoutSwimlanes()
+{
+    const QVector<TimelineEvent> events = model_->getAllEvents();
+    const double laneStride = LaneAssigner::laneToY(1, ITEM_HEIGHT, LANE_SPACING);
+
+    swimlaneLayout_.layout(events, model_->laneGapSeconds(), DATE_SCALE_OFFSET, laneStride, GROUP_HEADER_HEIGHT);
+    pendingSwimlaneIds_.clear();
+    swimlanesStale_ = false;
+
+    // Drop items of collapsed groups and of events that are gone
+    for (auto it = eventIdToItem_.begin(); it != eventIdToItem_.end();)
+    {
+        if (swimlaneLayout_.isEventVisible(it.key()))
+        {
+            ++it;
+            continue;
+        }
+
+        TimelineItem* item = it.value();
+        it = eventIdToItem_.erase(it);
+        removeItem(item);
+        delete item;
+    }
+
+    // Create items for newly expanded groups; move the rest only if their row or event changed
+    for (const TimelineEvent& event : events)
+    {
+        if (!swimlaneLayout_.isEventVisible(event.id))
+        {
+            continue;
+        }
+
+        TimelineItem* item = eventIdToItem_.value(event.id, nullptr);
+
+        if (!item)
+        {
+            createItemForEvent(event);
+        }
+        else if (item->modelRevision() != event.revision || item->rect().top() != swimlaneLayout_.eventTop(event.id))
+        {
+            updateItemFromEvent(item, event);
+        }
+    }
+}
+
+
+void TimelineScene::queueSwimlaneChanges(const QStringList& eventIds)
+{
+    for (const QString& eventId : eventIds)
+    {
+        pendingSwimlaneIds_.insert(eventId);
+    }
+}
+
+
+void TimelineScene::syncSwimlaneItems(const QSet<QString>& groupKeys)
+{
+    // Members of the re-laid out groups that have items, resolved in one model pass
+    QStringList refreshIds;
+    for (const QString& key : groupKeys)
+    {
+        if (swimlaneLayout_.isExpanded(key))
+        {
+            refreshIds += swimlaneLayout_.groupMembers(key);
+        }
+    }
+
+    const QHash<QString, TimelineEvent> events = model_->getEvents(refreshIds);
+
+    // Other groups kept their lanes, so their items only shift with the groups above them
+    for (auto it = eventIdToItem_.begin(); it != eventIdToItem_.end();)
+    {
+        if (!swimlaneLayout_.isEventVisible(it.key()))
+        {
+            TimelineItem* item = it.value();
+            it = eventIdToItem_.erase(it);
+            removeItem(item);
+            delete item;
+            continue;
+        }
+
+        if (!events.contains(it.key()))
+        {
+            TimelineItem* item = it.value();
+            const double dy = swimlaneLayout_.eventTop(it.key()) - item->rect().top();
+            if (dy != 0.0)
+            {
+                item->setRect(item->rect().translated(0.0, dy));
+            }
+        }
+        ++it;
+    }
+
+    for (auto it = events.cbegin(); it != events.cend(); ++it)
+    {
+        if (!swimlaneLayout_.isEventVisible(it.key()))
+        {
+            continue;
+        }
+
+        TimelineItem* item = eventIdToItem_.value(it.key(), nullptr);
+
+        if (!item)
+        {
+            createItemForEvent(it.value());
+        }
+        else if (item->modelRevision() != it->revision || item->rect().top() != swimlaneLayout_.eventTop(it.key()))
+        {
+            updateItemFromEvent(item, it.value());
+        }
+    }
+}
+
+
+void TimelineScene::syncSwimlaneGroupItems(double left, double right)
+{
+    QSet<QString> liveKeys;
+
+    for (const SwimlaneLayout::Group& group : swimlaneLayout_.groups())
+    {
+        liveKeys.insert(group.key);
+
+        QVector<SwimlaneGroupItem::SummaryRect> summary;
+        summary.reserve(group.summary.size());
+
+        for (const SwimlaneLayout::SummaryBar& bar : group.summary)
+        {
+            summary.append({ mapper_->dateTimeRangeToRect(bar.start, bar.end, group.top + GROUP_HEADER_HEIGHT, ITEM_HEIGHT),
+                             bar.eventCount });
+        }
+
+        SwimlaneGroupItem* item = groupItems_.value(group.key, nullptr);
+        if (!item)
+        {
+            item = new SwimlaneGroupItem(group.key);
+            addItem(item);
+            groupItems_.insert(group.key, item);
+        }
+
+        item->setGroup(QRectF(left, group.top, right - left, GROUP_HEADER_HEIGHT),
+                       group.label,
+                       group.eventCount,
+                       group.collapsed,
+                       summary);
+    }
+
+    // Groups that emptied out (or all of them when grouping is off)
+    for (auto it = groupItems_.begin(); it != groupItems_.end();)
+    {
+        if (liveKeys.contains(it.key()))
+        {
+            ++it;
+            continue;
+        }
+
+        SwimlaneGroupItem* item = it.value();
+        it = groupItems_.erase(it);
+        removeItem(item);
+        delete item;
+    }
+}
@@ -4,6 +4,7 @@
 #pragma once
 #include <QGraphicsScene>
 #include <QMap>
+#include "SwimlaneLayout.h"
 
 
 class TimelineModel;
@@ -12,6 +13,9 @@ class TimelineItem;
 class TimelineDateScale;
 class CurrentDateMarker;
 class VersionBoundaryMarker;
+class TimelineBaselineComparator;
+class BaselineGhostItem;
+class SwimlaneGroupItem;
 class QUndoStack;
 
 
@@ -24,6 +28,7 @@ class QUndoStack;
  * - Positioning items using coordinate mapper
  * - Responding to model changes via signals/slots
  * - Rendering date scale and current date marker (Phase 1 & 3)
+ * - Optional swimlane grouping, where only expanded groups get lanes and items
  * - Emitting selection events when items are clicked
  */
 class TimelineScene : public QGraphicsScene
@@ -47,6 +52,14 @@ public:
     void rebuildFromModel();                                                    ///< @brief Rebuild all items from the model (useful after zoom or major changes)
     void updateVersionNamePosition();                                           ///< @brief Update version name label to stay centered in viewport
     TimelineItem* findItemByEventId(const QString& eventId) const;              ///< @brief Find the TimelineItem associated with an event ID
+    void setBaselineComparator(TimelineBaselineComparator* comparator);         ///< @brief Attach a baseline comparator to render ghost bars and slip arrows
+    static int laneAtY(double y);                                               ///< @brief Lane whose row contains scene Y (0 above the first lane)
+    static qint64 laneGapSecondsAt(double pixelsPerDay);                        ///< @brief Lane gap (TimelineModel::laneGapSeconds()) this scene keeps at a zoom level
+
+    void setSwimlaneGrouping(SwimlaneGrouping grouping);                        ///< @brief Group rows into swimlanes (None = classic packed lanes); groups start collapsed
+    SwimlaneGrouping swimlaneGrouping() const { return swimlaneLayout_.grouping(); }    ///< @brief Current swimlane grouping
+    void setSwimlaneGroupExpanded(const QString& key, bool expanded);           ///< @brief Expand (lay out and create items) or collapse one group
+    void setAllSwimlaneGroupsExpanded(bool expanded);                           ///< @brief Expand or collapse every group
 
 signals:
     void itemClicked(const QString& eventId);                   ///< @brief Emitted when a timeline item is clicked
@@ -58,12 +71,20 @@ signals:
 public slots:
     void onEventAdded(const QString& eventId);                                  ///< @brief Handle a new event being added to the model
     void onEventRemoved(const QString& eventId);                                ///< @brief Handle an event being removed from the model
+    void onEventsAdded(const QStringList& eventIds);                            ///< @brief Handle a batch insert (single scene height update)
+    void onEventsRemoved(const QStringList& eventIds);                          ///< @brief Handle a batch removal (single scene height update)
     void onEventUpdated(const QString& eventId);                                ///< @brief Handle an event being updated in the model
-    void onVersionDatesChanged();                                               ///< @brief Handle version dates changing (requires full rebuild)
+    void onEventsUpdated(const QStringList& eventIds);                          ///< @brief Handle a batch update (one model pass)
+    void onVersionDatesChanged();                                               ///< @brief Handle version dates changing (moves markers and scene rect only)
     void onVersionNameChanged();                                                ///< @brief Handle version name changes
     void onLanesRecalculated();                                                 ///< @brief Handle lanes being recalculated
     void onEventAttachmentsChanged(const QString& eventId);                     ///<
+    void onEventAttachmentsReset();                                             ///< @brief Refresh all badges from the precomputed count table
     void onFilesDropped(const QString& eventId, const QStringList& filePaths);  ///<
+    void onBaselineReset();                                                     ///< @brief Bring all baseline ghosts up to date after a full comparison
+    void onBaselineDiffChanged(const QString& eventId);                         ///< @brief Update the ghost of a single reclassified event
+    void onBaselineDiffsChanged(const QStringList& eventIds);                   ///< @brief Update the ghosts of a batch of reclassified events (one model pass)
+    void onModelGenerationChanged();                                            ///< @brief Regroup once per model mutation while swimlanes are grouped
 
 protected:
     void mousePressEvent(QGraphicsSceneMouseEvent* event) override;         ///< @brief Override to detect item clicks
@@ -72,18 +93,36 @@ protected:
 
 private:
     TimelineItem* createItemForEvent(const QString& eventId);               ///< Create a single timeline item from event data
+    TimelineItem* createItemForEvent(const TimelineEvent& event);           ///< Create a timeline item from an already resolved event
     void updateItemFromEvent(TimelineItem* item, const QString& eventId);   ///< Update an existing item's visual representation
-    void updateSceneHeight();                                               ///< Update scene height based on current lane count
+    void updateItemFromEvent(TimelineItem* item, const TimelineEvent& event);   ///< Same, for an event already at hand (no model search)
+    void updateSceneRect();                                                 ///< Update scene rect, date scale and markers for the version dates and lane count
+    void syncLaneGap();                                                     ///< Convert the minimum lane gap setting to time at the current zoom
     void setupDateScale();                                                  ///< Initialize date scale and current date marker
     void setupVersionBoundaryMarkers();                                     ///< Setup version boundary markers
     void setupVersionNameLabel();                                           ///< Setup version name label
     void updateVersionNameLabel();                                          ///< Update version name label text and position
     void connectItemSignals(TimelineItem* item);                            ///<
+    QRectF displayRectFor(const QDateTime& start, const QDateTime& end, double yPos) const;   ///< Scene rect for a bar with the given dates and top
+    double eventTop(const TimelineEvent& event) const;                      ///< Bar top for an event (-1 if it sits in a collapsed group)
+    void relayoutSwimlanes();                                               ///< Regroup and create/update/drop items so only expanded groups have items
+    void syncSwimlaneItems(const QSet<QString>& groupKeys);                 ///< After a partial regroup: rebuild items of the given groups, shift the others
+    void queueSwimlaneChanges(const QStringList& eventIds);                 ///< Remember events to regroup on the next generationChanged
+    void syncSwimlaneGroupItems(double left, double right);                 ///< Create, update or remove group headers and summary strips
+    void updateGhostItem(const QString& eventId, const TimelineEvent* live);    ///< Create, update or remove the baseline ghost for an event (live is nullptr if removed)
+    void refreshGhostItems();                                               ///< Move every ghost in place and drop stale ones (after zoom, regrouping or a full comparison)
+    static QString itemToolTip(const TimelineEvent& event, int attachmentCount);  ///< Tooltip text for an event bar
 
     TimelineModel* model_;                              ///< Data model (not owned)
     TimelineCoordinateMapper* mapper_;                  ///< Coordinate mapper (not owned)
     QUndoStack* undoStack_ = nullptr;                   ///<
     QMap<QString, TimelineItem*> eventIdToItem_;        ///< Map event IDs to scene items
+    TimelineBaselineComparator* baselineComparator_ = nullptr;  ///< Baseline comparator (not owned, nullable)
+    QMap<QString, BaselineGhostItem*> ghostItems_;      ///< Baseline ghosts for changed events only
+    SwimlaneLayout swimlaneLayout_;                     ///< Group layout (inactive when grouping is None)
+    QSet<QString> pendingSwimlaneIds_;                  ///< Events changed since the last grouped layout
+    bool swimlanesStale_ = false;                       ///< Model was cleared; regroup everything next time
+    QMap<QString, SwimlaneGroupItem*> groupItems_;      ///< Group headers by grouping value
 
     TimelineDateScale* dateScale_;                      ///< Date scale renderer (owned by scene)
     CurrentDateMarker* currentDateMarker_;              ///< Today marker (owned by scene)
@@ -97,4 +136,6 @@ private:
     static constexpr double ITEM_HEIGHT = 30.0;         ///< Default height of timeline bars
     static constexpr double LANE_SPACING = 5.0;         ///< Vertical spacing between lanes
     static constexpr double DATE_SCALE_OFFSET = 80.0;   ///< Y offset for events (below date scale)
+    static constexpr double GROUP_HEADER_HEIGHT = 22.0; ///< Height of a swimlane group header row
+    static constexpr int SCENE_PADDING_MONTHS = 1;      ///< Scene rect padding before/after the version dates
 };
@@ -10,6 +10,8 @@
 #include <QDebug>
 #include <QDir>
 #include <QStandardPaths>
+#include <QCryptographicHash>
+#include <algorithm>
 
 
 bool TimelineSerializer::saveToFile(const TimelineModel* model, const QString& filePath)
@@ -114,47 +116,418 @@ QJsonObject TimelineSerializer::serializeModel(const TimelineModel* model)
 
 bool TimelineSerializer::deserializeModel(TimelineModel* model, const QJsonObject& json)
 {
-    model->clear();
+    TimelineProjectData project;
+    readProject(json, project);
 
-    QString startDateStr = json["versionStart"].toString();
-    QString endDateStr = json["versionEnd"].toString();
+    model->clear();
 
-    QDate startDate = QDate::fromString(startDateStr, Qt::ISODate);
-    QDate endDate = QDate::fromString(endDateStr, Qt::ISODate);
+    if (project.versionStart.isValid() && project.versionEnd.isValid())
+    {
+        model->setVersionDates(project.versionStart, project.versionEnd);
+    }
 
-    if (startDate.isValid() && endDate.isValid())
+    if (project.hasVersionName)
     {
-        model->setVersionDates(startDate, endDate);
+        model->setVersionName(project.versionName);
     }
 
+    model->addEvents(project.events);
+    model->addArchivedEvents(project.archivedEvents);
+
+    // Attachments are installed in one step once the events exist
+    AttachmentManager::instance().importRegistry(project.attachmentRegistry);
+
+    return true;
+}
+
+
+bool TimelineSerializer::readProject(const QJsonObject& json,
+                                     TimelineProjectData& project,
+                                     const std::atomic_bool* cancelFlag,
+                                     const std::function<void(int)>& progress)
+{
+    project = TimelineProjectData();
+
+    project.versionStart = QDate::fromString(json["versionStart"].toString(), Qt::ISODate);
+    project.versionEnd = QDate::fromString(json["versionEnd"].toString(), Qt::ISODate);
+
     if (json.contains("versionName"))
     {
-        model->setVersionName(json["versionName"].toString());
+        project.versionName = json["versionName"].toString();
+        project.hasVersionName = true;
+    }
+
+    const QJsonArray eventsArray = json["events"].toArray();
+    const QJsonArray archivedArray = json["archivedEvents"].toArray();
+    const qsizetype total = eventsArray.size() + archivedArray.size();
+
+    project.events.reserve(eventsArray.size());
+    project.archivedEvents.reserve(archivedArray.size());
+
+    qsizetype parsed = 0;
+    int lastPercent = -1;
+
+    // Returns false once cancellation was requested
+    auto step = [&]()
+    {
+        ++parsed;
+        if ((parsed & 0xFF) != 0)
+        {
+            return true;
+        }
+
+        if (cancelFlag && *cancelFlag)
+        {
+            return false;
+        }
+
+        const int percent = static_cast<int>(parsed * 100 / total);
+        if (progress && percent != lastPercent)
+        {
+            lastPercent = percent;
+            progress(percent);
+        }
+        return true;
+    };
+
+    for (const QJsonValue& val : eventsArray)
+    {
+        project.events.append(deserializeEvent(val.toObject(), true, &project.attachmentRegistry));
+        if (!step())
+        {
+            return false;
+        }
+    }
+
+    for (const QJsonValue& val : archivedArray)
+    {
+        TimelineEvent event = deserializeEvent(val.toObject(), true, &project.attachmentRegistry);
+        event.archived = true;
+        project.archivedEvents.append(event);
+        if (!step())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool TimelineSerializer::readEventsFromFile(const QString& filePath,
+                                            QVector<TimelineEvent>& events,
+                                            QString* versionName)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << "Failed to open file for reading:" << filePath;
+        return false;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    file.close();
+
+    if (doc.isNull() || !doc.isObject())
+    {
+        qWarning() << "Invalid JSON format in file:" << filePath;
+        return false;
+    }
+
+    QJsonObject json = doc.object();
+
+    if (isShardManifest(json))
+    {
+        // Snapshots need the whole history
+        TimelineProjectData project;
+        QString errorString;
+        if (!readShardedProject(filePath, json, project, QDate(), QDate(), &errorString))
+        {
+            qWarning() << "Failed to read sharded project:" << errorString;
+            return false;
+        }
+
+        events = project.events;
+        if (versionName)
+        {
+            *versionName = project.versionName;
+        }
+        return true;
     }
 
     QJsonArray eventsArray = json["events"].toArray();
+
+    events.clear();
+    events.reserve(eventsArray.size());
+
     for (const QJsonValue& val : eventsArray)
     {
-        TimelineEvent event = deserializeEvent(val.toObject());
-        model->addEvent(event);
+        events.append(deserializeEvent(val.toObject(), false));
+    }
+
+    if (versionName)
+    {
+        *versionName = json["versionName"].toString();
+    }
+
+    return true;
+}
+
+
+bool TimelineSerializer::isShardManifest(const QJsonObject& json)
+{
+    return json.contains("shards") && !json.contains("events");
+}
+
+
+bool TimelineSerializer::readShardedProject(const QString& manifestPath,
+                                            const QJsonObject& json,
+                                            TimelineProjectData& project,
+                                            const QDate& from,
+                                            const QDate& to,
+                                            QString* errorString,
+                                            const std::atomic_bool* cancelFlag,
+                                            const std::function<void(int)>& progress)
+{
+    project = TimelineProjectData();
+    project.sharded = true;
+
+    project.versionStart = QDate::fromString(json["versionStart"].toString(), Qt::ISODate);
+    project.versionEnd = QDate::fromString(json["versionEnd"].toString(), Qt::ISODate);
+
+    if (json.contains("versionName"))
+    {
+        project.versionName = json["versionName"].toString();
+        project.hasVersionName = true;
+    }
+
+    TimelineShardManifest& manifest = project.manifest;
+    manifest.periodMonths = json["shardPeriodMonths"].toInt(1) == 3 ? 3 : 1;
+
+    const QJsonArray shardsArray = json["shards"].toArray();
+    manifest.shards.reserve(shardsArray.size());
+
+    for (const QJsonValue& val : shardsArray)
+    {
+        const QJsonObject obj = val.toObject();
+
+        TimelineShardInfo info = shardInfoForKey(obj["key"].toString(), manifest.periodMonths);
+        info.fileName = obj["file"].toString(info.fileName);
+        info.lastEnd = QDate::fromString(obj["lastEnd"].toString(), Qt::ISODate);
+        info.eventCount = obj["events"].toInt();
+        info.archivedCount = obj["archived"].toInt();
+        info.checksum = obj["sha256"].toString();
+        manifest.shards.append(info);
     }
 
-    if (json.contains("archivedEvents"))
+    std::sort(manifest.shards.begin(), manifest.shards.end(),
+              [](const TimelineShardInfo& a, const TimelineShardInfo& b) { return a.key < b.key; });
+
+    // Only the shards the caller asked for are read
+    const bool allShards = !from.isValid() || !to.isValid();
+    QVector<const TimelineShardInfo*> selected;
+
+    for (const TimelineShardInfo& info : manifest.shards)
     {
-        QJsonArray archivedArray = json["archivedEvents"].toArray();
-        for (const QJsonValue& val : archivedArray)
+        if (allShards || info.overlaps(from, to))
         {
-            TimelineEvent event = deserializeEvent(val.toObject());
-            event.archived = true;
-            QString eventId = model->addEvent(event);
-            if (!eventId.isEmpty())
+            selected.append(&info);
+        }
+    }
+
+    const QDir shardDir(shardDirectory(manifestPath));
+
+    for (int i = 0; i < selected.size(); ++i)
+    {
+        if (cancelFlag && *cancelFlag)
+        {
+            return false;
+        }
+
+        if (!readShard(shardDir.filePath(selected[i]->fileName), *selected[i], project, errorString))
+        {
+            return false;
+        }
+        project.loadedShards.append(selected[i]->key);
+
+        if (progress)
+        {
+            progress((i + 1) * 100 / selected.size());
+        }
+    }
+
+    return true;
+}
+
+
+bool TimelineSerializer::readShard(const QString& shardPath,
+                                   const TimelineShardInfo& info,
+                                   TimelineProjectData& project,
+                                   QString* errorString)
+{
+    auto fail = [errorString](const QString& message)
+    {
+        if (errorString)
+        {
+            *errorString = message;
+        }
+        return false;
+    };
+
+    QFile file(shardPath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return fail(QString("Missing shard %1: %2").arg(info.key, file.errorString()));
+    }
+
+    const QByteArray data = file.readAll();
+    file.close();
+
+    // Each shard is verified on its own, so one damaged file doesn't hide behind the manifest
+    if (!info.checksum.isEmpty() && checksumOf(data) != info.checksum)
+    {
+        return fail(QString("Shard %1 failed its checksum (changed outside the application or corrupt)").arg(info.key));
+    }
+
+    const QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (doc.isNull() || !doc.isObject())
+    {
+        return fail(QString("Invalid JSON format in shard %1").arg(info.key));
+    }
+
+    TimelineProjectData shard;
+    readProject(doc.object(), shard);
+
+    project.events += shard.events;
+    project.archivedEvents += shard.archivedEvents;
+    project.attachmentRegistry.insert(shard.attachmentRegistry);
+
+    return true;
+}
+
+
+QByteArray TimelineSerializer::serializeShard(const QString& key,
+                                              QVector<TimelineEvent> events,
+                                              QVector<TimelineEvent> archivedEvents)
+{
+    // Model order changes with every relayout; the file must not
+    auto byStart = [](const TimelineEvent& a, const TimelineEvent& b)
+    {
+        return a.startDate != b.startDate ? a.startDate < b.startDate : a.id < b.id;
+    };
+    std::sort(events.begin(), events.end(), byStart);
+    std::sort(archivedEvents.begin(), archivedEvents.end(), byStart);
+
+    auto toArray = [](const QVector<TimelineEvent>& list)
+    {
+        QJsonArray array;
+        for (const TimelineEvent& event : list)
+        {
+            QJsonObject obj = serializeEvent(event);
+            if (!event.laneControlEnabled)
             {
-                model->archiveEvent(eventId);
+                obj.remove("lane");     // Recalculated on load
             }
+            array.append(obj);
         }
+        return array;
+    };
+
+    QJsonObject obj;
+    obj["shard"] = key;
+    obj["events"] = toArray(events);
+    obj["archivedEvents"] = toArray(archivedEvents);
+    obj["serializerVersion"] = "1.0";
+
+    return QJsonDocument(obj).toJson(QJsonDocument::Indented);
+}
+
+
+QByteArray TimelineSerializer::eventHash(const TimelineEvent& event)
+{
+    QJsonObject obj = serializeEvent(event, false);
+    if (!event.laneControlEnabled)
+    {
+        obj.remove("lane");
     }
 
-    return true;
+    // QJsonObject keeps its keys sorted, so the compact form is canonical
+    return QCryptographicHash::hash(QJsonDocument(obj).toJson(QJsonDocument::Compact), QCryptographicHash::Sha1);
+}
+
+
+QJsonObject TimelineSerializer::serializeManifest(const TimelineModel* model, const TimelineShardManifest& manifest)
+{
+    QJsonObject obj;
+
+    obj["versionStart"] = model->versionStartDate().toString(Qt::ISODate);
+    obj["versionEnd"] = model->versionEndDate().toString(Qt::ISODate);
+    obj["versionName"] = model->versionName();
+    obj["shardPeriodMonths"] = manifest.periodMonths;
+
+    QJsonArray shardsArray;
+    for (const TimelineShardInfo& info : manifest.shards)
+    {
+        QJsonObject shardObj;
+        shardObj["key"] = info.key;
+        shardObj["file"] = info.fileName;
+        shardObj["events"] = info.eventCount;
+        shardObj["archived"] = info.archivedCount;
+        shardObj["sha256"] = info.checksum;
+        if (info.lastEnd.isValid())
+        {
+            shardObj["lastEnd"] = info.lastEnd.toString(Qt::ISODate);
+        }
+        shardsArray.append(shardObj);
+    }
+    obj["shards"] = shardsArray;
+
+    obj["serializerVersion"] = "1.0";
+
+    return obj;
+}
+
+
+QString TimelineSerializer::shardDirectory(const QString& manifestPath)
+{
+    const QFileInfo info(manifestPath);
+    return info.absoluteDir().filePath(info.completeBaseName() + ".shards");
+}
+
+
+QString TimelineSerializer::shardKeyFor(const TimelineEvent& event, int periodMonths)
+{
+    if (!event.startDate.isValid())
+    {
+        return UNDATED_SHARD_KEY;
+    }
+
+    const QDate start = event.startDate.date();
+    const int firstMonth = ((start.month() - 1) / periodMonths) * periodMonths + 1;
+
+    return QDate(start.year(), firstMonth, 1).toString("yyyy-MM");
+}
+
+
+TimelineShardInfo TimelineSerializer::shardInfoForKey(const QString& key, int periodMonths)
+{
+    TimelineShardInfo info;
+    info.key = key;
+    info.fileName = key + ".json";
+
+    if (key != UNDATED_SHARD_KEY)
+    {
+        info.periodStart = QDate::fromString(key + "-01", Qt::ISODate);
+        info.periodEnd = info.periodStart.isValid() ? info.periodStart.addMonths(periodMonths).addDays(-1) : QDate();
+    }
+
+    return info;
+}
+
+
+QString TimelineSerializer::checksumOf(const QByteArray& data)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
 }
 
 
@@ -188,7 +561,7 @@ bool TimelineSerializer::createBackup(const QString& filePath)
 }
 
 
-QJsonObject TimelineSerializer::serializeEvent(const TimelineEvent& event)
+QJsonObject TimelineSerializer::serializeEvent(const TimelineEvent& event, bool includeAttachments)
 {
     QJsonObject obj;
 
@@ -251,6 +624,17 @@ QJsonObject TimelineSerializer::serializeEvent(const TimelineEvent& event)
         obj["preparationChecklist"] = checklistObj;
     }
 
+    if (event.hasTestResults())
+    {
+        QJsonObject resultsObj;
+        resultsObj["passed"] = event.testsPassed;
+        resultsObj["failed"] = event.testsFailed;
+        resultsObj["skipped"] = event.testsSkipped;
+        resultsObj["durationSecs"] = event.testDurationSecs;
+        resultsObj["imported"] = event.testResultsImported.toString(Qt::ISODate);
+        obj["testResults"] = resultsObj;
+    }
+
     // Jira Ticket-specific fields
     if (!event.jiraKey.isEmpty())
         obj["jiraKey"] = event.jiraKey;
@@ -261,6 +645,11 @@ QJsonObject TimelineSerializer::serializeEvent(const TimelineEvent& event)
     if (!event.jiraStatus.isEmpty())
         obj["jiraStatus"] = event.jiraStatus;
 
+    if (!includeAttachments)
+    {
+        return obj;
+    }
+
     // Serialize attachments using UUID hash
     int numericEventId = qHash(event.id);
 
@@ -277,7 +666,9 @@ QJsonObject TimelineSerializer::serializeEvent(const TimelineEvent& event)
 }
 
 
-TimelineEvent TimelineSerializer::deserializeEvent(const QJsonObject& json)
+TimelineEvent TimelineSerializer::deserializeEvent(const QJsonObject& json,
+                                                   bool restoreAttachments,
+                                                   QHash<int, QJsonArray>* attachmentRegistry)
 {
     TimelineEvent event;
 
@@ -402,6 +793,16 @@ TimelineEvent TimelineSerializer::deserializeEvent(const QJsonObject& json)
         }
     }
 
+    if (json.contains("testResults"))
+    {
+        QJsonObject resultsObj = json["testResults"].toObject();
+        event.testsPassed = resultsObj["passed"].toInt();
+        event.testsFailed = resultsObj["failed"].toInt();
+        event.testsSkipped = resultsObj["skipped"].toInt();
+        event.testDurationSecs = resultsObj["durationSecs"].toDouble();
+        event.testResultsImported = QDateTime::fromString(resultsObj["imported"].toString(), Qt::ISODate);
+    }
+
     // Jira Ticket-specific fields
     if (json.contains("jiraKey"))
         event.jiraKey = json["jiraKey"].toString();
@@ -420,6 +821,27 @@ TimelineEvent TimelineSerializer::deserializeEvent(const QJsonObject& json)
         event.status = "Not Started";
     }
 
+    if (!restoreAttachments)
+    {
+        return event;
+    }
+
+    auto restore = [attachmentRegistry](int numericEventId, const QJsonArray& attachmentsArray)
+    {
+        if (attachmentRegistry)
+        {
+            QJsonArray& entries = (*attachmentRegistry)[numericEventId];
+            for (const QJsonValue& value : attachmentsArray)
+            {
+                entries.append(value);
+            }
+        }
+        else
+        {
+            AttachmentManager::instance().deserializeAttachments(numericEventId, attachmentsArray);
+        }
+    };
+
     // Deserialize attachments
     if (json.contains("attachments"))
     {
@@ -431,8 +853,7 @@ TimelineEvent TimelineSerializer::deserializeEvent(const QJsonObject& json)
 
         if (ok && !attachmentsArray.isEmpty())
         {
-            AttachmentManager::instance().deserializeAttachments(numericEventId, attachmentsArray);
-            qDebug() << "Deserialized" << attachmentsArray.size() << "attachments for event" << event.id;
+            restore(numericEventId, attachmentsArray);
         }
         else if (!ok)
         {
@@ -449,10 +870,7 @@ TimelineEvent TimelineSerializer::deserializeEvent(const QJsonObject& json)
 
         if (!attachmentsArray.isEmpty())
         {
-            AttachmentManager::instance().deserializeAttachments(numericEventId, attachmentsArray);
-            qDebug() << "Deserialized" << attachmentsArray.size()
-                     << "attachments for event" << event.id
-                     << "(hash:" << numericEventId << ")";
+            restore(numericEventId, attachmentsArray);
         }
     }
 
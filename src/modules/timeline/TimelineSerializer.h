@@ -5,7 +5,71 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
 #include "TimelineModel.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+
+/**
+ * @struct TimelineShardInfo
+ * @brief Manifest entry for one shard file of a sharded project
+ *
+ * Events are sharded by the period their start date falls in. An event may run past
+ * its period, so lastEnd widens the range the shard has to be loaded for.
+ */
+struct TimelineShardInfo
+{
+    QString key;                ///< Period key: first month of the period ("2025-04"), or "undated"
+    QString fileName;           ///< File name inside the shard directory
+    QDate periodStart;          ///< First day of the period (invalid for the undated shard)
+    QDate periodEnd;            ///< Last day of the period
+    QDate lastEnd;              ///< Latest event end date stored in the shard
+    int eventCount = 0;         ///< Active events in the shard
+    int archivedCount = 0;      ///< Archived events in the shard
+    QString checksum;           ///< SHA-256 of the shard file (hex)
+
+    bool overlaps(const QDate& from, const QDate& to) const     ///< Whether any event in the shard can fall in [from, to]
+    {
+        if (!periodStart.isValid())
+        {
+            return true;    // Undated events are always needed
+        }
+        return periodStart <= to && std::max(periodEnd, lastEnd) >= from;
+    }
+};
+
+
+/**
+ * @struct TimelineShardManifest
+ * @brief Shard list of a sharded project (the manifest also carries the version fields)
+ */
+struct TimelineShardManifest
+{
+    int periodMonths = 1;                   ///< Shard length in months (1 = month, 3 = quarter)
+    QVector<TimelineShardInfo> shards;      ///< Shards sorted by key
+};
+
+
+/**
+ * @struct TimelineProjectData
+ * @brief Contents of a timeline file, parsed without touching any live model or the AttachmentManager
+ */
+struct TimelineProjectData
+{
+    QDate versionStart;                             ///< Invalid if the file has no version range
+    QDate versionEnd;
+    QString versionName;
+    bool hasVersionName = false;
+    QVector<TimelineEvent> events;                  ///< Active events in file order
+    QVector<TimelineEvent> archivedEvents;
+    QHash<int, QJsonArray> attachmentRegistry;      ///< For AttachmentManager::importRegistry()
+
+    bool sharded = false;                           ///< Read from a shard manifest
+    TimelineShardManifest manifest;                 ///< Shard list (sharded projects only)
+    QStringList loadedShards;                       ///< Keys of the shards whose events were read
+};
 
 /**
  * @class TimelineSerializer
@@ -16,6 +80,8 @@
  * - Load timeline model from JSON file
  * - Auto-save with configurable intervals
  * - Backup management
+ * - Sharded projects: a small manifest plus one file per month/quarter in a
+ *   "<name>.shards" directory next to it, each with its own checksum
  */
 class TimelineSerializer
 {
@@ -53,29 +119,131 @@ public:
     static bool deserializeModel(TimelineModel* model, const QJsonObject& json);
 
     /**
-     * @brief Get default save location for timeline data
-     * @return Full path to default timeline file
+     * @brief Parse a timeline JSON object into plain data (safe to call from a worker thread)
+     * @param json JSON object containing model data
+     * @param project Receives the parsed contents
+     * @param cancelFlag Optional flag polled between events
+     * @param progress Optional callback receiving 0-100 as events are parsed
+     * @return false if cancelled
      */
-    static QString getDefaultSaveLocation();
+    static bool readProject(const QJsonObject& json,
+                            TimelineProjectData& project,
+                            const std::atomic_bool* cancelFlag = nullptr,
+                            const std::function<void(int)>& progress = {});
 
     /**
-     * @brief Create backup of existing file
-     * @param filePath Original file path
-     * @return true if backup created successfully
+     * @brief Read the active events of a timeline file without touching any live model
+     * @param filePath Full path to load from
+     * @param events Receives the non-archived events stored in the file
+     * @param versionName Optional output for the stored version name
+     * @return true if the file was read and parsed successfully
+     *
+     * Used for read-only snapshots (e.g. baseline comparison). Attachments are
+     * not registered with the AttachmentManager and the project directory is left unchanged.
      */
-    static bool createBackup(const QString& filePath);
+    static bool readEventsFromFile(const QString& filePath,
+                                   QVector<TimelineEvent>& events,
+                                   QString* versionName = nullptr);
+
+    /**
+     * @brief Whether a parsed timeline file is a shard manifest rather than a single-file project
+     */
+    static bool isShardManifest(const QJsonObject& json);
+
+    /**
+     * @brief Read a shard manifest and the shards overlapping a date range
+     * @param manifestPath Path of the manifest (locates the shard directory)
+     * @param json Parsed manifest
+     * @param project Receives the version fields, the manifest and the events of the loaded shards
+     * @param from First day to load (invalid = load every shard)
+     * @param to Last day to load
+     * @param errorString Receives the reason for a failure (missing or corrupt shard)
+     * @param cancelFlag Optional flag polled between shards
+     * @param progress Optional callback receiving 0-100 as shards are read
+     * @return false on error or cancellation
+     */
+    static bool readShardedProject(const QString& manifestPath,
+                                   const QJsonObject& json,
+                                   TimelineProjectData& project,
+                                   const QDate& from,
+                                   const QDate& to,
+                                   QString* errorString = nullptr,
+                                   const std::atomic_bool* cancelFlag = nullptr,
+                                   const std::function<void(int)>& progress = {});
+
+    /**
+     * @brief Read one shard file, verifying its checksum, and append its contents (safe on any thread)
+     * @param shardPath Shard file
+     * @param info Manifest entry (an empty checksum skips verification)
+     * @param project Events, archived events and attachment records are appended
+     * @param errorString Receives the reason for a failure
+     */
+    static bool readShard(const QString& shardPath,
+                          const TimelineShardInfo& info,
+                          TimelineProjectData& project,
+                          QString* errorString = nullptr);
+
+    /**
+     * @brief Serialize the contents of one shard
+     *
+     * Events are written in a stable order and automatic lanes are left out (they are
+     * recalculated on load), so an unchanged shard serializes to identical bytes.
+     */
+    static QByteArray serializeShard(const QString& key,
+                                     QVector<TimelineEvent> events,
+                                     QVector<TimelineEvent> archivedEvents);
+
+    /**
+     * @brief Serialize a shard manifest with the model's version fields
+     */
+    static QJsonObject serializeManifest(const TimelineModel* model, const TimelineShardManifest& manifest);
+
+    static QString shardDirectory(const QString& manifestPath);                     ///< "<dir>/<name>.shards" for a manifest path
+    static QString shardKeyFor(const TimelineEvent& event, int periodMonths);       ///< Key of the shard an event belongs to
+    static TimelineShardInfo shardInfoForKey(const QString& key, int periodMonths); ///< Period and file name for a key (no counts or checksum)
+    static QString checksumOf(const QByteArray& data);                              ///< SHA-256 hex digest used for shard files
+
+    static constexpr const char* UNDATED_SHARD_KEY = "undated";
+
+    /**
+     * @brief Content hash of one event, used to tell which side of a merge changed it
+     *
+     * Covers every stored field except automatic lanes (recalculated on load) and
+     * attachments (kept by AttachmentManager), so equal hashes mean equal events
+     * regardless of field order or which machine laid them out.
+     */
+    static QByteArray eventHash(const TimelineEvent& event);
 
-private:
     /**
      * @brief Serialize a single event to JSON
+     * @param includeAttachments If false, AttachmentManager is not consulted (merge hashes, live sync)
      */
-    static QJsonObject serializeEvent(const TimelineEvent& event);
+    static QJsonObject serializeEvent(const TimelineEvent& event, bool includeAttachments = true);
 
     /**
      * @brief Deserialize a single event from JSON
+     * @param restoreAttachments If false, attachment records are skipped (read-only snapshots)
+     * @param attachmentRegistry If set, attachment records are collected here for
+     *        AttachmentManager::importRegistry() instead of being installed one event at a time
+     */
+    static TimelineEvent deserializeEvent(const QJsonObject& json,
+                                          bool restoreAttachments = true,
+                                          QHash<int, QJsonArray>* attachmentRegistry = nullptr);
+
+    /**
+     * @brief Get default save location for timeline data
+     * @return Full path to default timeline file
+     */
+    static QString getDefaultSaveLocation();
+
+    /**
+     * @brief Create backup of existing file
+     * @param filePath Original file path
+     * @return true if backup created successfully
      */
-    static TimelineEvent deserializeEvent(const QJsonObject& json);
+    static bool createBackup(const QString& filePath);
 
+private:
     /**
      * @brief Convert event type enum to string
      */
@@ -72,6 +72,46 @@ void TimelineSettings::setAutoSaveEnabled(bool enabled)
     settings_.setValue("AutoSave/Enabled", enabled);
 }
 
+
+int TimelineSettings::shardPeriodMonths() const
+{
+    // Monthly or quarterly - anything else would not line up with shard keys
+    return settings_.value("Storage/ShardPeriodMonths", DEFAULT_SHARD_PERIOD_MONTHS).toInt() == 3 ? 3 : 1;
+}
+
+
+void TimelineSettings::setShardPeriodMonths(int months)
+{
+    settings_.setValue("Storage/ShardPeriodMonths", months == 3 ? 3 : 1);
+}
+
+// ============================================================================
+// Live Session Preferences
+// ============================================================================
+
+int TimelineSettings::syncPort() const
+{
+    return settings_.value("Sync/Port", DEFAULT_SYNC_PORT).toInt();
+}
+
+
+void TimelineSettings::setSyncPort(int port)
+{
+    settings_.setValue("Sync/Port", port);
+}
+
+
+QString TimelineSettings::syncLastAddress() const
+{
+    return settings_.value("Sync/LastAddress", QString("127.0.0.1:%1").arg(DEFAULT_SYNC_PORT)).toString();
+}
+
+
+void TimelineSettings::setSyncLastAddress(const QString& address)
+{
+    settings_.setValue("Sync/LastAddress", address);
+}
+
 // ============================================================================
 // View Preferences
 // ============================================================================
@@ -111,6 +151,30 @@ void TimelineSettings::setSidePanelVisible(bool visible)
     settings_.setValue("View/SidePanelVisible", visible);
 }
 
+
+int TimelineSettings::laneMinGapPixels() const
+{
+    return settings_.value("View/LaneMinGapPixels", DEFAULT_LANE_MIN_GAP_PIXELS).toInt();
+}
+
+
+void TimelineSettings::setLaneMinGapPixels(int pixels)
+{
+    settings_.setValue("View/LaneMinGapPixels", qMax(0, pixels));
+}
+
+
+int TimelineSettings::swimlaneGrouping() const
+{
+    return settings_.value("View/SwimlaneGrouping", DEFAULT_SWIMLANE_GROUPING).toInt();
+}
+
+
+void TimelineSettings::setSwimlaneGrouping(int grouping)
+{
+    settings_.setValue("View/SwimlaneGrouping", grouping);
+}
+
 // ============================================================================
 // Scroll-to-Date Preferences
 // ============================================================================
@@ -222,9 +286,14 @@ void TimelineSettings::resetToDefaults()
     setUseSoftDelete(DEFAULT_USE_SOFT_DELETE);
     setAutoSaveInterval(DEFAULT_AUTOSAVE_INTERVAL);
     setAutoSaveEnabled(DEFAULT_AUTOSAVE_ENABLED);
+    setShardPeriodMonths(DEFAULT_SHARD_PERIOD_MONTHS);
+    setSyncPort(DEFAULT_SYNC_PORT);
+    setSyncLastAddress(QString("127.0.0.1:%1").arg(DEFAULT_SYNC_PORT));
     setDefaultPixelsPerDay(DEFAULT_PIXELS_PER_DAY);
     setSidePanelWidth(DEFAULT_SIDE_PANEL_WIDTH);
     setSidePanelVisible(DEFAULT_SIDE_PANEL_VISIBLE);
+    setLaneMinGapPixels(DEFAULT_LANE_MIN_GAP_PIXELS);
+    setSwimlaneGrouping(DEFAULT_SWIMLANE_GROUPING);
     setScrollAnimationEnabled(DEFAULT_SCROLL_ANIMATION_ENABLED);
     setScrollHighlightEnabled(DEFAULT_SCROLL_HIGHLIGHT_ENABLED);
     setScrollHighlightRange(DEFAULT_SCROLL_HIGHLIGHT_RANGE);
@@ -312,3 +381,38 @@ void TimelineSettings::setSidePanelFilterTypes(const QSet<TimelineEventType>& ty
     }
     settings_.setValue("SidePanel/FilterTypes", typeStrings);
 }
+
+// ============================================================================
+// Session Restore
+// ============================================================================
+
+TimelineSessionState TimelineSettings::sessionState() const
+{
+    TimelineSessionState state;
+    state.projectPath = settings_.value("Session/ProjectPath").toString();
+    state.pixelsPerDay = settings_.value("Session/PixelsPerDay", 0.0).toDouble();
+    state.centerDateTime = QDateTime::fromString(settings_.value("Session/CenterDateTime").toString(), Qt::ISODate);
+    state.centerY = settings_.value("Session/CenterY", 0.0).toDouble();
+    state.visibleStartDate = QDate::fromString(settings_.value("Session/VisibleStart").toString(), Qt::ISODate);
+    state.visibleEndDate = QDate::fromString(settings_.value("Session/VisibleEnd").toString(), Qt::ISODate);
+    state.firstVisibleLane = settings_.value("Session/FirstVisibleLane", 0).toInt();
+    state.lastVisibleLane = settings_.value("Session/LastVisibleLane", -1).toInt();
+    state.selectedEventIds = settings_.value("Session/SelectedEvents").toStringList();
+    state.sidePanelTab = settings_.value("Session/SidePanelTab", 0).toInt();
+    return state;
+}
+
+
+void TimelineSettings::setSessionState(const TimelineSessionState& state)
+{
+    settings_.setValue("Session/ProjectPath", state.projectPath);
+    settings_.setValue("Session/PixelsPerDay", state.pixelsPerDay);
+    settings_.setValue("Session/CenterDateTime", state.centerDateTime.toString(Qt::ISODate));
+    settings_.setValue("Session/CenterY", state.centerY);
+    settings_.setValue("Session/VisibleStart", state.visibleStartDate.toString(Qt::ISODate));
+    settings_.setValue("Session/VisibleEnd", state.visibleEndDate.toString(Qt::ISODate));
+    settings_.setValue("Session/FirstVisibleLane", state.firstVisibleLane);
+    settings_.setValue("Session/LastVisibleLane", state.lastVisibleLane);
+    settings_.setValue("Session/SelectedEvents", state.selectedEventIds);
+    settings_.setValue("Session/SidePanelTab", state.sidePanelTab);
+}
@@ -5,6 +5,28 @@
 #include <QSettings>
 #include <QString>
 #include <QDate>
+#include <QDateTime>
+#include <QStringList>
+
+/**
+ * @struct TimelineSessionState
+ * @brief Where the user left off, restored at the next launch
+ */
+struct TimelineSessionState
+{
+    QString projectPath;                ///< Open project (empty if none was saved to a file)
+    double pixelsPerDay = 0.0;          ///< Zoom level (0 = not saved)
+    QDateTime centerDateTime;           ///< Date/time at the horizontal viewport center
+    double centerY = 0.0;               ///< Scene Y at the viewport center
+    QDate visibleStartDate;             ///< Visible date range, used to publish on-screen events first
+    QDate visibleEndDate;
+    int firstVisibleLane = 0;
+    int lastVisibleLane = -1;
+    QStringList selectedEventIds;
+    int sidePanelTab = 0;
+
+    bool hasViewport() const { return pixelsPerDay > 0.0 && centerDateTime.isValid(); }
+};
 
 /**
  * @class TimelineSettings
@@ -29,6 +51,16 @@ public:
     bool autoSaveEnabled() const;
     void setAutoSaveEnabled(bool enabled);
 
+    // Storage Preferences
+    int shardPeriodMonths() const;                  ///< Months per shard for new sharded projects (1 or 3)
+    void setShardPeriodMonths(int months);
+
+    // Live Session Preferences
+    int syncPort() const;                           ///< Port a hosted relay listens on
+    void setSyncPort(int port);
+    QString syncLastAddress() const;                ///< "host:port" last joined
+    void setSyncLastAddress(const QString& address);
+
     // View Preferences
     double defaultPixelsPerDay() const;
     void setDefaultPixelsPerDay(double pixelsPerDay);
@@ -36,6 +68,10 @@ public:
     void setSidePanelWidth(int width);
     bool sidePanelVisible() const;
     void setSidePanelVisible(bool visible);
+    int laneMinGapPixels() const;                   ///< Minimum on-screen gap between timed events sharing a lane
+    void setLaneMinGapPixels(int pixels);
+    int swimlaneGrouping() const;                   ///< SwimlaneGrouping value (0 = ungrouped)
+    void setSwimlaneGrouping(int grouping);
 
     // Scroll-to-Date Preferences
     bool scrollAnimationEnabled() const;
@@ -69,6 +105,10 @@ public:
     QSet<TimelineEventType> sidePanelFilterTypes() const;
     void setSidePanelFilterTypes(const QSet<TimelineEventType>& types);
 
+    // Session Restore
+    TimelineSessionState sessionState() const;
+    void setSessionState(const TimelineSessionState& state);
+
     // In the private section, add default values:
     static constexpr int DEFAULT_SORT_MODE = 0; // ByDate
 
@@ -85,9 +125,13 @@ private:
     static constexpr bool DEFAULT_USE_SOFT_DELETE = true;
     static constexpr int DEFAULT_AUTOSAVE_INTERVAL = 300000;
     static constexpr bool DEFAULT_AUTOSAVE_ENABLED = true;
+    static constexpr int DEFAULT_SHARD_PERIOD_MONTHS = 1;
+    static constexpr int DEFAULT_SYNC_PORT = 47800;
     static constexpr double DEFAULT_PIXELS_PER_DAY = 20.0;
     static constexpr int DEFAULT_SIDE_PANEL_WIDTH = 350;
     static constexpr bool DEFAULT_SIDE_PANEL_VISIBLE = true;
+    static constexpr int DEFAULT_LANE_MIN_GAP_PIXELS = 4;
+    static constexpr int DEFAULT_SWIMLANE_GROUPING = 0; // None
     static constexpr bool DEFAULT_SCROLL_ANIMATION_ENABLED = true;
     static constexpr bool DEFAULT_SCROLL_HIGHLIGHT_ENABLED = false;
     static constexpr int DEFAULT_SCROLL_HIGHLIGHT_RANGE = 7;
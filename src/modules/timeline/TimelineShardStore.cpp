@@ -0,0 +1,531 @@
+// TimelineShardStore.cpp
+
+
+#include "../../shared/models/AttachmentModel.h"
+#include "TimelineShardStore.h"
+#include "TimelineSettings.h"
+#include <QThread>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QDebug>
+#include <algorithm>
+#include <utility>
+
+
+TimelineShardStore::TimelineShardStore(TimelineModel* model, QObject* parent)
+    : QObject(parent)
+    , model_(model)
+{
+}
+
+
+TimelineShardStore::~TimelineShardStore()
+{
+    cancelRequested_ = true;
+
+    if (worker_)
+    {
+        worker_->wait();
+    }
+}
+
+
+bool TimelineShardStore::isShardedPath(const QString& filePath)
+{
+    return QFileInfo(filePath).suffix().compare("tlproj", Qt::CaseInsensitive) == 0;
+}
+
+
+void TimelineShardStore::stopLoad()
+{
+    // The worker reads shards_, so it has to be gone before the GUI thread changes it
+    if (worker_)
+    {
+        cancelRequested_ = true;
+        worker_->wait();
+        worker_ = nullptr;
+        cancelRequested_ = false;
+    }
+
+    ++session_;     // Drops the result still queued by a stopped worker
+    pendingFrom_ = QDate();
+    pendingTo_ = QDate();
+}
+
+
+void TimelineShardStore::reset()
+{
+    stopLoad();
+
+    manifestPath_.clear();
+    periodMonths_ = 1;
+    shards_.clear();
+}
+
+
+void TimelineShardStore::attach(const QString& manifestPath, const TimelineProjectData& project)
+{
+    reset();
+
+    manifestPath_ = manifestPath;
+    periodMonths_ = project.manifest.periodMonths;
+
+    for (const TimelineShardInfo& info : project.manifest.shards)
+    {
+        shards_[info.key].info = info;
+    }
+
+    for (const QString& key : project.loadedShards)
+    {
+        shards_[key].loaded = true;
+    }
+
+    // File contents by shard, to notice events that later move or disappear
+    auto remember = [this](const TimelineEvent& event)
+    {
+        auto it = shards_.find(TimelineSerializer::shardKeyFor(event, periodMonths_));
+        if (it != shards_.end() && it->loaded)
+        {
+            it->eventIds.insert(event.id);
+        }
+    };
+
+    for (const TimelineEvent& event : project.events)
+    {
+        remember(event);
+    }
+    for (const TimelineEvent& event : project.archivedEvents)
+    {
+        remember(event);
+    }
+}
+
+
+void TimelineShardStore::markLoadedClean()
+{
+    const quint64 generation = model_->generation();
+
+    for (ShardState& state : shards_)
+    {
+        if (state.loaded)
+        {
+            state.cleanGeneration = generation;
+        }
+    }
+}
+
+
+int TimelineShardStore::loadedShardCount() const
+{
+    return static_cast<int>(std::count_if(shards_.cbegin(), shards_.cend(),
+                                          [](const ShardState& state) { return state.loaded; }));
+}
+
+
+QStringList TimelineShardStore::unloadedKeys(const QDate& from, const QDate& to) const
+{
+    const bool everything = !from.isValid() || !to.isValid();
+    QStringList keys;
+
+    for (auto it = shards_.cbegin(); it != shards_.cend(); ++it)
+    {
+        if (!it->loaded && (everything || it->info.overlaps(from, to)))
+        {
+            keys.append(it.key());
+        }
+    }
+
+    return keys;
+}
+
+
+void TimelineShardStore::ensureLoaded(const QDate& from, const QDate& to)
+{
+    if (!isActive())
+    {
+        return;
+    }
+
+    // One load at a time; the newest range is picked up when it finishes
+    if (worker_)
+    {
+        pendingFrom_ = from;
+        pendingTo_ = to;
+        return;
+    }
+
+    const QStringList keys = unloadedKeys(from, to);
+    if (!keys.isEmpty())
+    {
+        startLoad(keys);
+    }
+}
+
+
+bool TimelineShardStore::loadAll(QString* errorString)
+{
+    if (!isActive())
+    {
+        return true;
+    }
+
+    const QStringList keys = unloadedKeys(QDate(), QDate());
+    if (keys.isEmpty())
+    {
+        return true;
+    }
+
+    stopLoad();
+
+    TimelineProjectData data;
+    if (!readShards(keys, data, errorString))
+    {
+        return false;
+    }
+
+    applyLoaded(data, keys);
+    return true;
+}
+
+
+void TimelineShardStore::startLoad(const QStringList& keys)
+{
+    cancelRequested_ = false;
+
+    const quint64 session = session_;
+
+    QThread* thread = QThread::create([this, keys, session]()
+    {
+        TimelineProjectData data;
+        QString errorString;
+        const bool ok = readShards(keys, data, &errorString);
+
+        // Apply on the GUI thread
+        QMetaObject::invokeMethod(this, [this, keys, session, ok, data, errorString]()
+        {
+            // The project was closed, replaced or saved while reading
+            if (session != session_)
+            {
+                return;
+            }
+
+            worker_ = nullptr;
+
+            if (!ok)
+            {
+                emit shardLoadFailed(errorString);
+                return;
+            }
+
+            applyLoaded(data, keys);
+            emit shardsLoaded(keys.size(), data.events.size());
+
+            if (pendingFrom_.isValid())
+            {
+                const QDate from = std::exchange(pendingFrom_, QDate());
+                const QDate to = std::exchange(pendingTo_, QDate());
+                ensureLoaded(from, to);
+            }
+        }, Qt::QueuedConnection);
+    });
+
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+
+    worker_ = thread;
+    worker_->start();
+}
+
+
+bool TimelineShardStore::readShards(const QStringList& keys, TimelineProjectData& data, QString* errorString) const
+{
+    // Runs on the worker thread: shards_ is only written on the GUI thread, and never while a load is running
+    const QDir shardDir(TimelineSerializer::shardDirectory(manifestPath_));
+
+    for (const QString& key : keys)
+    {
+        if (cancelRequested_)
+        {
+            return false;
+        }
+
+        const TimelineShardInfo& info = shards_.value(key).info;
+        if (!TimelineSerializer::readShard(shardDir.filePath(info.fileName), info, data, errorString))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void TimelineShardStore::applyLoaded(const TimelineProjectData& data, const QStringList& keys)
+{
+    applying_ = true;
+
+    // IDs already in the model (events moved into an unloaded period and saved there) keep the live copy
+    QSet<QString> archivedIds;
+    for (const TimelineEvent& event : model_->getAllArchivedEvents())
+    {
+        archivedIds.insert(event.id);
+    }
+
+    QVector<TimelineEvent> archived;
+    for (const TimelineEvent& event : data.archivedEvents)
+    {
+        if (!archivedIds.contains(event.id))
+        {
+            archived.append(event);
+        }
+    }
+
+    // Same defaults as a project opened by TimelineProjectLoader
+    QVector<TimelineEvent> events = data.events;
+    for (TimelineEvent& event : events)
+    {
+        if (!event.color.isValid())
+        {
+            event.color = TimelineModel::colorForType(event.type);
+        }
+    }
+
+    model_->addEvents(events);              // One relayout for the whole batch; duplicates are skipped
+    model_->addArchivedEvents(archived);
+    AttachmentManager::instance().mergeRegistry(data.attachmentRegistry);
+
+    applying_ = false;
+
+    const quint64 generation = model_->generation();
+    for (const QString& key : keys)
+    {
+        ShardState& state = shards_[key];
+        state.loaded = true;
+        state.cleanGeneration = generation;
+        state.eventIds.clear();
+    }
+
+    for (const QVector<TimelineEvent>* list : { &data.events, &data.archivedEvents })
+    {
+        for (const TimelineEvent& event : *list)
+        {
+            auto it = shards_.find(TimelineSerializer::shardKeyFor(event, periodMonths_));
+            if (it != shards_.end() && keys.contains(it.key()))
+            {
+                it->eventIds.insert(event.id);
+            }
+        }
+    }
+
+    qDebug() << "TimelineShardStore: Loaded" << keys.size() << "shard(s) with"
+             << data.events.size() << "events," << loadedShardCount() << "of" << shards_.size() << "shards in memory";
+}
+
+
+bool TimelineShardStore::save(const QString& manifestPath, QString* errorString)
+{
+    const QString previousProjectDirectory = AttachmentManager::instance().projectDirectory();
+
+    auto fail = [errorString, &previousProjectDirectory](const QString& message)
+    {
+        AttachmentManager::instance().setProjectDirectory(previousProjectDirectory);
+        if (errorString)
+        {
+            *errorString = message;
+        }
+        qWarning() << "TimelineShardStore:" << message;
+        return false;
+    };
+
+    stopLoad();
+
+    const bool samePath = isActive()
+                          && QFileInfo(manifestPath).absoluteFilePath() == QFileInfo(manifestPath_).absoluteFilePath();
+
+    if (!samePath)
+    {
+        // A new location gets every shard, so the whole history has to be in memory once
+        if (!loadAll(errorString))
+        {
+            return false;
+        }
+    }
+
+    // The new state is built aside and only adopted once the manifest is on disk, so a
+    // failed save (or save-as) leaves the store describing the project it had
+    const QString targetPath = samePath ? manifestPath_ : manifestPath;
+    const int periodMonths = isActive() ? periodMonths_ : TimelineSettings::instance().shardPeriodMonths();
+    QMap<QString, ShardState> shards = samePath ? shards_ : QMap<QString, ShardState>();
+
+    // ========== BUCKET THE MODEL BY SHARD ==========
+    struct Bucket
+    {
+        QVector<TimelineEvent> events;
+        QVector<TimelineEvent> archived;
+        QSet<QString> ids;
+        quint64 maxRevision = 0;
+        QDate lastEnd;
+    };
+
+    QMap<QString, Bucket> buckets;
+
+    auto add = [&](const TimelineEvent& event, bool isArchived)
+    {
+        Bucket& bucket = buckets[TimelineSerializer::shardKeyFor(event, periodMonths)];
+        (isArchived ? bucket.archived : bucket.events).append(event);
+        bucket.ids.insert(event.id);
+        bucket.maxRevision = std::max(bucket.maxRevision, event.revision);
+        if (event.endDate.isValid() && (!bucket.lastEnd.isValid() || event.endDate.date() > bucket.lastEnd))
+        {
+            bucket.lastEnd = event.endDate.date();
+        }
+    };
+
+    for (const TimelineEvent& event : model_->getAllEvents())
+    {
+        add(event, false);
+    }
+    for (const TimelineEvent& event : model_->getAllArchivedEvents())
+    {
+        add(event, true);
+    }
+
+    // Events moved into a period that was never loaded: that shard's file has to be merged in first
+    QStringList mergeKeys;
+    for (auto it = buckets.cbegin(); it != buckets.cend(); ++it)
+    {
+        auto state = shards.constFind(it.key());
+        if (state != shards.cend() && !state->loaded)
+        {
+            mergeKeys.append(it.key());
+        }
+    }
+
+    if (!mergeKeys.isEmpty())
+    {
+        // Only those periods are read - the rest of the history stays on disk
+        TimelineProjectData data;
+        if (!readShards(mergeKeys, data, errorString))
+        {
+            return false;
+        }
+        applyLoaded(data, mergeKeys);
+        return save(manifestPath, errorString);     // Re-bucket with the merged events
+    }
+
+    // ========== WRITE DIRTY SHARDS ==========
+    const QString shardDirPath = TimelineSerializer::shardDirectory(targetPath);
+    if (!QDir().mkpath(shardDirPath))
+    {
+        return fail(QString("Cannot create shard directory %1").arg(shardDirPath));
+    }
+    const QDir shardDir(shardDirPath);
+
+    // Attachment paths are stored relative to the project directory
+    AttachmentManager::instance().setProjectDirectory(QFileInfo(targetPath).absolutePath());
+
+    const quint64 generation = model_->generation();
+    QStringList obsoleteFiles;
+    int written = 0;
+
+    QStringList keys = buckets.keys();
+    for (auto it = shards.cbegin(); it != shards.cend(); ++it)
+    {
+        if (!buckets.contains(it.key()))
+        {
+            keys.append(it.key());
+        }
+    }
+
+    for (const QString& key : keys)
+    {
+        const bool known = shards.contains(key);
+        ShardState& state = shards[key];
+        const Bucket bucket = buckets.value(key);
+
+        if (known && !state.loaded)
+        {
+            continue;   // History that was never opened is never rewritten
+        }
+
+        if (bucket.ids.isEmpty())
+        {
+            // Everything in this period was deleted or moved out
+            if (!state.info.fileName.isEmpty())
+            {
+                obsoleteFiles.append(state.info.fileName);
+            }
+            shards.remove(key);
+            continue;
+        }
+
+        const bool dirty = !known || bucket.ids != state.eventIds || bucket.maxRevision > state.cleanGeneration;
+        if (dirty)
+        {
+            const QByteArray data = TimelineSerializer::serializeShard(key, bucket.events, bucket.archived);
+            const QString checksum = TimelineSerializer::checksumOf(data);
+
+            // Lane and attachment restamps often leave the bytes unchanged
+            if (!known || checksum != state.info.checksum)
+            {
+                TimelineShardInfo info = TimelineSerializer::shardInfoForKey(key, periodMonths);
+                info.fileName = QString("%1.%2.json").arg(key, checksum.left(12));
+
+                QSaveFile file(shardDir.filePath(info.fileName));
+                if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+                {
+                    return fail(QString("Failed to write shard %1: %2").arg(key, file.errorString()));
+                }
+
+                if (known && state.info.fileName != info.fileName)
+                {
+                    obsoleteFiles.append(state.info.fileName);
+                }
+
+                info.checksum = checksum;
+                state.info = info;
+                ++written;
+            }
+        }
+
+        state.info.eventCount = bucket.events.size();
+        state.info.archivedCount = bucket.archived.size();
+        state.info.lastEnd = bucket.lastEnd;
+        state.loaded = true;
+        state.cleanGeneration = generation;
+        state.eventIds = bucket.ids;
+    }
+
+    // ========== MANIFEST ==========
+    TimelineShardManifest manifest;
+    manifest.periodMonths = periodMonths;
+    for (const ShardState& state : shards)
+    {
+        manifest.shards.append(state.info);
+    }
+
+    const QByteArray manifestData = QJsonDocument(TimelineSerializer::serializeManifest(model_, manifest)).toJson(QJsonDocument::Indented);
+
+    QSaveFile manifestFile(targetPath);
+    if (!manifestFile.open(QIODevice::WriteOnly | QIODevice::Text)
+        || manifestFile.write(manifestData) != manifestData.size()
+        || !manifestFile.commit())
+    {
+        return fail(QString("Failed to write manifest: %1").arg(manifestFile.errorString()));
+    }
+
+    // Replaced shard files are only dropped once the new manifest no longer points at them
+    for (const QString& fileName : std::as_const(obsoleteFiles))
+    {
+        QFile::remove(shardDir.filePath(fileName));
+    }
+
+    shards_ = std::move(shards);
+    manifestPath_ = targetPath;
+    periodMonths_ = periodMonths;
+
+    qDebug() << "TimelineShardStore: Saved" << manifestPath_ << "-" << written << "of" << shards_.size() << "shards written";
+    return true;
+}
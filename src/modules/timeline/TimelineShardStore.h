@@ -0,0 +1,91 @@
+// TimelineShardStore.h
+
+
+#pragma once
+#include "TimelineSerializer.h"
+#include <QObject>
+#include <QMap>
+#include <QSet>
+#include <atomic>
+
+
+class QThread;
+
+
+/**
+ * @class TimelineShardStore
+ * @brief Tracks which shards of a sharded project are in the model, loads more on demand and saves dirty ones
+ *
+ * A sharded project (*.tlproj) is a small manifest plus one file per month or quarter
+ * (see TimelineSerializer). TimelineProjectLoader reads only the shards around the
+ * version dates; ensureLoaded() reads further shards on a worker thread as the view
+ * moves and adds them to the model in one batch.
+ *
+ * save() rewrites only shards whose events changed since they were loaded or last
+ * saved: a shard is a candidate if its set of event IDs changed or any of its events
+ * carries a newer model revision, and a candidate is written only if its bytes
+ * differ. Shard files are named after their checksum and the old file is removed
+ * after the manifest is replaced, so an interrupted save leaves the previous
+ * manifest and its shards intact.
+ */
+class TimelineShardStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimelineShardStore(TimelineModel* model, QObject* parent = nullptr);
+    ~TimelineShardStore() override;
+
+    static bool isShardedPath(const QString& filePath);                     ///< Whether a path uses the sharded layout (*.tlproj)
+
+    void reset();                                                           ///< Forget the current project (single-file project or closed)
+    void attach(const QString& manifestPath, const TimelineProjectData& project);   ///< Adopt a sharded project opened by TimelineProjectLoader
+    void markLoadedClean();                                                 ///< Loaded shards match their files as of now (after publishing)
+
+    bool isActive() const { return !manifestPath_.isEmpty(); }              ///< A sharded project is open
+    QString manifestPath() const { return manifestPath_; }
+    bool isLoading() const { return worker_ != nullptr; }                   ///< Shards are being read in the background
+    bool isApplying() const { return applying_; }                           ///< Loaded shards are being added to the model (not a user edit)
+    int shardCount() const { return shards_.size(); }
+    int loadedShardCount() const;
+
+    void ensureLoaded(const QDate& from, const QDate& to);                  ///< Load the shards overlapping [from, to] in the background (latest request wins)
+    bool loadAll(QString* errorString = nullptr);                           ///< Load every remaining shard now (before writing the whole project elsewhere)
+
+    /**
+     * @brief Write dirty shards and the manifest
+     * @param manifestPath Target manifest; a different path than the open one writes every shard
+     * @param errorString Receives the reason for a failure
+     */
+    bool save(const QString& manifestPath, QString* errorString = nullptr);
+
+signals:
+    void shardsLoaded(int shardCount, int eventCount);      ///< On-demand shards were added to the model
+    void shardLoadFailed(const QString& errorString);       ///< A shard could not be read (missing or failed its checksum)
+
+private:
+    struct ShardState
+    {
+        TimelineShardInfo info;             ///< Manifest entry as last read or written
+        bool loaded = false;                ///< Events are in the model
+        quint64 cleanGeneration = 0;        ///< Model generation when the shard last matched its file
+        QSet<QString> eventIds;             ///< Active and archived IDs in the file (loaded shards only)
+    };
+
+    QStringList unloadedKeys(const QDate& from, const QDate& to) const;    ///< Invalid dates = every unloaded shard
+    void startLoad(const QStringList& keys);
+    void stopLoad();                                                        ///< Wait for a running load and drop its result
+    bool readShards(const QStringList& keys, TimelineProjectData& data, QString* errorString) const;
+    void applyLoaded(const TimelineProjectData& data, const QStringList& keys);
+
+    TimelineModel* model_;                          ///< Model the shards are loaded into (not owned)
+    QString manifestPath_;                          ///< Open manifest (empty = no sharded project)
+    int periodMonths_ = 1;                          ///< Shard length of the open project
+    QMap<QString, ShardState> shards_;              ///< Shards by key
+    QThread* worker_ = nullptr;                     ///< Running load (nullptr when idle)
+    std::atomic_bool cancelRequested_ { false };    ///< Polled by the worker between shards
+    quint64 session_ = 0;                           ///< Bumped by reset()/attach() so stale loads are dropped
+    QDate pendingFrom_;                             ///< Range requested while a load was running
+    QDate pendingTo_;
+    bool applying_ = false;
+};
@@ -5,6 +5,7 @@
 #include "ui_TimelineSidePanel.h"
 #include "TimelineCommands.h"
 #include "AttachmentListWidget.h"
+#include "EventDetailsRenderer.h"
 #include "TimelineModel.h"
 #include "TimelineView.h"
 #include "TimelineSettings.h"
@@ -43,6 +44,7 @@
 #include <QToolTip>
 #include <QScrollArea>
 #include <QShortcut>
+#include <QTimer>
 
 
 TimelineSidePanel::TimelineSidePanel(TimelineModel* model, TimelineView* view, QWidget* parent)
@@ -54,6 +56,8 @@ TimelineSidePanel::TimelineSidePanel(TimelineModel* model, TimelineView* view, Q
 {
     ui->setupUi(this);
 
+    detailsRenderer_ = new EventDetailsRenderer(this);
+
     // Robust edit-mode shortcuts (work even when child widgets have focus)
     saveShortcut_ = new QShortcut(QKeySequence::Save, this);
     saveShortcut_->setContext(Qt::WidgetWithChildrenShortcut);
@@ -279,8 +283,7 @@ void TimelineSidePanel::refreshAttachmentsForCurrentEvent()
     }
 
     attachmentsWidget_->setVisible(true);
-    attachmentsWidget_->setEventId(currentEventId_);
-    attachmentsWidget_->refresh();
+    attachmentsWidget_->setEventId(currentEventId_);   // Refreshes the list
 
     if (count <= 0)
     {
@@ -1216,9 +1219,14 @@ void TimelineSidePanel::connectSignals()
     connect(model_, &TimelineModel::eventAdded, this, &TimelineSidePanel::onEventAdded);
     connect(model_, &TimelineModel::eventRemoved, this, &TimelineSidePanel::onEventRemoved);
     connect(model_, &TimelineModel::eventUpdated, this, &TimelineSidePanel::onEventUpdated);
+    connect(model_, &TimelineModel::eventsUpdated, this, &TimelineSidePanel::scheduleRefreshAllTabs);
     connect(model_, &TimelineModel::lanesRecalculated, this, &TimelineSidePanel::onLanesRecalculated);
     connect(model_, &TimelineModel::eventArchived, this, &TimelineSidePanel::onEventRemoved);
     connect(model_, &TimelineModel::eventRestored, this, &TimelineSidePanel::onEventAdded);
+    connect(model_, &TimelineModel::eventsAdded, this, &TimelineSidePanel::scheduleRefreshAllTabs);
+    connect(model_, &TimelineModel::eventsRemoved, this, &TimelineSidePanel::scheduleRefreshAllTabs);
+    connect(model_, &TimelineModel::eventsArchived, this, &TimelineSidePanel::scheduleRefreshAllTabs);
+    connect(model_, &TimelineModel::eventsRestored, this, &TimelineSidePanel::scheduleRefreshAllTabs);
 
     // Connect to list widget click signals
     connect(ui->allEventsList, &QListWidget::itemClicked, this, &TimelineSidePanel::onAllEventsItemClicked);
@@ -1230,7 +1238,57 @@ void TimelineSidePanel::connectSignals()
     connect(ui->lookaheadList, &QListWidget::itemSelectionChanged, this, &TimelineSidePanel::onListSelectionChanged);
     connect(ui->todayList, &QListWidget::itemSelectionChanged, this, &TimelineSidePanel::onListSelectionChanged);
 
+    // Connect current item signals (arrow-key navigation)
+    connect(ui->allEventsList, &QListWidget::currentItemChanged, this, &TimelineSidePanel::onListCurrentItemChanged);
+    connect(ui->lookaheadList, &QListWidget::currentItemChanged, this, &TimelineSidePanel::onListCurrentItemChanged);
+    connect(ui->todayList, &QListWidget::currentItemChanged, this, &TimelineSidePanel::onListCurrentItemChanged);
+
     connect(model_, &TimelineModel::eventAttachmentsChanged, this, &TimelineSidePanel::onEventAttachmentsChanged);
+    connect(model_, &TimelineModel::eventAttachmentsReset, this, &TimelineSidePanel::refreshAttachmentsForCurrentEvent);
+}
+
+
+int TimelineSidePanel::currentTab() const
+{
+    return ui->tabWidget->currentIndex();
+}
+
+
+void TimelineSidePanel::setCurrentTab(int index)
+{
+    if (index >= 0 && index < ui->tabWidget->count())
+    {
+        ui->tabWidget->setCurrentIndex(index);
+    }
+}
+
+
+void TimelineSidePanel::scheduleRefreshAllTabs()
+{
+    if (!refreshThrottleTimer_)
+    {
+        refreshThrottleTimer_ = new QTimer(this);
+        refreshThrottleTimer_->setSingleShot(true);
+        refreshThrottleTimer_->setInterval(250);
+        connect(refreshThrottleTimer_, &QTimer::timeout, this, [this]() {
+            if (refreshPending_)
+            {
+                refreshPending_ = false;
+                refreshAllTabs();
+                refreshThrottleTimer_->start();
+            }
+        });
+    }
+
+    // First batch refreshes immediately; batches within the cooldown collapse into one refresh
+    if (refreshThrottleTimer_->isActive())
+    {
+        refreshPending_ = true;
+        return;
+    }
+
+    refreshAllTabs();
+    refreshThrottleTimer_->start();
 }
 
 
@@ -2051,9 +2109,7 @@ void TimelineSidePanel::updateLookaheadTabLabel()
 
 void TimelineSidePanel::updateAllEventsTabLabel()
 {
-    QVector<TimelineEvent> events = model_->getAllEvents();
-
-    QString label = QString("All Events (%1)").arg(events.size());
+    QString label = QString("All Events (%1)").arg(model_->eventCount());
 
     ui->tabWidget->setTabText(2, label);
 }
@@ -2061,12 +2117,26 @@ void TimelineSidePanel::updateAllEventsTabLabel()
 
 void TimelineSidePanel::refreshAllTabs()
 {
+    refreshedGeneration_ = model_->generation();
+
     refreshAllEventsTab();
     refreshLookaheadTab();
     refreshTodayTab();
 }
 
 
+void TimelineSidePanel::refreshAllTabsIfModelChanged()
+{
+    // A single model change arrives as several signals (lanesRecalculated, then eventAdded/Updated/...)
+    if (model_->generation() == refreshedGeneration_)
+    {
+        return;
+    }
+
+    refreshAllTabs();
+}
+
+
 void TimelineSidePanel::refreshTodayTab()
 {
     QDate targetDate = TimelineSettings::instance().todayTabUseCustomDate()
@@ -2143,26 +2213,32 @@ void TimelineSidePanel::populateListWidget(QListWidget* listWidget, const QVecto
 
 QListWidgetItem* TimelineSidePanel::createListItem(const TimelineEvent& event)
 {
+    // Text and tooltip only change with the event, so reuse them across tab refreshes
+    const ListItemText itemText = listItemTextMemo_.value(event.id, event.revision, [&]()
+    {
+        QString tooltip = QString("%1\n%2\nPriority: %3\nLane: %4")
+                              .arg(event.title)
+                              .arg(formatEventDateRange(event))
+                              .arg(event.priority)
+                              .arg(event.lane);
+
+        if (!event.description.isEmpty())
+        {
+            tooltip += "\n\n" + event.description;
+        }
+
+        return ListItemText{formatEventText(event), tooltip};
+    });
+
     auto item = new QListWidgetItem();
-    item->setText(formatEventText(event));
+    item->setText(itemText.text);
     item->setData(Qt::UserRole, event.id);
 
     QPixmap colorPixmap(16, 16);
     colorPixmap.fill(event.color);
     item->setIcon(QIcon(colorPixmap));
 
-    QString tooltip = QString("%1\n%2\nPriority: %3\nLane: %4")
-                          .arg(event.title)
-                          .arg(formatEventDateRange(event))
-                          .arg(event.priority)
-                          .arg(event.lane);
-
-    if (!event.description.isEmpty())
-    {
-        tooltip += "\n\n" + event.description;
-    }
-
-    item->setToolTip(tooltip);
+    item->setToolTip(itemText.toolTip);
     return item;
 }
 
@@ -2268,568 +2344,69 @@ void TimelineSidePanel::displayEventDetails(const QString& eventId)
     // Clear previous type-specific content
     clearTypeSpecificFields();
 
-    // Build details text starting with description, then type-specific info
-    QString detailsText;
-
-    // Description First (Common to all types)
-    if (!event->description.isEmpty())
-    {
-        detailsText = QString("<b>Description:</b><br>%1").arg(event->description);
-    }
-
-    // Type-Specific Fields
-    QString typeSpecificDetails;
-
-    switch (event->type)
-    {
-    case TimelineEventType_Meeting:     typeSpecificDetails = buildMeetingDetails(*event);      break;
-    case TimelineEventType_Action:      typeSpecificDetails = buildActionDetails(*event);       break;
-    case TimelineEventType_TestEvent:   typeSpecificDetails = buildTestEventDetails(*event);    break;
-    case TimelineEventType_Reminder:    typeSpecificDetails = buildReminderDetails(*event);     break;
-    case TimelineEventType_JiraTicket:  typeSpecificDetails = buildJiraTicketDetails(*event);   break;
-    default:                            typeSpecificDetails = buildGenericDetails(*event);      break;
-    }
-
-    // Combine description and type-specific details with proper spacing
-    if (!typeSpecificDetails.isEmpty())
-    {
-        if (!detailsText.isEmpty())
-        {
-            detailsText += "<br><br>";  // Add blank line between description and type-specific
-        }
-        detailsText += typeSpecificDetails;
-    }
-
     // Set the combined details text & show the details group box
-    ui->detailsTextEdit->setHtml(detailsText);
+    ui->detailsTextEdit->setHtml(detailsRenderer_->html(*event));
     ui->eventDetailsGroupBox->setVisible(true);
 
     refreshAttachmentsForCurrentEvent();
 
     updateDetailsPaneGeometry();
-}
-
-
-QString TimelineSidePanel::buildMeetingDetails(const TimelineEvent& event)
-{
-    QString details;
-
-    // ========== DATE/TIME SECTION ==========
-    details += QString("<b>Date & Time:</b><br>");
-
-    // Check if all-day event (time is 00:00:00 to 23:59:59)
-    bool isAllDay = (event.startDate.time() == QTime(0, 0, 0) &&
-                     event.endDate.time() == QTime(23, 59, 59));
-
-    if (isAllDay)
-    {
-        details += QString("Start: %1 (All Day)<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"));
-        details += QString("End: %1 (All Day)<br>")
-                       .arg(event.endDate.toString("yyyy-MM-dd"));
-    }
-    else
-    {
-        details += QString("Start: %1 at %2<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"))
-            .arg(event.startDate.time().toString("HH:mm"));
-        details += QString("End: %1 at %2<br>")
-                       .arg(event.endDate.toString("yyyy-MM-dd"))
-                       .arg(event.endDate.time().toString("HH:mm"));
-    }
 
-    // Duration calculation
-    if (event.startDate.date() == event.endDate.date())
-    {
-        // Same day - calculate time duration
-        qint64 seconds = event.startDate.secsTo(event.endDate);
-        int hours = seconds / 3600;
-        int mins = (seconds % 3600) / 60;
-
-        if (hours > 0)
-        {
-            details += QString("Duration: %1h %2m<br>").arg(hours).arg(mins);
-        }
-        else
-        {
-            details += QString("Duration: %1m<br>").arg(mins);
-        }
-    }
-    else
-    {
-        // Multi-day event
-        int days = event.startDate.daysTo(event.endDate);
-        details += QString("Duration: %1 days<br>").arg(days + 1);
-    }
-
-    // ========== MEETING-SPECIFIC FIELDS ==========
-    if (!event.location.isEmpty() || !event.participants.isEmpty())
-    {
-        details += "<br>";  // Add spacing before next section
-    }
-
-    if (!event.location.isEmpty())
-    {
-        details += QString("<b>Location:</b><br>%1<br>").arg(event.location);
-    }
-
-    if (!event.participants.isEmpty())
-    {
-        if (!event.location.isEmpty())
-        {
-            details += "<br>";  // Spacing between location and participants
-        }
-        details += QString("<b>Participants:</b><br>%1<br>").arg(event.participants);
-    }
-
-    return details;
+    prefetchListNeighbours(eventId);
 }
 
 
-
-QString TimelineSidePanel::buildActionDetails(const TimelineEvent& event)
+void TimelineSidePanel::prefetchListNeighbours(const QString& eventId)
 {
-    QString details;
-
-    // ========== DATE/TIME SECTION ==========
-    details += QString("<b>Date & Time:</b><br>");
-
-    // Check if all-day event
-    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
-
-    if (isStartAllDay)
-    {
-        details += QString("Start: %1 (All Day)<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"));
-    }
-    else
-    {
-        details += QString("Start: %1 at %2<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"))
-            .arg(event.startDate.time().toString("HH:mm"));
-    }
-
-    // Due Date/Time
-    if (event.dueDateTime.isValid())
+    QListWidget* listWidget = activeListWidget();
+    if (!listWidget)
     {
-        // Check if due time is midnight (all-day)
-        bool isDueAllDay = (event.dueDateTime.time() == QTime(0, 0, 0) ||
-                            event.dueDateTime.time() == QTime(23, 59, 59));
-
-        if (isDueAllDay)
-        {
-            details += QString("Due: %1 (All Day)<br>")
-            .arg(event.dueDateTime.toString("yyyy-MM-dd"));
-        }
-        else
-        {
-            details += QString("Due: %1 at %2<br>")
-            .arg(event.dueDateTime.toString("yyyy-MM-dd"))
-                .arg(event.dueDateTime.time().toString("HH:mm"));
-        }
+        return;
     }
 
-    // ========== STATUS SECTION ==========
-    if (!event.status.isEmpty())
+    // The selection is normally the current item; fall back to a scan for timeline clicks
+    int row = -1;
+    QListWidgetItem* current = listWidget->currentItem();
+    if (current && current->data(Qt::UserRole).toString() == eventId)
     {
-        details += "<br>";  // Add spacing before status section
-
-        QString statusColor = "black";
-        if (event.status == "Completed")
-            statusColor = "green";
-        else if (event.status == "In Progress")
-            statusColor = "blue";
-        else if (event.status == "Blocked")
-            statusColor = "red";
-
-        details += QString("<b>Status:</b> <span style='color:%1;'>%2</span><br>")
-                       .arg(statusColor)
-                       .arg(event.status);
+        row = listWidget->row(current);
     }
-
-    // ========== TIME TRACKING SECTION ==========
-    if (event.dueDateTime.isValid())
+    else
     {
-        details += "<br>";  // Add spacing before time tracking
-
-        QDateTime now = QDateTime::currentDateTime();
-        qint64 secsRemaining = now.secsTo(event.dueDateTime);
-
-        if (secsRemaining > 0)
-        {
-            int days = secsRemaining / 86400;
-            int hours = (secsRemaining % 86400) / 3600;
-
-            if (days > 0)
-            {
-                details += QString("<b>Time Remaining:</b><br>%1 days, %2 hours<br>")
-                .arg(days)
-                    .arg(hours);
-            }
-            else if (hours > 0)
-            {
-                details += QString("<b>Time Remaining:</b><br>%1 hours<br>")
-                .arg(hours);
-            }
-            else
-            {
-                int mins = secsRemaining / 60;
-                details += QString("<b>Time Remaining:</b><br>%1 minutes<br>")
-                               .arg(mins);
-            }
-        }
-        else if (secsRemaining < 0)
+        for (int i = 0; i < listWidget->count(); ++i)
         {
-            int days = (-secsRemaining) / 86400;
-            int hours = ((-secsRemaining) % 86400) / 3600;
-
-            if (days > 0)
+            if (listWidget->item(i)->data(Qt::UserRole).toString() == eventId)
             {
-                details += QString("<b style='color:red;'>Overdue By:</b><br>%1 days, %2 hours<br>")
-                .arg(days)
-                    .arg(hours);
+                row = i;
+                break;
             }
-            else
-            {
-                details += QString("<b style='color:red;'>Overdue By:</b><br>%1 hours<br>")
-                .arg(hours);
-            }
-        }
-        else
-        {
-            details += QString("<b style='color:orange;'>Due Now!</b><br>");
-        }
-    }
-
-    return details;
-}
-
-
-QString TimelineSidePanel::buildTestEventDetails(const TimelineEvent& event)
-{
-    QString details;
-
-    // ========== DATE/TIME SECTION ==========
-    details += QString("<b>Date & Time:</b><br>");
-
-    // Check if all-day events
-    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
-    bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
-
-    if (isStartAllDay && isEndAllDay)
-    {
-        details += QString("Start: %1 (All Day)<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"));
-        details += QString("End: %1 (All Day)<br>")
-                       .arg(event.endDate.toString("yyyy-MM-dd"));
-    }
-    else
-    {
-        details += QString("Start: %1 at %2<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"))
-            .arg(event.startDate.time().toString("HH:mm"));
-        details += QString("End: %1 at %2<br>")
-                       .arg(event.endDate.toString("yyyy-MM-dd"))
-                       .arg(event.endDate.time().toString("HH:mm"));
-    }
-
-    // Duration calculation
-    int durationDays = event.startDate.daysTo(event.endDate) + 1;
-    details += QString("Duration: %1 days<br>").arg(durationDays);
-
-    // ========== TEST-SPECIFIC FIELDS ==========
-    if (!event.testCategory.isEmpty())
-    {
-        details += "<br>";  // Add spacing before category section
-        details += QString("<b>Event Category:</b><br>%1<br>").arg(event.testCategory);
-    }
-
-    // ========== PROGRESS SECTION ==========
-    if (!event.preparationChecklist.isEmpty())
-    {
-        details += "<br>";  // Add spacing before progress section
-
-        int completedCount = 0;
-        int totalCount = event.preparationChecklist.size();
-
-        for (bool completed : event.preparationChecklist.values())
-        {
-            if (completed) completedCount++;
         }
-
-        double percentage = (totalCount > 0) ? (completedCount * 100.0 / totalCount) : 0.0;
-
-        details += QString("<b>Preparation Progress:</b><br>%1 / %2 completed (%3%)<br>")
-                       .arg(completedCount)
-                       .arg(totalCount)
-                       .arg(QString::number(percentage, 'f', 0));
-    }
-
-    return details;
-}
-
-
-QString TimelineSidePanel::buildReminderDetails(const TimelineEvent& event)
-{
-    QString details;
-
-    // ========== REMINDER DATE/TIME SECTION ==========
-    if (event.reminderDateTime.isValid())
-    {
-        details += QString("<b>Reminder:</b><br>");
-        details += QString("%1 at %2<br>")
-                       .arg(event.reminderDateTime.toString("yyyy-MM-dd"))
-                       .arg(event.reminderDateTime.time().toString("HH:mm"));
     }
 
-    // ========== EVENT DATE/TIME SECTION ==========
-    if (event.startDate.isValid() && event.endDate.isValid())
+    if (row < 0)
     {
-        details += "<br>";  // Add spacing before event timeline section
-        details += QString("<b>Event Date & Time:</b><br>");
-
-        bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
-        bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
-
-        if (isStartAllDay && isEndAllDay)
-        {
-            details += QString("Start: %1 (All Day)<br>")
-            .arg(event.startDate.toString("yyyy-MM-dd"));
-            details += QString("End: %1 (All Day)<br>")
-                           .arg(event.endDate.toString("yyyy-MM-dd"));
-        }
-        else
-        {
-            details += QString("Start: %1 at %2<br>")
-            .arg(event.startDate.toString("yyyy-MM-dd"))
-                .arg(event.startDate.time().toString("HH:mm"));
-            details += QString("End: %1 at %2<br>")
-                           .arg(event.endDate.toString("yyyy-MM-dd"))
-                           .arg(event.endDate.time().toString("HH:mm"));
-        }
-
-        // Duration calculation
-        int durationDays = event.startDate.daysTo(event.endDate) + 1;
-        if (durationDays > 1)
-        {
-            details += QString("Duration: %1 days<br>").arg(durationDays);
-        }
-    }
-
-    // ========== RECURRENCE SECTION ==========
-    if (!event.recurringRule.isEmpty() && event.recurringRule != "None")
-    {
-        details += "<br>";  // Add spacing before recurrence section
-        details += QString("<b>Recurrence:</b><br>%1<br>").arg(event.recurringRule);
+        return;
     }
 
-    // ========== TIME TRACKING SECTION ==========
-    if (event.reminderDateTime.isValid())
+    QVector<TimelineEvent> neighbours;
+    for (int offset = 1; offset <= PREFETCH_NEIGHBOURS; ++offset)
     {
-        details += "<br>";  // Add spacing before time tracking
-
-        QDateTime now = QDateTime::currentDateTime();
-        qint64 secsUntilReminder = now.secsTo(event.reminderDateTime);
-
-        if (secsUntilReminder > 0)
+        for (int neighbourRow : {row - offset, row + offset})
         {
-            int days = secsUntilReminder / 86400;
-            int hours = (secsUntilReminder % 86400) / 3600;
-            int mins = ((secsUntilReminder % 86400) % 3600) / 60;
-
-            if (days > 0)
-            {
-                details += QString("<b>Time Until Reminder:</b><br>%1 days, %2 hours, %3 minutes<br>")
-                .arg(days)
-                    .arg(hours)
-                    .arg(mins);
-            }
-            else if (hours > 0)
+            QListWidgetItem* item = listWidget->item(neighbourRow);
+            if (!item)
             {
-                details += QString("<b>Time Until Reminder:</b><br>%1 hours, %2 minutes<br>")
-                .arg(hours)
-                    .arg(mins);
+                continue;
             }
-            else
+
+            if (const TimelineEvent* event = model_->getEvent(item->data(Qt::UserRole).toString()))
             {
-                details += QString("<b>Time Until Reminder:</b><br>%1 minutes<br>").arg(mins);
+                neighbours.append(*event);
             }
         }
-        else if (secsUntilReminder < 0)
-        {
-            details += QString("<b style='color:red;'>Reminder Past Due</b><br>");
-        }
-        else
-        {
-            details += QString("<b style='color:orange;'>Reminder is NOW!</b><br>");
-        }
-    }
-
-    return details;
-}
-
-
-QString TimelineSidePanel::buildJiraTicketDetails(const TimelineEvent& event)
-{
-    QString details;
-
-    // ========== DATE/TIME SECTION ==========
-    details += QString("<b>Date & Time:</b><br>");
-
-    // Check if all-day events
-    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
-    bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
-
-    if (isStartAllDay)
-    {
-        details += QString("Start: %1 (All Day)<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"));
-    }
-    else
-    {
-        details += QString("Start: %1 at %2<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"))
-            .arg(event.startDate.time().toString("HH:mm"));
-    }
-
-    if (isEndAllDay)
-    {
-        details += QString("Due: %1 (All Day)<br>")
-        .arg(event.endDate.toString("yyyy-MM-dd"));
-    }
-    else
-    {
-        details += QString("Due: %1 at %2<br>")
-        .arg(event.endDate.toString("yyyy-MM-dd"))
-            .arg(event.endDate.time().toString("HH:mm"));
-    }
-
-    // Duration calculation
-    int durationDays = event.startDate.daysTo(event.endDate) + 1;
-    details += QString("Duration: %1 days<br>").arg(durationDays);
-
-    // ========== JIRA-SPECIFIC FIELDS ==========
-    if (!event.jiraKey.isEmpty() || !event.jiraType.isEmpty())
-    {
-        details += "<br>";  // Add spacing before Jira section
-    }
-
-    if (!event.jiraKey.isEmpty())
-    {
-        details += QString("<b>Jira Key:</b> %1<br>").arg(event.jiraKey);
-    }
-
-    if (!event.jiraType.isEmpty())
-    {
-        QString typeIcon = "📝";
-        if (event.jiraType == "Bug")
-            typeIcon = "🐛";
-        else if (event.jiraType == "Story")
-            typeIcon = "📖";
-        else if (event.jiraType == "Epic")
-            typeIcon = "🎯";
-        else if (event.jiraType == "Task")
-            typeIcon = "✅";
-
-        if (!event.jiraKey.isEmpty())
-        {
-            details += "<br>";  // Spacing between key and type
-        }
-        details += QString("<b>Type:</b> %1 %2<br>").arg(typeIcon).arg(event.jiraType);
     }
 
-    // ========== STATUS SECTION ==========
-    if (!event.jiraStatus.isEmpty())
-    {
-        details += "<br>";  // Add spacing before status section
-
-        QString statusColor = "black";
-        if (event.jiraStatus == "Done")
-            statusColor = "green";
-        else if (event.jiraStatus == "In Progress")
-            statusColor = "blue";
-
-        details += QString("<b>Status:</b> <span style='color:%1;'>%2</span><br>")
-                       .arg(statusColor)
-                       .arg(event.jiraStatus);
-    }
-
-    // ========== TIME TRACKING SECTION ==========
-    details += "<br>";  // Add spacing before time tracking
-
-    QDate today = QDate::currentDate();
-    int daysRemaining = today.daysTo(event.endDate.date());
-
-    if (daysRemaining > 0)
-    {
-        details += QString("<b>Days Remaining:</b> %1<br>").arg(daysRemaining);
-    }
-    else if (daysRemaining < 0)
-    {
-        details += QString("<b style='color:red;'>Overdue By:</b> %1 days<br>").arg(-daysRemaining);
-    }
-    else
-    {
-        details += QString("<b style='color:orange;'>Due Today!</b><br>");
-    }
-
-    return details;
-}
-
-
-QString TimelineSidePanel::buildGenericDetails(const TimelineEvent& event)
-{
-    QString details;
-
-    // ========== DATE/TIME SECTION ==========
-    details += QString("<b>Date & Time:</b><br>");
-
-    // Check if all-day events
-    bool isStartAllDay = (event.startDate.time() == QTime(0, 0, 0));
-    bool isEndAllDay = (event.endDate.time() == QTime(23, 59, 59));
-
-    if (isStartAllDay && isEndAllDay)
-    {
-        details += QString("Start: %1 (All Day)<br>")
-        .arg(event.startDate.toString("yyyy-MM-dd"));
-        details += QString("End: %1 (All Day)<br>")
-                       .arg(event.endDate.toString("yyyy-MM-dd"));
-    }
-    else
-    {
-        if (isStartAllDay)
-        {
-            details += QString("Start: %1 (All Day)<br>")
-            .arg(event.startDate.toString("yyyy-MM-dd"));
-        }
-        else
-        {
-            details += QString("Start: %1 at %2<br>")
-            .arg(event.startDate.toString("yyyy-MM-dd"))
-                .arg(event.startDate.time().toString("HH:mm"));
-        }
-
-        if (isEndAllDay)
-        {
-            details += QString("End: %1 (All Day)<br>")
-            .arg(event.endDate.toString("yyyy-MM-dd"));
-        }
-        else
-        {
-            details += QString("End: %1 at %2<br>")
-            .arg(event.endDate.toString("yyyy-MM-dd"))
-                .arg(event.endDate.time().toString("HH:mm"));
-        }
-    }
-
-    // Duration calculation
-    int durationDays = event.startDate.daysTo(event.endDate) + 1;
-    if (durationDays > 1)
-    {
-        details += QString("Duration: %1 days<br>").arg(durationDays);
-    }
-
-    return details;
+    detailsRenderer_->prefetch(neighbours);
 }
 
 
@@ -2940,25 +2517,25 @@ void TimelineSidePanel::clearEventDetails()
 
 void TimelineSidePanel::onEventAdded(const QString& /*eventId*/)
 {
-    refreshAllTabs();
+    refreshAllTabsIfModelChanged();
 }
 
 
 void TimelineSidePanel::onEventRemoved(const QString& /*eventId*/)
 {
-    refreshAllTabs();
+    refreshAllTabsIfModelChanged();
 }
 
 
 void TimelineSidePanel::onEventUpdated(const QString& /*eventId*/)
 {
-    refreshAllTabs();
+    refreshAllTabsIfModelChanged();
 }
 
 
 void TimelineSidePanel::onLanesRecalculated()
 {
-    refreshAllTabs();
+    refreshAllTabsIfModelChanged();
 }
 
 
@@ -3108,29 +2685,35 @@ QStringList TimelineSidePanel::getSelectedEventIds() const
 {
     QStringList eventIds;
 
-    QWidget* currentWidget = ui->tabWidget->currentWidget();
+    QListWidget* activeList = activeListWidget();
 
-    QListWidget* activeList = nullptr;
+    if (activeList)
+    {
+        eventIds = getSelectedEventIds(activeList);
+    }
+
+    return eventIds;
+}
+
+
+QListWidget* TimelineSidePanel::activeListWidget() const
+{
+    QWidget* currentWidget = ui->tabWidget->currentWidget();
 
     if (currentWidget == ui->todayTab)
     {
-        activeList = ui->todayList;
+        return ui->todayList;
     }
     else if (currentWidget == ui->lookaheadTab)
     {
-        activeList = ui->lookaheadList;
+        return ui->lookaheadList;
     }
     else if (currentWidget == ui->allEventsTab)
     {
-        activeList = ui->allEventsList;
-    }
-
-    if (activeList)
-    {
-        eventIds = getSelectedEventIds(activeList);
+        return ui->allEventsList;
     }
 
-    return eventIds;
+    return nullptr;
 }
 
 
@@ -3140,6 +2723,22 @@ void TimelineSidePanel::onListSelectionChanged()
 }
 
 
+void TimelineSidePanel::onListCurrentItemChanged(QListWidgetItem* current)
+{
+    // Keyboard navigation moves the current item without a click
+    if (!current || current->flags() == Qt::NoItemFlags)
+    {
+        return;
+    }
+
+    QString eventId = current->data(Qt::UserRole).toString();
+    if (!eventId.isEmpty() && eventId != currentEventId_)
+    {
+        displayEventDetails(eventId);
+    }
+}
+
+
 void TimelineSidePanel::focusNextItem(QListWidget* listWidget, int deletedRow)
 {
     if (!listWidget || listWidget->count() == 0)
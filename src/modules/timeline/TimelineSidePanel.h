@@ -4,6 +4,7 @@
 #pragma once
 #include "TimelineModel.h"
 #include "TimelineSettings.h"
+#include "RevisionMemo.h"
 #include <QWidget>
 #include <QSet>
 #include <QMap>
@@ -12,6 +13,7 @@
 
 // Forward declarations
 class AttachmentListWidget;
+class EventDetailsRenderer;
 class TimelineModel;
 class TimelineView;
 class QTabWidget;
@@ -28,6 +30,7 @@ class QComboBox;
 class QSpinBox;
 class QTextEdit;
 class QLineEdit;
+class QTimer;
 class QDateTimeEdit;
 class QCheckBox;
 class QWidget;
@@ -54,6 +57,8 @@ public:
     void refreshAllTabs();                                              ///< Refresh all tabs from the model
     void adjustWidthToFitTabs();                                        ///< Adjust side panel width to get all tabs in view
     QStringList getSelectedEventIds() const;                            ///< Selected event IDs from active tab
+    int currentTab() const;                                             ///< Index of the active list tab
+    void setCurrentTab(int index);                                      ///< Switch list tab (ignored if out of range)
     void setTimelineView(TimelineView* view) { view_ = view; }          ///< Set timeline view reference (exports)
 
 signals:
@@ -81,6 +86,7 @@ private slots:
 
     void onListContextMenuRequested(const QPoint& pos);
     void onListSelectionChanged();
+    void onListCurrentItemChanged(QListWidgetItem* current);
 
     // Tab context menu handlers
     void onTabBarContextMenuRequested(const QPoint& pos);
@@ -123,6 +129,8 @@ private slots:
 
 private:
     void connectSignals();
+    void scheduleRefreshAllTabs();                                      ///< Throttled refreshAllTabs() for batch inserts/removals
+    void refreshAllTabsIfModelChanged();                                ///< refreshAllTabs() unless this model generation is already shown
 
     void refreshAllEventsTab();
     void refreshLookaheadTab();
@@ -137,12 +145,7 @@ private:
 
     bool hasUnsavedChanges_ = false;
 
-    QString buildMeetingDetails(const TimelineEvent& event);
-    QString buildActionDetails(const TimelineEvent& event);
-    QString buildTestEventDetails(const TimelineEvent& event);
-    QString buildReminderDetails(const TimelineEvent& event);
-    QString buildJiraTicketDetails(const TimelineEvent& event);
-    QString buildGenericDetails(const TimelineEvent& event);
+    void prefetchListNeighbours(const QString& eventId);               ///< Render details for the rows around eventId in the background
 
     void populateListWidget(QListWidget* listWidget, const QVector<TimelineEvent>& events);
     QListWidgetItem* createListItem(const TimelineEvent& event);
@@ -162,6 +165,7 @@ private:
 
     void enableMultiSelection(QListWidget* listWidget);
     QStringList getSelectedEventIds(QListWidget* listWidget) const;
+    QListWidget* activeListWidget() const;                              ///< List of the current tab (nullptr if none)
     void focusNextItem(QListWidget* listWidget, int deletedRow);
 
     QVector<TimelineEvent> getEventsFromTab(int tabIndex) const;
@@ -204,6 +208,19 @@ private:
 
     QString currentEventId_;
 
+    QTimer* refreshThrottleTimer_ = nullptr;    ///< Cooldown after a batch refresh (progressive project load sends many batches)
+    bool refreshPending_ = false;               ///< A batch arrived during the cooldown
+    quint64 refreshedGeneration_ = 0;           ///< Model generation the tabs were last built from
+
+    struct ListItemText
+    {
+        QString text;
+        QString toolTip;
+    };
+    RevisionMemo<QString, ListItemText> listItemTextMemo_;     ///< List text and tooltip per event revision
+    EventDetailsRenderer* detailsRenderer_ = nullptr;           ///< Cached/prefetched details HTML (child QObject)
+    static constexpr int PREFETCH_NEIGHBOURS = 2;               ///< Rows above and below the selection rendered ahead
+
     // Attachments (created programmatically)
     QWidget* attachmentsSection_ = nullptr;
 
@@ -0,0 +1,167 @@
+// TimelineSyncProtocol.cpp
+
+
+#include "TimelineSyncProtocol.h"
+#include <QCborArray>
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QtEndian>
+#include <algorithm>
+
+
+QByteArray TimelineSyncProtocol::encode(const QCborMap& message)
+{
+    const QByteArray payload = QCborValue(message).toCbor();
+
+    QByteArray frame;
+    frame.resize(4);
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), frame.data());
+    frame.append(payload);
+
+    return frame;
+}
+
+
+bool TimelineSyncProtocol::takeMessage(QByteArray& buffer, QCborMap& message, bool* malformed)
+{
+    if (malformed)
+    {
+        *malformed = false;
+    }
+
+    if (buffer.size() < 4)
+    {
+        return false;
+    }
+
+    const quint32 length = qFromBigEndian<quint32>(buffer.constData());
+    if (length > static_cast<quint32>(MAX_FRAME_BYTES))
+    {
+        if (malformed)
+        {
+            *malformed = true;
+        }
+        return false;
+    }
+
+    if (buffer.size() < 4 + static_cast<qsizetype>(length))
+    {
+        return false;       // Rest of the frame still in flight
+    }
+
+    QCborParserError error;
+    const QCborValue value = QCborValue::fromCbor(buffer.mid(4, length), &error);
+    buffer.remove(0, 4 + length);
+
+    if (error.error != QCborError::NoError || !value.isMap())
+    {
+        if (malformed)
+        {
+            *malformed = true;
+        }
+        return false;
+    }
+
+    message = value.toMap();
+    return true;
+}
+
+
+QString TimelineSyncProtocol::generateToken()
+{
+    // 64 random bits: short enough to read out, far too many to guess over a socket
+    const QString hex = QString::number(QRandomGenerator::system()->generate64(), 16).rightJustified(16, '0');
+    return QStringList{ hex.mid(0, 4), hex.mid(4, 4), hex.mid(8, 4), hex.mid(12, 4) }.join('-');
+}
+
+
+QString TimelineSyncProtocol::normalizeToken(const QString& token)
+{
+    QString normalized;
+    normalized.reserve(token.size());
+    for (const QChar c : token)
+    {
+        if (c != '-' && !c.isSpace())
+        {
+            normalized.append(c.toLower());
+        }
+    }
+    return normalized;
+}
+
+
+bool TimelineSyncProtocol::tokensMatch(const QString& expected, const QString& given)
+{
+    const QByteArray a = normalizeToken(expected).toUtf8();
+    const QByteArray b = normalizeToken(given).toUtf8();
+    if (a.isEmpty() || a.size() != b.size())
+    {
+        return false;
+    }
+
+    // No early exit, so the response time does not reveal how much of a guess was right
+    char difference = 0;
+    for (qsizetype i = 0; i < a.size(); ++i)
+    {
+        difference |= a.at(i) ^ b.at(i);
+    }
+    return difference == 0;
+}
+
+
+QByteArray TimelineSyncProtocol::stateHash(const QHash<QString, QJsonObject>& events, const QJsonObject& version)
+{
+    // Sorted IDs and compact JSON (keys sorted too) give the same bytes on every participant
+    QStringList ids = events.keys();
+    std::sort(ids.begin(), ids.end());
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (const QString& id : std::as_const(ids))
+    {
+        hash.addData(QJsonDocument(events.value(id)).toJson(QJsonDocument::Compact));
+        hash.addData(QByteArray(1, '\n'));
+    }
+    hash.addData(QJsonDocument(version).toJson(QJsonDocument::Compact));
+
+    return hash.result();
+}
+
+
+QVector<QByteArray> TimelineSyncProtocol::encodeSnapshot(const QHash<QString, QJsonObject>& events, const QJsonObject& version, qint64 sequence)
+{
+    QVector<QByteArray> frames;
+    frames.reserve(static_cast<int>(events.size() / SNAPSHOT_CHUNK) + 1);
+
+    QCborArray chunk;
+    auto flush = [&](bool last)
+    {
+        QCborMap message;
+        message.insert(QStringLiteral("t"), QString::fromLatin1(SNAPSHOT));
+        message.insert(QStringLiteral("s"), sequence);
+        message.insert(QStringLiteral("e"), chunk);
+        message.insert(QStringLiteral("d"), last);
+        if (last)
+        {
+            message.insert(QStringLiteral("vs"), version.value("vs").toString());
+            message.insert(QStringLiteral("ve"), version.value("ve").toString());
+            message.insert(QStringLiteral("vn"), version.value("vn").toString());
+        }
+        frames.append(encode(message));
+        chunk = QCborArray();
+    };
+
+    for (auto it = events.cbegin(); it != events.cend(); ++it)
+    {
+        chunk.append(QCborMap::fromJsonObject(it.value()));
+        if (chunk.size() == SNAPSHOT_CHUNK)
+        {
+            flush(false);
+        }
+    }
+    flush(true);
+
+    return frames;
+}
@@ -0,0 +1,83 @@
+// TimelineSyncProtocol.h
+
+
+#pragma once
+#include <QByteArray>
+#include <QCborMap>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+
+class QIODevice;
+
+
+/**
+ * @class TimelineSyncProtocol
+ * @brief Wire format shared by TimelineSyncSession and TimelineSyncRelay
+ *
+ * Every message is one CBOR map, framed by a 4-byte big-endian length. Messages
+ * carry a "t" (type) key:
+ *
+ * - hello    client -> relay  { v: version, k: session token, c: client id, r: last relay id seen,
+ *                              s: last sequence seen, h: stateHash() of the client's project }
+ * - denied   relay -> client  { m: reason }; the relay then closes the connection
+ * - welcome  relay -> client  { r: relay id, s: current sequence, x: true if the relay has no
+ *                              snapshot yet and the client must seed it }
+ *                             then, unless the client is seeding, the snapshot (only if the
+ *                             client cannot continue from its sequence and its hash differs),
+ *                             every batch after that, and "ready"
+ * - snapshot client -> relay  the seeding client's whole project, answered with "ready"
+ *            relay -> client  the project as of sequence s
+ *                             { s: sequence, e: [events], d: last chunk, vs, ve, vn (last chunk only) },
+ *                             split into chunks of SNAPSHOT_CHUNK events
+ * - ops      client -> relay  { c: client id, b: client batch number, ops: [...] }
+ *            relay -> all     the same plus { s: sequence }; the sender's own copy is its acknowledgement
+ * - peers    relay -> all     { n: participants }
+ *
+ * An operation is a map with "o" (kind) and "id" (event):
+ * - put { e: event }                      add, or replace a whole event
+ * - set { f: {field: value}, u: [field] } changed and removed fields only
+ * - del                                   event deleted (active or archived)
+ * - arc { a: archived }                   moved to or from the archive
+ * - ver { vs, ve, vn }                    version range and name (no "id")
+ *
+ * Events and fields use the keys of TimelineSerializer's JSON format. A snapshot holds every
+ * active and archived event in the synchronized form (TimelineSyncSession::stateOf()).
+ */
+class TimelineSyncProtocol
+{
+public:
+    static QByteArray encode(const QCborMap& message);                      ///< Length-prefixed frame
+    static bool takeMessage(QByteArray& buffer, QCborMap& message, bool* malformed = nullptr);   ///< Pop one complete frame from a receive buffer
+
+    static QString generateToken();                                        ///< Random session token ("xxxx-xxxx-xxxx-xxxx")
+    static QString normalizeToken(const QString& token);                   ///< Lower case, without separators and spaces
+    static bool tokensMatch(const QString& expected, const QString& given); ///< Normalized comparison in constant time
+
+    static QByteArray stateHash(const QHash<QString, QJsonObject>& events, const QJsonObject& version);    ///< Digest of a synchronized project, independent of event order
+    static QVector<QByteArray> encodeSnapshot(const QHash<QString, QJsonObject>& events, const QJsonObject& version, qint64 sequence);    ///< Snapshot frames, in chunks
+
+    static constexpr int VERSION = 2;
+    static constexpr quint16 DEFAULT_PORT = 47800;
+    static constexpr qint32 MAX_FRAME_BYTES = 16 * 1024 * 1024;            ///< Larger frames mean a corrupt stream
+    static constexpr int SNAPSHOT_CHUNK = 500;                              ///< Events per snapshot frame (keeps frames far below MAX_FRAME_BYTES)
+    static constexpr const char* TOKEN_VARIABLE = "TESTLEADTOOLBOX_SYNC_TOKEN";    ///< Hands the token to a relay process (not visible in process lists)
+
+    // Message types
+    static constexpr const char* HELLO = "hello";
+    static constexpr const char* DENIED = "denied";
+    static constexpr const char* WELCOME = "welcome";
+    static constexpr const char* READY = "ready";
+    static constexpr const char* SNAPSHOT = "snapshot";
+    static constexpr const char* OPS = "ops";
+    static constexpr const char* PEERS = "peers";
+
+    // Operation kinds
+    static constexpr const char* OP_PUT = "put";
+    static constexpr const char* OP_SET = "set";
+    static constexpr const char* OP_DELETE = "del";
+    static constexpr const char* OP_ARCHIVE = "arc";
+    static constexpr const char* OP_VERSION = "ver";
+};
@@ -0,0 +1,451 @@
+// TimelineSyncRelay.cpp
+
+
+#include "TimelineSyncRelay.h"
+#include "TimelineSyncProtocol.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QCoreApplication>
+#include <QUuid>
+#include <QDebug>
+#include <algorithm>
+#include <utility>
+
+
+TimelineSyncRelay::TimelineSyncRelay(QObject* parent)
+    : QObject(parent)
+    , server_(new QTcpServer(this))
+    , relayId_(QUuid::createUuid().toString(QUuid::WithoutBraces))
+{
+    connect(server_, &QTcpServer::newConnection, this, &TimelineSyncRelay::onNewConnection);
+}
+
+
+bool TimelineSyncRelay::listen(const QHostAddress& address, quint16 port, QString* errorString)
+{
+    if (!server_->listen(address, port))
+    {
+        if (errorString)
+        {
+            *errorString = server_->errorString();
+        }
+        return false;
+    }
+
+    qDebug() << "TimelineSyncRelay: Listening on" << server_->serverAddress().toString() << server_->serverPort();
+    return true;
+}
+
+
+quint16 TimelineSyncRelay::port() const
+{
+    return server_->serverPort();
+}
+
+
+int TimelineSyncRelay::runStandalone(const QStringList& arguments)
+{
+    quint16 port = TimelineSyncProtocol::DEFAULT_PORT;
+
+    const int portIndex = arguments.indexOf("--sync-port");
+    if (portIndex >= 0 && portIndex + 1 < arguments.size())
+    {
+        port = static_cast<quint16>(arguments.at(portIndex + 1).toUInt());
+    }
+
+    QString token = qEnvironmentVariable(TimelineSyncProtocol::TOKEN_VARIABLE);
+    if (TimelineSyncProtocol::normalizeToken(token).isEmpty())
+    {
+        token = TimelineSyncProtocol::generateToken();
+        qInfo().noquote() << "TimelineSyncRelay: Session token" << token;
+    }
+
+    TimelineSyncRelay relay;
+    relay.setSessionToken(token);
+    relay.setExitWhenIdle(arguments.contains("--sync-exit-when-idle"));
+
+    // Other machines can only reach the relay when sharing was asked for
+    const QHostAddress address = arguments.contains("--sync-shared") ? QHostAddress(QHostAddress::Any)
+                                                                     : QHostAddress(QHostAddress::LocalHost);
+
+    QString error;
+    if (!relay.listen(address, port, &error))
+    {
+        qCritical() << "TimelineSyncRelay: Cannot listen on port" << port << "-" << error;
+        return 1;
+    }
+
+    return QCoreApplication::exec();
+}
+
+
+void TimelineSyncRelay::onNewConnection()
+{
+    while (QTcpSocket* socket = server_->nextPendingConnection())
+    {
+        // Small batches should leave immediately rather than wait for Nagle
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+        clients_.insert(socket, Client());
+
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() { onDisconnected(socket); });
+    }
+}
+
+
+void TimelineSyncRelay::onReadyRead(QTcpSocket* socket)
+{
+    auto it = clients_.find(socket);
+    if (it == clients_.end())
+    {
+        return;
+    }
+
+    it->buffer.append(socket->readAll());
+
+    QCborMap message;
+    bool malformed = false;
+    while (TimelineSyncProtocol::takeMessage(it->buffer, message, &malformed))
+    {
+        const QString type = message.value("t").toString();
+
+        if (type == TimelineSyncProtocol::HELLO && !it->joined && it->waitingHello.isEmpty() && socket != seeder_)
+        {
+            handleHello(socket, message);
+        }
+        else if (type == TimelineSyncProtocol::SNAPSHOT && socket == seeder_)
+        {
+            handleSnapshot(socket, message);
+        }
+        else if (type == TimelineSyncProtocol::OPS && it->joined)
+        {
+            handleOps(socket, message);
+        }
+
+        // Handlers may have dropped or refused the client
+        it = clients_.find(socket);
+        if (it == clients_.end() || socket->state() != QAbstractSocket::ConnectedState)
+        {
+            return;
+        }
+    }
+
+    if (malformed)
+    {
+        qWarning() << "TimelineSyncRelay: Dropping client with a malformed stream:" << socket->peerAddress().toString();
+        socket->abort();
+    }
+}
+
+
+void TimelineSyncRelay::handleHello(QTcpSocket* socket, const QCborMap& message)
+{
+    if (message.value("v").toInteger() != TimelineSyncProtocol::VERSION)
+    {
+        qWarning() << "TimelineSyncRelay: Protocol version mismatch from" << socket->peerAddress().toString();
+        deny(socket, "The relay runs a different version of the application");
+        return;
+    }
+
+    if (!TimelineSyncProtocol::tokensMatch(token_, message.value("k").toString()))
+    {
+        qWarning() << "TimelineSyncRelay: Wrong session token from" << socket->peerAddress().toString();
+        deny(socket, "Wrong session token");
+        return;
+    }
+
+    const qint64 sequence = snapshotSequence_ + log_.size();
+
+    if (!seeded_)
+    {
+        if (seeder_)
+        {
+            // Somebody is uploading the project; this client joins once it is complete
+            clients_[socket].waitingHello = message;
+            return;
+        }
+
+        // First participant: its project becomes the session's starting point
+        seeder_ = socket;
+
+        QCborMap welcome;
+        welcome.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::WELCOME));
+        welcome.insert(QStringLiteral("r"), relayId_);
+        welcome.insert(QStringLiteral("s"), sequence);
+        welcome.insert(QStringLiteral("x"), true);
+        socket->write(TimelineSyncProtocol::encode(welcome));
+
+        qDebug() << "TimelineSyncRelay: Client" << message.value("c").toString() << "is seeding the session";
+        return;
+    }
+
+    clients_[socket].joined = true;
+
+    QCborMap welcome;
+    welcome.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::WELCOME));
+    welcome.insert(QStringLiteral("r"), relayId_);
+    welcome.insert(QStringLiteral("s"), sequence);
+    socket->write(TimelineSyncProtocol::encode(welcome));
+
+    // Sequence numbers from another relay process mean nothing here, and compacted ones are gone
+    qint64 since = message.value("r").toString() == relayId_ ? message.value("s").toInteger() : -1;
+    bool sentSnapshot = false;
+
+    if (since < snapshotSequence_ || since > sequence)
+    {
+        // A project that already matches the snapshot only needs the log
+        if (message.value("h").toByteArray() != snapshotHash())
+        {
+            for (const QByteArray& frame : TimelineSyncProtocol::encodeSnapshot(snapshot_, snapshotVersion_, snapshotSequence_))
+            {
+                socket->write(frame);
+            }
+            sentSnapshot = true;
+        }
+        since = snapshotSequence_;
+    }
+
+    // Catch up with everything the client has not seen
+    for (qsizetype i = since - snapshotSequence_; i < log_.size(); ++i)
+    {
+        socket->write(log_.at(i));
+    }
+
+    QCborMap ready;
+    ready.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::READY));
+    socket->write(TimelineSyncProtocol::encode(ready));
+
+    qDebug() << "TimelineSyncRelay: Client" << message.value("c").toString() << "joined,"
+             << (sentSnapshot ? "sent the snapshot and" : "") << "replayed" << sequence - since << "batches";
+    broadcastPeers();
+}
+
+
+void TimelineSyncRelay::handleSnapshot(QTcpSocket* socket, const QCborMap& message)
+{
+    const QCborArray events = message.value("e").toArray();
+    for (const QCborValue& value : events)
+    {
+        const QJsonObject event = value.toMap().toJsonObject();
+        const QString eventId = event.value("id").toString();
+        if (!eventId.isEmpty())
+        {
+            snapshot_.insert(eventId, event);
+        }
+    }
+
+    if (!message.value("d").toBool())
+    {
+        return;     // More chunks to come
+    }
+
+    snapshotVersion_ = QJsonObject{ { "vs", message.value("vs").toString() },
+                                    { "ve", message.value("ve").toString() },
+                                    { "vn", message.value("vn").toString() } };
+    snapshotHash_.clear();
+    seeded_ = true;
+    seeder_ = nullptr;
+
+    clients_[socket].joined = true;
+
+    QCborMap ready;
+    ready.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::READY));
+    socket->write(TimelineSyncProtocol::encode(ready));
+
+    qDebug() << "TimelineSyncRelay: Session seeded with" << snapshot_.size() << "events";
+    broadcastPeers();
+
+    admitWaitingClients();
+}
+
+
+void TimelineSyncRelay::handleOps(QTcpSocket* /*socket*/, QCborMap message)
+{
+    message.insert(QStringLiteral("s"), snapshotSequence_ + log_.size() + 1);
+
+    const QByteArray frame = TimelineSyncProtocol::encode(message);
+    log_.append(frame);
+    broadcast(frame);
+
+    if (log_.size() > LOG_LIMIT)
+    {
+        compactLog(log_.size() - LOG_KEEP);
+    }
+}
+
+
+void TimelineSyncRelay::admitWaitingClients()
+{
+    QVector<QTcpSocket*> waiting;
+    for (auto it = clients_.cbegin(); it != clients_.cend(); ++it)
+    {
+        if (!it->waitingHello.isEmpty())
+        {
+            waiting.append(it.key());
+        }
+    }
+
+    for (QTcpSocket* socket : std::as_const(waiting))
+    {
+        const QCborMap hello = std::exchange(clients_[socket].waitingHello, QCborMap());
+        handleHello(socket, hello);
+    }
+}
+
+
+void TimelineSyncRelay::compactLog(qsizetype count)
+{
+    for (qsizetype i = 0; i < count; ++i)
+    {
+        QByteArray frame = log_.at(i);
+        QCborMap batch;
+        if (TimelineSyncProtocol::takeMessage(frame, batch))
+        {
+            foldOps(batch.value("ops").toArray());
+        }
+    }
+
+    log_.remove(0, count);
+    snapshotSequence_ += count;
+    snapshotHash_.clear();
+
+    qDebug() << "TimelineSyncRelay: Folded" << count << "batches into the snapshot (now at sequence" << snapshotSequence_ << ")";
+}
+
+
+void TimelineSyncRelay::foldOps(const QCborArray& ops)
+{
+    // Same order-based rules every client applies, without the client's pending-write bookkeeping
+    for (const QCborValue& value : ops)
+    {
+        const QCborMap op = value.toMap();
+        const QString kind = op.value("o").toString();
+        const QString eventId = op.value("id").toString();
+
+        if (kind == TimelineSyncProtocol::OP_VERSION)
+        {
+            snapshotVersion_["vs"] = op.value("vs").toString();
+            snapshotVersion_["ve"] = op.value("ve").toString();
+            snapshotVersion_["vn"] = op.value("vn").toString();
+            continue;
+        }
+
+        if (kind == TimelineSyncProtocol::OP_PUT)
+        {
+            snapshot_.insert(eventId, op.value("e").toMap().toJsonObject());
+            continue;
+        }
+
+        if (kind == TimelineSyncProtocol::OP_DELETE)
+        {
+            snapshot_.remove(eventId);
+            continue;
+        }
+
+        auto event = snapshot_.find(eventId);
+        if (event == snapshot_.end())
+        {
+            continue;   // Field writes to a deleted event are ignored by everyone
+        }
+
+        if (kind == TimelineSyncProtocol::OP_ARCHIVE)
+        {
+            (*event)["archived"] = op.value("a").toBool();
+        }
+        else if (kind == TimelineSyncProtocol::OP_SET)
+        {
+            const QCborMap changed = op.value("f").toMap();
+            for (auto it = changed.cbegin(); it != changed.cend(); ++it)
+            {
+                (*event)[it.key().toString()] = it.value().toJsonValue();
+            }
+
+            const QCborArray removed = op.value("u").toArray();
+            for (const QCborValue& key : removed)
+            {
+                event->remove(key.toString());
+            }
+        }
+    }
+}
+
+
+QByteArray TimelineSyncRelay::snapshotHash()
+{
+    if (snapshotHash_.isEmpty())
+    {
+        snapshotHash_ = TimelineSyncProtocol::stateHash(snapshot_, snapshotVersion_);
+    }
+    return snapshotHash_;
+}
+
+
+void TimelineSyncRelay::deny(QTcpSocket* socket, const QString& reason)
+{
+    QCborMap denied;
+    denied.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::DENIED));
+    denied.insert(QStringLiteral("m"), reason);
+    socket->write(TimelineSyncProtocol::encode(denied));
+
+    // Nothing else this client sent is read; the reason is flushed before closing
+    clients_[socket].buffer.clear();
+    socket->disconnectFromHost();
+}
+
+
+void TimelineSyncRelay::broadcast(const QByteArray& frame)
+{
+    for (auto it = clients_.cbegin(); it != clients_.cend(); ++it)
+    {
+        if (it->joined)
+        {
+            it.key()->write(frame);
+        }
+    }
+}
+
+
+void TimelineSyncRelay::broadcastPeers()
+{
+    int joined = 0;
+    for (const Client& client : std::as_const(clients_))
+    {
+        joined += client.joined ? 1 : 0;
+    }
+
+    QCborMap peers;
+    peers.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::PEERS));
+    peers.insert(QStringLiteral("n"), joined);
+    broadcast(TimelineSyncProtocol::encode(peers));
+}
+
+
+void TimelineSyncRelay::onDisconnected(QTcpSocket* socket)
+{
+    const bool wasJoined = clients_.value(socket).joined;
+    clients_.remove(socket);
+    socket->deleteLater();
+
+    if (wasJoined)
+    {
+        broadcastPeers();
+    }
+
+    if (socket == seeder_)
+    {
+        // Upload cut short: the next waiting client seeds instead
+        seeder_ = nullptr;
+        snapshot_.clear();
+        admitWaitingClients();
+    }
+
+    if (exitWhenIdle_ && clients_.isEmpty())
+    {
+        qDebug() << "TimelineSyncRelay: Last participant left, exiting";
+        QCoreApplication::quit();
+    }
+}
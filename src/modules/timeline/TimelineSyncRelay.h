@@ -0,0 +1,107 @@
+// TimelineSyncRelay.h
+
+
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QByteArray>
+#include <QCborMap>
+#include <QJsonObject>
+#include <QHostAddress>
+
+
+class QTcpServer;
+class QTcpSocket;
+class QCborArray;
+
+
+/**
+ * @class TimelineSyncRelay
+ * @brief Sequences and fans out operation batches for one live session
+ *
+ * The relay does not understand timeline data. It stamps every batch it receives
+ * with the next sequence number, appends it to an in-memory log and forwards it
+ * to every participant, sender included. All clients therefore apply the same
+ * batches in the same order, which is what makes them converge (see
+ * TimelineSyncSession). A client that reconnects names the last sequence it saw
+ * and receives only the batches it missed.
+ *
+ * The first participant (the host) seeds the relay with a snapshot of its project.
+ * A joiner whose project hashes differently receives that snapshot before the log,
+ * so everybody starts from the host's state rather than from their own file. Once
+ * the log exceeds LOG_LIMIT batches, the oldest are folded into the snapshot, which
+ * the relay can do with the generic put/set/del/arc/ver rules alone.
+ *
+ * Only clients that present the session token in their hello may join; anybody
+ * else is told so and disconnected. Traffic is not encrypted, so a relay listening
+ * beyond localhost belongs on a trusted network.
+ *
+ * Runs headless inside the application executable ("--sync-relay"), started by
+ * the hosting user or by hand on any machine the participants can reach.
+ */
+class TimelineSyncRelay : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimelineSyncRelay(QObject* parent = nullptr);
+
+    bool listen(const QHostAddress& address, quint16 port, QString* errorString = nullptr);
+    quint16 port() const;
+    int participantCount() const { return clients_.size(); }
+
+    void setSessionToken(const QString& token) { token_ = token; }             ///< Token every hello must carry
+    void setExitWhenIdle(bool exitWhenIdle) { exitWhenIdle_ = exitWhenIdle; }   ///< Quit the application once the last participant leaves
+
+    /**
+     * @brief Entry point for "--sync-relay [--sync-port N] [--sync-shared] [--sync-exit-when-idle]"
+     *
+     * Listens on localhost only unless --sync-shared is given. The session token is
+     * read from the TimelineSyncProtocol::TOKEN_VARIABLE environment variable; without
+     * one a token is generated and printed.
+     *
+     * @return Process exit code
+     */
+    static int runStandalone(const QStringList& arguments);
+
+private slots:
+    void onNewConnection();
+
+private:
+    struct Client
+    {
+        QByteArray buffer;          ///< Bytes of an incomplete frame
+        bool joined = false;        ///< Said hello (receives broadcasts)
+        QCborMap waitingHello;      ///< Hello held back until the snapshot is seeded (empty if none)
+    };
+
+    void onReadyRead(QTcpSocket* socket);
+    void onDisconnected(QTcpSocket* socket);
+    void handleHello(QTcpSocket* socket, const QCborMap& message);
+    void handleSnapshot(QTcpSocket* socket, const QCborMap& message);
+    void handleOps(QTcpSocket* socket, QCborMap message);
+    void admitWaitingClients();                                 ///< Replay the hellos held back while nobody had seeded the relay
+    void compactLog(qsizetype count);                           ///< Fold the oldest batches into the snapshot
+    void foldOps(const QCborArray& ops);                        ///< Apply one batch's operations to the snapshot
+    QByteArray snapshotHash();                                  ///< Cached stateHash() of the snapshot
+    void deny(QTcpSocket* socket, const QString& reason);
+    void broadcast(const QByteArray& frame);
+    void broadcastPeers();
+
+    QTcpServer* server_;
+    QHash<QTcpSocket*, Client> clients_;
+    QVector<QByteArray> log_;           ///< Encoded batches; log_[i] has sequence snapshotSequence_ + i + 1
+    QHash<QString, QJsonObject> snapshot_;  ///< Every event as of snapshotSequence_
+    QJsonObject snapshotVersion_;       ///< Version range and name as of snapshotSequence_
+    qint64 snapshotSequence_ = 0;       ///< Last batch folded into the snapshot
+    QByteArray snapshotHash_;           ///< Empty until computed (and after every compaction)
+    bool seeded_ = false;               ///< A participant has uploaded the snapshot
+    QTcpSocket* seeder_ = nullptr;      ///< Client currently uploading it
+    QString relayId_;                   ///< Distinguishes this process from an earlier relay on the same port
+    QString token_;                     ///< Session token (no client joins while empty)
+    bool exitWhenIdle_ = false;
+
+    static constexpr int LOG_LIMIT = 2000;     ///< Batches kept before compacting
+    static constexpr int LOG_KEEP = 500;       ///< Batches left after compacting, so short reconnects still get a replay
+};
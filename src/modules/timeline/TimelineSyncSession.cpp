@@ -0,0 +1,901 @@
+// TimelineSyncSession.cpp
+
+
+#include "TimelineSyncSession.h"
+#include "TimelineSyncProtocol.h"
+#include "TimelineModel.h"
+#include "TimelineSerializer.h"
+#include <QTcpSocket>
+#include <QTimer>
+#include <QCborMap>
+#include <QCborValue>
+#include <QUuid>
+#include <QDebug>
+
+
+TimelineSyncSession::TimelineSyncSession(TimelineModel* model, QObject* parent)
+    : QObject(parent)
+    , model_(model)
+    , socket_(new QTcpSocket(this))
+    , flushTimer_(new QTimer(this))
+    , reconnectTimer_(new QTimer(this))
+{
+    flushTimer_->setSingleShot(true);
+    flushTimer_->setInterval(FLUSH_DELAY_MS);
+    connect(flushTimer_, &QTimer::timeout, this, &TimelineSyncSession::flushLocalChanges);
+
+    reconnectTimer_->setSingleShot(true);
+    reconnectTimer_->setInterval(RECONNECT_DELAY_MS);
+    connect(reconnectTimer_, &QTimer::timeout, this, [this]()
+    {
+        if (active_)
+        {
+            socket_->connectToHost(host_, port_);
+        }
+    });
+
+    connect(socket_, &QTcpSocket::connected, this, &TimelineSyncSession::onConnected);
+    connect(socket_, &QTcpSocket::disconnected, this, &TimelineSyncSession::onDisconnected);
+    connect(socket_, &QTcpSocket::errorOccurred, this, &TimelineSyncSession::onSocketError);
+    connect(socket_, &QTcpSocket::readyRead, this, &TimelineSyncSession::onReadyRead);
+
+    connectModel();
+}
+
+
+TimelineSyncSession::~TimelineSyncSession()
+{
+    stop();
+}
+
+
+void TimelineSyncSession::connectModel()
+{
+    auto one = [this](const QString& eventId) { markDirty(eventId); };
+    auto many = [this](const QStringList& eventIds) { markDirty(eventIds); };
+
+    connect(model_, &TimelineModel::eventAdded, this, one);
+    connect(model_, &TimelineModel::eventsAdded, this, many);
+    connect(model_, &TimelineModel::eventUpdated, this, one);
+    connect(model_, &TimelineModel::eventsUpdated, this, many);
+    connect(model_, &TimelineModel::eventRemoved, this, one);
+    connect(model_, &TimelineModel::eventsRemoved, this, many);
+    connect(model_, &TimelineModel::eventArchived, this, one);
+    connect(model_, &TimelineModel::eventsArchived, this, many);
+    connect(model_, &TimelineModel::eventRestored, this, one);
+    connect(model_, &TimelineModel::eventsRestored, this, many);
+    connect(model_, &TimelineModel::eventLockStateChanged, this, one);
+    connect(model_, &TimelineModel::versionDatesChanged, this, &TimelineSyncSession::markVersionDirty);
+    connect(model_, &TimelineModel::versionNameChanged, this, &TimelineSyncSession::markVersionDirty);
+
+    // Another project replaces this one: its events must not be sent as edits
+    connect(model_, &TimelineModel::eventsCleared, this, [this]()
+    {
+        if (active_)
+        {
+            stop();
+            emit sessionError("The project was closed, so the live session was left");
+        }
+    });
+}
+
+
+void TimelineSyncSession::start(const QString& host, quint16 port, const QString& token)
+{
+    stop();
+
+    host_ = host;
+    port_ = port;
+    token_ = token;
+    clientId_ = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    relayId_.clear();
+    lastSequence_ = 0;
+    nextBatch_ = 1;
+
+    resetShadow();
+    active_ = true;
+
+    socket_->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    socket_->connectToHost(host_, port_);
+}
+
+
+void TimelineSyncSession::stop()
+{
+    const bool wasActive = active_;
+    active_ = false;
+    ready_ = false;
+
+    reconnectTimer_->stop();
+    flushTimer_->stop();
+    socket_->abort();
+
+    buffer_.clear();
+    snapshotEvents_ = QCborArray();
+    shadow_.clear();
+    dirtyIds_.clear();
+    versionDirty_ = false;
+    unacknowledged_.clear();
+    pending_.clear();
+    pendingVersion_ = 0;
+    participants_ = 0;
+
+    if (wasActive)
+    {
+        emit connectionChanged(false);
+    }
+}
+
+
+bool TimelineSyncSession::isConnected() const
+{
+    return active_ && ready_;
+}
+
+
+QString TimelineSyncSession::address() const
+{
+    return QString("%1:%2").arg(host_).arg(port_);
+}
+
+
+QJsonObject TimelineSyncSession::stateOf(const TimelineEvent& event)
+{
+    QJsonObject state = TimelineSerializer::serializeEvent(event, false);
+    if (!event.laneControlEnabled)
+    {
+        state.remove("lane");   // Every participant lays out automatic lanes itself
+    }
+    return state;
+}
+
+
+QJsonObject TimelineSyncSession::versionState() const
+{
+    QJsonObject state;
+    state["vs"] = model_->versionStartDate().toString(Qt::ISODate);
+    state["ve"] = model_->versionEndDate().toString(Qt::ISODate);
+    state["vn"] = model_->versionName();
+    return state;
+}
+
+
+void TimelineSyncSession::resetShadow()
+{
+    shadow_.clear();
+
+    const QVector<TimelineEvent> events = model_->getAllEvents();
+    const QVector<TimelineEvent> archived = model_->getAllArchivedEvents();
+    shadow_.reserve(events.size() + archived.size());
+
+    for (const TimelineEvent& event : events)
+    {
+        shadow_.insert(event.id, stateOf(event));
+    }
+    for (const TimelineEvent& event : archived)
+    {
+        shadow_.insert(event.id, stateOf(event));
+    }
+
+    versionShadow_ = versionState();
+}
+
+
+// ============================================================================
+// Local changes
+// ============================================================================
+
+void TimelineSyncSession::markDirty(const QString& eventId)
+{
+    if (!active_ || applying_)
+    {
+        return;
+    }
+
+    dirtyIds_.insert(eventId);
+    if (!flushTimer_->isActive())
+    {
+        flushTimer_->start();
+    }
+}
+
+
+void TimelineSyncSession::markDirty(const QStringList& eventIds)
+{
+    if (!active_ || applying_)
+    {
+        return;
+    }
+
+    for (const QString& eventId : eventIds)
+    {
+        dirtyIds_.insert(eventId);
+    }
+    if (!flushTimer_->isActive())
+    {
+        flushTimer_->start();
+    }
+}
+
+
+void TimelineSyncSession::markVersionDirty()
+{
+    if (!active_ || applying_)
+    {
+        return;
+    }
+
+    versionDirty_ = true;
+    if (!flushTimer_->isActive())
+    {
+        flushTimer_->start();
+    }
+}
+
+
+void TimelineSyncSession::flushLocalChanges()
+{
+    flushTimer_->stop();
+
+    if (!active_ || (dirtyIds_.isEmpty() && !versionDirty_))
+    {
+        return;
+    }
+
+    // Current state of the changed events: a few lookups, or one pass over a big change
+    QHash<QString, QJsonObject> indexed;
+    const bool useIndex = dirtyIds_.size() > INDEX_THRESHOLD;
+    if (useIndex)
+    {
+        for (const QVector<TimelineEvent>& list : { model_->getAllEvents(), model_->getAllArchivedEvents() })
+        {
+            for (const TimelineEvent& event : list)
+            {
+                if (dirtyIds_.contains(event.id))
+                {
+                    indexed.insert(event.id, stateOf(event));
+                }
+            }
+        }
+    }
+
+    auto currentState = [&](const QString& eventId) -> std::optional<QJsonObject>
+    {
+        if (useIndex)
+        {
+            auto it = indexed.constFind(eventId);
+            return it != indexed.constEnd() ? std::optional<QJsonObject>(*it) : std::nullopt;
+        }
+        if (const TimelineEvent* event = model_->getEvent(eventId))
+        {
+            return stateOf(*event);
+        }
+        if (const TimelineEvent* event = model_->getArchivedEvent(eventId))
+        {
+            return stateOf(*event);
+        }
+        return std::nullopt;
+    };
+
+    QCborArray ops;
+    Batch batch;
+
+    for (const QString& eventId : std::as_const(dirtyIds_))
+    {
+        auto before = shadow_.constFind(eventId);
+        const std::optional<QJsonObject> after = currentState(eventId);
+
+        QCborMap op;
+        op.insert(QStringLiteral("id"), eventId);
+
+        if (before == shadow_.constEnd())
+        {
+            if (!after)
+            {
+                continue;
+            }
+
+            op.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_PUT));
+            op.insert(QStringLiteral("e"), QCborMap::fromJsonObject(*after));
+            ops.append(op);
+            batch.writes.append({ eventId, "*" });
+            shadow_.insert(eventId, *after);
+            continue;
+        }
+
+        if (!after)
+        {
+            op.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_DELETE));
+            ops.append(op);
+            batch.writes.append({ eventId, "*" });
+            shadow_.remove(eventId);
+            continue;
+        }
+
+        const QJsonObject& previous = *before;
+
+        if (previous.value("archived") != after->value("archived"))
+        {
+            QCborMap archiveOp = op;
+            archiveOp.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_ARCHIVE));
+            archiveOp.insert(QStringLiteral("a"), after->value("archived").toBool());
+            ops.append(archiveOp);
+            batch.writes.append({ eventId, "archived" });
+        }
+
+        // Only the fields that changed
+        QCborMap changed;
+        QCborArray removed;
+
+        for (auto it = after->constBegin(); it != after->constEnd(); ++it)
+        {
+            if (it.key() != "archived" && it.key() != "id" && previous.value(it.key()) != it.value())
+            {
+                changed.insert(it.key(), QCborValue::fromJsonValue(it.value()));
+                batch.writes.append({ eventId, it.key() });
+            }
+        }
+        for (auto it = previous.constBegin(); it != previous.constEnd(); ++it)
+        {
+            if (it.key() != "archived" && !after->contains(it.key()))
+            {
+                removed.append(it.key());
+                batch.writes.append({ eventId, it.key() });
+            }
+        }
+
+        if (!changed.isEmpty() || !removed.isEmpty())
+        {
+            op.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_SET));
+            if (!changed.isEmpty())
+            {
+                op.insert(QStringLiteral("f"), changed);
+            }
+            if (!removed.isEmpty())
+            {
+                op.insert(QStringLiteral("u"), removed);
+            }
+            ops.append(op);
+        }
+
+        shadow_.insert(eventId, *after);
+    }
+    dirtyIds_.clear();
+
+    if (versionDirty_)
+    {
+        versionDirty_ = false;
+
+        const QJsonObject version = versionState();
+        if (version != versionShadow_)
+        {
+            QCborMap op = QCborMap::fromJsonObject(version);
+            op.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_VERSION));
+            ops.append(op);
+            batch.writesVersion = true;
+            versionShadow_ = version;
+        }
+    }
+
+    if (ops.isEmpty())
+    {
+        return;     // Lane-only relayouts and the like
+    }
+
+    const qint64 batchNumber = nextBatch_++;
+
+    QCborMap message;
+    message.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::OPS));
+    message.insert(QStringLiteral("c"), clientId_);
+    message.insert(QStringLiteral("b"), batchNumber);
+    message.insert(QStringLiteral("ops"), ops);
+    batch.frame = TimelineSyncProtocol::encode(message);
+
+    for (const auto& write : std::as_const(batch.writes))
+    {
+        ++pending_[write.first][write.second];
+    }
+    pendingVersion_ += batch.writesVersion ? 1 : 0;
+
+    // Sent now, or after the next (re)connect has caught up
+    if (ready_)
+    {
+        send(batch.frame);
+    }
+    unacknowledged_.insert(batchNumber, batch);
+}
+
+
+void TimelineSyncSession::acknowledge(qint64 batchNumber)
+{
+    auto batch = unacknowledged_.find(batchNumber);
+    if (batch == unacknowledged_.end())
+    {
+        return;
+    }
+
+    for (const auto& write : std::as_const(batch->writes))
+    {
+        auto fields = pending_.find(write.first);
+        if (fields == pending_.end())
+        {
+            continue;
+        }
+
+        if (--(*fields)[write.second] <= 0)
+        {
+            fields->remove(write.second);
+        }
+        if (fields->isEmpty())
+        {
+            pending_.erase(fields);
+        }
+    }
+    pendingVersion_ -= batch->writesVersion ? 1 : 0;
+
+    unacknowledged_.erase(batch);
+}
+
+
+bool TimelineSyncSession::isPending(const QString& eventId, const QString& field) const
+{
+    auto fields = pending_.constFind(eventId);
+    return fields != pending_.constEnd() && (fields->contains("*") || fields->contains(field));
+}
+
+
+// ============================================================================
+// Remote changes
+// ============================================================================
+
+void TimelineSyncSession::applyRemoteBatch(const QCborArray& ops)
+{
+    // Unflushed local edits become pending first, so the rules below protect them too
+    flushLocalChanges();
+
+    QHash<QString, std::optional<QJsonObject>> targets;
+    auto stateFor = [&](const QString& eventId) -> std::optional<QJsonObject>
+    {
+        auto target = targets.constFind(eventId);
+        if (target != targets.constEnd())
+        {
+            return *target;
+        }
+        auto known = shadow_.constFind(eventId);
+        return known != shadow_.constEnd() ? std::optional<QJsonObject>(*known) : std::nullopt;
+    };
+
+    QJsonObject versionTarget = versionShadow_;
+    bool versionChanged = false;
+
+    // ========== FOLD THE BATCH INTO ONE TARGET STATE PER EVENT ==========
+    for (const QCborValue& value : ops)
+    {
+        const QCborMap op = value.toMap();
+        const QString kind = op.value(QStringLiteral("o")).toString();
+        const QString eventId = op.value(QStringLiteral("id")).toString();
+
+        if (kind == TimelineSyncProtocol::OP_VERSION)
+        {
+            if (pendingVersion_ == 0)
+            {
+                versionTarget["vs"] = op.value(QStringLiteral("vs")).toString();
+                versionTarget["ve"] = op.value(QStringLiteral("ve")).toString();
+                versionTarget["vn"] = op.value(QStringLiteral("vn")).toString();
+                versionChanged = true;
+            }
+            continue;
+        }
+
+        // Our unacknowledged whole-event write is ordered after this one everywhere
+        if (eventId.isEmpty() || isPending(eventId, "*"))
+        {
+            continue;
+        }
+
+        const std::optional<QJsonObject> state = stateFor(eventId);
+
+        if (kind == TimelineSyncProtocol::OP_PUT)
+        {
+            QJsonObject event = op.value(QStringLiteral("e")).toMap().toJsonObject();
+
+            // Fields we wrote after it survive
+            if (state)
+            {
+                const QHash<QString, int> ownFields = pending_.value(eventId);
+                for (auto it = ownFields.cbegin(); it != ownFields.cend(); ++it)
+                {
+                    if (state->contains(it.key()))
+                    {
+                        event[it.key()] = state->value(it.key());
+                    }
+                    else
+                    {
+                        event.remove(it.key());
+                    }
+                }
+            }
+
+            targets.insert(eventId, event);
+        }
+        else if (kind == TimelineSyncProtocol::OP_DELETE)
+        {
+            targets.insert(eventId, std::nullopt);
+        }
+        else if (kind == TimelineSyncProtocol::OP_ARCHIVE)
+        {
+            if (state && !isPending(eventId, "archived"))
+            {
+                QJsonObject event = *state;
+                event["archived"] = op.value(QStringLiteral("a")).toBool();
+                targets.insert(eventId, event);
+            }
+        }
+        else if (kind == TimelineSyncProtocol::OP_SET)
+        {
+            if (!state)
+            {
+                continue;   // Deleted earlier in the order: ignored by everyone
+            }
+
+            QJsonObject event = *state;
+
+            const QCborMap changed = op.value(QStringLiteral("f")).toMap();
+            for (auto it = changed.cbegin(); it != changed.cend(); ++it)
+            {
+                const QString field = it.key().toString();
+                if (!isPending(eventId, field))
+                {
+                    event[field] = it.value().toJsonValue();
+                }
+            }
+
+            const QCborArray removed = op.value(QStringLiteral("u")).toArray();
+            for (const QCborValue& key : removed)
+            {
+                if (!isPending(eventId, key.toString()))
+                {
+                    event.remove(key.toString());
+                }
+            }
+
+            targets.insert(eventId, event);
+        }
+    }
+
+    // ========== ONE MODEL CALL PER KIND OF CHANGE ==========
+    QStringList removeActive;
+    QStringList removeArchived;
+    QStringList restoreIds;
+    QStringList archiveIds;
+    QVector<TimelineEvent> updates;
+    QVector<TimelineEvent> adds;
+    QVector<TimelineEvent> archivedAdds;
+    QVector<TimelineEvent> archivedUpdates;
+
+    for (auto it = targets.cbegin(); it != targets.cend(); ++it)
+    {
+        auto known = shadow_.constFind(it.key());
+        const bool existed = known != shadow_.constEnd();
+        const std::optional<QJsonObject>& after = it.value();
+
+        if (!existed && !after)
+        {
+            continue;
+        }
+
+        const bool wasArchived = existed && known->value("archived").toBool();
+
+        if (!after)
+        {
+            (wasArchived ? removeArchived : removeActive).append(it.key());
+            continue;
+        }
+
+        if (existed && *known == *after)
+        {
+            continue;
+        }
+
+        TimelineEvent event = TimelineSerializer::deserializeEvent(*after, false);
+        const bool isArchived = event.archived;
+
+        if (!existed)
+        {
+            (isArchived ? archivedAdds : adds).append(event);
+        }
+        else if (!wasArchived && !isArchived)
+        {
+            updates.append(event);
+        }
+        else if (!wasArchived && isArchived)
+        {
+            event.archived = false;         // Updated in place, then moved
+            updates.append(event);
+            archiveIds.append(event.id);
+        }
+        else if (wasArchived && !isArchived)
+        {
+            restoreIds.append(event.id);    // Moved back, then updated in place
+            updates.append(event);
+        }
+        else
+        {
+            archivedUpdates.append(event);
+        }
+    }
+
+    applying_ = true;
+
+    model_->removeEvents(removeActive);
+    model_->permanentlyDeleteArchivedEvents(removeArchived);
+    model_->restoreEvents(restoreIds);
+    model_->updateEvents(updates);
+    model_->addEvents(adds);
+    model_->archiveEvents(archiveIds);
+    model_->addArchivedEvents(archivedAdds);
+    model_->updateArchivedEvents(archivedUpdates);
+
+    if (versionChanged && versionTarget != versionShadow_)
+    {
+        const QDate start = QDate::fromString(versionTarget["vs"].toString(), Qt::ISODate);
+        const QDate end = QDate::fromString(versionTarget["ve"].toString(), Qt::ISODate);
+        if (start.isValid() && end.isValid()
+            && (start != model_->versionStartDate() || end != model_->versionEndDate()))
+        {
+            model_->setVersionDates(start, end);
+        }
+        if (versionTarget["vn"].toString() != model_->versionName())
+        {
+            model_->setVersionName(versionTarget["vn"].toString());
+        }
+        versionShadow_ = versionTarget;
+    }
+
+    applying_ = false;
+
+    for (auto it = targets.cbegin(); it != targets.cend(); ++it)
+    {
+        if (it.value())
+        {
+            shadow_.insert(it.key(), *it.value());
+        }
+        else
+        {
+            shadow_.remove(it.key());
+        }
+    }
+
+    if (!targets.isEmpty() || versionChanged)
+    {
+        emit remoteChangesApplied(targets.size());
+    }
+}
+
+
+void TimelineSyncSession::applySnapshot(const QCborMap& lastChunk)
+{
+    // Every snapshot event as a put and every event it lacks as a delete, so our own
+    // pending writes are protected exactly as for any other remote batch
+    QCborArray ops;
+    QSet<QString> snapshotIds;
+    snapshotIds.reserve(snapshotEvents_.size());
+
+    for (const QCborValue& value : std::as_const(snapshotEvents_))
+    {
+        const QCborMap event = value.toMap();
+        const QString eventId = event.value(QStringLiteral("id")).toString();
+        snapshotIds.insert(eventId);
+
+        QCborMap op;
+        op.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_PUT));
+        op.insert(QStringLiteral("id"), eventId);
+        op.insert(QStringLiteral("e"), event);
+        ops.append(op);
+    }
+    snapshotEvents_ = QCborArray();
+
+    for (auto it = shadow_.cbegin(); it != shadow_.cend(); ++it)
+    {
+        if (!snapshotIds.contains(it.key()))
+        {
+            QCborMap op;
+            op.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_DELETE));
+            op.insert(QStringLiteral("id"), it.key());
+            ops.append(op);
+        }
+    }
+
+    QCborMap version;
+    version.insert(QStringLiteral("o"), QString::fromLatin1(TimelineSyncProtocol::OP_VERSION));
+    version.insert(QStringLiteral("vs"), lastChunk.value(QStringLiteral("vs")));
+    version.insert(QStringLiteral("ve"), lastChunk.value(QStringLiteral("ve")));
+    version.insert(QStringLiteral("vn"), lastChunk.value(QStringLiteral("vn")));
+    ops.append(version);
+
+    applyRemoteBatch(ops);
+    lastSequence_ = lastChunk.value(QStringLiteral("s")).toInteger();
+
+    qDebug() << "TimelineSyncSession: Took over the session's project at sequence" << lastSequence_;
+}
+
+
+void TimelineSyncSession::sendSnapshot()
+{
+    for (const QByteArray& frame : TimelineSyncProtocol::encodeSnapshot(shadow_, versionShadow_, lastSequence_))
+    {
+        send(frame);
+    }
+
+    qDebug() << "TimelineSyncSession: Seeded the relay with" << shadow_.size() << "events";
+}
+
+
+// ============================================================================
+// Connection
+// ============================================================================
+
+void TimelineSyncSession::onConnected()
+{
+    buffer_.clear();
+    snapshotEvents_ = QCborArray();
+    ready_ = false;
+
+    // Local edits are part of the state we describe
+    flushLocalChanges();
+
+    QCborMap hello;
+    hello.insert(QStringLiteral("t"), QString::fromLatin1(TimelineSyncProtocol::HELLO));
+    hello.insert(QStringLiteral("v"), TimelineSyncProtocol::VERSION);
+    hello.insert(QStringLiteral("k"), token_);
+    hello.insert(QStringLiteral("c"), clientId_);
+    hello.insert(QStringLiteral("r"), relayId_);
+    hello.insert(QStringLiteral("s"), lastSequence_);
+    hello.insert(QStringLiteral("h"), TimelineSyncProtocol::stateHash(shadow_, versionShadow_));
+    socket_->write(TimelineSyncProtocol::encode(hello));
+
+    qDebug() << "TimelineSyncSession: Connected to" << address() << "- catching up from sequence" << lastSequence_;
+}
+
+
+void TimelineSyncSession::onDisconnected()
+{
+    const bool wasReady = ready_;
+    ready_ = false;
+    participants_ = 0;
+
+    if (!active_)
+    {
+        return;
+    }
+
+    if (wasReady)
+    {
+        emit connectionChanged(false);
+    }
+
+    // Edits keep working offline and are sent after reconnecting
+    reconnectTimer_->start();
+}
+
+
+void TimelineSyncSession::onSocketError(QAbstractSocket::SocketError /*error*/)
+{
+    if (!active_)
+    {
+        return;
+    }
+
+    qWarning() << "TimelineSyncSession:" << socket_->errorString();
+
+    // A refused connection never reaches disconnected(), so retry from here
+    if (socket_->state() == QAbstractSocket::UnconnectedState && !reconnectTimer_->isActive())
+    {
+        emit sessionError(QString("Relay %1: %2 - retrying").arg(address(), socket_->errorString()));
+        reconnectTimer_->start();
+    }
+}
+
+
+void TimelineSyncSession::onReadyRead()
+{
+    buffer_.append(socket_->readAll());
+
+    QCborMap message;
+    bool malformed = false;
+    while (active_ && TimelineSyncProtocol::takeMessage(buffer_, message, &malformed))
+    {
+        handleMessage(message);
+    }
+
+    if (malformed)
+    {
+        emit sessionError("Received a corrupt message from the relay - reconnecting");
+        socket_->abort();
+    }
+}
+
+
+void TimelineSyncSession::handleMessage(const QCborMap& message)
+{
+    const QString type = message.value(QStringLiteral("t")).toString();
+
+    if (type == TimelineSyncProtocol::OPS)
+    {
+        // Duplicates can only come from a replay overlapping what we already have
+        const qint64 sequence = message.value(QStringLiteral("s")).toInteger();
+        if (sequence <= lastSequence_)
+        {
+            return;
+        }
+        lastSequence_ = sequence;
+
+        if (message.value(QStringLiteral("c")).toString() == clientId_)
+        {
+            acknowledge(message.value(QStringLiteral("b")).toInteger());
+        }
+        else
+        {
+            applyRemoteBatch(message.value(QStringLiteral("ops")).toArray());
+        }
+    }
+    else if (type == TimelineSyncProtocol::WELCOME)
+    {
+        const QString relayId = message.value(QStringLiteral("r")).toString();
+        if (relayId != relayId_)
+        {
+            relayId_ = relayId;
+            lastSequence_ = 0;      // A new relay numbers from scratch
+        }
+
+        if (message.value(QStringLiteral("x")).toBool())
+        {
+            sendSnapshot();
+        }
+    }
+    else if (type == TimelineSyncProtocol::SNAPSHOT)
+    {
+        for (const QCborValue& event : message.value(QStringLiteral("e")).toArray())
+        {
+            snapshotEvents_.append(event);
+        }
+
+        if (message.value(QStringLiteral("d")).toBool())
+        {
+            applySnapshot(message);
+        }
+    }
+    else if (type == TimelineSyncProtocol::READY)
+    {
+        ready_ = true;
+
+        // Batches the relay never echoed (it restarted, or we were offline)
+        for (const Batch& batch : std::as_const(unacknowledged_))
+        {
+            send(batch.frame);
+        }
+
+        emit connectionChanged(true);
+    }
+    else if (type == TimelineSyncProtocol::PEERS)
+    {
+        participants_ = static_cast<int>(message.value(QStringLiteral("n")).toInteger());
+        emit participantsChanged(participants_);
+    }
+    else if (type == TimelineSyncProtocol::DENIED)
+    {
+        // Retrying would be refused the same way
+        const QString reason = message.value(QStringLiteral("m")).toString();
+        stop();
+        emit sessionError(QString("The relay at %1 refused to let us join: %2").arg(address(), reason));
+    }
+}
+
+
+void TimelineSyncSession::send(const QByteArray& frame)
+{
+    if (socket_->state() == QAbstractSocket::ConnectedState)
+    {
+        socket_->write(frame);
+    }
+}
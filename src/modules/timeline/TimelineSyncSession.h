@@ -0,0 +1,131 @@
+// TimelineSyncSession.h
+
+
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QJsonObject>
+#include <QCborArray>
+#include <QAbstractSocket>
+#include <optional>
+
+
+class TimelineModel;
+struct TimelineEvent;
+class QTcpSocket;
+class QTimer;
+class QCborMap;
+
+
+/**
+ * @class TimelineSyncSession
+ * @brief Live co-editing: streams local model changes to a relay and applies everyone else's
+ *
+ * Local changes are picked up from the model's signals and diffed against a shadow
+ * copy of every event, so an edit is sent as the fields it changed rather than the
+ * whole project. Changes are batched for FLUSH_DELAY_MS and sent as one message;
+ * a received batch is applied with one model call per kind of change (add, update,
+ * remove, archive, restore), so cost follows the size of the edit.
+ *
+ * Convergence: the relay puts all batches in one order, and for every event field
+ * the last write in that order wins. A local write is applied at once and stays
+ * "pending" until the relay echoes its batch back; remote writes to a pending field
+ * are skipped because the pending write will be ordered after them everywhere.
+ * Deleting wins over earlier field writes, so a field write to a deleted event is
+ * ignored by every participant alike.
+ *
+ * The first participant seeds the relay with its project; everybody who joins later
+ * and whose project differs receives that snapshot first, applied like a remote
+ * batch, so the session always starts from the host's state. Attachments are not
+ * synchronized.
+ */
+class TimelineSyncSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimelineSyncSession(TimelineModel* model, QObject* parent = nullptr);
+    ~TimelineSyncSession() override;
+
+    void start(const QString& host, quint16 port, const QString& token);  ///< Connect (and keep reconnecting) to a relay
+    void stop();                                        ///< Leave the session; unsent changes stay local
+
+    bool isActive() const { return active_; }           ///< Started and not stopped (may be reconnecting)
+    bool isConnected() const;
+    bool isApplying() const { return applying_; }       ///< Remote changes are being applied (not a local edit)
+    int participantCount() const { return participants_; }
+    QString address() const;                            ///< "host:port" of the relay
+
+signals:
+    void connectionChanged(bool connected);
+    void participantsChanged(int count);
+    void remoteChangesApplied(int eventCount);
+    void sessionError(const QString& message);
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onSocketError(QAbstractSocket::SocketError error);
+    void onReadyRead();
+    void flushLocalChanges();
+
+private:
+    struct Batch
+    {
+        QByteArray frame;                   ///< Encoded message, resent after a reconnect
+        QVector<QPair<QString, QString>> writes;    ///< (event ID, field) pairs it writes; "*" = whole event
+        bool writesVersion = false;
+    };
+
+    void connectModel();
+    void resetShadow();
+    void markDirty(const QString& eventId);
+    void markDirty(const QStringList& eventIds);
+    void markVersionDirty();
+
+    void handleMessage(const QCborMap& message);
+    void acknowledge(qint64 batchNumber);
+    void applyRemoteBatch(const QCborArray& ops);
+    void applySnapshot(const QCborMap& lastChunk);      ///< Turn the received snapshot into one remote batch
+    void sendSnapshot();                                ///< Seed the relay with our project
+    void send(const QByteArray& frame);
+
+    bool isPending(const QString& eventId, const QString& field) const;
+    static QJsonObject stateOf(const TimelineEvent& event);     ///< Synchronized fields of an event (no automatic lane, no attachments)
+    QJsonObject versionState() const;
+
+    TimelineModel* model_;
+    QTcpSocket* socket_;
+    QTimer* flushTimer_;
+    QTimer* reconnectTimer_;
+
+    QString host_;
+    quint16 port_ = 0;
+    QString token_;                     ///< Session token presented in every hello
+    QString clientId_;                  ///< Identifies our batches when the relay echoes them
+    QString relayId_;                   ///< Relay process the sequence numbers belong to
+    qint64 lastSequence_ = 0;           ///< Last relay sequence applied
+    qint64 nextBatch_ = 1;
+    QByteArray buffer_;                 ///< Bytes of an incomplete frame
+    QCborArray snapshotEvents_;         ///< Snapshot chunks received so far
+
+    QHash<QString, QJsonObject> shadow_;    ///< Last known synchronized state of every active and archived event
+    QJsonObject versionShadow_;             ///< Last known version range and name
+    QSet<QString> dirtyIds_;                ///< Changed locally since the last flush
+    bool versionDirty_ = false;
+
+    QMap<qint64, Batch> unacknowledged_;                ///< Sent (or queued) batches the relay has not echoed yet
+    QHash<QString, QHash<QString, int>> pending_;       ///< Unacknowledged writes per event and field
+    int pendingVersion_ = 0;                            ///< Unacknowledged version writes
+
+    bool active_ = false;
+    bool ready_ = false;                ///< Caught up after (re)connecting
+    bool applying_ = false;
+    int participants_ = 0;
+
+    static constexpr int FLUSH_DELAY_MS = 50;
+    static constexpr int RECONNECT_DELAY_MS = 2000;
+    static constexpr int INDEX_THRESHOLD = 16;      ///< Above this many changed events, index the model once instead of searching per event
+};
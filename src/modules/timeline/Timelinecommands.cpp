@@ -2,6 +2,7 @@
 
 
 #include "TimelineCommands.h"
+#include <QSet>
 #include <QDebug>
 
 
@@ -248,6 +249,9 @@ BatchDeleteCommand::BatchDeleteCommand(TimelineModel* model,
                                        bool softDelete,
                                        QUndoCommand* parent)
     : QUndoCommand(parent)
+    , model_(model)
+    , eventIds_(eventIds)
+    , softDelete_(softDelete)
 {
     if (eventIds.size() == 1)
     {
@@ -257,12 +261,170 @@ BatchDeleteCommand::BatchDeleteCommand(TimelineModel* model,
     {
         setText(QString("Delete %1 events").arg(eventIds.size()));
     }
+}
+
+
+void BatchDeleteCommand::redo()
+{
+    if (softDelete_)
+    {
+        affectedIds_ = model_->archiveEvents(eventIds_);
+
+        qDebug() << "BatchDeleteCommand::redo() - Archived" << affectedIds_.size() << "events";
+        return;
+    }
+
+    // Back up the current state so undo can re-add exactly what was deleted
+    const QSet<QString> toDelete(eventIds_.cbegin(), eventIds_.cend());
+    const QVector<TimelineEvent> all = model_->getAllEvents();
+
+    eventBackups_.clear();
+    affectedIds_.clear();
+
+    for (const TimelineEvent& event : all)
+    {
+        if (toDelete.contains(event.id))
+        {
+            eventBackups_.append(event);
+            affectedIds_.append(event.id);
+        }
+    }
+
+    int count = model_->removeEvents(affectedIds_);
+
+    qDebug() << "BatchDeleteCommand::redo() - Deleted" << count << "events";
+}
+
+
+void BatchDeleteCommand::undo()
+{
+    if (softDelete_)
+    {
+        const QStringList restored = model_->restoreEvents(affectedIds_);
+
+        if (restored.size() != affectedIds_.size())
+        {
+            qWarning() << "BatchDeleteCommand::undo() - Restored" << restored.size() << "of" << affectedIds_.size() << "events";
+        }
+
+        qDebug() << "BatchDeleteCommand::undo() - Restored" << restored.size() << "events";
+        return;
+    }
+
+    const QStringList added = model_->addEvents(eventBackups_);
+
+    if (added.size() != eventBackups_.size())
+    {
+        qWarning() << "BatchDeleteCommand::undo() - Re-added" << added.size() << "of" << eventBackups_.size() << "events";
+    }
+
+    qDebug() << "BatchDeleteCommand::undo() - Re-added" << added.size() << "events";
+}
+
+
+// ============================================================================
+// BatchUpdateEventsCommand Implementation
+// ============================================================================
+
+BatchUpdateEventsCommand::BatchUpdateEventsCommand(TimelineModel* model,
+                                                   const QVector<TimelineEvent>& updatedEvents,
+                                                   const QString& text,
+                                                   QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , model_(model)
+{
+    setText(text);
+
+    oldEvents_.reserve(updatedEvents.size());
+    newEvents_.reserve(updatedEvents.size());
 
-    // Create child commands for each event
-    for (const QString& eventId : eventIds)
+    QStringList eventIds;
+    eventIds.reserve(updatedEvents.size());
+    for (const TimelineEvent& updated : updatedEvents)
     {
-        new DeleteEventCommand(model, eventId, softDelete, this);
+        eventIds.append(updated.id);
     }
+
+    // Back up the current state of every event that still exists (one pass over the model)
+    const QHash<QString, TimelineEvent> current = model_->getEvents(eventIds);
+    for (const TimelineEvent& updated : updatedEvents)
+    {
+        auto it = current.constFind(updated.id);
+        if (it != current.constEnd())
+        {
+            oldEvents_.append(it.value());
+            newEvents_.append(updated);
+        }
+    }
+}
+
+
+void BatchUpdateEventsCommand::redo()
+{
+    int count = model_->updateEvents(newEvents_);
+
+    qDebug() << "BatchUpdateEventsCommand::redo() - Updated" << count << "events";
+}
+
+
+void BatchUpdateEventsCommand::undo()
+{
+    int count = model_->updateEvents(oldEvents_);
+
+    qDebug() << "BatchUpdateEventsCommand::undo() - Restored" << count << "events";
+}
+
+
+// ============================================================================
+// BatchAddEventsCommand Implementation
+// ============================================================================
+
+BatchAddEventsCommand::BatchAddEventsCommand(TimelineModel* model,
+                                             const QVector<TimelineEvent>& events,
+                                             const QString& text,
+                                             QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , model_(model)
+    , events_(events)
+    , firstRun_(true)
+{
+    setText(text);
+}
+
+
+void BatchAddEventsCommand::redo()
+{
+    addedIds_ = model_->addEvents(events_);
+
+    if (firstRun_)
+    {
+        // Keep the stored copies as the model created them, so generated IDs survive undo/redo
+        const QSet<QString> added(addedIds_.cbegin(), addedIds_.cend());
+        const QVector<TimelineEvent> all = model_->getAllEvents();
+
+        events_.clear();
+        events_.reserve(addedIds_.size());
+
+        for (const TimelineEvent& event : all)
+        {
+            if (added.contains(event.id))
+            {
+                events_.append(event);
+            }
+        }
+
+        firstRun_ = false;
+    }
+
+    qDebug() << "BatchAddEventsCommand::redo() - Added" << addedIds_.size() << "events";
+}
+
+
+void BatchAddEventsCommand::undo()
+{
+    int count = model_->removeEvents(addedIds_);
+
+    qDebug() << "BatchAddEventsCommand::undo() - Removed" << count << "events";
 }
 
 
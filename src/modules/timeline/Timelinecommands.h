@@ -86,7 +86,11 @@ private:
 
 /**
  * @class BatchDeleteCommand
- * @brief Undoable command for deleting multiple events at once
+ * @brief Undoable command for deleting/archiving multiple events at once
+ *
+ * The whole set goes through TimelineModel::archiveEvents()/restoreEvents() (soft
+ * delete) or removeEvents()/addEvents() (hard delete), so each redo/undo is one
+ * compaction pass, one relayout and one notification.
  */
 class BatchDeleteCommand : public QUndoCommand
 {
@@ -99,7 +103,76 @@ public:
                        bool softDelete = true,
                        QUndoCommand* parent = nullptr);
 
-    // No need to override redo/undo - child commands handle it
+    void redo() override;                       ///< Archive or delete the events
+    void undo() override;                       ///< Restore or re-add the events affected by redo
+
+private:
+    TimelineModel* model_;                      ///< Model to modify (not owned)
+    QStringList eventIds_;                      ///< Events to delete
+    QStringList affectedIds_;                   ///< Events the last redo actually archived/deleted
+    QVector<TimelineEvent> eventBackups_;       ///< Hard delete backups for undo
+    bool softDelete_;                           ///< Archive vs hard delete
+};
+
+
+/**
+ * @class BatchUpdateEventsCommand
+ * @brief Undoable command for replacing many events in a single model update
+ *
+ * The whole set is applied through TimelineModel::updateEvents() so lanes are
+ * recalculated once.
+ */
+class BatchUpdateEventsCommand : public QUndoCommand
+{
+public:
+    /**
+     * @brief Construct a batch update command
+     * @param updatedEvents New state for each event (matched by ID)
+     * @param text Undo stack description
+     */
+    BatchUpdateEventsCommand(TimelineModel* model,
+                             const QVector<TimelineEvent>& updatedEvents,
+                             const QString& text,
+                             QUndoCommand* parent = nullptr);
+
+    void redo() override;                       ///< Apply the new event states
+    void undo() override;                       ///< Restore the original event states
+
+private:
+    TimelineModel* model_;                      ///< Model to modify (not owned)
+    QVector<TimelineEvent> oldEvents_;          ///< Original event states
+    QVector<TimelineEvent> newEvents_;          ///< Updated event states
+};
+
+
+/**
+ * @class BatchAddEventsCommand
+ * @brief Undoable command for inserting many events in a single model update
+ *
+ * Used by bulk imports. The whole set goes through TimelineModel::addEvents() and
+ * TimelineModel::removeEvents(), so each redo/undo is one relayout and one notification.
+ */
+class BatchAddEventsCommand : public QUndoCommand
+{
+public:
+    /**
+     * @brief Construct a batch add command
+     * @param events Events to insert (IDs are generated for events without one)
+     * @param text Undo stack description
+     */
+    BatchAddEventsCommand(TimelineModel* model,
+                          const QVector<TimelineEvent>& events,
+                          const QString& text,
+                          QUndoCommand* parent = nullptr);
+
+    void redo() override;                       ///< Insert the events
+    void undo() override;                       ///< Remove the inserted events
+
+private:
+    TimelineModel* model_;                      ///< Model to modify (not owned)
+    QVector<TimelineEvent> events_;             ///< Events to insert
+    QStringList addedIds_;                      ///< IDs actually inserted (duplicates are skipped)
+    bool firstRun_;                             ///< True until the first redo has fixed the generated IDs
 };
 
 
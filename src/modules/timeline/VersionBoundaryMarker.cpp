@@ -26,10 +26,9 @@ VersionBoundaryMarker::VersionBoundaryMarker(TimelineCoordinateMapper* mapper,
 
 QRectF VersionBoundaryMarker::boundingRect() const
 {
-    double xPos = mapper_->dateToX(markerDate_);
-
+    // Local coordinates: the line is at x = 0, the item is moved with setPos()
     // Make bounding rect wide enough for the line and label
-    return QRectF(xPos - 40, -25, 80, timelineHeight_);
+    return QRectF(-40, -25, 80, timelineHeight_);
 }
 
 
@@ -37,7 +36,7 @@ void VersionBoundaryMarker::paint(QPainter* painter,
                                   const QStyleOptionGraphicsItem* /*option*/,
                                   QWidget* /*widget*/)
 {
-    double xPos = mapper_->dateToX(markerDate_);
+    const double xPos = 0.0;
 
     painter->setRenderHint(QPainter::Antialiasing, true);
 
@@ -82,14 +81,18 @@ void VersionBoundaryMarker::updatePosition()
                       ? mapper_->versionStart()
                       : mapper_->versionEnd();
 
-    prepareGeometryChange();
-    update();
+    // Moving the marker is a position change only; its geometry stays the same
+    setPos(mapper_->dateToX(markerDate_), 0.0);
 }
 
 
 void VersionBoundaryMarker::setTimelineHeight(double height)
 {
-    timelineHeight_ = height;
+    if (height == timelineHeight_)
+    {
+        return;
+    }
+
     prepareGeometryChange();
-    update();
+    timelineHeight_ = height;
 }
@@ -47,7 +47,7 @@ public:
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
 
     /**
-     * @brief Update marker position (call when dates change or zoom changes)
+     * @brief Move the marker to the current version boundary (call when dates change or zoom changes)
      */
     void updatePosition();
 
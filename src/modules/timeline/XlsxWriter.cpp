@@ -0,0 +1,970 @@
+// XlsxWriter.cpp
+
+
+#include "XlsxWriter.h"
+#include <QFile>
+#include <QIODevice>
+#include <QXmlStreamWriter>
+#include <QDebug>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+
+// ============================================================================
+// CRC-32 (ZIP polynomial)
+// ============================================================================
+
+static quint32 crc32Update(quint32 crc, const char* data, qint64 length)
+{
+    static const std::array<quint32, 256> table = []()
+    {
+        std::array<quint32, 256> t{};
+        for (quint32 i = 0; i < 256; ++i)
+        {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (qint64 i = 0; i < length; ++i)
+    {
+        crc = table[(crc ^ quint8(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+
+// ============================================================================
+// DeflateEncoder - streaming RFC 1951 encoder (LZ77 + fixed Huffman codes)
+// ============================================================================
+
+/**
+ * @brief Minimal streaming deflate encoder
+ *
+ * Uses a 64 KB sliding buffer with hash chains for LZ77 matching and the fixed
+ * Huffman tables, which keeps the encoder small while still compressing repetitive
+ * spreadsheet XML by roughly an order of magnitude. Memory use is constant.
+ */
+class DeflateEncoder
+{
+public:
+    explicit DeflateEncoder(QIODevice* sink)
+        : sink_(sink)
+        , window_(2 * WINDOW_SIZE)
+        , head_(HASH_SIZE, -1)
+        , prev_(WINDOW_SIZE, -1)
+    {
+    }
+
+    void reset()
+    {
+        fill_ = 0;
+        pos_ = 0;
+        std::fill(head_.begin(), head_.end(), -1);
+        std::fill(prev_.begin(), prev_.end(), -1);
+        bitBuffer_ = 0;
+        bitCount_ = 0;
+        out_.resize(0);
+        written_ = 0;
+        started_ = false;
+    }
+
+    void write(const char* data, qint64 length)
+    {
+        startBlock();
+
+        while (length > 0)
+        {
+            const qint64 chunk = qMin<qint64>(length, qint64(window_.size()) - fill_);
+            std::memcpy(window_.data() + fill_, data, size_t(chunk));
+            fill_ += int(chunk);
+            data += chunk;
+            length -= chunk;
+
+            // Keep a full match of lookahead until the input is finished
+            if (fill_ == int(window_.size()))
+            {
+                encode(fill_ - MAX_MATCH);
+                slide();
+            }
+        }
+    }
+
+    qint64 finish()
+    {
+        startBlock();
+        encode(fill_);
+        putSymbol(END_OF_BLOCK);
+
+        // The running block was opened as non-final - close the stream with an empty final block
+        putBits(1, 1);
+        putBits(1, 2);
+        putSymbol(END_OF_BLOCK);
+
+        if (bitCount_ > 0)
+        {
+            out_.append(char(bitBuffer_ & 0xFF));
+            bitBuffer_ = 0;
+            bitCount_ = 0;
+        }
+        flushOutput();
+
+        return written_;
+    }
+
+private:
+    static constexpr int WINDOW_SIZE = 32768;
+    static constexpr int WINDOW_MASK = WINDOW_SIZE - 1;
+    static constexpr int HASH_SIZE = 1 << 15;
+    static constexpr int MIN_MATCH = 3;
+    static constexpr int MAX_MATCH = 258;
+    static constexpr int MAX_CHAIN = 32;
+    static constexpr int END_OF_BLOCK = 256;
+    static constexpr int OUTPUT_CHUNK = 64 * 1024;
+
+    void startBlock()
+    {
+        if (!started_)
+        {
+            putBits(0, 1);      // BFINAL = 0
+            putBits(1, 2);      // BTYPE = 01 (fixed Huffman)
+            started_ = true;
+        }
+    }
+
+    int hashAt(int pos) const
+    {
+        const quint8* w = window_.data();
+        return ((w[pos] << 10) ^ (w[pos + 1] << 5) ^ w[pos + 2]) & (HASH_SIZE - 1);
+    }
+
+    void insertHash(int pos, int hash)
+    {
+        prev_[pos & WINDOW_MASK] = head_[hash];
+        head_[hash] = pos;
+    }
+
+    void encode(int limit)
+    {
+        const quint8* w = window_.data();
+
+        while (pos_ < limit)
+        {
+            int bestLength = 0;
+            int bestDistance = 0;
+            const int available = fill_ - pos_;
+
+            if (available >= MIN_MATCH)
+            {
+                const int hash = hashAt(pos_);
+                const int maxLength = qMin(available, MAX_MATCH);
+                int candidate = head_[hash];
+                int chain = MAX_CHAIN;
+
+                while (candidate >= 0 && pos_ - candidate <= WINDOW_SIZE && chain-- > 0)
+                {
+                    // Cheap reject on the byte that would extend the current best match
+                    if (w[candidate + bestLength] == w[pos_ + bestLength])
+                    {
+                        int length = 0;
+                        while (length < maxLength && w[candidate + length] == w[pos_ + length])
+                        {
+                            ++length;
+                        }
+
+                        if (length > bestLength)
+                        {
+                            bestLength = length;
+                            bestDistance = pos_ - candidate;
+                            if (length == maxLength)
+                            {
+                                break;
+                            }
+                        }
+                    }
+
+                    const int next = prev_[candidate & WINDOW_MASK];
+                    if (next >= candidate)
+                    {
+                        break;      // Slot was reused by a newer position - chain ends here
+                    }
+                    candidate = next;
+                }
+
+                insertHash(pos_, hash);
+            }
+
+            if (bestLength >= MIN_MATCH)
+            {
+                putMatch(bestLength, bestDistance);
+
+                for (int i = 1; i < bestLength; ++i)
+                {
+                    if (fill_ - (pos_ + i) >= MIN_MATCH)
+                    {
+                        insertHash(pos_ + i, hashAt(pos_ + i));
+                    }
+                }
+                pos_ += bestLength;
+            }
+            else
+            {
+                putSymbol(w[pos_]);
+                ++pos_;
+            }
+        }
+    }
+
+    void slide()
+    {
+        std::memmove(window_.data(), window_.data() + WINDOW_SIZE, size_t(fill_ - WINDOW_SIZE));
+        fill_ -= WINDOW_SIZE;
+        pos_ -= WINDOW_SIZE;
+
+        for (int& p : head_)
+        {
+            p = p >= WINDOW_SIZE ? p - WINDOW_SIZE : -1;
+        }
+        for (int& p : prev_)
+        {
+            p = p >= WINDOW_SIZE ? p - WINDOW_SIZE : -1;
+        }
+    }
+
+    void putBits(quint32 value, int count)
+    {
+        bitBuffer_ |= quint64(value) << bitCount_;
+        bitCount_ += count;
+
+        while (bitCount_ >= 8)
+        {
+            out_.append(char(bitBuffer_ & 0xFF));
+            bitBuffer_ >>= 8;
+            bitCount_ -= 8;
+        }
+
+        if (out_.size() >= OUTPUT_CHUNK)
+        {
+            flushOutput();
+        }
+    }
+
+    // Huffman codes are defined MSB-first, the bit stream is LSB-first
+    void putCode(quint32 code, int length)
+    {
+        quint32 reversed = 0;
+        for (int i = 0; i < length; ++i)
+        {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        putBits(reversed, length);
+    }
+
+    void putSymbol(int symbol)
+    {
+        if (symbol < 144)
+            putCode(0x30 + symbol, 8);
+        else if (symbol < 256)
+            putCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280)
+            putCode(symbol - 256, 7);
+        else
+            putCode(0xC0 + symbol - 280, 8);
+    }
+
+    void putMatch(int length, int distance)
+    {
+        static const int lengthBase[29] = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+        };
+        static const int lengthExtra[29] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+        };
+        static const int distanceBase[30] = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+        };
+        static const int distanceExtra[30] = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+        };
+
+        const int lengthCode = int(std::upper_bound(lengthBase, lengthBase + 29, length) - lengthBase) - 1;
+        putSymbol(257 + lengthCode);
+        if (lengthExtra[lengthCode] > 0)
+        {
+            putBits(quint32(length - lengthBase[lengthCode]), lengthExtra[lengthCode]);
+        }
+
+        const int distanceCode = int(std::upper_bound(distanceBase, distanceBase + 30, distance) - distanceBase) - 1;
+        putCode(quint32(distanceCode), 5);
+        if (distanceExtra[distanceCode] > 0)
+        {
+            putBits(quint32(distance - distanceBase[distanceCode]), distanceExtra[distanceCode]);
+        }
+    }
+
+    void flushOutput()
+    {
+        if (out_.isEmpty())
+        {
+            return;
+        }
+
+        sink_->write(out_);
+        written_ += out_.size();
+        out_.resize(0);
+    }
+
+    QIODevice* sink_;
+    std::vector<quint8> window_;        ///< History (up to 32 KB) + pending input
+    std::vector<int> head_;             ///< Most recent position per hash
+    std::vector<int> prev_;             ///< Previous position with the same hash, indexed by pos & WINDOW_MASK
+    int fill_ = 0;                      ///< Bytes in window_
+    int pos_ = 0;                       ///< Next byte to encode
+    quint64 bitBuffer_ = 0;
+    int bitCount_ = 0;
+    QByteArray out_;
+    qint64 written_ = 0;                ///< Compressed bytes handed to the sink
+    bool started_ = false;
+};
+
+
+// ============================================================================
+// ZipStreamWriter - ZIP container with deflated entries, written front to back
+// ============================================================================
+
+static void appendLE16(QByteArray& buffer, quint16 value)
+{
+    buffer.append(char(value & 0xFF));
+    buffer.append(char((value >> 8) & 0xFF));
+}
+
+
+static void appendLE32(QByteArray& buffer, quint32 value)
+{
+    appendLE16(buffer, quint16(value & 0xFFFF));
+    appendLE16(buffer, quint16(value >> 16));
+}
+
+
+/**
+ * @brief Writes a ZIP archive entry by entry
+ *
+ * Entry sizes and CRC are patched into the local header after the data has been
+ * streamed, so the output device must be seekable. ZIP64 is not supported.
+ */
+class ZipStreamWriter
+{
+public:
+    explicit ZipStreamWriter(QFile* file)
+        : file_(file)
+        , deflate_(file)
+    {
+        const QDateTime now = QDateTime::currentDateTime();
+        dosTime_ = quint16((now.time().hour() << 11) | (now.time().minute() << 5) | (now.time().second() / 2));
+        dosDate_ = quint16(((now.date().year() - 1980) << 9) | (now.date().month() << 5) | now.date().day());
+    }
+
+    bool ok() const { return ok_; }
+    QString errorString() const { return errorString_; }
+
+    void beginEntry(const QString& name)
+    {
+        current_ = Record();
+        current_.name = name.toUtf8();
+        current_.offset = file_->pos();
+
+        QByteArray header;
+        appendLE32(header, 0x04034b50);
+        appendLE16(header, 20);             // version needed
+        appendLE16(header, 0x0800);         // UTF-8 names
+        appendLE16(header, 8);              // deflate
+        appendLE16(header, dosTime_);
+        appendLE16(header, dosDate_);
+        appendLE32(header, 0);              // CRC - patched in endEntry()
+        appendLE32(header, 0);              // compressed size - patched
+        appendLE32(header, 0);              // uncompressed size - patched
+        appendLE16(header, quint16(current_.name.size()));
+        appendLE16(header, 0);
+        header.append(current_.name);
+
+        checkedWrite(header);
+
+        crc_ = 0;
+        uncompressed_ = 0;
+        deflate_.reset();
+    }
+
+    void writeData(const char* data, qint64 length)
+    {
+        crc_ = crc32Update(crc_, data, length);
+        uncompressed_ += length;
+        deflate_.write(data, length);
+    }
+
+    void endEntry()
+    {
+        const qint64 compressed = deflate_.finish();
+
+        if (compressed > 0xFFFFFFFFLL || uncompressed_ > 0xFFFFFFFFLL)
+        {
+            fail("Entry " + QString::fromUtf8(current_.name) + " exceeds 4 GB (ZIP64 is not supported)");
+        }
+
+        current_.crc = crc_;
+        current_.compressedSize = quint32(compressed);
+        current_.uncompressedSize = quint32(uncompressed_);
+
+        // Patch CRC and sizes into the local header
+        const qint64 end = file_->pos();
+        QByteArray patch;
+        appendLE32(patch, current_.crc);
+        appendLE32(patch, current_.compressedSize);
+        appendLE32(patch, current_.uncompressedSize);
+
+        if (!file_->seek(current_.offset + 14))
+        {
+            fail(file_->errorString());
+        }
+        checkedWrite(patch);
+        file_->seek(end);
+
+        records_.append(current_);
+    }
+
+    void finish()
+    {
+        const qint64 directoryOffset = file_->pos();
+
+        QByteArray directory;
+        for (const Record& record : records_)
+        {
+            appendLE32(directory, 0x02014b50);
+            appendLE16(directory, 20);      // version made by
+            appendLE16(directory, 20);      // version needed
+            appendLE16(directory, 0x0800);
+            appendLE16(directory, 8);
+            appendLE16(directory, dosTime_);
+            appendLE16(directory, dosDate_);
+            appendLE32(directory, record.crc);
+            appendLE32(directory, record.compressedSize);
+            appendLE32(directory, record.uncompressedSize);
+            appendLE16(directory, quint16(record.name.size()));
+            appendLE16(directory, 0);       // extra
+            appendLE16(directory, 0);       // comment
+            appendLE16(directory, 0);       // disk
+            appendLE16(directory, 0);       // internal attributes
+            appendLE32(directory, 0);       // external attributes
+            appendLE32(directory, quint32(record.offset));
+            directory.append(record.name);
+        }
+        const qint64 directorySize = directory.size();
+
+        appendLE32(directory, 0x06054b50);
+        appendLE16(directory, 0);
+        appendLE16(directory, 0);
+        appendLE16(directory, quint16(records_.size()));
+        appendLE16(directory, quint16(records_.size()));
+        appendLE32(directory, quint32(directorySize));
+        appendLE32(directory, quint32(directoryOffset));
+        appendLE16(directory, 0);
+
+        checkedWrite(directory);
+    }
+
+private:
+    struct Record
+    {
+        QByteArray name;
+        qint64 offset = 0;
+        quint32 crc = 0;
+        quint32 compressedSize = 0;
+        quint32 uncompressedSize = 0;
+    };
+
+    void checkedWrite(const QByteArray& data)
+    {
+        if (file_->write(data) != data.size())
+        {
+            fail(file_->errorString());
+        }
+    }
+
+    void fail(const QString& message)
+    {
+        if (ok_)
+        {
+            ok_ = false;
+            errorString_ = message;
+            qWarning() << "XlsxWriter:" << message;
+        }
+    }
+
+    QFile* file_;
+    DeflateEncoder deflate_;
+    QVector<Record> records_;
+    Record current_;
+    quint32 crc_ = 0;
+    qint64 uncompressed_ = 0;
+    quint16 dosTime_ = 0;
+    quint16 dosDate_ = 0;
+    bool ok_ = true;
+    QString errorString_;
+};
+
+
+/**
+ * @brief Write-only device that feeds the current ZIP entry (target for QXmlStreamWriter)
+ */
+class ZipEntryDevice : public QIODevice
+{
+public:
+    explicit ZipEntryDevice(ZipStreamWriter* zip) : zip_(zip) {}
+
+protected:
+    qint64 readData(char*, qint64) override { return -1; }
+
+    qint64 writeData(const char* data, qint64 length) override
+    {
+        zip_->writeData(data, length);
+        return length;
+    }
+
+private:
+    ZipStreamWriter* zip_;
+};
+
+
+// ============================================================================
+// XlsxWriter
+// ============================================================================
+
+static const QString SPREADSHEET_NS = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+
+
+XlsxWriter::XlsxWriter() = default;
+
+
+XlsxWriter::~XlsxWriter() = default;
+
+
+bool XlsxWriter::open(const QString& filePath)
+{
+    file_ = std::make_unique<QFile>(filePath);
+
+    if (!file_->open(QIODevice::ReadWrite | QIODevice::Truncate))
+    {
+        errorString_ = file_->errorString();
+        failed_ = true;
+        qWarning() << "XlsxWriter: Cannot create" << filePath << "-" << errorString_;
+        return false;
+    }
+
+    zip_ = std::make_unique<ZipStreamWriter>(file_.get());
+    return true;
+}
+
+
+bool XlsxWriter::close()
+{
+    if (!zip_)
+    {
+        return false;
+    }
+
+    if (xml_)
+    {
+        endSheet();
+    }
+
+    writeSharedStrings();
+    writeWorkbookParts();
+    zip_->finish();
+
+    file_->close();
+
+    if (!zip_->ok())
+    {
+        errorString_ = zip_->errorString();
+        failed_ = true;
+    }
+
+    return !failed_;
+}
+
+
+void XlsxWriter::beginSheet(const QString& name, const QStringList& headers)
+{
+    if (xml_)
+    {
+        endSheet();
+    }
+
+    // Excel sheet names: max 31 characters, none of []:*?/\
+    QString sheetName = name;
+    for (QChar& c : sheetName)
+    {
+        if (QStringLiteral("[]:*?/\\").contains(c))
+        {
+            c = u'_';
+        }
+    }
+    sheetName.truncate(31);
+    sheetNames_.append(sheetName);
+
+    zip_->beginEntry(QString("xl/worksheets/sheet%1.xml").arg(sheetNames_.size()));
+
+    entry_ = std::make_unique<ZipEntryDevice>(zip_.get());
+    entry_->open(QIODevice::WriteOnly);
+
+    xml_ = std::make_unique<QXmlStreamWriter>(entry_.get());
+    xml_->writeStartDocument("1.0", true);
+    xml_->writeStartElement("worksheet");
+    xml_->writeDefaultNamespace(SPREADSHEET_NS);
+
+    if (!headers.isEmpty())
+    {
+        // Freeze the header row
+        xml_->writeStartElement("sheetViews");
+        xml_->writeStartElement("sheetView");
+        xml_->writeAttribute("workbookViewId", "0");
+        xml_->writeEmptyElement("pane");
+        xml_->writeAttribute("ySplit", "1");
+        xml_->writeAttribute("topLeftCell", "A2");
+        xml_->writeAttribute("activePane", "bottomLeft");
+        xml_->writeAttribute("state", "frozen");
+        xml_->writeEndElement();
+        xml_->writeEndElement();
+
+        xml_->writeStartElement("cols");
+        xml_->writeEmptyElement("col");
+        xml_->writeAttribute("min", "1");
+        xml_->writeAttribute("max", QString::number(headers.size()));
+        xml_->writeAttribute("width", "20");
+        xml_->writeAttribute("customWidth", "1");
+        xml_->writeEndElement();
+    }
+
+    xml_->writeStartElement("sheetData");
+    row_ = 0;
+
+    if (!headers.isEmpty())
+    {
+        beginRow();
+        for (const QString& header : headers)
+        {
+            beginCell(Style_Header, "s");
+            xml_->writeTextElement("v", QString::number(sharedStringIndex(header)));
+            xml_->writeEndElement();
+        }
+        endRow();
+    }
+}
+
+
+void XlsxWriter::endSheet()
+{
+    if (!xml_)
+    {
+        return;
+    }
+
+    xml_->writeEndElement();    // sheetData
+    xml_->writeEndElement();    // worksheet
+    xml_->writeEndDocument();
+
+    xml_.reset();
+    entry_->close();
+    entry_.reset();
+
+    zip_->endEntry();
+}
+
+
+void XlsxWriter::beginRow()
+{
+    ++row_;
+    column_ = 0;
+
+    xml_->writeStartElement("row");
+    xml_->writeAttribute("r", QString::number(row_));
+}
+
+
+void XlsxWriter::endRow()
+{
+    xml_->writeEndElement();
+}
+
+
+void XlsxWriter::addString(const QString& value)
+{
+    if (value.isEmpty())
+    {
+        ++column_;
+        return;
+    }
+
+    const int index = sharedStringIndex(value);
+
+    beginCell(Style_Default, "s");
+    xml_->writeTextElement("v", QString::number(index));
+    xml_->writeEndElement();
+}
+
+
+void XlsxWriter::addInlineString(const QString& value)
+{
+    if (value.isEmpty())
+    {
+        ++column_;
+        return;
+    }
+
+    beginCell(Style_Default, "inlineStr");
+    xml_->writeStartElement("is");
+    writeText(*xml_, value);
+    xml_->writeEndElement();
+    xml_->writeEndElement();
+}
+
+
+void XlsxWriter::addNumber(double value)
+{
+    beginCell(Style_Default, nullptr);
+    xml_->writeTextElement("v", QString::number(value, 'g', 15));
+    xml_->writeEndElement();
+}
+
+
+void XlsxWriter::addDateTime(const QDateTime& value)
+{
+    if (!value.isValid())
+    {
+        ++column_;
+        return;
+    }
+
+    beginCell(Style_DateTime, nullptr);
+    xml_->writeTextElement("v", QString::number(toExcelSerial(value), 'f', 6));
+    xml_->writeEndElement();
+}
+
+
+void XlsxWriter::addEmpty()
+{
+    ++column_;
+}
+
+
+void XlsxWriter::beginCell(CellStyle style, const char* type)
+{
+    xml_->writeStartElement("c");
+    xml_->writeAttribute("r", cellReference(column_, row_));
+
+    if (style != Style_Default)
+    {
+        xml_->writeAttribute("s", QString::number(int(style)));
+    }
+
+    if (type)
+    {
+        xml_->writeAttribute("t", QString::fromLatin1(type));
+    }
+
+    ++column_;
+}
+
+
+int XlsxWriter::sharedStringIndex(const QString& value)
+{
+    ++sharedReferences_;
+
+    auto it = sharedIndex_.constFind(value);
+    if (it != sharedIndex_.constEnd())
+    {
+        return it.value();
+    }
+
+    const int index = sharedStrings_.size();
+    sharedIndex_.insert(value, index);
+    sharedStrings_.append(value);
+    return index;
+}
+
+
+bool XlsxWriter::writePart(const QString& name, const QByteArray& content)
+{
+    zip_->beginEntry(name);
+    zip_->writeData(content.constData(), content.size());
+    zip_->endEntry();
+
+    return zip_->ok();
+}
+
+
+bool XlsxWriter::writeSharedStrings()
+{
+    zip_->beginEntry("xl/sharedStrings.xml");
+
+    ZipEntryDevice device(zip_.get());
+    device.open(QIODevice::WriteOnly);
+
+    QXmlStreamWriter xml(&device);
+    xml.writeStartDocument("1.0", true);
+    xml.writeStartElement("sst");
+    xml.writeDefaultNamespace(SPREADSHEET_NS);
+    xml.writeAttribute("count", QString::number(sharedReferences_));
+    xml.writeAttribute("uniqueCount", QString::number(sharedStrings_.size()));
+
+    for (const QString& value : sharedStrings_)
+    {
+        xml.writeStartElement("si");
+        writeText(xml, value);
+        xml.writeEndElement();
+    }
+
+    xml.writeEndElement();
+    xml.writeEndDocument();
+    device.close();
+
+    zip_->endEntry();
+
+    return zip_->ok();
+}
+
+
+bool XlsxWriter::writeWorkbookParts()
+{
+    const int sheetCount = sheetNames_.size();
+
+    // [Content_Types].xml
+    QString contentTypes =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+        "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+        "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+        "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+        "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>"
+        "<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml\"/>";
+    for (int i = 1; i <= sheetCount; ++i)
+    {
+        contentTypes += QString("<Override PartName=\"/xl/worksheets/sheet%1.xml\" "
+                                "ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>").arg(i);
+    }
+    contentTypes += "</Types>";
+
+    // _rels/.rels
+    const QByteArray packageRels =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+        "</Relationships>";
+
+    // xl/workbook.xml
+    QString workbook =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+        "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\"><sheets>";
+    for (int i = 0; i < sheetCount; ++i)
+    {
+        workbook += QString("<sheet name=\"%1\" sheetId=\"%2\" r:id=\"rId%2\"/>")
+                        .arg(sheetNames_[i].toHtmlEscaped())
+                        .arg(i + 1);
+    }
+    workbook += "</sheets></workbook>";
+
+    // xl/_rels/workbook.xml.rels
+    QString workbookRels =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">";
+    for (int i = 1; i <= sheetCount; ++i)
+    {
+        workbookRels += QString("<Relationship Id=\"rId%1\" "
+                                "Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" "
+                                "Target=\"worksheets/sheet%1.xml\"/>").arg(i);
+    }
+    workbookRels += QString("<Relationship Id=\"rId%1\" "
+                            "Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles\" "
+                            "Target=\"styles.xml\"/>").arg(sheetCount + 1);
+    workbookRels += QString("<Relationship Id=\"rId%1\" "
+                            "Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/sharedStrings\" "
+                            "Target=\"sharedStrings.xml\"/>").arg(sheetCount + 2);
+    workbookRels += "</Relationships>";
+
+    // xl/styles.xml - cellXfs order must match CellStyle
+    const QByteArray styles =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<styleSheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<numFmts count=\"1\"><numFmt numFmtId=\"164\" formatCode=\"yyyy-mm-dd hh:mm\"/></numFmts>"
+        "<fonts count=\"2\">"
+        "<font><sz val=\"11\"/><name val=\"Calibri\"/></font>"
+        "<font><b/><sz val=\"11\"/><name val=\"Calibri\"/></font>"
+        "</fonts>"
+        "<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+        "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+        "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+        "<cellXfs count=\"3\">"
+        "<xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/>"
+        "<xf numFmtId=\"164\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyNumberFormat=\"1\"/>"
+        "<xf numFmtId=\"0\" fontId=\"1\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+        "</cellXfs>"
+        "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+        "</styleSheet>";
+
+    writePart("[Content_Types].xml", contentTypes.toUtf8());
+    writePart("_rels/.rels", packageRels);
+    writePart("xl/workbook.xml", workbook.toUtf8());
+    writePart("xl/_rels/workbook.xml.rels", workbookRels.toUtf8());
+    writePart("xl/styles.xml", styles);
+
+    return zip_->ok();
+}
+
+
+QString XlsxWriter::cellReference(int column, int row)
+{
+    QString letters;
+    for (int c = column + 1; c > 0; c = (c - 1) / 26)
+    {
+        letters.prepend(QChar(u'A' + (c - 1) % 26));
+    }
+
+    return letters + QString::number(row);
+}
+
+
+double XlsxWriter::toExcelSerial(const QDateTime& value)
+{
+    // Excel's 1900 date system counts days from 1899-12-30
+    static const QDate epoch(1899, 12, 30);
+
+    return double(epoch.daysTo(value.date())) + value.time().msecsSinceStartOfDay() / 86400000.0;
+}
+
+
+void XlsxWriter::writeText(QXmlStreamWriter& xml, const QString& value)
+{
+    // XML 1.0 cannot carry most control characters - drop them rather than produce an unreadable file
+    QString text = value;
+    text.removeIf([](QChar c) { return c.unicode() < 0x20 && c != u'\t' && c != u'\n' && c != u'\r'; });
+
+    xml.writeStartElement("t");
+    if (!text.isEmpty() && (text.front().isSpace() || text.back().isSpace()))
+    {
+        xml.writeAttribute("xml:space", "preserve");
+    }
+    xml.writeCharacters(text);
+    xml.writeEndElement();
+}
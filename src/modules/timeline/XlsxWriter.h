@@ -0,0 +1,100 @@
+// XlsxWriter.h
+
+
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QDateTime>
+#include <memory>
+
+
+class QFile;
+class QXmlStreamWriter;
+class ZipStreamWriter;
+class ZipEntryDevice;
+
+
+/**
+ * @class XlsxWriter
+ * @brief Streaming writer for Office Open XML spreadsheets (.xlsx) with no external dependencies
+ *
+ * Sheet XML is produced with QXmlStreamWriter and fed straight into an in-process
+ * deflate encoder inside a ZIP container, so only the current row is held in memory.
+ * Strings from addString() are deduplicated into the shared string table, which is
+ * written after all sheets and so stays in memory until then; use it for columns with
+ * few distinct values. Text that is unique per row goes through addInlineString(),
+ * which writes it into the row and keeps nothing.
+ *
+ * Usage:
+ * @code
+ * XlsxWriter xlsx;
+ * xlsx.open(path);
+ * xlsx.beginSheet("Events", {"Title", "Start"});
+ * xlsx.beginRow();
+ * xlsx.addString(title);
+ * xlsx.addDateTime(start);
+ * xlsx.endRow();
+ * xlsx.endSheet();
+ * xlsx.close();
+ * @endcode
+ *
+ * Calls must not be interleaved between sheets; the writer is not thread-safe but can
+ * be used entirely from a worker thread.
+ */
+class XlsxWriter
+{
+public:
+    XlsxWriter();
+    ~XlsxWriter();
+
+    bool open(const QString& filePath);                                 ///< @brief Create the file and start the container
+    bool close();                                                       ///< @brief Write workbook parts and finish the container
+
+    void beginSheet(const QString& name, const QStringList& headers = {});  ///< @brief Start a new worksheet, optionally with a bold header row
+    void endSheet();                                                    ///< @brief Finish the current worksheet
+
+    void beginRow();                                                    ///< @brief Start a row in the current sheet
+    void endRow();                                                      ///< @brief Finish the current row
+
+    void addString(const QString& value);                               ///< @brief Shared-string cell for repeated values (empty strings leave the cell blank)
+    void addInlineString(const QString& value);                         ///< @brief Inline string cell for per-row text (empty strings leave the cell blank)
+    void addNumber(double value);                                       ///< @brief Numeric cell
+    void addDateTime(const QDateTime& value);                           ///< @brief Date-time cell stored as an Excel serial number (invalid = blank)
+    void addEmpty();                                                    ///< @brief Skip a cell
+
+    QString errorString() const { return errorString_; }                ///< @brief Reason for the last failure
+
+private:
+    enum CellStyle
+    {
+        Style_Default = 0,
+        Style_DateTime = 1,
+        Style_Header = 2
+    };
+
+    void beginCell(CellStyle style, const char* type);
+    int sharedStringIndex(const QString& value);
+    bool writePart(const QString& name, const QByteArray& content);
+    bool writeSharedStrings();
+    bool writeWorkbookParts();
+    static QString cellReference(int column, int row);
+    static void writeText(QXmlStreamWriter& xml, const QString& value);    ///< <t> element, without control characters XML cannot carry
+    static double toExcelSerial(const QDateTime& value);
+
+    std::unique_ptr<QFile> file_;
+    std::unique_ptr<ZipStreamWriter> zip_;
+    std::unique_ptr<ZipEntryDevice> entry_;             ///< Device for the sheet currently being written
+    std::unique_ptr<QXmlStreamWriter> xml_;             ///< Sheet XML writer (null outside a sheet)
+
+    QStringList sheetNames_;
+    QHash<QString, int> sharedIndex_;                   ///< Distinct string -> index in sharedStrings_
+    QVector<QString> sharedStrings_;                    ///< Distinct strings in index order
+    qint64 sharedReferences_ = 0;                       ///< Total string cells (for the "count" attribute)
+
+    int row_ = 0;                                       ///< 1-based row of the open row
+    int column_ = 0;                                    ///< 0-based column of the next cell
+    bool failed_ = false;
+    QString errorString_;
+};
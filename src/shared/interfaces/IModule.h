@@ -24,4 +24,5 @@ public:
     virtual void onDeactivate() {}
     virtual bool hasUnsavedChanges() const { return false; }
     virtual bool save() { return true; }
+    virtual bool prepareToClose() { return true; }     ///< Resolve anything teardown could not (false cancels closing)
 };
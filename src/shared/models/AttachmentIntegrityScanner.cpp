@@ -0,0 +1,412 @@
+// AttachmentIntegrityScanner.cpp
+
+
+#include "AttachmentIntegrityScanner.h"
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+
+
+namespace {
+    constexpr qint64 HASH_CHUNK_BYTES = 1024 * 1024;    // Read size while hashing (cancel granularity)
+
+    // Comparable form of a path (no filesystem access)
+    QString normalizedPath(const QString& path) {
+        QString normalized = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+#ifdef Q_OS_WIN
+        normalized = normalized.toLower();
+#endif
+        return normalized;
+    }
+
+    // One distinct referenced path
+    struct PathJob {
+        QString path;
+        bool hashContent = false;       // Inline copies are hashed; linked files are only stat'ed
+        bool exists = false;
+        bool hashed = false;            // Hash was computed (cache miss)
+        AttachmentFileRecord record;
+    };
+}
+
+
+// ============================================================================
+// AttachmentScanIssue / AttachmentScanReport
+// ============================================================================
+
+QString AttachmentScanIssue::kindString() const {
+    switch (kind) {
+    case MissingFile:       return "Missing file";
+    case ContentChanged:    return "Content changed";
+    case OrphanFile:        return "Orphan file";
+    case OrphanDirectory:   return "Orphan directory";
+    }
+    return QString();
+}
+
+
+int AttachmentScanReport::issueCount(AttachmentScanIssue::Kind kind) const {
+    return static_cast<int>(std::count_if(issues.cbegin(), issues.cend(),
+                                          [kind](const AttachmentScanIssue& issue) { return issue.kind == kind; }));
+}
+
+
+// ============================================================================
+// AttachmentIntegrityScanner
+// ============================================================================
+
+AttachmentIntegrityScanner::AttachmentIntegrityScanner(QObject* parent)
+    : QObject(parent)
+{
+}
+
+
+AttachmentIntegrityScanner::~AttachmentIntegrityScanner() {
+    cancel();
+
+    if (worker_) {
+        worker_->wait();
+    }
+}
+
+
+bool AttachmentIntegrityScanner::startScan() {
+    if (worker_) {
+        qWarning() << "AttachmentIntegrityScanner: Scan already in progress";
+        return false;
+    }
+
+    cancelRequested_ = false;
+
+    // Snapshots; the worker never touches the manager
+    const QMap<int, QList<Attachment>> registry = AttachmentManager::instance().allAttachments();
+    const QString projectDirectory = AttachmentManager::instance().projectDirectory();
+
+    // Records of the last scan are stored with the attachments, so they survive restarts
+    QHash<QString, AttachmentFileRecord> cache;
+    for (const QList<Attachment>& attachments : registry) {
+        for (const Attachment& attachment : attachments) {
+            if (attachment.lastScan.modifiedMs != 0) {
+                cache.insert(attachment.filePath, attachment.lastScan);
+            }
+        }
+    }
+
+    QThread* thread = QThread::create([this, registry, projectDirectory, cache]() {
+        auto reportProgress = [this](int percent) {
+            QMetaObject::invokeMethod(this, [this, percent]() { emit progressChanged(percent); }, Qt::QueuedConnection);
+        };
+
+        AttachmentScanReport report = scan(registry, projectDirectory, cache, &cancelRequested_, reportProgress);
+
+        QMetaObject::invokeMethod(this, [this, report]() {
+            worker_ = nullptr;
+            applyReport(report);
+            emit scanFinished(report);
+        }, Qt::QueuedConnection);
+    });
+
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+
+    worker_ = thread;
+    worker_->start(QThread::LowPriority);
+
+    return true;
+}
+
+
+void AttachmentIntegrityScanner::cancel() {
+    cancelRequested_ = true;
+}
+
+
+void AttachmentIntegrityScanner::applyReport(const AttachmentScanReport& report) {
+    if (report.cancelled) {
+        return;
+    }
+
+    const int updated = AttachmentManager::instance().refreshStoredMetadata(report.files);
+
+    qDebug() << "AttachmentIntegrityScanner: Checked" << report.filesChecked << "files,"
+             << "hashed" << report.filesHashed << "," << report.issues.size() << "issue(s),"
+             << updated << "stored record(s) refreshed in" << report.elapsedMs << "ms";
+}
+
+
+AttachmentScanReport AttachmentIntegrityScanner::scan(const QMap<int, QList<Attachment>>& registry,
+                                                      const QString& projectDirectory,
+                                                      const QHash<QString, AttachmentFileRecord>& cache,
+                                                      const std::atomic_bool* cancelFlag,
+                                                      const std::function<void(int)>& progress) {
+    AttachmentScanReport report;
+    QElapsedTimer timer;
+    timer.start();
+
+    auto isCancelled = [cancelFlag]() { return cancelFlag && *cancelFlag; };
+
+    // ---- Distinct referenced paths ----
+    QVector<PathJob> jobs;
+    QHash<QString, int> jobIndex;
+    QSet<QString> referenced;
+
+    for (auto it = registry.constBegin(); it != registry.constEnd(); ++it) {
+        for (const Attachment& attachment : it.value()) {
+            auto found = jobIndex.constFind(attachment.filePath);
+            int index;
+            if (found == jobIndex.constEnd()) {
+                index = jobs.size();
+                jobIndex.insert(attachment.filePath, index);
+                PathJob job;
+                job.path = attachment.filePath;
+                jobs.append(job);
+                referenced.insert(normalizedPath(attachment.filePath));
+            } else {
+                index = found.value();
+            }
+
+            if (attachment.storageMode == AttachmentStorageMode::InlineEmbedded) {
+                jobs[index].hashContent = true;
+            }
+        }
+    }
+
+    // ---- Walk the project store: totals and orphans (first 10%) ----
+    const QString storeRoot = projectDirectory.isEmpty() ? QString() : QDir(projectDirectory).filePath("attachments");
+
+    if (!storeRoot.isEmpty() && QFileInfo(storeRoot).isDir()) {
+        QDirIterator dirs(storeRoot, QDir::Dirs | QDir::NoDotAndDotDot);
+        while (dirs.hasNext()) {
+            const QString dirPath = dirs.next();
+
+            bool isEventDir = false;
+            const int eventId = dirs.fileName().toInt(&isEventDir);
+            const bool ownerHasAttachments = isEventDir && !registry.value(eventId).isEmpty();
+
+            QVector<AttachmentScanIssue> unreferenced;
+            qint64 dirBytes = 0;
+            int referencedInDir = 0;
+
+            QDirIterator files(dirPath, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+            while (files.hasNext()) {
+                if (isCancelled()) {
+                    report.cancelled = true;
+                    return report;
+                }
+
+                files.next();
+                const QFileInfo fileInfo = files.fileInfo();
+                const qint64 size = fileInfo.size();
+
+                report.storeBytes += size;
+                dirBytes += size;
+
+                if (referenced.contains(normalizedPath(fileInfo.absoluteFilePath()))) {
+                    ++referencedInDir;
+                    continue;
+                }
+
+                AttachmentScanIssue issue;
+                issue.kind = AttachmentScanIssue::OrphanFile;
+                issue.eventId = isEventDir ? eventId : 0;
+                issue.path = fileInfo.absoluteFilePath();
+                issue.bytes = size;
+                unreferenced.append(issue);
+            }
+
+            for (const AttachmentScanIssue& issue : std::as_const(unreferenced)) {
+                report.orphanBytes += issue.bytes;
+            }
+
+            // A whole leftover directory is reported once instead of file by file
+            if (!ownerHasAttachments && referencedInDir == 0 && !unreferenced.isEmpty()) {
+                AttachmentScanIssue issue;
+                issue.kind = AttachmentScanIssue::OrphanDirectory;
+                issue.eventId = isEventDir ? eventId : 0;
+                issue.path = dirPath;
+                issue.bytes = dirBytes;
+                report.issues.append(issue);
+            } else {
+                report.issues += unreferenced;
+            }
+        }
+
+        // Loose files directly in the store root are never referenced by the manager's layout
+        QDirIterator rootFiles(storeRoot, QDir::Files | QDir::Hidden);
+        while (rootFiles.hasNext()) {
+            rootFiles.next();
+            const QFileInfo fileInfo = rootFiles.fileInfo();
+            if (referenced.contains(normalizedPath(fileInfo.absoluteFilePath()))) {
+                report.storeBytes += fileInfo.size();
+                continue;
+            }
+
+            AttachmentScanIssue issue;
+            issue.kind = AttachmentScanIssue::OrphanFile;
+            issue.path = fileInfo.absoluteFilePath();
+            issue.bytes = fileInfo.size();
+            report.storeBytes += issue.bytes;
+            report.orphanBytes += issue.bytes;
+            report.issues.append(issue);
+        }
+    }
+
+    if (progress) {
+        progress(10);
+    }
+
+    // ---- Check referenced paths in parallel (remaining 90%) ----
+    if (!jobs.isEmpty()) {
+        PathJob* jobData = jobs.data();    // Detached once here; workers only touch distinct elements
+        const int jobCount = jobs.size();
+
+        std::atomic_int next { 0 };
+        std::atomic_int completed { 0 };
+        std::atomic_int lastPercent { 10 };
+
+        auto work = [&]() {
+            for (;;) {
+                const int index = next.fetch_add(1);
+                if (index >= jobCount || isCancelled()) {
+                    return;
+                }
+
+                PathJob& job = jobData[index];
+                const QFileInfo fileInfo(job.path);
+
+                job.exists = fileInfo.exists() && fileInfo.isFile();
+                if (job.exists) {
+                    job.record.size = fileInfo.size();
+                    job.record.modifiedMs = fileInfo.lastModified().toMSecsSinceEpoch();
+
+                    if (job.hashContent) {
+                        auto cached = cache.constFind(job.path);
+                        if (cached != cache.constEnd()
+                            && cached->size == job.record.size
+                            && cached->modifiedMs == job.record.modifiedMs
+                            && !cached->sha256.isEmpty()) {
+                            job.record.sha256 = cached->sha256;
+                        } else if (hashFile(job.path, job.record.sha256, cancelFlag)) {
+                            job.hashed = true;
+                        }
+                    }
+                }
+
+                const int percent = 10 + (++completed) * 90 / jobCount;
+                int previous = lastPercent.load();
+                if (progress && percent > previous && lastPercent.compare_exchange_strong(previous, percent)) {
+                    progress(percent);
+                }
+            }
+        };
+
+        const int helperCount = std::min(QThread::idealThreadCount(), jobCount) - 1;
+        QVector<QThread*> helpers;
+        for (int i = 0; i < helperCount; ++i) {
+            QThread* helper = QThread::create(work);
+            helper->start(QThread::LowPriority);
+            helpers.append(helper);
+        }
+
+        work();     // This thread takes a share too
+
+        for (QThread* helper : std::as_const(helpers)) {
+            helper->wait();
+            delete helper;
+        }
+
+        if (isCancelled()) {
+            report.cancelled = true;
+            return report;
+        }
+    }
+
+    // ---- Assemble per-event results ----
+    const QString storePrefix = storeRoot.isEmpty() ? QString() : normalizedPath(storeRoot) + '/';
+
+    for (const PathJob& job : std::as_const(jobs)) {
+        if (!job.exists) {
+            continue;
+        }
+
+        report.files.insert(job.path, job.record);
+        report.filesHashed += job.hashed ? 1 : 0;
+
+        if (storePrefix.isEmpty() || !normalizedPath(job.path).startsWith(storePrefix)) {
+            report.linkedBytes += job.record.size;
+        }
+    }
+    report.filesChecked = jobs.size();
+
+    for (auto it = registry.constBegin(); it != registry.constEnd(); ++it) {
+        for (const Attachment& attachment : it.value()) {
+            const PathJob& job = jobs.at(jobIndex.value(attachment.filePath));
+
+            if (!job.exists) {
+                AttachmentScanIssue issue;
+                issue.kind = AttachmentScanIssue::MissingFile;
+                issue.eventId = it.key();
+                issue.path = attachment.filePath;
+                report.issues.append(issue);
+                continue;
+            }
+
+            report.bytesPerEvent[it.key()] += job.record.size;
+
+            if (!attachment.contentHash.isEmpty() && !job.record.sha256.isEmpty()
+                && attachment.contentHash != job.record.sha256) {
+                AttachmentScanIssue issue;
+                issue.kind = AttachmentScanIssue::ContentChanged;
+                issue.eventId = it.key();
+                issue.path = attachment.filePath;
+                report.issues.append(issue);
+            }
+        }
+    }
+
+    report.elapsedMs = timer.elapsed();
+
+    if (progress) {
+        progress(100);
+    }
+
+    return report;
+}
+
+
+bool AttachmentIntegrityScanner::hashFile(const QString& filePath, QString& sha256, const std::atomic_bool* cancelFlag) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "AttachmentIntegrityScanner: Cannot read" << filePath << ":" << file.errorString();
+        return false;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QByteArray buffer(HASH_CHUNK_BYTES, Qt::Uninitialized);
+
+    for (;;) {
+        if (cancelFlag && *cancelFlag) {
+            return false;
+        }
+
+        const qint64 bytesRead = file.read(buffer.data(), buffer.size());
+        if (bytesRead < 0) {
+            qWarning() << "AttachmentIntegrityScanner: Read error in" << filePath << ":" << file.errorString();
+            return false;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+
+        hash.addData(QByteArrayView(buffer.constData(), bytesRead));
+    }
+
+    sha256 = QString::fromLatin1(hash.result().toHex());
+    return true;
+}
@@ -0,0 +1,106 @@
+// AttachmentIntegrityScanner.h
+
+#pragma once
+
+#include "AttachmentModel.h"
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include <QMetaType>
+#include <atomic>
+#include <functional>
+
+class QThread;
+
+/**
+ * @brief A problem found by the integrity scan
+ */
+struct AttachmentScanIssue {
+    enum Kind {
+        MissingFile,        ///< Referenced file does not exist
+        ContentChanged,     ///< Content no longer matches the hash recorded by an earlier scan
+        OrphanFile,         ///< File in the project attachment store that no attachment references
+        OrphanDirectory     ///< Attachment directory of an event that has no attachments
+    };
+
+    Kind kind = MissingFile;
+    int eventId = 0;            ///< Owning event (numeric ID), 0 for orphans without an owner
+    QString path;
+    qint64 bytes = 0;           ///< Disk usage of orphans
+
+    QString kindString() const;
+};
+
+/**
+ * @brief Result of a full attachment integrity scan
+ */
+struct AttachmentScanReport {
+    QHash<QString, AttachmentFileRecord> files;     ///< Existing referenced files
+    QHash<int, qint64> bytesPerEvent;               ///< Actual disk usage of each event's attachments
+    qint64 storeBytes = 0;                          ///< Everything under <project>/attachments (orphans included)
+    qint64 linkedBytes = 0;                         ///< Externally linked files outside the store
+    qint64 orphanBytes = 0;                         ///< Part of storeBytes not referenced by any attachment
+    int filesChecked = 0;                           ///< Distinct referenced paths checked
+    int filesHashed = 0;                            ///< Paths that had to be re-hashed (cache misses)
+    QVector<AttachmentScanIssue> issues;
+    qint64 elapsedMs = 0;
+    bool cancelled = false;
+
+    int issueCount(AttachmentScanIssue::Kind kind) const;
+};
+
+Q_DECLARE_METATYPE(AttachmentScanReport)
+
+/**
+ * @brief Verifies attachment files and measures real disk usage on background threads
+ *
+ * A scan snapshots the AttachmentManager registry, then on a worker thread:
+ * - Walks <project>/attachments to total the store and find orphan files/directories
+ *   (e.g. left behind when removeEventAttachmentDirectory() failed)
+ * - Checks every referenced path on idealThreadCount() workers, hashing inline copies
+ *   with SHA-256 (linked files are only stat'ed)
+ *
+ * Hashes are cached by path, size and mtime in the scan record stored with each
+ * attachment and saved with the project, so a re-scan of an unchanged project only
+ * stats files, also after a restart. When the scan finishes, stored sizes, hashes and
+ * scan records in the AttachmentManager are refreshed so getTotalAttachmentsSize()
+ * reports actual usage.
+ */
+class AttachmentIntegrityScanner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AttachmentIntegrityScanner(QObject* parent = nullptr);
+    ~AttachmentIntegrityScanner() override;
+
+    bool startScan();                                       ///< @brief Start a scan (false if one is already running)
+    void cancel();                                          ///< @brief Request cancellation of the running scan
+    bool isRunning() const { return worker_ != nullptr; }   ///< @brief Whether a scan is in progress
+
+    /**
+     * @brief Run a scan synchronously (called from the worker thread)
+     * @param registry eventId -> attachments snapshot
+     * @param projectDirectory Project directory (the store is <projectDirectory>/attachments)
+     * @param cache Records from a previous scan; unchanged files are not re-hashed
+     * @param cancelFlag Optional flag polled while scanning
+     * @param progress Optional callback receiving 0-100
+     */
+    static AttachmentScanReport scan(const QMap<int, QList<Attachment>>& registry,
+                                     const QString& projectDirectory,
+                                     const QHash<QString, AttachmentFileRecord>& cache,
+                                     const std::atomic_bool* cancelFlag = nullptr,
+                                     const std::function<void(int)>& progress = {});
+
+signals:
+    void progressChanged(int percent);
+    void scanFinished(const AttachmentScanReport& report);
+
+private:
+    void applyReport(const AttachmentScanReport& report);
+
+    static bool hashFile(const QString& filePath, QString& sha256, const std::atomic_bool* cancelFlag);
+
+    QThread* worker_ = nullptr;
+    std::atomic_bool cancelRequested_ { false };
+};
@@ -0,0 +1,309 @@
+// AttachmentMetadataCache.cpp
+
+
+#include "AttachmentMetadataCache.h"
+#include <QThread>
+#include <QTimer>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QFileIconProvider>
+#include <QCoreApplication>
+#include <QMimeDatabase>
+#include <QMimeType>
+
+
+// ============================================================================
+// Worker (lives on the metadata thread)
+// ============================================================================
+
+/**
+ * @brief Performs stat calls and owns the QFileSystemWatcher; every method runs on the worker thread
+ */
+class AttachmentMetadataWorker : public QObject {
+public:
+    explicit AttachmentMetadataWorker(AttachmentMetadataCache* cache)
+        : cache_(cache)
+    {}
+
+    void validate(const QStringList& filePaths);
+
+private:
+    bool watch(const QString& filePath, bool exists);
+    void ensureWatcher();
+
+    AttachmentMetadataCache* cache_;
+    QFileSystemWatcher* watcher_ = nullptr;            ///< Created lazily so it belongs to this thread
+    QSet<QString> watchedFiles_;
+    QHash<QString, QSet<QString>> missingByDirectory_; ///< Watched directory -> missing files inside it
+};
+
+
+void AttachmentMetadataWorker::validate(const QStringList& filePaths) {
+    ensureWatcher();
+
+    QHash<QString, AttachmentFileInfo> results;
+    results.reserve(filePaths.size());
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    for (const QString& path : filePaths) {
+        QFileInfo fileInfo(path);
+
+        AttachmentFileInfo info;
+        info.known = true;
+        info.exists = fileInfo.exists() && fileInfo.isFile();
+        if (info.exists) {
+            info.size = fileInfo.size();
+            info.lastModified = fileInfo.lastModified();
+        }
+        info.checkedAtMs = now;
+        info.watched = watch(path, info.exists);
+
+        results.insert(path, info);
+    }
+
+    AttachmentMetadataCache* cache = cache_;
+    QMetaObject::invokeMethod(cache, [cache, results]() {
+        cache->applyResults(results);
+    }, Qt::QueuedConnection);
+}
+
+
+void AttachmentMetadataWorker::ensureWatcher() {
+    if (watcher_) {
+        return;
+    }
+
+    watcher_ = new QFileSystemWatcher(this);
+
+    // A watched file changed, was replaced or was deleted
+    QObject::connect(watcher_, &QFileSystemWatcher::fileChanged, this, [this](const QString& path) {
+        validate({path});
+    });
+
+    // A file may have appeared in a directory we watch for missing attachments
+    QObject::connect(watcher_, &QFileSystemWatcher::directoryChanged, this, [this](const QString& directory) {
+        const QSet<QString> missing = missingByDirectory_.value(directory);
+        if (!missing.isEmpty()) {
+            validate(QStringList(missing.cbegin(), missing.cend()));
+        }
+    });
+}
+
+
+bool AttachmentMetadataWorker::watch(const QString& filePath, bool exists) {
+    const QString directory = QFileInfo(filePath).absolutePath();
+    const int watchedCount = watchedFiles_.size() + missingByDirectory_.size();
+
+    if (exists) {
+        // No longer missing: drop the directory watch once nothing else waits on it
+        auto dirIt = missingByDirectory_.find(directory);
+        if (dirIt != missingByDirectory_.end() && dirIt->remove(filePath) && dirIt->isEmpty()) {
+            watcher_->removePath(directory);
+            missingByDirectory_.erase(dirIt);
+        }
+
+        if (watchedFiles_.contains(filePath)) {
+            return true;
+        }
+        if (watchedCount >= AttachmentMetadataCache::MAX_WATCHED_PATHS || !watcher_->addPath(filePath)) {
+            return false;
+        }
+        watchedFiles_.insert(filePath);
+        return true;
+    }
+
+    if (watchedFiles_.remove(filePath)) {
+        watcher_->removePath(filePath);
+    }
+
+    auto dirIt = missingByDirectory_.find(directory);
+    if (dirIt != missingByDirectory_.end()) {
+        dirIt->insert(filePath);
+        return true;
+    }
+
+    if (watchedCount >= AttachmentMetadataCache::MAX_WATCHED_PATHS || !watcher_->addPath(directory)) {
+        return false;   // Directory is gone too (or limit reached): fall back to periodic re-checks
+    }
+    missingByDirectory_[directory].insert(filePath);
+    return true;
+}
+
+
+// ============================================================================
+// AttachmentMetadataCache
+// ============================================================================
+
+AttachmentMetadataCache::AttachmentMetadataCache()
+    : QObject(nullptr)
+{
+    dispatchTimer_ = new QTimer(this);
+    dispatchTimer_->setSingleShot(true);
+    dispatchTimer_->setInterval(0);     // Coalesce requests made during one event loop pass
+    connect(dispatchTimer_, &QTimer::timeout, this, &AttachmentMetadataCache::dispatchPending);
+
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &AttachmentMetadataCache::shutdown);
+    }
+}
+
+
+AttachmentMetadataCache::~AttachmentMetadataCache() {
+    shutdown();
+}
+
+
+AttachmentMetadataCache& AttachmentMetadataCache::instance() {
+    static AttachmentMetadataCache instance;
+    return instance;
+}
+
+
+AttachmentFileInfo AttachmentMetadataCache::fileInfo(const QString& filePath) {
+    if (filePath.isEmpty()) {
+        return AttachmentFileInfo();
+    }
+
+    auto it = cache_.constFind(filePath);
+    if (it == cache_.constEnd()) {
+        requestValidation({filePath});
+        return AttachmentFileInfo();
+    }
+
+    if (!it->watched && QDateTime::currentMSecsSinceEpoch() - it->checkedAtMs > STALE_AFTER_MS) {
+        requestValidation({filePath});
+    }
+
+    return it.value();
+}
+
+
+QIcon AttachmentMetadataCache::iconForType(const QString& fileType) {
+    const QString extension = fileType.toLower();
+
+    auto it = iconCache_.constFind(extension);
+    if (it != iconCache_.constEnd()) {
+        return it.value();
+    }
+
+    // Matched on the name alone, so nothing is stat'ed
+    const QMimeType mimeType = QMimeDatabase().mimeTypeForFile(QStringLiteral("attachment.") + extension,
+                                                               QMimeDatabase::MatchExtension);
+    QIcon icon = QIcon::fromTheme(mimeType.iconName(), QIcon::fromTheme(mimeType.genericIconName()));
+    if (icon.isNull()) {
+        icon = QFileIconProvider().icon(QAbstractFileIconProvider::File);
+    }
+
+    iconCache_.insert(extension, icon);
+    return icon;
+}
+
+
+void AttachmentMetadataCache::requestValidation(const QStringList& filePaths) {
+    for (const QString& path : filePaths) {
+        if (!path.isEmpty() && !inFlight_.contains(path)) {
+            pending_.insert(path);
+        }
+    }
+
+    if (!pending_.isEmpty() && !dispatchTimer_->isActive()) {
+        dispatchTimer_->start();
+    }
+}
+
+
+void AttachmentMetadataCache::ensureWorker() {
+    if (thread_) {
+        return;
+    }
+
+    thread_ = new QThread();
+    thread_->setObjectName("AttachmentMetadata");
+
+    worker_ = new AttachmentMetadataWorker(this);
+    worker_->moveToThread(thread_);
+
+    thread_->start(QThread::LowPriority);
+}
+
+
+void AttachmentMetadataCache::dispatchPending() {
+    if (pending_.isEmpty()) {
+        return;
+    }
+
+    ensureWorker();
+
+    auto post = [this](const QStringList& batch) {
+        AttachmentMetadataWorker* worker = worker_;
+        QMetaObject::invokeMethod(worker, [worker, batch]() {
+            worker->validate(batch);
+        }, Qt::QueuedConnection);
+    };
+
+    // Several smaller batches let results for the first paths arrive early
+    QStringList batch;
+    for (const QString& path : std::as_const(pending_)) {
+        batch.append(path);
+        inFlight_.insert(path);
+
+        if (batch.size() == BATCH_SIZE) {
+            post(batch);
+            batch.clear();
+        }
+    }
+    if (!batch.isEmpty()) {
+        post(batch);
+    }
+
+    pending_.clear();
+}
+
+
+void AttachmentMetadataCache::applyResults(const QHash<QString, AttachmentFileInfo>& results) {
+    QStringList changed;
+
+    for (auto it = results.constBegin(); it != results.constEnd(); ++it) {
+        inFlight_.remove(it.key());
+
+        const AttachmentFileInfo& fresh = it.value();
+        auto cached = cache_.find(it.key());
+
+        const bool isChange = cached == cache_.end()
+                              || cached->exists != fresh.exists
+                              || cached->size != fresh.size
+                              || cached->lastModified != fresh.lastModified;
+
+        cache_.insert(it.key(), fresh);
+
+        if (isChange) {
+            changed.append(it.key());
+        }
+    }
+
+    if (!changed.isEmpty()) {
+        emit fileInfoChanged(changed);
+    }
+}
+
+
+void AttachmentMetadataCache::shutdown() {
+    if (!thread_) {
+        return;
+    }
+
+    // The watcher must be destroyed on the thread that owns it
+    AttachmentMetadataWorker* worker = worker_;
+    QMetaObject::invokeMethod(worker, [worker]() { delete worker; }, Qt::BlockingQueuedConnection);
+    worker_ = nullptr;
+
+    thread_->quit();
+    thread_->wait();
+    delete thread_;
+    thread_ = nullptr;
+
+    pending_.clear();
+    inFlight_.clear();
+}
@@ -0,0 +1,91 @@
+// AttachmentMetadataCache.h
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QIcon>
+#include <QHash>
+#include <QSet>
+
+class QThread;
+class QTimer;
+class AttachmentMetadataWorker;
+
+/**
+ * @brief Last known filesystem state of an attachment file
+ */
+struct AttachmentFileInfo {
+    bool known = false;         ///< False until the first background check has completed
+    bool exists = false;        ///< File was present at the last check
+    qint64 size = 0;            ///< Size in bytes at the last check
+    QDateTime lastModified;     ///< Modification time at the last check
+    qint64 checkedAtMs = 0;     ///< Time of the last check (ms since epoch)
+    bool watched = false;       ///< Changes are pushed by QFileSystemWatcher
+};
+
+/**
+ * @brief Caches attachment file metadata and icons so UI refreshes never touch the filesystem
+ *
+ * All stat calls happen on a dedicated worker thread:
+ * - fileInfo() answers from the cache and queues unknown or stale paths for validation
+ * - Queued paths are coalesced and checked in batches of BATCH_SIZE
+ * - Checked paths are registered with a QFileSystemWatcher (files that exist, parent
+ *   directories for files that are missing), so later changes are pushed instead of polled
+ * - fileInfoChanged() is emitted on the GUI thread with the paths whose state changed
+ *
+ * Icons are resolved per extension through QMimeDatabase (matched by extension only) and
+ * the icon theme, falling back to the generic file icon, so no file is touched.
+ */
+class AttachmentMetadataCache : public QObject {
+    Q_OBJECT
+
+public:
+    static AttachmentMetadataCache& instance();
+
+    /**
+     * @brief Cached state of a file (never blocks)
+     * @param filePath Attachment path
+     * @return Cached info; known == false if the file has not been checked yet
+     *
+     * Unknown paths, and unwatched paths older than STALE_AFTER_MS, are queued for validation.
+     */
+    AttachmentFileInfo fileInfo(const QString& filePath);
+
+    QIcon iconForType(const QString& fileType);                 ///< @brief Icon for a file extension (cached)
+
+    void requestValidation(const QStringList& filePaths);       ///< @brief Queue paths for a background check
+    void shutdown();                                            ///< @brief Stop the worker thread (called on application exit)
+
+    static constexpr int BATCH_SIZE = 256;                      ///< Paths checked per worker round trip
+    static constexpr int MAX_WATCHED_PATHS = 4096;              ///< Stay well below OS watch limits
+    static constexpr qint64 STALE_AFTER_MS = 30000;             ///< Re-check interval for unwatched paths
+
+signals:
+    void fileInfoChanged(const QStringList& filePaths);         ///< @brief New or changed state for these paths
+
+private:
+    friend class AttachmentMetadataWorker;
+
+    AttachmentMetadataCache();
+    ~AttachmentMetadataCache() override;
+
+    // Prevent copying
+    AttachmentMetadataCache(const AttachmentMetadataCache&) = delete;
+    AttachmentMetadataCache& operator=(const AttachmentMetadataCache&) = delete;
+
+    void ensureWorker();
+    void dispatchPending();
+    void applyResults(const QHash<QString, AttachmentFileInfo>& results);
+
+    QHash<QString, AttachmentFileInfo> cache_;  ///< path -> last known state
+    QHash<QString, QIcon> iconCache_;           ///< lower-case extension -> icon
+    QSet<QString> pending_;                     ///< Waiting for the next batch
+    QSet<QString> inFlight_;                    ///< Sent to the worker, result not yet applied
+
+    QThread* thread_ = nullptr;
+    AttachmentMetadataWorker* worker_ = nullptr;
+    QTimer* dispatchTimer_ = nullptr;
+};
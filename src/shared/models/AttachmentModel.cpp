@@ -2,9 +2,9 @@
 
 
 #include "AttachmentModel.h"
+#include "AttachmentMetadataCache.h"
 #include <QFileInfo>
 #include <QFile>
-#include <QFileIconProvider>
 #include <QImageReader>
 #include <QTextStream>
 #include <QDesktopServices>
@@ -45,9 +45,8 @@ QString Attachment::sizeString() const {
 
 
 QIcon Attachment::icon() const {
-    QFileIconProvider iconProvider;
-    QFileInfo fileInfo(filePath);
-    return iconProvider.icon(fileInfo);
+    // Per-extension icon from the cache; no filesystem access
+    return AttachmentMetadataCache::instance().iconForType(fileType);
 }
 
 
@@ -89,6 +88,18 @@ QJsonObject Attachment::toJson() const {
     json["attachedDate"] = attachedDate.toString(Qt::ISODate);
     json["notes"] = notes;
     json["storageMode"] = (storageMode == AttachmentStorageMode::InlineEmbedded) ? "inline" : "external";
+    if (!contentHash.isEmpty()) {
+        json["sha256"] = contentHash;
+    }
+    if (lastScan.modifiedMs != 0) {
+        QJsonObject scan;
+        scan["size"] = lastScan.size;
+        scan["mtime"] = lastScan.modifiedMs;
+        if (!lastScan.sha256.isEmpty()) {
+            scan["sha256"] = lastScan.sha256;
+        }
+        json["lastScan"] = scan;
+    }
     return json;
 }
 
@@ -107,6 +118,12 @@ Attachment Attachment::fromJson(const QJsonObject& json) {
     attachment.storageMode = (storageModeStr == "inline")
                                  ? AttachmentStorageMode::InlineEmbedded
                                  : AttachmentStorageMode::ExternalLink;
+    attachment.contentHash = json["sha256"].toString();
+
+    const QJsonObject scan = json["lastScan"].toObject();
+    attachment.lastScan.size = scan["size"].toInteger();
+    attachment.lastScan.modifiedMs = scan["mtime"].toInteger();
+    attachment.lastScan.sha256 = scan["sha256"].toString();
 
     return attachment;
 }
@@ -253,6 +270,7 @@ bool AttachmentManager::addAttachment(int eventId, const QString& filePath,
 
     // Add to storage
     attachments_[eventId].append(attachment);
+    updateAttachmentCount(eventId);
 
     emit attachmentAdded(eventId, attachment);
     emit attachmentsChanged(eventId);
@@ -283,6 +301,7 @@ bool AttachmentManager::removeAttachment(int eventId, int attachmentIndex) {
     }
 
     eventAttachments.removeAt(attachmentIndex);
+    updateAttachmentCount(eventId);
 
     emit attachmentRemoved(eventId, attachmentIndex);
     emit attachmentsChanged(eventId);
@@ -299,7 +318,17 @@ QList<Attachment> AttachmentManager::getAttachments(int eventId) const {
 
 
 int AttachmentManager::getAttachmentCount(int eventId) const {
-    return attachments_.value(eventId, QList<Attachment>()).size();
+    return attachmentCounts_.value(eventId, 0);
+}
+
+
+void AttachmentManager::updateAttachmentCount(int eventId) {
+    const int count = attachments_.value(eventId).size();
+    if (count > 0) {
+        attachmentCounts_.insert(eventId, count);
+    } else {
+        attachmentCounts_.remove(eventId);
+    }
 }
 
 
@@ -334,6 +363,7 @@ void AttachmentManager::clearAttachments(int eventId) {
     }
 
     attachments_.remove(eventId);
+    attachmentCounts_.remove(eventId);
     emit attachmentsChanged(eventId);
 
     qDebug() << "AttachmentManager: Cleared all attachments for event" << eventId;
@@ -425,6 +455,46 @@ qint64 AttachmentManager::getTotalProjectAttachmentsSize() const {
 }
 
 
+int AttachmentManager::refreshStoredMetadata(const QHash<QString, AttachmentFileRecord>& records) {
+    int updated = 0;
+
+    for (QList<Attachment>& attachmentList : attachments_) {
+        for (Attachment& attachment : attachmentList) {
+            auto record = records.constFind(attachment.filePath);
+            if (record == records.constEnd()) {
+                continue;
+            }
+
+            bool changed = false;
+            if (attachment.fileSize != record->size) {
+                attachment.fileSize = record->size;
+                changed = true;
+            }
+            // The first hash becomes the reference later scans verify against
+            if (attachment.contentHash.isEmpty() && !record->sha256.isEmpty()) {
+                attachment.contentHash = record->sha256;
+                changed = true;
+            }
+            // Saved with the project, so the next launch does not re-hash unchanged files
+            if (attachment.lastScan.size != record->size || attachment.lastScan.modifiedMs != record->modifiedMs
+                || attachment.lastScan.sha256 != record->sha256) {
+                attachment.lastScan = *record;
+                changed = true;
+            }
+
+            updated += changed ? 1 : 0;
+        }
+    }
+
+    if (updated > 0) {
+        emit attachmentsReset();
+        emit metadataRefreshed();
+    }
+
+    return updated;
+}
+
+
 bool AttachmentManager::removeEventAttachmentDirectory(int eventId) {
     QString attachmentDir = getAttachmentDirectory(eventId);
     if (attachmentDir.isEmpty() || !QDir(attachmentDir).exists()) {
@@ -487,7 +557,110 @@ QJsonArray AttachmentManager::serializeAttachments(int eventId) const {
 
 
 bool AttachmentManager::deserializeAttachments(int eventId, const QJsonArray& jsonArray) {
-    QList<Attachment> loadedAttachments;
+    QList<Attachment> loadedAttachments = parseAttachments(jsonArray);
+
+    if (!loadedAttachments.isEmpty()) {
+        // Start checking the files in the background before any list asks for them
+        QStringList filePaths;
+        for (const Attachment& attachment : loadedAttachments) {
+            filePaths.append(attachment.filePath);
+        }
+        AttachmentMetadataCache::instance().requestValidation(filePaths);
+
+        attachments_[eventId] = loadedAttachments;
+        updateAttachmentCount(eventId);
+        emit attachmentsChanged(eventId);
+        qDebug() << "AttachmentManager: Loaded" << loadedAttachments.size()
+                 << "attachments for event" << eventId;
+    }
+
+    return true;
+}
+
+
+void AttachmentManager::importRegistry(const QHash<int, QJsonArray>& registry, bool validateFiles) {
+    QMap<int, QList<Attachment>> attachments;
+    QHash<int, int> counts;
+    counts.reserve(registry.size());
+    int attachmentCount = 0;
+
+    // One pass: parse and count
+    for (auto it = registry.constBegin(); it != registry.constEnd(); ++it) {
+        QList<Attachment> loadedAttachments = parseAttachments(it.value());
+        if (loadedAttachments.isEmpty()) {
+            continue;
+        }
+
+        attachmentCount += loadedAttachments.size();
+
+        QList<Attachment>& target = attachments[it.key()];
+        target += loadedAttachments;
+        counts.insert(it.key(), target.size());
+    }
+
+    attachments_ = std::move(attachments);
+    attachmentCounts_ = std::move(counts);
+
+    if (validateFiles) {
+        requestFileValidation();
+    }
+
+    qDebug() << "AttachmentManager: Imported" << attachmentCount
+             << "attachments for" << attachmentCounts_.size() << "events";
+
+    emit attachmentsReset();
+}
+
+
+void AttachmentManager::mergeRegistry(const QHash<int, QJsonArray>& registry) {
+    QStringList filePaths;
+
+    for (auto it = registry.constBegin(); it != registry.constEnd(); ++it) {
+        if (attachments_.contains(it.key())) {
+            continue;
+        }
+
+        QList<Attachment> loadedAttachments = parseAttachments(it.value());
+        if (loadedAttachments.isEmpty()) {
+            continue;
+        }
+
+        for (const Attachment& attachment : loadedAttachments) {
+            filePaths.append(attachment.filePath);
+        }
+
+        attachmentCounts_.insert(it.key(), loadedAttachments.size());
+        attachments_.insert(it.key(), std::move(loadedAttachments));
+    }
+
+    if (filePaths.isEmpty()) {
+        return;
+    }
+
+    AttachmentMetadataCache::instance().requestValidation(filePaths);
+
+    qDebug() << "AttachmentManager: Merged" << filePaths.size() << "attachments";
+
+    emit attachmentsReset();
+}
+
+
+void AttachmentManager::requestFileValidation() const {
+    QStringList filePaths;
+
+    for (const QList<Attachment>& attachmentList : attachments_) {
+        for (const Attachment& attachment : attachmentList) {
+            filePaths.append(attachment.filePath);
+        }
+    }
+
+    AttachmentMetadataCache::instance().requestValidation(filePaths);
+}
+
+
+QList<Attachment> AttachmentManager::parseAttachments(const QJsonArray& jsonArray) {
+    QList<Attachment> attachments;
+    attachments.reserve(jsonArray.size());
 
     for (const QJsonValue& value : jsonArray) {
         if (!value.isObject()) {
@@ -496,18 +669,11 @@ bool AttachmentManager::deserializeAttachments(int eventId, const QJsonArray& js
 
         Attachment attachment = Attachment::fromJson(value.toObject());
         if (attachment.isValid()) {
-            loadedAttachments.append(attachment);
+            attachments.append(attachment);
         }
     }
 
-    if (!loadedAttachments.isEmpty()) {
-        attachments_[eventId] = loadedAttachments;
-        emit attachmentsChanged(eventId);
-        qDebug() << "AttachmentManager: Loaded" << loadedAttachments.size()
-                 << "attachments for event" << eventId;
-    }
-
-    return true;
+    return attachments;
 }
 
 
@@ -8,6 +8,7 @@
 #include <QPixmap>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QFileInfo>
 #include <QDir>
 #include <QJsonArray>
@@ -22,6 +23,15 @@ enum class AttachmentStorageMode {
     InlineEmbedded   ///< Copy file into project directory
 };
 
+/**
+ * @brief On-disk state of one attachment file as measured by AttachmentIntegrityScanner
+ */
+struct AttachmentFileRecord {
+    qint64 size = 0;            ///< Actual size in bytes
+    qint64 modifiedMs = 0;      ///< Modification time (ms since epoch)
+    QString sha256;             ///< Hex SHA-256 of the content (empty for linked files)
+};
+
 /**
  * @brief Represents a single file attachment
  */
@@ -34,6 +44,8 @@ struct Attachment {
     QDateTime attachedDate;     ///< When it was attached
     QString notes;              ///< Optional user notes
     AttachmentStorageMode storageMode;
+    QString contentHash;        ///< Hex SHA-256 recorded by the first integrity scan (inline copies only)
+    AttachmentFileRecord lastScan;  ///< State measured by the last integrity scan (modifiedMs 0 = never scanned); lets later scans skip unchanged files
 
     Attachment()
         : fileSize(0)
@@ -43,8 +55,8 @@ struct Attachment {
     // Helper methods
     bool isValid() const;
     QString sizeString() const;
-    QIcon icon() const;
-    bool exists() const;
+    QIcon icon() const;         ///< Cached per-extension icon (no filesystem access)
+    bool exists() const;        ///< Stats the file; UI code should use AttachmentMetadataCache::fileInfo()
 
     // Preview support
     bool supportsPreview() const;
@@ -122,7 +134,9 @@ public:
                        AttachmentStorageMode mode, QString& errorMsg);
     bool removeAttachment(int eventId, int attachmentIndex);
     QList<Attachment> getAttachments(int eventId) const;
-    int getAttachmentCount(int eventId) const;
+    QMap<int, QList<Attachment>> allAttachments() const { return attachments_; }  ///< Whole registry (implicitly shared snapshot)
+    int getAttachmentCount(int eventId) const;                          ///< Reads the precomputed count table
+    QHash<int, int> attachmentCounts() const { return attachmentCounts_; }  ///< eventId -> count (events with attachments only)
 
     // Bulk operations
     bool addMultipleAttachments(int eventId, const QStringList& filePaths,
@@ -139,6 +153,13 @@ public:
     qint64 getTotalAttachmentsSize(int eventId) const;
     qint64 getTotalProjectAttachmentsSize() const;
 
+    /**
+     * @brief Update stored sizes and scan records from a scan and record first-seen content hashes
+     * @param records filePath -> measured state
+     * @return Number of attachments updated (emits attachmentsReset() and metadataRefreshed() if any)
+     */
+    int refreshStoredMetadata(const QHash<QString, AttachmentFileRecord>& records);
+
     // Cleanup operations
     bool removeEventAttachmentDirectory(int eventId);
 
@@ -151,10 +172,32 @@ public:
     QJsonArray serializeAttachments(int eventId) const;
     bool deserializeAttachments(int eventId, const QJsonArray& jsonArray);
 
+    /**
+     * @brief Replace the whole registry in one step (project load)
+     * @param registry eventId -> serialized attachment array
+     * @param validateFiles Queue every file for a background check now; pass false to
+     *        defer that to requestFileValidation() (e.g. until a project has finished loading)
+     *
+     * Parses all lists and builds the count table in one pass, then emits a single
+     * attachmentsReset() instead of attachmentsChanged() per event.
+     */
+    void importRegistry(const QHash<int, QJsonArray>& registry, bool validateFiles = true);
+
+    /**
+     * @brief Add the records of events loaded after the project was opened (on-demand shards)
+     * @param registry eventId -> serialized attachment array
+     *
+     * Events that already have attachments keep them. Emits a single attachmentsReset().
+     */
+    void mergeRegistry(const QHash<int, QJsonArray>& registry);
+    void requestFileValidation() const;     ///< @brief Queue every registered file for a background metadata check
+
 signals:
     void attachmentsChanged(int eventId);
     void attachmentAdded(int eventId, const Attachment& attachment);
     void attachmentRemoved(int eventId, int index);
+    void attachmentsReset();    ///< Whole registry replaced (re-read all counts)
+    void metadataRefreshed();   ///< Stored sizes/hashes changed by a scan (the project has to be saved)
 
 private:
     AttachmentManager();
@@ -165,10 +208,13 @@ private:
     AttachmentManager& operator=(const AttachmentManager&) = delete;
 
     QMap<int, QList<Attachment>> attachments_;  ///< eventId -> attachments
+    QHash<int, int> attachmentCounts_;          ///< eventId -> attachments_[eventId].size(), kept in sync on every change
     QString projectDirectory_;
     AttachmentStorageMode defaultStorageMode_ = AttachmentStorageMode::InlineEmbedded;
 
     bool copyFileToProject(const QString& sourcePath, int eventId,
                            QString& destinationPath, QString& errorMsg);
     QString generateUniqueFileName(int eventId, const QString& originalName) const;
+    void updateAttachmentCount(int eventId);
+    static QList<Attachment> parseAttachments(const QJsonArray& jsonArray);
 };
@@ -0,0 +1,90 @@
+// AllocationCounter.cpp
+
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+namespace
+{
+    std::atomic<quint64> allocations { 0 };
+
+
+    void* allocate(std::size_t size)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+
+        const std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc wants a size that is a multiple of the alignment
+        const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+        return std::aligned_alloc(align, rounded);
+#endif
+    }
+
+
+    void releaseAligned(void* pointer) noexcept
+    {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+
+
+    void* orThrow(void* pointer)
+    {
+        if (!pointer)
+        {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+}
+
+
+quint64 AllocationCounter::count()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+
+// ============================================================================
+// Replacement operator new/delete (every form the standard library may call)
+// ============================================================================
+
+void* operator new(std::size_t size) { return orThrow(allocate(size)); }
+void* operator new[](std::size_t size) { return orThrow(allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return orThrow(allocateAligned(size, alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return orThrow(allocateAligned(size, alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
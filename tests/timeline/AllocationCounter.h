@@ -0,0 +1,20 @@
+// AllocationCounter.h
+
+
+#pragma once
+#include <QtGlobal>
+
+
+/**
+ * @brief Heap allocations made through operator new since the process started
+ *
+ * The counting operator new/delete replacement lives in AllocationCounter.cpp and is
+ * linked into test executables only, never into the application. Memory Qt containers
+ * take with malloc() directly (QString, QList and QByteArray data) is not included, so
+ * the count tracks objects, nodes and std containers - the allocations that scale with
+ * items drawn or visited per frame.
+ */
+namespace AllocationCounter
+{
+    quint64 count();
+}
@@ -0,0 +1,47 @@
+#include "AllocationCounter.h"
+#include "TimelineRenderBenchmark.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <algorithm>
+
+// Timeline render benchmark: scripted paint times, allocation counts and golden images.
+// Registered with CTest as "timeline_render_benchmark" (QT_QPA_PLATFORM=offscreen).
+
+int main(int argc, char *argv[])
+{
+    QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Timeline render benchmark");
+    parser.addHelpOption();
+    parser.addOption({ "sizes", "Comma-separated synthetic event counts.", "counts" });
+    parser.addOption({ "frames", "Scripted frames per scenario.", "frames" });
+    parser.addOption({ "output", "Directory for the JSON report and captured frames.", "dir" });
+    parser.addOption({ "thresholds", "JSON file with allocation limits and (reported only) p95 frame time budgets.", "file" });
+    parser.addOption({ "goldens", "Directory with reference images.", "dir" });
+    parser.addOption({ "update-goldens", "Store the captured frames as the new reference images." });
+    parser.process(a);
+
+    TimelineRenderBenchmarkOptions options;
+
+    if (parser.isSet("sizes")) {
+        options.eventCounts.clear();
+        for (const QString& size : parser.value("sizes").split(',', Qt::SkipEmptyParts)) {
+            const int count = size.trimmed().toInt();
+            if (count > 0) {
+                options.eventCounts.append(count);
+            }
+        }
+    }
+    if (parser.isSet("frames")) {
+        options.framesPerScenario = std::max(2, parser.value("frames").toInt());
+    }
+
+    options.outputDir = parser.value("output");
+    options.thresholdsFile = parser.value("thresholds");
+    options.goldenDir = parser.value("goldens");
+    options.updateGoldens = parser.isSet("update-goldens");
+    options.allocationCount = &AllocationCounter::count;
+
+    return TimelineRenderBenchmark::run(options);
+}
@@ -0,0 +1,458 @@
+// TimelineRenderBenchmark.cpp
+
+
+#include "TimelineRenderBenchmark.h"
+#include "modules/timeline/TimelineCoordinateMapper.h"
+#include "modules/timeline/TimelineView.h"
+#include "modules/timeline/TimelineScene.h"
+#include "modules/timeline/TimelineItem.h"
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QScrollBar>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QFile>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QTextStream>
+#include <QHash>
+#include <QUndoStack>
+#include <QDebug>
+#include <algorithm>
+#include <cstdlib>
+
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace
+{
+    const QDate kVersionStart(2020, 1, 1);
+    const QDate kVersionEnd(2020, 12, 31);
+
+    constexpr int kMaxDragSelection = 20;       ///< Items moved together in the multidrag scenario
+    constexpr int kPixelChannelTolerance = 8;   ///< Per-channel difference still counted as equal (antialiasing)
+
+    const QStringList kGoldenScenarios { "static", "zoom", "pan", "hover" };
+
+
+    double percentile(QVector<double> values, double fraction)
+    {
+        if (values.isEmpty())
+        {
+            return 0.0;
+        }
+
+        std::sort(values.begin(), values.end());
+        const int index = std::clamp(static_cast<int>(fraction * (values.size() - 1) + 0.5), 0, static_cast<int>(values.size()) - 1);
+        return values[index];
+    }
+
+
+    struct Threshold
+    {
+        double p95Ms = 0.0;
+        double allocationsP95 = 0.0;
+    };
+
+
+    QHash<QString, Threshold> loadThresholds(const QString& filePath)
+    {
+        QHash<QString, Threshold> thresholds;
+        if (filePath.isEmpty())
+        {
+            return thresholds;
+        }
+
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            qWarning() << "TimelineRenderBenchmark: Cannot read thresholds" << filePath << "-" << file.errorString();
+            return thresholds;
+        }
+
+        const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+        for (auto it = root.begin(); it != root.end(); ++it)
+        {
+            const QJsonObject limits = it.value().toObject();
+            thresholds.insert(it.key(), { limits.value("p95Ms").toDouble(), limits.value("allocationsP95").toDouble() });
+        }
+
+        return thresholds;
+    }
+
+
+    double imageDifference(const QImage& actual, const QImage& expected)
+    {
+        if (actual.size() != expected.size())
+        {
+            return 1.0;
+        }
+
+        const QImage a = actual.convertToFormat(QImage::Format_ARGB32);
+        const QImage b = expected.convertToFormat(QImage::Format_ARGB32);
+
+        qint64 differing = 0;
+        for (int y = 0; y < a.height(); ++y)
+        {
+            const QRgb* lineA = reinterpret_cast<const QRgb*>(a.constScanLine(y));
+            const QRgb* lineB = reinterpret_cast<const QRgb*>(b.constScanLine(y));
+
+            for (int x = 0; x < a.width(); ++x)
+            {
+                if (std::abs(qRed(lineA[x]) - qRed(lineB[x])) > kPixelChannelTolerance
+                    || std::abs(qGreen(lineA[x]) - qGreen(lineB[x])) > kPixelChannelTolerance
+                    || std::abs(qBlue(lineA[x]) - qBlue(lineB[x])) > kPixelChannelTolerance)
+                {
+                    ++differing;
+                }
+            }
+        }
+
+        return static_cast<double>(differing) / (static_cast<double>(a.width()) * a.height());
+    }
+
+
+    void sendMouse(QWidget* target, QEvent::Type type, const QPoint& pos, Qt::MouseButton button, Qt::MouseButtons buttons)
+    {
+        QMouseEvent event(type, pos, target->mapToGlobal(pos), button, buttons, Qt::NoModifier);
+        QApplication::sendEvent(target, &event);
+    }
+
+
+    void sendCtrlWheel(QWidget* target, const QPoint& pos, int angleDelta)
+    {
+        QWheelEvent event(pos, target->mapToGlobal(pos), QPoint(), QPoint(0, angleDelta),
+                          Qt::NoButton, Qt::ControlModifier, Qt::NoScrollPhase, false);
+        QApplication::sendEvent(target, &event);
+    }
+
+
+    QList<TimelineItem*> visibleTimelineItems(TimelineView& view, int limit)
+    {
+        QList<TimelineItem*> result;
+
+        const QRectF visibleRect = view.mapToScene(view.viewport()->rect()).boundingRect();
+        const QList<QGraphicsItem*> items = view.timelineScene()->items(visibleRect, Qt::ContainsItemBoundingRect);
+        for (QGraphicsItem* graphicsItem : items)
+        {
+            if (auto* item = dynamic_cast<TimelineItem*>(graphicsItem))
+            {
+                result.append(item);
+                if (result.size() >= limit)
+                {
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+}
+
+
+// ============================================================================
+// Synthetic data
+// ============================================================================
+
+QVector<TimelineEvent> TimelineRenderBenchmark::syntheticEvents(int count, const QDate& start, const QDate& end, quint32 seed)
+{
+    static const TimelineEventType types[] = { TimelineEventType_Meeting, TimelineEventType_Action,
+                                               TimelineEventType_TestEvent, TimelineEventType_Reminder,
+                                               TimelineEventType_JiraTicket };
+
+    QRandomGenerator random(seed);
+    const int spanDays = std::max<qint64>(1, start.daysTo(end));
+
+    QVector<TimelineEvent> events;
+    events.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        TimelineEvent event;
+        event.id = QString("bench-%1").arg(i);
+        event.type = types[random.bounded(5)];
+        event.title = QString("Synthetic event %1").arg(i);
+        event.priority = random.bounded(6);
+        event.color = TimelineModel::colorForType(event.type);
+
+        // Mostly short events with a tail of long ones, like real schedules
+        const int length = random.bounded(100) < 85 ? random.bounded(1, 6) : random.bounded(6, 45);
+        const QDate first = start.addDays(random.bounded(spanDays));
+        const QDate last = std::min(first.addDays(length - 1), end);
+        event.startDate = QDateTime(first, QTime(9, 0));
+        event.endDate = QDateTime(last, QTime(17, 0));
+
+        events.append(event);
+    }
+
+    TimelineModel::assignLanes(events);
+    return events;
+}
+
+
+const QStringList& TimelineRenderBenchmark::scenarios()
+{
+    static const QStringList names { "static", "zoom", "pan", "hover", "multidrag" };
+    return names;
+}
+
+
+// ============================================================================
+// Run
+// ============================================================================
+
+int TimelineRenderBenchmark::run(const TimelineRenderBenchmarkOptions& options)
+{
+    QTextStream out(stdout);
+
+    const QHash<QString, Threshold> thresholds = loadThresholds(options.thresholdsFile);
+    const bool countAllocations = static_cast<bool>(options.allocationCount);
+
+    if (!options.outputDir.isEmpty())
+    {
+        QDir().mkpath(options.outputDir);
+    }
+    if (!options.goldenDir.isEmpty() && options.updateGoldens)
+    {
+        QDir().mkpath(options.goldenDir);
+    }
+
+    out << "Timeline render benchmark (" << QGuiApplication::platformName() << ", "
+        << options.viewSize.width() << "x" << options.viewSize.height() << ", "
+        << options.framesPerScenario << " frames per scenario)\n";
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8  %9\n")
+               .arg("scenario", -10).arg("events", 8).arg("median", 9).arg("p95", 9).arg("max", 9).arg("budget", 9)
+               .arg("allocs", 9).arg("limit", 9).arg("golden");
+    out.flush();
+
+    QJsonArray reportResults;
+    bool allPassed = true;
+
+    for (int eventCount : options.eventCounts)
+    {
+        const QVector<TimelineEvent> events = syntheticEvents(eventCount, kVersionStart, kVersionEnd);
+
+        for (const QString& scenario : scenarios())
+        {
+            // Fresh model and view per scenario, so zoom or drags never leak into the next one
+            TimelineModel model;
+            model.setVersionDates(kVersionStart, kVersionEnd);
+            model.addLaidOutEvents(events);
+
+            TimelineCoordinateMapper mapper(kVersionStart, kVersionEnd, TimelineCoordinateMapper::DEFAULT_PIXELS_PER_DAY);
+            TimelineView view(&model, &mapper);
+
+            // Drags commit through the undo stack exactly as in the module
+            QUndoStack undoStack;
+            view.timelineScene()->setUndoStack(&undoStack);
+            view.timelineScene()->rebuildFromModel();
+
+            view.resize(options.viewSize);
+            view.show();
+            QApplication::processEvents();
+
+            view.centerOn(mapper.dateTimeToX(QDateTime(QDate(2020, 6, 1), QTime(0, 0))), 0.0);
+
+            QWidget* viewport = view.viewport();
+            const QPoint viewportCenter = viewport->rect().center();
+
+            QImage frame(view.size(), QImage::Format_ARGB32_Premultiplied);
+            auto paintFrame = [&view, &frame]()
+            {
+                frame.fill(Qt::white);
+                QPainter painter(&frame);
+                view.render(&painter);
+            };
+
+            // Multi-selection picked up from the first screen
+            QList<TimelineItem*> dragItems;
+            QPoint dragPos;
+            if (scenario == "multidrag")
+            {
+                dragItems = visibleTimelineItems(view, kMaxDragSelection);
+                for (TimelineItem* item : std::as_const(dragItems))
+                {
+                    item->setSelected(true);
+                }
+                if (!dragItems.isEmpty())
+                {
+                    dragPos = view.mapFromScene(dragItems.first()->sceneBoundingRect().center());
+                }
+            }
+
+            // Warm-up frame (font and pixmap caches) is not measured
+            paintFrame();
+
+            TimelineRenderScenarioResult result;
+            result.scenario = scenario;
+            result.eventCount = eventCount;
+            result.frameMs.reserve(options.framesPerScenario);
+            result.frameAllocations.reserve(countAllocations ? options.framesPerScenario : 0);
+
+            const int frames = options.framesPerScenario;
+            QElapsedTimer timer;
+
+            for (int i = 0; i < frames; ++i)
+            {
+                const quint64 allocationsBefore = countAllocations ? options.allocationCount() : 0;
+                timer.start();
+
+                if (scenario == "zoom")
+                {
+                    // In for the first half, back out for the second
+                    sendCtrlWheel(viewport, viewportCenter, i < frames / 2 ? 120 : -120);
+                }
+                else if (scenario == "pan")
+                {
+                    QScrollBar* bar = (i % 4 == 3) ? view.verticalScrollBar() : view.horizontalScrollBar();
+                    bar->setValue(bar->value() + ((i % 4 == 3) ? viewport->height() / 6 : viewport->width() / 8));
+                }
+                else if (scenario == "hover")
+                {
+                    const QPoint pos((i * viewport->width()) / std::max(1, frames),
+                                     40 + (i * 37) % std::max(1, viewport->height() - 80));
+                    sendMouse(viewport, QEvent::MouseMove, pos, Qt::NoButton, Qt::NoButton);
+                }
+                else if (scenario == "multidrag" && !dragItems.isEmpty())
+                {
+                    const QPoint pos = dragPos + QPoint(i * 6, 0);
+                    if (i == 0)
+                    {
+                        sendMouse(viewport, QEvent::MouseButtonPress, pos, Qt::LeftButton, Qt::LeftButton);
+                    }
+                    else if (i == frames - 1)
+                    {
+                        sendMouse(viewport, QEvent::MouseButtonRelease, pos, Qt::LeftButton, Qt::NoButton);
+                    }
+                    else
+                    {
+                        sendMouse(viewport, QEvent::MouseMove, pos, Qt::NoButton, Qt::LeftButton);
+                    }
+                }
+
+                // Deferred work triggered by the step belongs to its frame
+                QCoreApplication::sendPostedEvents();
+                paintFrame();
+
+                result.frameMs.append(timer.nsecsElapsed() / 1.0e6);
+                if (countAllocations)
+                {
+                    result.frameAllocations.append(static_cast<double>(options.allocationCount() - allocationsBefore));
+                }
+            }
+
+            result.medianMs = percentile(result.frameMs, 0.5);
+            result.p95Ms = percentile(result.frameMs, 0.95);
+            result.maxMs = *std::max_element(result.frameMs.cbegin(), result.frameMs.cend());
+            result.allocationsP95 = percentile(result.frameAllocations, 0.95);
+
+            const Threshold threshold = thresholds.value(result.key());
+            result.thresholdP95Ms = threshold.p95Ms;
+            result.thresholdAllocationsP95 = countAllocations ? threshold.allocationsP95 : 0.0;
+
+            // Final frame against the reference image
+            const QString imageName = QString("%1-%2.png").arg(scenario).arg(eventCount);
+            if (!options.outputDir.isEmpty())
+            {
+                frame.save(QDir(options.outputDir).filePath(imageName));
+            }
+
+            if (!options.goldenDir.isEmpty() && kGoldenScenarios.contains(scenario))
+            {
+                const QString goldenPath = QDir(options.goldenDir).filePath(imageName);
+                if (options.updateGoldens)
+                {
+                    frame.save(goldenPath);
+                    result.goldenStatus = "updated";
+                }
+                else
+                {
+                    const QImage golden(goldenPath);
+                    if (golden.isNull())
+                    {
+                        // An unseeded reference must not pass silently; seed it with --update-goldens
+                        result.goldenStatus = "missing";
+                    }
+                    else
+                    {
+                        result.goldenDiff = imageDifference(frame, golden);
+                        result.goldenStatus = result.goldenDiff <= options.goldenTolerance ? "match" : "mismatch";
+                    }
+                }
+            }
+
+            allPassed = allPassed && result.passed();
+
+            out << QString("%1 %2 %3 %4 %5 %6 %7 %8  %9%10%11\n")
+                       .arg(scenario, -10)
+                       .arg(eventCount, 8)
+                       .arg(result.medianMs, 9, 'f', 2)
+                       .arg(result.p95Ms, 9, 'f', 2)
+                       .arg(result.maxMs, 9, 'f', 2)
+                       .arg(result.thresholdP95Ms > 0.0 ? QString::number(result.thresholdP95Ms, 'f', 2) : QString("-"), 9)
+                       .arg(countAllocations ? QString::number(result.allocationsP95, 'f', 0) : QString("-"), 9)
+                       .arg(result.thresholdAllocationsP95 > 0.0 ? QString::number(result.thresholdAllocationsP95, 'f', 0) : QString("-"), 9)
+                       .arg(result.goldenStatus.isEmpty() ? QString("-") : result.goldenStatus)
+                       .arg(result.overBudget() ? QString("  slow") : QString())
+                       .arg(result.passed() ? QString() : QString("  FAIL"));
+            out.flush();
+
+            QJsonArray frameTimes;
+            for (double ms : std::as_const(result.frameMs))
+            {
+                frameTimes.append(ms);
+            }
+
+            QJsonArray frameAllocations;
+            for (double allocations : std::as_const(result.frameAllocations))
+            {
+                frameAllocations.append(allocations);
+            }
+
+            QJsonObject entry;
+            entry["scenario"] = scenario;
+            entry["eventCount"] = eventCount;
+            entry["medianMs"] = result.medianMs;
+            entry["p95Ms"] = result.p95Ms;
+            entry["maxMs"] = result.maxMs;
+            entry["thresholdP95Ms"] = result.thresholdP95Ms;
+            entry["overBudget"] = result.overBudget();
+            entry["allocationsP95"] = result.allocationsP95;
+            entry["thresholdAllocationsP95"] = result.thresholdAllocationsP95;
+            entry["golden"] = result.goldenStatus;
+            entry["goldenDiff"] = result.goldenDiff;
+            entry["passed"] = result.passed();
+            entry["frameMs"] = frameTimes;
+            entry["frameAllocations"] = frameAllocations;
+            reportResults.append(entry);
+        }
+    }
+
+    if (!options.outputDir.isEmpty())
+    {
+        QJsonObject report;
+        report["platform"] = QGuiApplication::platformName();
+        report["viewWidth"] = options.viewSize.width();
+        report["viewHeight"] = options.viewSize.height();
+        report["framesPerScenario"] = options.framesPerScenario;
+        report["allocationsCounted"] = countAllocations;
+        report["passed"] = allPassed;
+        report["results"] = reportResults;
+
+        QFile file(QDir(options.outputDir).filePath("render-benchmark.json"));
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            file.write(QJsonDocument(report).toJson());
+        }
+    }
+
+    out << (allPassed ? "PASSED\n" : "FAILED\n");
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// TimelineRenderBenchmark.h
+
+
+#pragma once
+#include "modules/timeline/TimelineModel.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QSize>
+#include <QDate>
+#include <functional>
+
+
+/**
+ * @struct TimelineRenderBenchmarkOptions
+ * @brief What the render benchmark runs and where it reads/writes reference data
+ */
+struct TimelineRenderBenchmarkOptions
+{
+    QVector<int> eventCounts { 1000, 10000, 50000 };    ///< Synthetic model sizes, run in order
+    int framesPerScenario = 40;                         ///< Scripted steps per scenario
+    QSize viewSize { 1600, 900 };                       ///< View size in pixels
+    QString outputDir;                                  ///< Report and captured frames (empty = no files written)
+    QString thresholdsFile;                             ///< JSON thresholds (empty = report only)
+    QString goldenDir;                                  ///< Reference images (empty = no image comparison)
+    bool updateGoldens = false;                         ///< Overwrite reference images instead of comparing
+    double goldenTolerance = 0.002;                     ///< Fraction of pixels allowed to differ
+    std::function<quint64()> allocationCount;           ///< Running allocation total (empty = allocations not counted)
+};
+
+
+/**
+ * @struct TimelineRenderScenarioResult
+ * @brief Frame times of one scenario at one model size
+ */
+struct TimelineRenderScenarioResult
+{
+    QString scenario;                   ///< static, zoom, pan, hover or multidrag
+    int eventCount = 0;
+    QVector<double> frameMs;            ///< Input handling + full view paint, per frame
+    QVector<double> frameAllocations;   ///< Allocations per frame (empty if not counted)
+    double medianMs = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+    double allocationsP95 = 0.0;
+    double thresholdP95Ms = 0.0;        ///< Frame time budget, reported only (0 = none configured)
+    double thresholdAllocationsP95 = 0.0;   ///< 0 = no threshold configured (or allocations not counted)
+    QString goldenStatus;               ///< match, mismatch, updated, missing or empty (not compared)
+    double goldenDiff = 0.0;            ///< Fraction of differing pixels
+
+    QString key() const { return QString("%1/%2").arg(scenario).arg(eventCount); }
+    bool overBudget() const { return thresholdP95Ms > 0.0 && p95Ms > thresholdP95Ms; }   ///< Slower than the frame time budget (does not fail the run)
+
+    /// Wall-clock times depend on the machine, so only allocations and images decide the result
+    bool passed() const
+    {
+        return (thresholdAllocationsP95 <= 0.0 || allocationsP95 <= thresholdAllocationsP95)
+               && goldenStatus != "mismatch"
+               && goldenStatus != "missing";
+    }
+};
+
+
+/**
+ * @class TimelineRenderBenchmark
+ * @brief Scripted paint-time and golden-image check of TimelineScene/TimelineView
+ *
+ * Builds a view over deterministic synthetic models of increasing size and drives it with
+ * the same events a user would produce (Ctrl+wheel zoom, scrolling, hover moves, dragging a
+ * multi-selection). Every step is timed together with a synchronous paint of the whole view,
+ * and its allocations are counted when the caller provides a counter.
+ *
+ * Runs in the TimelineRenderBenchmark test executable with QT_QPA_PLATFORM=offscreen. The
+ * thresholds file maps "scenario/eventCount" to { "p95Ms": ..., "allocationsP95": ... }.
+ * The allocation limit and the reference images ("<scenario>-<eventCount>.png", a missing
+ * one included) decide the exit code; p95Ms is a budget that is only reported, since frame
+ * times vary between machines. The synthetic project lies in 2020, so the current date
+ * marker never appears in captured frames.
+ */
+class TimelineRenderBenchmark
+{
+public:
+    /**
+     * @brief Run all scenarios for all configured sizes
+     * @return Process exit code: 0 if every allocation limit and golden image passed, 1 otherwise
+     */
+    static int run(const TimelineRenderBenchmarkOptions& options);
+
+    /**
+     * @brief Deterministic synthetic events with final lanes assigned
+     * @param count Number of events
+     * @param start First day events may start on
+     * @param end Last day events may end on
+     * @param seed Random seed (same seed, same events)
+     */
+    static QVector<TimelineEvent> syntheticEvents(int count, const QDate& start, const QDate& end, quint32 seed = 1);
+
+    static const QStringList& scenarios();      ///< @brief Scenario names in run order
+};